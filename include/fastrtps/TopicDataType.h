@@ -80,6 +80,16 @@ class  TopicDataType {
          */
         RTPS_DllAPI virtual bool getKey(void* data, rtps::InstanceHandle_t* ihandle){ (void) data; (void) ihandle; return false; }
 
+        /**
+         * Check whether the type is plain: its samples have a fixed size and their memory representation is
+         * exactly what serialize() writes after the encapsulation, using the endianness of this host.
+         * Samples of plain types can be loaned from the history, avoiding the serialization copies
+         * (see Publisher::loan_sample and Subscriber::take_loaned). Loaned samples follow the 4 bytes of the
+         * encapsulation, so they are only guaranteed to be aligned to 4 bytes.
+         * @return True if the type is plain.
+         */
+        RTPS_DllAPI virtual bool is_plain() const { return false; }
+
         /**
          * Set topic data type name
          * @param nam Topic data type name
@@ -16,12 +16,14 @@
 #ifndef _FASTRTPS_LOG_LOG_H_
 #define _FASTRTPS_LOG_LOG_H_
 
-#include <fastrtps/utils/DBQueue.h>
 #include <fastrtps/fastrtps_dll.h>
 #include <thread>
 #include <sstream>
 #include <atomic>
 #include <regex>
+#include <mutex>
+#include <memory>
+#include <condition_variable>
 
 /**
  * eProsima log layer. Logging categories and verbosities can be specified dynamically at runtime. However, even on a category 
@@ -33,6 +35,13 @@
  * * #define LOG_NO_INFO
  *
  * Additionally. the lowest level (Info) is disabled by default on release branches.
+ *
+ * Both the verbosity level and the category filter are checked before the message is formatted. The result
+ * of the category filter is cached on each logging call site, so a disabled category only costs a call and a
+ * few atomic loads. Messages are formatted on the stack and pushed, without blocking, to a bounded ring that the logging
+ * thread drains. When the ring is full the entries are dropped, and the logging thread reports how many.
+ *
+ * Messages are limited to Log::MaxMessageSize bytes (1024). Longer ones are cut, and end with "..." to show it.
  */
 
 // Logging API:
@@ -48,6 +57,7 @@ namespace eprosima {
 namespace fastrtps {
 
 class LogConsumer;
+class LogRing;
 
 /**
  * Logging utilities.
@@ -97,6 +107,8 @@ public:
    RTPS_DllAPI static void KillThread();
    // Note: In VS2013, if you're linking this class statically, you will have to call KillThread before leaving
    // main, due to an unsolved MSVC bug.
+   //! Returns the number of entries dropped because the queue was full.
+   RTPS_DllAPI static uint64_t GetDroppedEntries();
 
    struct Context {
       const char* filename;
@@ -112,6 +124,52 @@ public:
       Log::Kind kind;
    };
 
+   //! Maximum length of a message. Longer messages are truncated, and end with "...".
+   static const size_t MaxMessageSize = 1024;
+
+   //! Number of entries the queue is able to hold until the logging thread takes them.
+   static const size_t QueueCapacity = 1024;
+
+   //! Result of the category filter for one logging call site, tagged with the filter it was computed for.
+   struct CategoryCache
+   {
+      CategoryCache() : state(0) {}
+
+      std::atomic<uint32_t> state;
+   };
+
+   //! Output stream formatting a message into a buffer on the stack, truncating it when it does not fit.
+   class MessageStream : private std::streambuf, public std::ostream
+   {
+   public:
+      MessageStream() : std::ostream(this), mTruncated(false) { setp(mBuffer, mBuffer + MaxMessageSize); }
+
+      const char* data() const { return mBuffer; }
+
+      size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+
+   private:
+      //! Called when the buffer is full. Marks the end of the message and drops the rest.
+      std::streambuf::int_type overflow(std::streambuf::int_type ch) override
+      {
+         if (!mTruncated)
+         {
+            mTruncated = true;
+            mBuffer[MaxMessageSize - 3] = mBuffer[MaxMessageSize - 2] = mBuffer[MaxMessageSize - 1] = '.';
+         }
+         return std::streambuf::traits_type::not_eof(ch);
+      }
+
+      char mBuffer[MaxMessageSize];
+      bool mTruncated;
+   };
+
+   /**
+    * Not recommended to call this method directly! It is used by the logging macros to check the verbosity
+    * level and the category filter before formatting the message.
+    */
+   RTPS_DllAPI static bool IsEnabled(Log::Kind, CategoryCache&, const char* category);
+
    /** 
     * Not recommended to call this method directly! Use the following macros:
     *  * logInfo(cat, msg);
@@ -120,10 +178,13 @@ public:
     */
    RTPS_DllAPI static void QueueLog(const std::string& message, const Log::Context&, Log::Kind);
 
+   //! Queues a message that is not null terminated.
+   RTPS_DllAPI static void QueueLog(const char* message, size_t length, const Log::Context&, Log::Kind);
+
 private:
    struct Resources 
    {
-      DBQueue<Entry> mLogs;
+      std::unique_ptr<LogRing> mLogs;
       std::vector<std::unique_ptr<LogConsumer> > mConsumers;
       std::unique_ptr<LogConsumer> mDefaultConsumer;
 
@@ -132,16 +193,24 @@ private:
       // Condition variable segment.
       std::condition_variable mCv;
       std::mutex mCvMutex;
-      bool mLogging;
-      bool mWork;
+      std::atomic<bool> mLogging;
+      // The logging thread is waiting for entries, so producers have to notify it.
+      std::atomic<bool> mSleeping;
+      // Dropped entries already reported by the logging thread.
+      uint64_t mReportedDrops;
 
       // Context configuration.
       std::mutex mConfigMutex;
       bool mFilenames;
       bool mFunctions;
+      // The category filter is checked by the threads that log, so it is not guarded by mConfigMutex,
+      // which is held while the consumers run.
+      std::mutex mCategoryFilterMutex;
       std::unique_ptr<std::regex> mCategoryFilter;
       std::unique_ptr<std::regex> mFilenameFilter;
       std::unique_ptr<std::regex> mErrorStringFilter;
+      // Changes whenever the category filter does, invalidating the CategoryCache of every call site.
+      std::atomic<uint32_t> mFilterGeneration;
 
       std::atomic<Log::Kind> mVerbosity;
 
@@ -157,6 +226,8 @@ private:
    static bool Preprocess(Entry&);
    static void LaunchThread();
    static void Run();
+   // Tells the consumers how many entries have been dropped since the last report.
+   static void ReportDrops();
 };
 
 /**
@@ -172,14 +243,16 @@ public:
    #define __func__ __FUNCTION__
 #endif
 
+#define LOG_QUEUE_(cat, msg, kind) { static Log::CategoryCache logCategoryCache_; if (Log::IsEnabled(kind, logCategoryCache_, #cat)) { Log::MessageStream ss; ss << msg; Log::QueueLog(ss.data(), ss.size(), Log::Context{__FILE__, __LINE__, __func__, #cat}, kind); } }
+
 #ifndef LOG_NO_ERROR
-   #define logError_(cat, msg) {std::stringstream ss; ss << msg; Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Error); }
+   #define logError_(cat, msg) LOG_QUEUE_(cat, msg, Log::Kind::Error)
 #else
    #define logError_(cat, msg) 
 #endif
 
 #ifndef LOG_NO_WARNING
-   #define logWarning_(cat, msg) { if (Log::GetVerbosity() >= Log::Kind::Warning) { std::stringstream ss; ss << msg; Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Warning); } } 
+   #define logWarning_(cat, msg) LOG_QUEUE_(cat, msg, Log::Kind::Warning)
 #else 
    #define logWarning_(cat, msg) 
 #endif
@@ -191,7 +264,7 @@ public:
 #endif
 
 #if COMPOSITE_LOG_NO_INFO 
-   #define logInfo_(cat, msg) { if (Log::GetVerbosity() >= Log::Kind::Info) { std::stringstream ss; ss << msg; Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Info); } }
+   #define logInfo_(cat, msg) LOG_QUEUE_(cat, msg, Log::Kind::Info)
 #else
    #define logInfo_(cat, msg)
 #endif
@@ -24,6 +24,7 @@
 #include <cstdio>
 #include "../rtps/common/Guid.h"
 #include "../rtps/common/Time_t.h"
+#include "../rtps/common/Statistics.h"
 #include "../attributes/PublisherAttributes.h"
 
 namespace eprosima {
@@ -51,7 +52,7 @@ public:
 
 	/**
 	 * Write data to the topic.
-	 * @param Data Pointer to the data
+	 * @param Data Pointer to the data, or a sample obtained with loan_sample, which is then no longer loaned.
 	 * @return True if correct
 	 * @par Calling example:
 	 * @snippet fastrtps_example.cpp ex_PublisherWrite
@@ -68,6 +69,22 @@ public:
 	 */
 	bool write(void*Data, rtps::WriteParams &wparams);
 
+	/**
+	 * Loan a sample from the history of the Publisher, only for plain types (see TopicDataType::is_plain).
+	 * The sample is stored directly in the payload that will be sent, so writing it doesn't serialize it.
+	 * It has to be either written, calling write with the loaned pointer, or given back with return_loan.
+	 * @param[out] sample Pointer to the loaned sample. Its contents are undefined.
+	 * @return True if a sample was loaned.
+	 */
+	bool loan_sample(void*& sample);
+
+	/**
+	 * Give back a loaned sample that is not going to be written.
+	 * @param sample Pointer to the sample obtained with loan_sample.
+	 * @return True if the pointer was a loaned sample.
+	 */
+	bool return_loan(void* sample);
+
 	/**
 	 * Dispose of a previously written data.
 	 * @param Data Pointer to the data.
@@ -108,6 +125,12 @@ public:
 	 */
 	PublisherAttributes getAttributes() const;
 
+	/**
+	 * Get the traffic handled by the associated RTPSWriter since it was created.
+	 * @return Snapshot of the statistics of the writer.
+	 */
+	rtps::EndpointStatistics get_statistics() const;
+
 private:
 	PublisherImpl* mp_impl;
 };
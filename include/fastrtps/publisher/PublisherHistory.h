@@ -26,6 +26,9 @@
 #include "../rtps/history/WriterHistory.h"
 #include "../qos/QosPolicies.h"
 
+#include <deque>
+#include <unordered_map>
+
 
 
 namespace eprosima {
@@ -41,8 +44,8 @@ class PublisherImpl;
 class PublisherHistory:public rtps::WriterHistory
 {
     public:
-        typedef std::pair<rtps::InstanceHandle_t,std::vector<rtps::CacheChange_t*>> t_p_I_Change;
-        typedef std::vector<t_p_I_Change> t_v_Inst_Caches;
+        typedef std::deque<rtps::CacheChange_t*> t_Inst_Changes;
+        typedef std::unordered_map<rtps::InstanceHandle_t, t_Inst_Changes> t_m_Inst_Caches;
         /**
          * Constructor of the PublisherHistory.
          * @param pimpl Pointer to the PublisherImpl.
@@ -82,16 +85,16 @@ class PublisherHistory:public rtps::WriterHistory
         /**
          * Remove a change by the publisher History.
          * @param change Pointer to the CacheChange_t.
-         * @param vit Pointer to the iterator of the Keyed history vector.
+         * @param vit Pointer to the iterator of the instance of the change.
          * @return True if removed.
          */
-        bool remove_change_pub(rtps::CacheChange_t* change,t_v_Inst_Caches::iterator* vit=nullptr);
+        bool remove_change_pub(rtps::CacheChange_t* change,t_m_Inst_Caches::iterator* vit=nullptr);
 
         virtual bool remove_change_g(rtps::CacheChange_t* a_change);
 
     private:
-        //!Vector of pointer to the CacheChange_t divided by key.
-        t_v_Inst_Caches m_keyedChanges;
+        //!Changes of each instance, ordered by sequence number and indexed by instance handle.
+        t_m_Inst_Caches m_keyedChanges;
         //!HistoryQosPolicy values.
         HistoryQosPolicy m_historyQos;
         //!ResourceLimitsQosPolicy values.
@@ -99,7 +102,7 @@ class PublisherHistory:public rtps::WriterHistory
         //!Publisher Pointer
         PublisherImpl* mp_pubImpl;
 
-        bool find_Key(rtps::CacheChange_t* a_change,t_v_Inst_Caches::iterator* vecPairIterrator);
+        bool find_Key(rtps::CacheChange_t* a_change,t_m_Inst_Caches::iterator* vecPairIterrator);
 };
 
 } /* namespace fastrtps */
@@ -634,17 +634,73 @@ typedef enum PublishModeQosPolicyKind : rtps::octet{
     ASYNCHRONOUS_PUBLISH_MODE	//!< Asynchronous publication mode.
 }PublishModeQosPolicyKind_t;
 
+/**
+ * Enum PublishModePriorityKind, priority classes of the asynchronous sends of a writer.
+ */
+typedef enum PublishModePriorityKind : rtps::octet{
+    LOW_PRIORITY_PUBLISH_MODE,	//!< Served only when no other writer has pending sends.
+    NORMAL_PRIORITY_PUBLISH_MODE,	//!< Default priority.
+    HIGH_PRIORITY_PUBLISH_MODE	//!< Served before the writers of lower priority.
+}PublishModePriorityKind_t;
+
 /**
  * Class PublishModeQosPolicy, defines the publication mode for a specific writer.
  * kind: Default value SYNCHRONOUS_PUBLISH_MODE.
+ * priority: Priority of the asynchronous sends of the writer. Default value NORMAL_PRIORITY_PUBLISH_MODE.
  */
 class PublishModeQosPolicy : public QosPolicy {
     public:
         PublishModeQosPolicyKind kind;
-        RTPS_DllAPI PublishModeQosPolicy() : kind(SYNCHRONOUS_PUBLISH_MODE){};
+        PublishModePriorityKind priority;
+        RTPS_DllAPI PublishModeQosPolicy() : kind(SYNCHRONOUS_PUBLISH_MODE),
+            priority(NORMAL_PRIORITY_PUBLISH_MODE){};
         virtual RTPS_DllAPI ~PublishModeQosPolicy(){};
 };
 
+/**
+ * Enum FragmentSchedulingQosPolicyKind, orders in which a writer sends the fragments of large samples.
+ */
+typedef enum FragmentSchedulingQosPolicyKind : rtps::octet{
+    SEQUENTIAL_FRAGMENT_SCHEDULING,	//!< All the fragments of a sample are sent before the ones of the next sample (default).
+    INTERLEAVED_FRAGMENT_SCHEDULING	//!< One fragment of each pending sample is sent in turn.
+}FragmentSchedulingQosPolicyKind_t;
+
+/**
+ * Class FragmentSchedulingQosPolicy, defines how an asynchronous writer sends the fragments of large samples.
+ * kind: Default value SEQUENTIAL_FRAGMENT_SCHEDULING.
+ * bytesPerReaderPerPeriod: Bytes of fragments sent to each matched reader in a period. Default value 0 (no limit).
+ * periodMillisecs: Pacing period in milliseconds. Default value 100.
+ */
+class FragmentSchedulingQosPolicy : public QosPolicy {
+    public:
+        FragmentSchedulingQosPolicyKind kind;
+        uint32_t bytesPerReaderPerPeriod;
+        uint32_t periodMillisecs;
+        RTPS_DllAPI FragmentSchedulingQosPolicy() : kind(SEQUENTIAL_FRAGMENT_SCHEDULING),
+            bytesPerReaderPerPeriod(0), periodMillisecs(100){};
+        virtual RTPS_DllAPI ~FragmentSchedulingQosPolicy(){};
+};
+
+/**
+ * Enum SlowReaderQosPolicyKind, what a reliable writer with a full history does when a reader is holding back its oldest samples.
+ */
+typedef enum SlowReaderQosPolicyKind : rtps::octet{
+    BLOCK_ON_SLOW_READER,	//!< The writer waits for the acknowledgements of all the readers (default).
+    DROP_SLOWEST_READER	//!< The writer stops waiting for the slowest readers and removes the samples they hold back.
+}SlowReaderQosPolicyKind_t;
+
+/**
+ * Class SlowReaderQosPolicy, defines how a reliable writer keeps its memory bounded when a reader does not keep up.
+ * Dropped readers are served as best-effort ones until they acknowledge again.
+ * kind: Default value BLOCK_ON_SLOW_READER.
+ */
+class SlowReaderQosPolicy : public QosPolicy {
+    public:
+        SlowReaderQosPolicyKind kind;
+        RTPS_DllAPI SlowReaderQosPolicy() : kind(BLOCK_ON_SLOW_READER){};
+        virtual RTPS_DllAPI ~SlowReaderQosPolicy(){};
+};
+
 }
 }
 
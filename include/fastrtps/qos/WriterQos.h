@@ -71,6 +71,10 @@ public:
 	GroupDataQosPolicy m_groupData;
 	//!Publication Mode Qos, implemented in the library.
 	PublishModeQosPolicy m_publishMode;
+	//!Fragment Scheduling Qos, implemented in the library.
+	FragmentSchedulingQosPolicy m_fragmentScheduling;
+	//!Slow Reader Qos, implemented in the library.
+	SlowReaderQosPolicy m_slowReader;
 	/**
 	 * Set Qos from another class
 	 * @param qos Reference from a WriterQos object.
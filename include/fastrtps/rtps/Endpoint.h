@@ -24,6 +24,7 @@
 #include "common/Types.h"
 #include "common/Locator.h"
 #include "common/Guid.h"
+#include "common/Statistics.h"
 
 #include "attributes/EndpointAttributes.h"
 
@@ -72,6 +73,18 @@ class Endpoint
      */
     RTPS_DllAPI inline EndpointAttributes* getAttributes() { return &m_att; }
 
+    /**
+     * Get the traffic counters, to be updated by the message group and the message receiver.
+     * @return Statistics counters of the endpoint
+     */
+    inline EndpointStatisticsCounters& statistics_counters() { return m_statistics; }
+
+    /**
+     * Get the traffic handled by this endpoint since it was created.
+     * @return Snapshot of the statistics of the endpoint
+     */
+    RTPS_DllAPI inline EndpointStatistics get_statistics() const { return m_statistics.snapshot(); }
+
 #if HAVE_SECURITY
     bool supports_rtps_protection() { return supports_rtps_protection_; }
 #endif
@@ -84,6 +97,8 @@ class Endpoint
     EndpointAttributes m_att;
     //!Endpoint Mutex
     std::recursive_mutex* mp_mutex;
+    //!Endpoint traffic counters
+    EndpointStatisticsCounters m_statistics;
 
     private:
 
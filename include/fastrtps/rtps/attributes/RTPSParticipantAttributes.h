@@ -214,6 +214,10 @@ class RTPSParticipantAttributes
             setName("RTPSParticipant");
             sendSocketBufferSize = 0;
             listenSocketBufferSize = 0;
+            listenWorkerThreads = 0;
+            listenBufferPoolSize = 64;
+            asyncSendThreads = 1;
+            eventThreads = 1;
             use_IP4_to_send = true;
             use_IP6_to_send = false;
             participantID = -1;
@@ -258,6 +262,30 @@ class RTPSParticipantAttributes
          */
         uint32_t listenSocketBufferSize;
 
+        /*! Number of threads decoding the messages received by each user traffic listen resource. The listening
+         * thread then only drains the socket, and messages from the same remote participant are always decoded
+         * by the same worker, preserving their order. Zero value decodes the messages on the listening thread.
+         * Default value: 0.
+         */
+        uint32_t listenWorkerThreads;
+
+        /*! Number of preallocated reception buffers shared by the worker threads of each listen resource.
+         * Only used when listenWorkerThreads is not zero. Default value: 64.
+         */
+        uint32_t listenBufferPoolSize;
+
+        /*! Number of threads sending the changes of the asynchronous writers of this participant, and the
+         * responses to the NACKs of all its writers. A writer is never served by two threads at the same time,
+         * so several threads only help when there are several writers with pending sends. Default value: 1.
+         */
+        uint32_t asyncSendThreads;
+
+        /*! Number of threads running the timed events (heartbeats, NACK responses, liveliness, ...) of this
+         * participant. Events expiring at the same time are run in parallel when there are several threads,
+         * but an event is never run by two threads at the same time. Default value: 1.
+         */
+        uint32_t eventThreads;
+
         //! Builtin parameters.
         BuiltinAttributes builtin;
         //!Port Parameters
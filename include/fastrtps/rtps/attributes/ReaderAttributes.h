@@ -39,12 +39,15 @@ class ReaderTimes
         {
             initialAcknackDelay.fraction = 200*1000*1000;
             heartbeatResponseDelay.fraction = 20*1000*1000;
+            fragmentedSampleTimeout.seconds = 10;
         };
         virtual ~ReaderTimes(){};
         //!Initial AckNack delay. Default value ~45ms.
         Duration_t initialAcknackDelay;
         //!Delay to be applied when a hearbeat message is received, default value ~116ms.
         Duration_t heartbeatResponseDelay;
+        //!Time a partially received fragmented sample is kept without receiving new fragments, default value 10s.
+        Duration_t fragmentedSampleTimeout;
 };
 
 /**
@@ -35,6 +35,14 @@ typedef enum RTPSWriterPublishMode : octet
     ASYNCHRONOUS_WRITER
 } RTPSWriterPublishMode;
 
+//! Priority classes of the writers served by the asynchronous send scheduler of a participant.
+typedef enum RTPSWriterAsyncPriority : octet
+{
+    LOW_PRIORITY_WRITER,
+    NORMAL_PRIORITY_WRITER,
+    HIGH_PRIORITY_WRITER
+} RTPSWriterAsyncPriority;
+
 
 /**
  * Class WriterTimes, defining the times associated with the Reliable Writers events.
@@ -71,6 +79,9 @@ class  WriterAttributes
     public:
 
         WriterAttributes() : mode(SYNCHRONOUS_WRITER),
+            asyncPriority(NORMAL_PRIORITY_WRITER),
+            interleaveFragments(false),
+            dropSlowestReader(false),
             disableHeartbeatPiggyback(false)
         {
             endpoint.endpointKind = WRITER;
@@ -89,9 +100,21 @@ class  WriterAttributes
         //!Indicates if the Writer is synchronous or asynchronous
         RTPSWriterPublishMode mode;
 
+        //!Priority of the writer in the asynchronous send scheduler of its participant
+        RTPSWriterAsyncPriority asyncPriority;
+
         // Throughput controller, always the last one to apply 
         ThroughputControllerDescriptor throughputController;
 
+        //!Send in turn one fragment of each sample pending to be sent, instead of a sample after the other (only used for RELIABLE).
+        bool interleaveFragments;
+
+        //!Limit of bytes of fragments sent to each matched reader per period (only used for RELIABLE). Not limited by default.
+        ThroughputControllerDescriptor readerFragmentThroughput;
+
+        //!Stop waiting for the slowest readers instead of blocking when the history is full (only used for RELIABLE).
+        bool dropSlowestReader;
+
         //! Disable the sending of heartbeat piggybacks.
         bool disableHeartbeatPiggyback;
 };
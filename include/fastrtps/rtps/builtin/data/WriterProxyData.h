@@ -180,7 +180,7 @@ class WriterProxyData
             m_typeName = std::move(typeName);
         }
 
-        RTPS_DllAPI std::string typeName() const
+        RTPS_DllAPI const std::string& typeName() const
         {
             return m_typeName;
         }
@@ -200,7 +200,7 @@ class WriterProxyData
             m_topicName = std::move(topicName);
         }
 
-        RTPS_DllAPI std::string topicName() const
+        RTPS_DllAPI const std::string& topicName() const
         {
             return m_topicName;
         }
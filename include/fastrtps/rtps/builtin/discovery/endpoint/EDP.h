@@ -30,6 +30,7 @@ namespace fastrtps{
 class TopicAttributes;
 class ReaderQos;
 class WriterQos;
+class PartitionQosPolicy;
 
 namespace rtps {
 
@@ -218,6 +219,15 @@ class EDP
          * @return True
          */
         bool pairingWriter(RTPSWriter* W, const ParticipantProxyData& pdata, const WriterProxyData& wdata);
+
+        /**
+         * Check whether the partitions of a writer and a reader match.
+         * Names without wildcards are compared directly, without going through pattern matching.
+         * @param wpartition Partition QoS of the writer.
+         * @param rpartition Partition QoS of the reader.
+         * @return True if they share a partition.
+         */
+        static bool validPartitions(const PartitionQosPolicy& wpartition, const PartitionQosPolicy& rpartition);
 };
 
 }
@@ -0,0 +1,148 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoveredEndpointIndex.h
+ *
+ */
+
+#ifndef DISCOVEREDENDPOINTINDEX_H_
+#define DISCOVEREDENDPOINTINDEX_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../../../common/Guid.h"
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+class ParticipantProxyData;
+
+/**
+ * Discovered reader or writer, together with the participant it belongs to.
+ *@ingroup DISCOVERY_MODULE
+ */
+template<class ProxyData>
+struct DiscoveredEndpoint
+{
+    ParticipantProxyData* participant;
+    ProxyData* data;
+};
+
+/**
+ * Index of the discovered readers or writers, by GUID and by topic name.
+ * It does not own the proxies, and it is not thread safe: the PDP mutex protects it.
+ *@ingroup DISCOVERY_MODULE
+ */
+template<class ProxyData>
+class DiscoveredEndpointIndex
+{
+    public:
+
+        /**
+         * Add an endpoint to the index.
+         * @param participant Participant the endpoint belongs to.
+         * @param data Proxy of the endpoint. Its GUID and topic name must not change while it is indexed.
+         * @return False if an endpoint with the same GUID was already indexed.
+         */
+        bool add(ParticipantProxyData* participant, ProxyData* data)
+        {
+            DiscoveredEndpoint<ProxyData> endpoint{participant, data};
+            if(!by_guid_.emplace(data->guid(), endpoint).second)
+                return false;
+
+            by_topic_[data->topicName()].push_back(endpoint);
+            return true;
+        }
+
+        /**
+         * Find an endpoint by GUID.
+         * @param guid GUID of the endpoint.
+         * @return Pointer to the endpoint, or nullptr if it is not indexed.
+         */
+        const DiscoveredEndpoint<ProxyData>* find(const GUID_t& guid) const
+        {
+            auto it = by_guid_.find(guid);
+            return it == by_guid_.end() ? nullptr : &it->second;
+        }
+
+        /**
+         * Remove an endpoint from the index.
+         * @param guid GUID of the endpoint.
+         * @param endpoint Filled with the removed endpoint.
+         * @return False if it was not indexed.
+         */
+        bool remove(const GUID_t& guid, DiscoveredEndpoint<ProxyData>& endpoint)
+        {
+            auto it = by_guid_.find(guid);
+            if(it == by_guid_.end())
+                return false;
+
+            endpoint = it->second;
+            by_guid_.erase(it);
+
+            auto topic_it = by_topic_.find(endpoint.data->topicName());
+            if(topic_it != by_topic_.end())
+            {
+                std::vector<DiscoveredEndpoint<ProxyData>>& endpoints = topic_it->second;
+                auto eit = std::find_if(endpoints.begin(), endpoints.end(),
+                        [&endpoint](const DiscoveredEndpoint<ProxyData>& e){ return e.data == endpoint.data; });
+                if(eit != endpoints.end())
+                {
+                    *eit = endpoints.back();
+                    endpoints.pop_back();
+                }
+
+                if(endpoints.empty())
+                    by_topic_.erase(topic_it);
+            }
+
+            return true;
+        }
+
+        /**
+         * Get the endpoints of a topic.
+         * @param topic_name Name of the topic.
+         * @return Copy of the endpoints, so it can be iterated while the index changes.
+         */
+        std::vector<DiscoveredEndpoint<ProxyData>> in_topic(const std::string& topic_name) const
+        {
+            auto it = by_topic_.find(topic_name);
+            if(it == by_topic_.end())
+                return std::vector<DiscoveredEndpoint<ProxyData>>();
+            return it->second;
+        }
+
+        //! Number of indexed endpoints.
+        size_t size() const { return by_guid_.size(); }
+
+        //! Number of topics with indexed endpoints.
+        size_t topic_count() const { return by_topic_.size(); }
+
+    private:
+
+        std::unordered_map<GUID_t, DiscoveredEndpoint<ProxyData>> by_guid_;
+
+        std::unordered_map<std::string, std::vector<DiscoveredEndpoint<ProxyData>>> by_topic_;
+};
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
+#endif
+#endif /* DISCOVEREDENDPOINTINDEX_H_ */
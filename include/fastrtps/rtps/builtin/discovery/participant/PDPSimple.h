@@ -22,6 +22,10 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "DiscoveredEndpointIndex.h"
 #include "../../../common/Guid.h"
 #include "../../../attributes/RTPSParticipantAttributes.h"
 
@@ -221,6 +225,22 @@ class PDPSimple
 
     CDRMessage_t get_participant_proxy_data_serialized(Endianness_t endian);
 
+    /**
+     * Get the readers, local and remote, discovered on a topic.
+     * The returned pointers are only valid while the PDP mutex is held.
+     * @param topic_name Name of the topic.
+     * @return Copy of the readers of the topic, so it can be iterated while matching changes the tables.
+     */
+    std::vector<DiscoveredEndpoint<ReaderProxyData>> getReadersInTopic(const std::string& topic_name) const;
+
+    /**
+     * Get the writers, local and remote, discovered on a topic.
+     * The returned pointers are only valid while the PDP mutex is held.
+     * @param topic_name Name of the topic.
+     * @return Copy of the writers of the topic, so it can be iterated while matching changes the tables.
+     */
+    std::vector<DiscoveredEndpoint<WriterProxyData>> getWritersInTopic(const std::string& topic_name) const;
+
     private:
     //!Pointer to the local RTPSParticipant.
     RTPSParticipantImpl* mp_RTPSParticipant;
@@ -234,6 +254,12 @@ class PDPSimple
     EDP* mp_EDP;
     //!Registered RTPSParticipants (including the local one, that is the first one.)
     std::vector<ParticipantProxyData*> m_participantProxies;
+    //!Registered RTPSParticipants by GUID prefix.
+    std::unordered_map<GuidPrefix_t, ParticipantProxyData*> m_participantsByPrefix;
+    //!Discovered readers by GUID and topic name.
+    DiscoveredEndpointIndex<ReaderProxyData> m_readerIndex;
+    //!Discovered writers by GUID and topic name.
+    DiscoveredEndpointIndex<WriterProxyData> m_writerIndex;
     //!Variable to indicate if any parameter has changed.
     bool m_hasChangedLocalPDP;
     //!TimedEvent to periodically resend the local RTPSParticipant information.
@@ -250,6 +276,19 @@ class PDPSimple
      * @return True if correct.
      */
     bool createSPDPEndpoints();
+
+    /**
+     * Register a participant proxy and index it by GUID prefix. The PDP mutex must be held.
+     * @param pdata Participant proxy, owned by this object from now on.
+     */
+    void addParticipantProxy(ParticipantProxyData* pdata);
+
+    /**
+     * Remove a participant proxy and all its endpoints from the discovery indexes. The PDP mutex must be held.
+     * @param pdata Participant proxy.
+     */
+    void unindexParticipantProxy(ParticipantProxyData* pdata);
+
     std::recursive_mutex* mp_mutex;
 
 
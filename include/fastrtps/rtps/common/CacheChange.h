@@ -27,6 +27,7 @@
 #include <fastrtps/rtps/common/FragmentNumber.h>
 
 #include <vector>
+#include <atomic>
 
 namespace eprosima
 {
@@ -79,6 +80,11 @@ namespace eprosima
                 WriteParams write_params;
                 bool is_untyped_;
 
+                //!Position of the change inside the CacheChangePool that owns it.
+                uint32_t pool_index_;
+                //!Next free change of the CacheChangePool, as its position plus one. Zero ends the list.
+                std::atomic<uint32_t> pool_next_;
+
                 /*!
                  * @brief Default constructor.
                  * Creates an empty CacheChange_t.
@@ -87,7 +93,8 @@ namespace eprosima
                     kind(ALIVE),
                     isRead(false),
                     is_untyped_(true),
-                    dataFragments_(new std::vector<uint32_t>()),
+                    pool_index_(0),
+                    pool_next_(0),
                     fragment_size_(0)
                 {
                 }
@@ -105,7 +112,8 @@ namespace eprosima
                     serializedPayload(payload_size),
                     isRead(false),
                     is_untyped_(is_untyped),
-                    dataFragments_(new std::vector<uint32_t>()),
+                    pool_index_(0),
+                    pool_next_(0),
                     fragment_size_(0)
                 {
                 }
@@ -126,8 +134,8 @@ namespace eprosima
 
                     bool ret = serializedPayload.copy(&ch_ptr->serializedPayload, (ch_ptr->is_untyped_ ? false : true));
 
-                    setFragmentSize(ch_ptr->fragment_size_);
-                    dataFragments_->assign(ch_ptr->dataFragments_->begin(), ch_ptr->dataFragments_->end());
+                    fragment_size_ = ch_ptr->fragment_size_;
+                    dataFragments_ = ch_ptr->dataFragments_;
 
                     isRead = ch_ptr->isRead;
 
@@ -146,24 +154,25 @@ namespace eprosima
                     // Copy certain values from serializedPayload
                     serializedPayload.encapsulation = ch_ptr->serializedPayload.encapsulation;
 
-                    setFragmentSize(ch_ptr->fragment_size_);
-                    dataFragments_->assign(ch_ptr->dataFragments_->begin(), ch_ptr->dataFragments_->end());
+                    fragment_size_ = ch_ptr->fragment_size_;
+                    dataFragments_ = ch_ptr->dataFragments_;
 
                     isRead = ch_ptr->isRead;
                 }
 
                 ~CacheChange_t()
                 {
-                    if (dataFragments_)
-                        delete dataFragments_;
                 }
 
                 uint32_t getFragmentCount() const
                 { 
-                    return (uint32_t)dataFragments_->size();
+                    return dataFragments_.size();
                 }
 
-                std::vector<uint32_t>* getDataFragments() { return dataFragments_; }
+                //! Fragments received of this change. Only used in readers.
+                FragmentBitmap_t& getDataFragments() { return dataFragments_; }
+
+                const FragmentBitmap_t& getDataFragments() const { return dataFragments_; }
 
                 uint16_t getFragmentSize() const { return fragment_size_; }
 
@@ -172,14 +181,14 @@ namespace eprosima
                     this->fragment_size_ = fragment_size;
 
                     if (fragment_size == 0) {
-                        dataFragments_->clear();
+                        dataFragments_.clear();
                     }
                     else
                     {
                         //TODO Mirar si cuando se compatibilice con RTI funciona el calculo, porque ellos
                         //en el sampleSize incluyen el padding.
                         uint32_t size = (serializedPayload.length + fragment_size - 1) / fragment_size;
-                        dataFragments_->assign(size, ChangeFragmentStatus_t::NOT_PRESENT);
+                        dataFragments_.assign(size, false);
                     }
                 }
 
@@ -187,7 +196,7 @@ namespace eprosima
                 private:
 
                 // Data fragments
-                std::vector<uint32_t>* dataFragments_;
+                FragmentBitmap_t dataFragments_;
 
                 // Fragment size
                 uint16_t fragment_size_;
@@ -229,13 +238,13 @@ namespace eprosima
 
                 public:
 
-                ChangeForReader_t() : status_(UNSENT), is_relevant_(true),
+                ChangeForReader_t() : status_(UNSENT), is_relevant_(true), is_repair_(false),
                 change_(nullptr)
                 {
                 }
 
                 ChangeForReader_t(const ChangeForReader_t& ch) : status_(ch.status_),
-                is_relevant_(ch.is_relevant_), seq_num_(ch.seq_num_), change_(ch.change_),
+                is_relevant_(ch.is_relevant_), is_repair_(ch.is_repair_), seq_num_(ch.seq_num_), change_(ch.change_),
                 unsent_fragments_(ch.unsent_fragments_)
                 {
                 }
@@ -243,15 +252,14 @@ namespace eprosima
                 //TODO(Ricardo) Temporal
                 //ChangeForReader_t(const CacheChange_t* change) : status_(UNSENT),
                 ChangeForReader_t(CacheChange_t* change) : status_(UNSENT),
-                is_relevant_(true), seq_num_(change->sequenceNumber), change_(change)
+                is_relevant_(true), is_repair_(false), seq_num_(change->sequenceNumber), change_(change)
                 {
                    if (change->getFragmentSize() != 0)
-                    for (uint32_t i = 1; i != change->getFragmentCount() + 1; i++)
-                       unsent_fragments_.insert(i); // Indexed on 1
+                       unsent_fragments_.assign(change->getFragmentCount(), true);
                 }
 
                 ChangeForReader_t(const SequenceNumber_t& seq_num) : status_(UNSENT),
-                is_relevant_(true), seq_num_(seq_num), change_(nullptr)
+                is_relevant_(true), is_repair_(false), seq_num_(seq_num), change_(nullptr)
                 {
                 }
 
@@ -261,6 +269,7 @@ namespace eprosima
                 {
                     status_ = ch.status_;
                     is_relevant_ = ch.is_relevant_;
+                    is_repair_ = ch.is_repair_;
                     seq_num_ = ch.seq_num_;
                     change_ = ch.change_;
                     unsent_fragments_ = ch.unsent_fragments_;
@@ -317,26 +326,56 @@ namespace eprosima
                 }
 
                 FragmentNumberSet_t getUnsentFragments() const
+                {
+                    FragmentNumberSet_t unsent;
+                    unsent_fragments_.to_fragment_number_set(unsent, true);
+                    return unsent;
+                }
+
+                //! Fragments pending to be sent, stored at their fragment number minus one.
+                const FragmentBitmap_t& getUnsentFragmentsBitmap() const
                 {
                     return unsent_fragments_;
                 }
 
+                bool hasUnsentFragments() const
+                {
+                    return unsent_fragments_.count() != 0;
+                }
+
                 void markAllFragmentsAsUnsent()
                 {
                    if (change_ != nullptr && change_->getFragmentSize() != 0)
-                    for (uint32_t i = 1; i != change_->getFragmentCount() + 1; i++)
-                       unsent_fragments_.insert(i); // Indexed on 1
+                       unsent_fragments_.assign(change_->getFragmentCount(), true);
                 }
 
                 void markFragmentsAsSent(const FragmentNumber_t& sentFragment)
                 {
-                    unsent_fragments_.erase(sentFragment);
+                    unsent_fragments_.reset(sentFragment - 1); // Indexed on 1
                 }
 
-                void markFragmentsAsUnsent(const FragmentNumberSet_t& unsentFragments)
+                /**
+                 * Marks fragments as pending to be sent again. Fragment numbers out of the change are ignored.
+                 * @return True if some of them had already been sent.
+                 */
+                bool markFragmentsAsUnsent(const FragmentNumberSet_t& unsentFragments)
                 {
+                    bool marked = false;
                     for(auto element : unsentFragments.set)
-                        unsent_fragments_.insert(element);
+                        marked |= unsent_fragments_.set(element - 1); // Indexed on 1
+                    return marked;
+                }
+
+                //! Marks the change as requested again by the reader.
+                void markAsRepair()
+                {
+                    is_repair_ = true;
+                }
+
+                //! Whether the reader has requested the change again.
+                bool isRepair() const
+                {
+                    return is_repair_;
                 }
 
                 private:
@@ -347,6 +386,9 @@ namespace eprosima
                 //!Boolean specifying if this change is relevant
                 bool is_relevant_;
 
+                //!Boolean specifying if the reader has requested this change again
+                bool is_repair_;
+
                 //!Sequence number
                 SequenceNumber_t seq_num_;
 
@@ -354,7 +396,7 @@ namespace eprosima
                 //const CacheChange_t* change_;
                 CacheChange_t* change_;
 
-                std::set<FragmentNumber_t> unsent_fragments_;
+                FragmentBitmap_t unsent_fragments_;
             };
 
             struct ChangeForReaderCmp
@@ -22,6 +22,7 @@
 #include "Types.h"
 
 #include <set>
+#include <vector>
 #include <cmath>
 #include <algorithm>
 #include <sstream>
@@ -184,6 +185,149 @@ inline FragmentNumberSet_t operator+(FragmentNumberSet_t lhs, const FragmentNumb
     return lhs;
 }
 
+//!Class FragmentBitmap_t, tracks which fragments of a sample are set using one bit per fragment.
+//!Positions are zero based, so the fragment number N is stored at position N - 1.
+//!@ingroup COMMON_MODULE
+class FragmentBitmap_t
+{
+    public:
+
+        FragmentBitmap_t() : size_(0), count_(0) {}
+
+        /**
+         * Resizes the bitmap, setting or clearing all its positions.
+         * The memory is kept, so reusing the bitmap for samples with the same number of fragments does not allocate.
+         * @param size Number of fragments.
+         * @param value Initial value of all the positions.
+         */
+        void assign(uint32_t size, bool value)
+        {
+            size_ = size;
+            count_ = value ? size : 0;
+            words_.assign((size + 31) / 32, value ? 0xFFFFFFFFu : 0u);
+
+            // Bits beyond the last position are always kept cleared.
+            if(value && (size % 32) != 0)
+                words_.back() = (1u << (size % 32)) - 1u;
+        }
+
+        //! Removes all the positions.
+        void clear()
+        {
+            size_ = 0;
+            count_ = 0;
+            words_.clear();
+        }
+
+        //! @return Number of positions.
+        uint32_t size() const { return size_; }
+
+        //! @return Number of positions set.
+        uint32_t count() const { return count_; }
+
+        //! @return True if all the positions are set.
+        bool all() const { return count_ == size_; }
+
+        bool test(uint32_t position) const
+        {
+            return position < size_ && (words_[position / 32] & (1u << (position % 32))) != 0;
+        }
+
+        /**
+         * Sets a position.
+         * @return True if the position was not set before. False if it was or is out of range.
+         */
+        bool set(uint32_t position)
+        {
+            if(position >= size_)
+                return false;
+
+            uint32_t mask = 1u << (position % 32);
+            uint32_t& word = words_[position / 32];
+            if((word & mask) != 0)
+                return false;
+
+            word |= mask;
+            ++count_;
+            return true;
+        }
+
+        /**
+         * Clears a position.
+         * @return True if the position was set before. False if it was not or is out of range.
+         */
+        bool reset(uint32_t position)
+        {
+            if(position >= size_)
+                return false;
+
+            uint32_t mask = 1u << (position % 32);
+            uint32_t& word = words_[position / 32];
+            if((word & mask) == 0)
+                return false;
+
+            word &= ~mask;
+            --count_;
+            return true;
+        }
+
+        /**
+         * Finds the first position, starting at a given one, with a given value.
+         * @return The position found, or size() if there is none.
+         */
+        uint32_t find_next(uint32_t position, bool value) const
+        {
+            while(position < size_)
+            {
+                uint32_t word = value ? words_[position / 32] : ~words_[position / 32];
+                word &= 0xFFFFFFFFu << (position % 32);
+
+                if(word != 0)
+                {
+                    uint32_t found = (position & ~31u) + lowest_bit_(word);
+                    return found < size_ ? found : size_;
+                }
+
+                position = (position & ~31u) + 32;
+            }
+
+            return size_;
+        }
+
+        //! Copies the fragment numbers of the positions with a given value into a FragmentNumberSet_t.
+        void to_fragment_number_set(FragmentNumberSet_t& fragment_set, bool value) const
+        {
+            fragment_set.set.clear();
+            fragment_set.base = 0;
+
+            uint32_t position = find_next(0, value);
+            if(position < size_)
+                fragment_set.base = position + 1;
+
+            for(; position < size_; position = find_next(position + 1, value))
+                fragment_set.set.insert(fragment_set.set.end(), position + 1);
+        }
+
+    private:
+
+        static uint32_t lowest_bit_(uint32_t word)
+        {
+            uint32_t bit = 0;
+            while((word & 1u) == 0)
+            {
+                word >>= 1;
+                ++bit;
+            }
+            return bit;
+        }
+
+        std::vector<uint32_t> words_;
+
+        uint32_t size_;
+
+        uint32_t count_;
+};
+
 }
 }
 }
@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
 
 namespace eprosima{
 namespace fastrtps{
@@ -472,5 +473,46 @@ inline std::ostream& operator<<(std::ostream& output,const GUID_t& guid)
 }
 }
 
+namespace std {
+
+//! Hash of an EntityId_t, so it can be used as key of unordered containers.
+template<>
+struct hash<eprosima::fastrtps::rtps::EntityId_t>
+{
+    size_t operator()(const eprosima::fastrtps::rtps::EntityId_t& id) const
+    {
+        return (static_cast<size_t>(id.value[0]) << 24) | (static_cast<size_t>(id.value[1]) << 16) |
+            (static_cast<size_t>(id.value[2]) << 8) | static_cast<size_t>(id.value[3]);
+    }
+};
+
+//! Hash of a GuidPrefix_t, so it can be used as key of unordered containers.
+template<>
+struct hash<eprosima::fastrtps::rtps::GuidPrefix_t>
+{
+    size_t operator()(const eprosima::fastrtps::rtps::GuidPrefix_t& prefix) const
+    {
+        // FNV-1a
+        uint64_t h = 14695981039346656037ULL;
+        for(size_t i = 0; i < eprosima::fastrtps::rtps::GuidPrefix_t::size; ++i)
+        {
+            h = (h ^ prefix.value[i]) * 1099511628211ULL;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+//! Hash of a GUID_t, so it can be used as key of unordered containers.
+template<>
+struct hash<eprosima::fastrtps::rtps::GUID_t>
+{
+    size_t operator()(const eprosima::fastrtps::rtps::GUID_t& guid) const
+    {
+        return hash<eprosima::fastrtps::rtps::GuidPrefix_t>()(guid.guidPrefix) * 31 +
+            hash<eprosima::fastrtps::rtps::EntityId_t>()(guid.entityId);
+    }
+};
+
+}
 
 #endif /* RTPS_GUID_H_ */
@@ -173,4 +173,24 @@ inline std::ostream& operator<<(std::ostream& output,const InstanceHandle_t& iHa
 }
 }
 
+namespace std {
+
+//! Hash of an InstanceHandle_t, so it can be used as key of unordered containers.
+template<>
+struct hash<eprosima::fastrtps::rtps::InstanceHandle_t>
+{
+    size_t operator()(const eprosima::fastrtps::rtps::InstanceHandle_t& handle) const
+    {
+        // FNV-1a
+        uint64_t h = 14695981039346656037ULL;
+        for(size_t i = 0; i < 16; ++i)
+        {
+            h = (h ^ handle.value[i]) * 1099511628211ULL;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+}
+
 #endif /* INSTANCEHANDLE_H_ */
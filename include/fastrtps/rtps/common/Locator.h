@@ -38,6 +38,7 @@ namespace rtps{
 #define LOCATOR_KIND_RESERVED 0
 #define LOCATOR_KIND_UDPv4 1
 #define LOCATOR_KIND_UDPv6 2
+#define LOCATOR_KIND_SHM 16
 
 
 //!@brief Class Locator_t, uniquely identifies a communication channel for a particular transport. 
@@ -51,6 +52,7 @@ class RTPS_DllAPI Locator_t
          * @brief Specifies the locator type. Valid values are:
          * LOCATOR_KIND_UDPv4
          * LOCATOR_KIND_UDPv6
+         * LOCATOR_KIND_SHM
          */
         int32_t kind;
         uint32_t port;
@@ -0,0 +1,365 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SequenceNumberWindow.h
+ */
+
+#ifndef SEQUENCENUMBERWINDOW_H_
+#define SEQUENCENUMBERWINDOW_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "SequenceNumber.h"
+
+#include <vector>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima
+{
+    namespace fastrtps
+    {
+        namespace rtps
+        {
+            /**
+             * Ordered container of elements identified by their sequence number, which is obtained through
+             * T::getSequenceNumber(). It offers the interface of an std::set ordered by sequence number, but the
+             * elements are stored in a circular array indexed by sequence number, so lookups are direct and
+             * traversals are linear scans over contiguous memory.
+             *
+             * It is designed for dense ranges of sequence numbers that move forward, like the changes a proxy keeps
+             * track of: holes between elements are allowed, but each one costs a slot.
+             * As with std::set, iterators are only invalidated when their element is erased. Pointers and
+             * references to the elements are also invalidated when an insertion makes the array grow.
+             * @ingroup COMMON_MODULE
+             */
+            template<class T>
+            class SequenceNumberWindow
+            {
+                template<class Window, class Value>
+                class Iterator
+                {
+                    friend class SequenceNumberWindow;
+
+                    template<class OtherWindow, class OtherValue>
+                    friend class Iterator;
+
+                    public:
+
+                    typedef std::bidirectional_iterator_tag iterator_category;
+                    typedef Value value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef Value* pointer;
+                    typedef Value& reference;
+
+                    Iterator() : window_(nullptr), seq_(c_end) {}
+
+                    //! Conversion from iterator to const_iterator.
+                    template<class OtherWindow, class OtherValue>
+                    Iterator(const Iterator<OtherWindow, OtherValue>& it) :
+                        window_(it.window_), seq_(it.seq_) {}
+
+                    Value& operator*() const { return window_->slot(seq_).value; }
+
+                    Value* operator->() const { return &window_->slot(seq_).value; }
+
+                    Iterator& operator++()
+                    {
+                        seq_ = window_->next_present(seq_ + 1);
+                        return *this;
+                    }
+
+                    Iterator operator++(int)
+                    {
+                        Iterator it(*this);
+                        ++(*this);
+                        return it;
+                    }
+
+                    Iterator& operator--()
+                    {
+                        seq_ = window_->previous_present(seq_ == c_end ? window_->last_ : seq_ - 1);
+                        return *this;
+                    }
+
+                    Iterator operator--(int)
+                    {
+                        Iterator it(*this);
+                        --(*this);
+                        return it;
+                    }
+
+                    template<class OtherWindow, class OtherValue>
+                    bool operator==(const Iterator<OtherWindow, OtherValue>& it) const
+                    {
+                        return seq_ == it.seq_;
+                    }
+
+                    template<class OtherWindow, class OtherValue>
+                    bool operator!=(const Iterator<OtherWindow, OtherValue>& it) const
+                    {
+                        return seq_ != it.seq_;
+                    }
+
+                    private:
+
+                    Iterator(Window* window, uint64_t seq) : window_(window), seq_(seq) {}
+
+                    Window* window_;
+
+                    //! Sequence number of the element, or c_end.
+                    uint64_t seq_;
+                };
+
+                public:
+
+                typedef T value_type;
+                typedef Iterator<SequenceNumberWindow, T> iterator;
+                typedef Iterator<const SequenceNumberWindow, const T> const_iterator;
+                typedef std::reverse_iterator<iterator> reverse_iterator;
+                typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+                SequenceNumberWindow() : first_(0), last_(0), size_(0) {}
+
+                size_t size() const { return size_; }
+
+                bool empty() const { return size_ == 0; }
+
+                iterator begin() { return iterator(this, size_ == 0 ? c_end : first_); }
+
+                const_iterator begin() const { return const_iterator(this, size_ == 0 ? c_end : first_); }
+
+                iterator end() { return iterator(this, c_end); }
+
+                const_iterator end() const { return const_iterator(this, c_end); }
+
+                reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+                const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+                reverse_iterator rend() { return reverse_iterator(begin()); }
+
+                const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+                //! Element with the given sequence number, or end() if there is none.
+                iterator find(const SequenceNumber_t& seq)
+                {
+                    return iterator(this, find_seq(seq.to64long()));
+                }
+
+                const_iterator find(const SequenceNumber_t& seq) const
+                {
+                    return const_iterator(this, find_seq(seq.to64long()));
+                }
+
+                //! First element whose sequence number is not lower than the given one.
+                iterator lower_bound(const SequenceNumber_t& seq)
+                {
+                    return iterator(this, lower_bound_seq(seq.to64long()));
+                }
+
+                const_iterator lower_bound(const SequenceNumber_t& seq) const
+                {
+                    return const_iterator(this, lower_bound_seq(seq.to64long()));
+                }
+
+                /**
+                 * Inserts a copy of the element, unless there is already one with its sequence number.
+                 * @return Iterator to the element with that sequence number, and whether it was inserted.
+                 */
+                std::pair<iterator, bool> insert(const T& value)
+                {
+                    const uint64_t seq = value.getSequenceNumber().to64long();
+
+                    if(size_ == 0)
+                    {
+                        reserve(seq, seq);
+                        first_ = last_ = seq;
+                    }
+                    else if(seq < first_)
+                    {
+                        reserve(seq, last_);
+                        for(uint64_t hole = seq + 1; hole < first_; ++hole)
+                            slot(hole).present = false;
+                        first_ = seq;
+                    }
+                    else if(seq > last_)
+                    {
+                        reserve(first_, seq);
+                        for(uint64_t hole = last_ + 1; hole < seq; ++hole)
+                            slot(hole).present = false;
+                        last_ = seq;
+                    }
+                    else if(slot(seq).present)
+                    {
+                        return std::make_pair(iterator(this, seq), false);
+                    }
+
+                    Slot& s = slot(seq);
+                    s.value = value;
+                    s.present = true;
+                    ++size_;
+                    return std::make_pair(iterator(this, seq), true);
+                }
+
+                /**
+                 * Removes an element. Erasing end(), e.g. the result of a failed find, does nothing.
+                 * @return Iterator to the element following the removed one.
+                 */
+                iterator erase(iterator it)
+                {
+                    if(it.seq_ == c_end)
+                        return it;
+
+                    iterator next(it);
+                    return erase(it, ++next);
+                }
+
+                /**
+                 * Removes the elements in the range [first, last).
+                 * @return last.
+                 */
+                iterator erase(iterator first, iterator last)
+                {
+                    if(first == last)
+                        return last;
+
+                    const uint64_t end_seq = last.seq_ == c_end ? last_ + 1 : last.seq_;
+                    for(uint64_t seq = first.seq_; seq < end_seq; ++seq)
+                    {
+                        Slot& s = slot(seq);
+                        if(s.present)
+                        {
+                            s.present = false;
+                            s.value = T();
+                            --size_;
+                        }
+                    }
+
+                    if(size_ > 0)
+                    {
+                        // Keep the first and last slots in use.
+                        first_ = next_present(first_);
+                        last_ = previous_present(last_);
+                    }
+
+                    return last;
+                }
+
+                void clear()
+                {
+                    erase(begin(), end());
+                }
+
+                private:
+
+                //! Sequence number of end iterators.
+                static const uint64_t c_end = ~static_cast<uint64_t>(0);
+
+                struct Slot
+                {
+                    Slot() : present(false) {}
+
+                    T value;
+
+                    bool present;
+                };
+
+                Slot& slot(uint64_t seq)
+                {
+                    return slots_[static_cast<size_t>(seq) & (slots_.size() - 1)];
+                }
+
+                const Slot& slot(uint64_t seq) const
+                {
+                    return slots_[static_cast<size_t>(seq) & (slots_.size() - 1)];
+                }
+
+                //! First element from the given sequence number onwards, or c_end if there is none.
+                uint64_t next_present(uint64_t seq) const
+                {
+                    if(size_ == 0)
+                        return c_end;
+
+                    for(; seq <= last_; ++seq)
+                    {
+                        if(slot(seq).present)
+                            return seq;
+                    }
+
+                    return c_end;
+                }
+
+                //! Last element from the given sequence number backwards. There must be one.
+                uint64_t previous_present(uint64_t seq) const
+                {
+                    while(!slot(seq).present)
+                        --seq;
+                    return seq;
+                }
+
+                uint64_t find_seq(uint64_t seq) const
+                {
+                    if(size_ == 0 || seq < first_ || seq > last_ || !slot(seq).present)
+                        return c_end;
+
+                    return seq;
+                }
+
+                uint64_t lower_bound_seq(uint64_t seq) const
+                {
+                    return next_present(seq < first_ ? first_ : seq);
+                }
+
+                //! Makes room for the elements between the given sequence numbers, both included.
+                void reserve(uint64_t first, uint64_t last)
+                {
+                    const uint64_t span = last - first + 1;
+                    if(span <= slots_.size())
+                        return;
+
+                    size_t capacity = slots_.empty() ? 16 : slots_.size();
+                    while(capacity < span)
+                        capacity <<= 1;
+
+                    std::vector<Slot> slots(capacity);
+                    for(uint64_t seq = first_; size_ > 0 && seq <= last_; ++seq)
+                        slots[static_cast<size_t>(seq) & (capacity - 1)] = slot(seq);
+
+                    slots_.swap(slots);
+                }
+
+                //! Circular array. Its size is always a power of two.
+                std::vector<Slot> slots_;
+
+                //! Sequence number of the first element.
+                uint64_t first_;
+
+                //! Sequence number of the last element.
+                uint64_t last_;
+
+                //! Number of elements.
+                size_t size_;
+            };
+
+            template<class T>
+            const uint64_t SequenceNumberWindow<T>::c_end;
+        }
+    }
+}
+
+#endif
+#endif /* SEQUENCENUMBERWINDOW_H_ */
@@ -0,0 +1,200 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file Statistics.h
+ */
+
+#ifndef _RTPS_COMMON_STATISTICS_H_
+#define _RTPS_COMMON_STATISTICS_H_
+
+#include "../../fastrtps_dll.h"
+#include "Locator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Traffic handled by an endpoint since it was created.
+ * Writers fill the sent DATA, DATA_FRAG, HEARTBEAT and GAP counters and the received ACKNACK and NACK_FRAG
+ * counters. Readers fill the opposite ones.
+ * @ingroup COMMON_MODULE
+ */
+struct RTPS_DllAPI EndpointStatistics
+{
+    //! DATA submessages sent.
+    uint64_t data_sent = 0;
+    //! DATA_FRAG submessages sent.
+    uint64_t data_frag_sent = 0;
+    //! Payload bytes sent in DATA and DATA_FRAG submessages.
+    uint64_t bytes_sent = 0;
+    //! HEARTBEAT submessages sent.
+    uint64_t heartbeats_sent = 0;
+    //! GAP submessages sent.
+    uint64_t gaps_sent = 0;
+    //! ACKNACK submessages sent.
+    uint64_t acknacks_sent = 0;
+    //! NACK_FRAG submessages sent.
+    uint64_t nack_frags_sent = 0;
+
+    //! DATA submessages received.
+    uint64_t data_received = 0;
+    //! DATA_FRAG submessages received.
+    uint64_t data_frag_received = 0;
+    //! Payload bytes received in DATA and DATA_FRAG submessages.
+    uint64_t bytes_received = 0;
+    //! HEARTBEAT submessages received.
+    uint64_t heartbeats_received = 0;
+    //! GAP submessages received.
+    uint64_t gaps_received = 0;
+    //! ACKNACK submessages received.
+    uint64_t acknacks_received = 0;
+    //! NACK_FRAG submessages received.
+    uint64_t nack_frags_received = 0;
+
+    //! Changes a writer had to send again because a reader requested them.
+    uint64_t retransmissions = 0;
+    //! DATA and DATA_FRAG submessages a reader discarded because their change was already received or lost.
+    uint64_t duplicates_received = 0;
+    //! Changes a reader gave up on because the writer no longer had them.
+    uint64_t samples_lost = 0;
+
+    //! Adds the counters of another endpoint.
+    EndpointStatistics& operator+=(const EndpointStatistics& other)
+    {
+        data_sent += other.data_sent;
+        data_frag_sent += other.data_frag_sent;
+        bytes_sent += other.bytes_sent;
+        heartbeats_sent += other.heartbeats_sent;
+        gaps_sent += other.gaps_sent;
+        acknacks_sent += other.acknacks_sent;
+        nack_frags_sent += other.nack_frags_sent;
+        data_received += other.data_received;
+        data_frag_received += other.data_frag_received;
+        bytes_received += other.bytes_received;
+        heartbeats_received += other.heartbeats_received;
+        gaps_received += other.gaps_received;
+        acknacks_received += other.acknacks_received;
+        nack_frags_received += other.nack_frags_received;
+        retransmissions += other.retransmissions;
+        duplicates_received += other.duplicates_received;
+        samples_lost += other.samples_lost;
+        return *this;
+    }
+};
+
+/**
+ * Datagrams handled by one of the receiver resources of a participant.
+ * @ingroup COMMON_MODULE
+ */
+struct RTPS_DllAPI ReceiverStatistics
+{
+    //! Locator the resource listens on.
+    Locator_t locator;
+    //! Datagrams received.
+    uint64_t datagrams_received = 0;
+    //! Bytes received.
+    uint64_t bytes_received = 0;
+    //! Datagrams discarded because they were not valid RTPS messages or could not be decoded.
+    uint64_t datagrams_dropped = 0;
+};
+
+/**
+ * Traffic handled by a participant: the sum of the statistics of its endpoints and the statistics of each of its
+ * receiver resources.
+ * @ingroup COMMON_MODULE
+ */
+struct RTPS_DllAPI ParticipantStatistics
+{
+    //! Sum of the statistics of the user and builtin endpoints.
+    EndpointStatistics endpoints;
+    //! One entry per receiver resource.
+    std::vector<ReceiverStatistics> receivers;
+};
+
+/**
+ * Counters behind EndpointStatistics.
+ * They are updated without locks from the sending and receiving threads, so a snapshot is not taken atomically
+ * as a whole, but every counter in it is exact.
+ * @ingroup COMMON_MODULE
+ */
+class EndpointStatisticsCounters
+{
+    public:
+
+        EndpointStatisticsCounters() = default;
+
+        EndpointStatisticsCounters(const EndpointStatisticsCounters&) = delete;
+
+        EndpointStatisticsCounters& operator=(const EndpointStatisticsCounters&) = delete;
+
+        //! Adds to one of the counters.
+        static void add(std::atomic<uint64_t>& counter, uint64_t amount = 1)
+        {
+            counter.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        //! Reads all the counters.
+        EndpointStatistics snapshot() const
+        {
+            EndpointStatistics statistics;
+            statistics.data_sent = data_sent.load(std::memory_order_relaxed);
+            statistics.data_frag_sent = data_frag_sent.load(std::memory_order_relaxed);
+            statistics.bytes_sent = bytes_sent.load(std::memory_order_relaxed);
+            statistics.heartbeats_sent = heartbeats_sent.load(std::memory_order_relaxed);
+            statistics.gaps_sent = gaps_sent.load(std::memory_order_relaxed);
+            statistics.acknacks_sent = acknacks_sent.load(std::memory_order_relaxed);
+            statistics.nack_frags_sent = nack_frags_sent.load(std::memory_order_relaxed);
+            statistics.data_received = data_received.load(std::memory_order_relaxed);
+            statistics.data_frag_received = data_frag_received.load(std::memory_order_relaxed);
+            statistics.bytes_received = bytes_received.load(std::memory_order_relaxed);
+            statistics.heartbeats_received = heartbeats_received.load(std::memory_order_relaxed);
+            statistics.gaps_received = gaps_received.load(std::memory_order_relaxed);
+            statistics.acknacks_received = acknacks_received.load(std::memory_order_relaxed);
+            statistics.nack_frags_received = nack_frags_received.load(std::memory_order_relaxed);
+            statistics.retransmissions = retransmissions.load(std::memory_order_relaxed);
+            statistics.duplicates_received = duplicates_received.load(std::memory_order_relaxed);
+            statistics.samples_lost = samples_lost.load(std::memory_order_relaxed);
+            return statistics;
+        }
+
+        std::atomic<uint64_t> data_sent{0};
+        std::atomic<uint64_t> data_frag_sent{0};
+        std::atomic<uint64_t> bytes_sent{0};
+        std::atomic<uint64_t> heartbeats_sent{0};
+        std::atomic<uint64_t> gaps_sent{0};
+        std::atomic<uint64_t> acknacks_sent{0};
+        std::atomic<uint64_t> nack_frags_sent{0};
+        std::atomic<uint64_t> data_received{0};
+        std::atomic<uint64_t> data_frag_received{0};
+        std::atomic<uint64_t> bytes_received{0};
+        std::atomic<uint64_t> heartbeats_received{0};
+        std::atomic<uint64_t> gaps_received{0};
+        std::atomic<uint64_t> acknacks_received{0};
+        std::atomic<uint64_t> nack_frags_received{0};
+        std::atomic<uint64_t> retransmissions{0};
+        std::atomic<uint64_t> duplicates_received{0};
+        std::atomic<uint64_t> samples_lost{0};
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_COMMON_STATISTICS_H_
@@ -23,12 +23,14 @@
 #define CACHECHANGEPOOL_H_
 
 #include "../resources/ResourceManagement.h"
+#include "PayloadArena.h"
 
 #include <vector>
 #include <functional>
 #include <cstdint>
 #include <cstddef>
 #include <mutex>
+#include <atomic>
 
 
 namespace eprosima {
@@ -57,8 +59,8 @@ class CacheChangePool {
          * @brief Reserves a CacheChange from the pool.
          * @param chan Returned pointer to the reserved CacheChange.
          * @param calculateSizeFunc Function that returns the size of the data which will go into the CacheChange.
-         * This function is executed depending on the memory management policy (DYNAMIC_RESERVE_MEMORY_MODE and
-         * PREALLOCATED_WITH_REALLOC_MEMORY_MODE)
+         * This function is executed depending on the memory management policy (DYNAMIC_RESERVE_MEMORY_MODE,
+         * PREALLOCATED_WITH_REALLOC_MEMORY_MODE and PREALLOCATED_WITH_ARENA_MEMORY_MODE)
          * @return True whether the CacheChange could be allocated. In other case returns false.
          */
         bool reserve_Cache(CacheChange_t** chan, const std::function<uint32_t()>& calculateSizeFunc);
@@ -67,7 +69,8 @@ class CacheChangePool {
          * @brief Reserves a CacheChange from the pool.
          * @param chan Returned pointer to the reserved CacheChange.
          * @param dataSize Size of the data which will go into the CacheChange if it is necessary (on memory management
-         * policy DYNAMIC_RESERVE_MEMORY_MODE and PREALLOCATED_WITH_REALLOC_MEMORY_MODE). In other case this variable is not used.
+         * policy DYNAMIC_RESERVE_MEMORY_MODE, PREALLOCATED_WITH_REALLOC_MEMORY_MODE and PREALLOCATED_WITH_ARENA_MEMORY_MODE).
+         * In other case this variable is not used.
          * @return True whether the CacheChange could be allocated. In other case returns false.
          */
         bool reserve_Cache(CacheChange_t** chan, uint32_t dataSize);
@@ -75,20 +78,41 @@ class CacheChangePool {
         //!Release a Cache back to the pool.
         void release_Cache(CacheChange_t*);
         //!Get the size of the cache vector; all of them (reserved and not reserved).
-        size_t get_allCachesSize(){return m_allCaches.size();}
+        size_t get_allCachesSize(){return m_pool_size;}
         //!Get the number of frre caches.
-        size_t get_freeCachesSize(){return m_freeCaches.size();}
+        size_t get_freeCachesSize(){return m_freeCount;}
         //!Get the initial payload size associated with the Pool.
         inline uint32_t getInitialPayloadSize(){return m_initial_payload_size;};
     private:
+        //!Maximum number of segments of the table of preallocated changes.
+        static const uint32_t c_maxSegments = 32;
+
         uint32_t m_initial_payload_size;
         uint32_t m_payload_size;
-        uint32_t m_pool_size;
+        std::atomic<uint32_t> m_pool_size;
         uint32_t m_max_pool_size;
-        std::vector<CacheChange_t*> m_freeCaches;
+        /*!
+         * Lock-free free list of the preallocated memory modes, linked through CacheChange_t::pool_next_.
+         * The lower 32 bits hold the position plus one of its first change, the upper ones a counter
+         * that changes on every update to avoid the ABA problem.
+         */
+        std::atomic<uint64_t> m_freeHead;
+        std::atomic<size_t> m_freeCount;
+        /*!
+         * Table of preallocated changes, indexed by CacheChange_t::pool_index_. Segment i holds 2^i changes,
+         * so growing the table never moves the changes that lock-free readers may be accessing.
+         */
+        std::atomic<CacheChange_t**> m_segments[c_maxSegments];
+        //!Changes of DYNAMIC_RESERVE_MEMORY_MODE, each one at its CacheChange_t::pool_index_.
         std::vector<CacheChange_t*> m_allCaches;
+        //!Payload buffers of PREALLOCATED_WITH_ARENA_MEMORY_MODE.
+        PayloadArena m_arena;
         bool allocateGroup(uint32_t pool_size);
         CacheChange_t* allocateSingle(uint32_t dataSize);
+        CacheChange_t* get_preallocated(uint32_t index) const;
+        CacheChange_t* pop_free();
+        void push_free(CacheChange_t* ch);
+        //!Only protects the growth of the preallocated table and DYNAMIC_RESERVE_MEMORY_MODE.
         std::mutex* mp_mutex;
         MemoryManagementPolicy_t memoryMode;
 };
@@ -0,0 +1,97 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadArena.h
+ *
+ */
+
+#ifndef PAYLOADARENA_H_
+#define PAYLOADARENA_H_
+
+#include "../common/Types.h"
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+struct SerializedPayload_t;
+
+/**
+ * Class PayloadArena, keeps the payload buffers of a CacheChangePool in power-of-two size classes,
+ * so released buffers are recycled by later changes of a similar size instead of being reallocated.
+ * Buffers are allocated with malloc, so a payload can still free or reallocate the one it holds.
+ * @ingroup COMMON_MODULE
+ */
+class PayloadArena
+{
+    public:
+
+        PayloadArena();
+
+        ~PayloadArena();
+
+        /**
+         * Gives the payload a buffer able to hold the given size, reusing a released one of its size class.
+         * @param payload Payload without buffer.
+         * @param size Minimum size of the buffer.
+         * @return False if the memory could not be allocated.
+         */
+        bool acquire(SerializedPayload_t& payload, uint32_t size);
+
+        /**
+         * Takes back the buffer of the payload into its size class. The payload is left without buffer.
+         * @param payload Payload whose buffer is released.
+         */
+        void release(SerializedPayload_t& payload);
+
+        //! Get the number of released buffers ready to be reused.
+        size_t get_freeBuffersSize();
+
+        //! Size of the smallest size class.
+        static const uint32_t c_minClassSize = 64;
+
+    private:
+
+        //! Number of size classes. The biggest one holds buffers of 2 GB.
+        static const uint32_t c_numClasses = 26;
+
+        //! Size class whose buffers are able to hold the given size.
+        static uint32_t class_to_hold(uint32_t size);
+
+        //! Biggest size class whose buffers fit in the given capacity.
+        static uint32_t class_within(uint32_t capacity);
+
+        struct SizeClass
+        {
+            std::mutex mutex;
+            std::vector<octet*> buffers;
+        };
+
+        SizeClass m_classes[c_numClasses];
+
+        PayloadArena(const PayloadArena&) = delete;
+        PayloadArena& operator=(const PayloadArena&) = delete;
+};
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
+
+#endif /* PAYLOADARENA_H_ */
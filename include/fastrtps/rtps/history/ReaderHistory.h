@@ -67,6 +67,15 @@ public:
      */
     RTPS_DllAPI bool remove_change(CacheChange_t* a_change);
 
+    /**
+     * Remove a CacheChange_t from the ReaderHistory, optionally keeping it out of the pool.
+     * @param a_change Pointer to the CacheChange to remove.
+     * @param release Whether the change goes back to the pool. Otherwise the caller becomes its owner
+     * and has to release it with release_Cache.
+     * @return True if removed.
+     */
+    RTPS_DllAPI bool remove_change(CacheChange_t* a_change, bool release);
+
     /**
      * Remove all changes from the History that have a certain guid.
      * @param a_guid Pointer to the target guid to search for.
@@ -25,7 +25,10 @@
 #include "../../qos/ParameterList.h"
 #include <fastrtps/rtps/writer/StatelessWriter.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
+#include <fastrtps/utils/SnapshotPtr.h>
 
+#include <memory>
+#include <unordered_map>
 
 namespace eprosima {
 namespace fastrtps{
@@ -62,8 +65,9 @@ class MessageReceiver
          * @param[in] RTPSParticipantguidprefix RTPSParticipant Guid Prefix
          * @param[in] loc Locator indicating the sending address.
          * @param[in] msg Pointer to the message
+         * @return False if the message was dropped because it is not a valid RTPS message or could not be decoded.
          */
-        void processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefix,Locator_t* loc, CDRMessage_t*msg);
+        bool processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefix,Locator_t* loc, CDRMessage_t*msg);
 
         //!Pointer to the Listen Resource that contains this MessageReceiver.
 
@@ -79,9 +83,37 @@ class MessageReceiver
         void removeEndpoint(Endpoint *to_remove);
 
     private:
-        std::vector<RTPSWriter *> AssociatedWriters;
-        std::vector<RTPSReader *> AssociatedReaders;
+        /**
+         * Associated endpoints, indexed by EntityId so each submessage is dispatched without scanning all of them.
+         * A table is never modified once published: associateEndpoint and removeEndpoint build a new one and
+         * swap it in, so the processing methods just take a snapshot of the current table without locking.
+         */
+        struct EndpointTable
+        {
+            std::unordered_map<EntityId_t, std::vector<RTPSReader*> > readersByEntity;
+            std::unordered_map<EntityId_t, std::vector<RTPSWriter*> > writersByEntity;
+            //! All the readers, in association order. Candidates for submessages directed to ENTITYID_UNKNOWN.
+            std::vector<RTPSReader*> readers;
+            std::vector<RTPSWriter*> writers;
+        };
+
+        //! Current table and the ones replaced while a submessage could still be processed with them.
+        SnapshotPtr<EndpointTable> endpoints_;
+        //! Serializes associateEndpoint and removeEndpoint.
         std::mutex mtx;
+
+        std::shared_ptr<const EndpointTable> endpoints() const;
+
+        /**
+         * Readers that may accept a submessage directed to the given entity.
+         * @return Pointer to the list of candidates, or nullptr if there is none. Each candidate still has to be
+         * asked through RTPSReader::acceptMsgDirectedTo.
+         */
+        static const std::vector<RTPSReader*>* readers_directed_to(const EndpointTable& table,
+                const EntityId_t& readerID);
+
+        //! Writer with the given GUID, or nullptr if it is not associated.
+        static RTPSWriter* find_writer(const EndpointTable& table, const GUID_t& writerGUID);
         //!Protocol version of the message
         ProtocolVersion_t sourceVersion;
         //!VendorID that created the message
@@ -61,6 +61,15 @@ class RTPSMessageGroup_t
 #if HAVE_SECURITY
         CDRMessage_t rtpsmsg_encrypt_;
 #endif
+
+        //! Destination locators of the message being built. Kept here so every group reuses its memory.
+        LocatorList_t current_locators_;
+
+        //! Destination participants of the message being built.
+        std::vector<GuidPrefix_t> current_remote_participants_;
+
+        //! Destination participants of the submessage being added.
+        std::vector<GuidPrefix_t> remote_participants_;
 };
 
 class RTPSWriter;
@@ -114,7 +123,7 @@ class RTPSMessageGroup
                 const std::vector<GuidPrefix_t>& remote_participants) const;
 
         void flush_and_reset(const LocatorList_t& locator_list,
-                std::vector<GuidPrefix_t>&& remote_participants);
+                std::vector<GuidPrefix_t>& remote_participants);
 
         void flush();
 
@@ -145,11 +154,13 @@ class RTPSMessageGroup
         CDRMessage_t* encrypt_msg_;
 #endif
 
-        LocatorList_t current_locators_;
+        LocatorList_t& current_locators_;
 
         GuidPrefix_t current_dst_;
 
-        std::vector<GuidPrefix_t> current_remote_participants_;
+        std::vector<GuidPrefix_t>& current_remote_participants_;
+
+        std::vector<GuidPrefix_t>& remote_participants_;
 };
 
 } /* namespace rtps */
@@ -81,6 +81,14 @@ class NetworkFactory
 
         bool is_local_locator(const Locator_t& locator) const;
 
+        /**
+         * Reports whether a registered shared memory transport should be used to reach the given remote
+         * locator, which happens for unicast locators of this host.
+         * @param remote Remote locator of any other transport.
+         * @param[out] shared_memory_locator Shared memory locator with the same port.
+         */
+        bool get_shared_memory_locator(const Locator_t& remote, Locator_t& shared_memory_locator) const;
+
         size_t numberOfRegisteredTransports() const;
 
         uint32_t get_max_message_size_between_transports() { return maxMessageSizeBetweenTransports_; }
@@ -91,6 +99,9 @@ class NetworkFactory
 
         std::vector<std::unique_ptr<TransportInterface> > mRegisteredTransports;
 
+        //! Registered shared memory transport, if any. Owned by mRegisteredTransports.
+        TransportInterface* mSharedMemTransport;
+
         uint32_t maxMessageSizeBetweenTransports_;
 
         uint32_t minSendBufferSize_;
@@ -15,9 +15,11 @@
 #ifndef RECEIVER_RESOURCE_H
 #define RECEIVER_RESOURCE_H
 
+#include <atomic>
 #include <functional>
 #include <vector>
 #include <fastrtps/transport/TransportInterface.h>
+#include <fastrtps/rtps/common/Statistics.h>
 
 namespace eprosima{
 namespace fastrtps{
@@ -51,6 +53,20 @@ public:
    bool Receive(octet* receiveBuffer, uint32_t receiveBufferCapacity, uint32_t& receiveBufferSize,
                 Locator_t& originLocator);
 
+  /**
+   * Performs a blocking receive of several messages through the channel managed by this resource.
+   * Blocks until at least one message is available.
+   * @param buffers Array of reception buffers. Size and origin locator of the used ones are filled.
+   * @param bufferCount Number of elements in the array.
+   * @return Number of messages received. Zero when the managed Receive operation fails.
+   */
+   uint32_t ReceiveBatch(TransportReceiveBuffer* buffers, uint32_t bufferCount);
+
+  /**
+   * Maximum number of messages worth passing to ReceiveBatch on a single call.
+   */
+   uint32_t MaxBatchSize() const;
+
   /**
    * Reports whether this resource supports the given local locator (i.e., said locator
    * maps to the transport channel managed by this resource).
@@ -62,6 +78,22 @@ public:
     */
    void Abort();
 
+  /**
+   * Accounts for a datagram received through this resource (thread safe).
+   * @param size Size of the datagram.
+   */
+   void CountReceived(uint32_t size);
+
+  /**
+   * Accounts for a received datagram that was discarded (thread safe).
+   */
+   void CountDropped();
+
+  /**
+   * Datagrams received and dropped since the resource was created.
+   */
+   ReceiverStatistics Statistics() const;
+
    /**
     * Resources can only be transfered through move semantics. Copy, assignment, and 
     * construction outside of the factory are forbidden.
@@ -78,7 +110,13 @@ private:
    std::function<void()> Cleanup;
    std::function<void()> Close;
    std::function<bool(octet*, uint32_t, uint32_t&, Locator_t&)> ReceiveFromAssociatedChannel;
+   std::function<uint32_t(TransportReceiveBuffer*, uint32_t)> ReceiveBatchFromAssociatedChannel;
    std::function<bool(const Locator_t&)> LocatorMapsToManagedChannel;
+   uint32_t mMaxBatchSize;
+   Locator_t mLocator;
+   std::atomic<uint64_t> mDatagramsReceived;
+   std::atomic<uint64_t> mBytesReceived;
+   std::atomic<uint64_t> mDatagramsDropped;
    bool mValid; // Post-construction validity check for the NetworkFactory
 };
 
@@ -48,6 +48,16 @@ public:
     */
    bool Send(const octet* data, uint32_t dataLength, const Locator_t& destinationLocator);
 
+   /**
+    * Sends the same data to several destination locators, through the channel managed by this resource.
+    * Transports supporting it move all the datagrams on as few system calls as possible.
+    * @param data Raw data slice to be sent.
+    * @param dataLength Length of the data to be sent.
+    * @param destinationLocators Locators describing the destination endpoints.
+    * @return Success of the send operation on at least one destination.
+    */
+   bool SendBatch(const octet* data, uint32_t dataLength, const LocatorList_t& destinationLocators);
+
    /** 
    * Reports whether this resource supports the given local locator (i.e., said locator
    * maps to the transport channel managed by this resource).
@@ -74,6 +84,7 @@ private:
    SenderResource(TransportInterface&, Locator_t&);
    std::function<void()> Cleanup;
    std::function<bool(const octet* data, uint32_t dataLength, const Locator_t&)> SendThroughAssociatedChannel;
+   std::function<bool(const octet* data, uint32_t dataLength, const LocatorList_t&)> SendBatchThroughAssociatedChannel;
    std::function<bool(const Locator_t&)> LocatorMapsToManagedChannel;
    std::function<bool(const Locator_t&)> ManagedChannelMapsToRemote;
    bool mValid; // Post-construction validity check for the NetworkFactory
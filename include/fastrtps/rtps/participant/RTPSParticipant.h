@@ -24,6 +24,7 @@
 #include <memory>
 #include "../../fastrtps_dll.h"
 #include "../common/Guid.h"
+#include "../common/Statistics.h"
 #include <fastrtps/rtps/reader/StatefulReader.h>
 
 #include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
@@ -145,6 +146,13 @@ class RTPS_DllAPI RTPSParticipant
 
     bool get_remote_reader_info(const GUID_t& readerGuid, ReaderProxyData& returnedInfo);
 
+    /**
+     * Get the traffic handled by this participant: the sum of the statistics of its writers and readers and
+     * the datagrams received and dropped by each of its receiver resources.
+     * @return Snapshot of the statistics of the participant.
+     */
+    ParticipantStatistics get_statistics() const;
+
     private:
 
     //!Pointer to the implementation.
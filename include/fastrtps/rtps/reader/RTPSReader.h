@@ -42,6 +42,7 @@ namespace eprosima
             struct SequenceNumber_t;
             class SequenceNumberSet_t;
             class FragmentedChangePitStop;
+            class FragmentedSampleTimeout;
 
             /**
              * Class RTPSReader, manages the reception of data from its matched writers.
@@ -164,6 +165,15 @@ namespace eprosima
                  */
                 RTPS_DllAPI virtual bool nextUntakenCache(CacheChange_t** change, WriterProxy** wp) = 0;
 
+                /**
+                 * Check whether a CacheChange_t of the history can be given to the user.
+                 * @param change Pointer to the CacheChange_t.
+                 * @param wp Pointer to pointer to the WriterProxy of the writer of the change. It is left untouched
+                 * when the writer is no longer matched, so the change will never be available.
+                 * @return True if the change can be read or taken.
+                 */
+                RTPS_DllAPI virtual bool is_change_available(CacheChange_t* change, WriterProxy** wp) = 0;
+
                 /**
                  * @return True if the reader expects Inline QOS.
                  */
@@ -181,6 +191,13 @@ namespace eprosima
                 CacheChange_t* findCacheInFragmentedCachePitStop(const SequenceNumber_t& sequence_number,
                         const GUID_t& writer_guid);
 
+                /*!
+                 * @brief Discards the fragmented samples that have not received new fragments
+                 * during the fragmented sample timeout.
+                 * @return Number of samples discarded.
+                 */
+                size_t remove_stale_fragmented_changes();
+
                 /*!
                  * @brief Returns there is a clean state with all Writers.
                  * It occurs when the Reader received all samples sent by Writers. In other words,
@@ -256,6 +273,9 @@ namespace eprosima
                 //TODO Select one
                 FragmentedChangePitStop* fragmentedChangePitStop_;
 
+                //!Discards the fragmented samples when no fragments are being received. Null without timeout.
+                FragmentedSampleTimeout* fragmentedSampleTimeout_;
+
                 private:
 
                 RTPSReader& operator=(const RTPSReader&) = delete;
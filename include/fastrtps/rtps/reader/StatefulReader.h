@@ -146,6 +146,15 @@ class StatefulReader:public RTPSReader
          */
         bool nextUntakenCache(CacheChange_t** change,WriterProxy** wpout=nullptr);
 
+        /**
+         * Check whether a CacheChange_t can be given to the user, that is, all the previous changes
+         * of its writer have been received or are not relevant.
+         * @param change Pointer to the CacheChange_t
+         * @param wpout Pointer to pointer the matched writer proxy
+         * @return True if the change can be read or taken.
+         */
+        bool is_change_available(CacheChange_t* change, WriterProxy** wpout);
+
 
         /**
          * Update the times parameters of the Reader.
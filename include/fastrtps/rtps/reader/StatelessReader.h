@@ -122,6 +122,14 @@ public:
      */
     bool nextUntakenCache(CacheChange_t** change,WriterProxy** wpout=nullptr);
 
+    /**
+     * Check whether a CacheChange_t can be given to the user. Every change of the history can.
+     * @param change Pointer to the CacheChange_t
+     * @param wpout Pointer to pointer of the matched writer proxy, set to nullptr
+     * @return True.
+     */
+    bool is_change_available(CacheChange_t* change, WriterProxy** wpout);
+
     /**
      * Get the number of matched writers
      * @return Number of matched writers
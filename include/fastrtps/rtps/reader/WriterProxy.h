@@ -25,6 +25,7 @@
 #include "../common/Types.h"
 #include "../common/Locator.h"
 #include "../common/CacheChange.h"
+#include "../common/SequenceNumberWindow.h"
 #include "../attributes/ReaderAttributes.h"
 
 #include<set>
@@ -167,6 +168,10 @@ namespace eprosima
                      */
                     SequenceNumber_t nextCacheChangeToBeNotified();
 
+                    /*!
+                     * @brief Checks whether a change was already received or given up on.
+                     * A true result is accounted as a duplicate in the statistics of the reader.
+                     */
                     bool change_was_received(const SequenceNumber_t& seq_num);
 
                 private:
@@ -193,8 +198,8 @@ namespace eprosima
                     //!Mutex Pointer
                     std::recursive_mutex* mp_mutex;
 
-                    //!Vector containing the ChangeFromWriter_t objects.
-                    std::set<ChangeFromWriter_t, ChangeFromWriterCmp> m_changesFromW;
+                    //!Changes and their state from this writer, indexed by sequence number.
+                    SequenceNumberWindow<ChangeFromWriter_t> m_changesFromW;
                     SequenceNumber_t changesFromWLowMark_;
 
                     //! Store last ChacheChange_t notified.
@@ -205,7 +210,7 @@ namespace eprosima
                             ChangeFromWriterStatus_t status,
                             ChangeFromWriterStatus_t new_status);
 
-                    void for_each_set_status_from_and_maybe_remove(decltype(m_changesFromW)::iterator first,
+                    size_t for_each_set_status_from_and_maybe_remove(decltype(m_changesFromW)::iterator first,
                             decltype(m_changesFromW)::iterator last,
                             ChangeFromWriterStatus_t status,
                             ChangeFromWriterStatus_t orstatus,
@@ -0,0 +1,65 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FragmentedSampleTimeout.h
+ *
+ */
+
+#ifndef FRAGMENTEDSAMPLETIMEOUT_H_
+#define FRAGMENTEDSAMPLETIMEOUT_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#include <fastrtps/rtps/resources/TimedEvent.h>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps{
+
+class RTPSReader;
+
+/**
+ * FragmentedSampleTimeout class, periodically discards the samples of a reader that stopped receiving fragments.
+ * Samples being reassembled are otherwise only checked when new fragments arrive.
+ * @ingroup READER_MODULE
+ */
+class FragmentedSampleTimeout: public TimedEvent
+{
+    public:
+        /**
+         * @param reader Reader whose uncompleted samples are checked.
+         * @param resource Event resource of the participant of the reader.
+         * @param interval Milliseconds between checks.
+         */
+        FragmentedSampleTimeout(RTPSReader* reader, ResourceEvent& resource, double interval);
+        virtual ~FragmentedSampleTimeout();
+
+        /**
+         * Method invoked when the event occurs
+         *
+         * @param code Code representing the status of the event
+         * @param msg Message associated to the event
+         */
+        void event(EventCode code, const char* msg= nullptr);
+
+    private:
+
+        RTPSReader* reader_;
+};
+
+}
+}
+}
+
+#endif
+#endif /* FRAGMENTEDSAMPLETIMEOUT_H_ */
@@ -19,52 +19,49 @@
 #ifndef _RTPS_RESOURCES_ASYNCWRITERTHREAD_H_
 #define _RTPS_RESOURCES_ASYNCWRITERTHREAD_H_
 
-#include <thread>
-#include <atomic>
-#include <mutex>
-#include <condition_variable>
-#include <list>
-
-#include <fastrtps/rtps/resources/AsyncInterestTree.h>
+#include <fastrtps/rtps/attributes/WriterAttributes.h>
 
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 class RTPSWriter;
+class RTPSParticipantImpl;
 
 /**
- * @brief This static class owns a thread that manages asynchronous writes.
+ * @brief This static class manages asynchronous writes.
  * Asynchronous writes happen directly (when using an async writer) and
  * indirectly (when responding to a NACK).
+ * They are run by the sender threads of the participant of each writer, so the writers
+ * of different participants never wait for each other.
  * @ingroup COMMON_MODULE
  */
 class AsyncWriterThread
 {
 public:
     /**
-     * @brief Adds a writer to be managed by this thread.
-     * Only asynchronous writers are permitted.
-     * @param writer Asynchronous writer to be added. 
+     * @brief Adds a writer to be managed by the sender threads of its participant.
+     * @param writer Writer to be added.
+     * @param priority Priority class of the writer.
      * @return Result of the operation.
      */
-    static bool addWriter(RTPSWriter& writer);
+    static bool addWriter(RTPSWriter& writer, RTPSWriterAsyncPriority priority = NORMAL_PRIORITY_WRITER);
 
     /**
-     * @brief Removes a writer.
-     * @param writer Asynchronous writer to be removed.
+     * @brief Removes a writer, waiting for any asynchronous write of it in progress.
+     * @param writer Writer to be removed.
      * @return Result of the operation.
      */
     static bool removeWriter(RTPSWriter& writer);
 
     /**
-     * Wakes the thread up.
+     * Schedules the pending writes of all the writers of a participant.
      * @param interestedParticipant The participant interested in an async write.
      */
     static void wakeUp(const RTPSParticipantImpl* interestedParticipant);
 
     /**
-     * Wakes the thread up.
-     * @param interestedParticipant The writer interested in an async write.
+     * Schedules the pending writes of a writer.
+     * @param interestedWriter The writer interested in an async write.
      */
     static void wakeUp(const RTPSWriter* interestedWriter);
 
@@ -73,21 +70,6 @@ private:
     ~AsyncWriterThread() = delete;
     AsyncWriterThread(const AsyncWriterThread&) = delete;
     const AsyncWriterThread& operator=(const AsyncWriterThread&) = delete;
-
-    //! @brief runs main method
-    static void run();
-
-    static std::thread* thread_;
-    static std::mutex data_structure_mutex_;
-    static std::mutex condition_variable_mutex_;
-    
-    //! List of asynchronous writers.
-    static std::list<RTPSWriter*> async_writers;
-    static AsyncInterestTree interestTree;
-
-    static bool running_;
-    static bool run_scheduled_;
-    static std::condition_variable cv_;
 };
 
 } // namespace rtps
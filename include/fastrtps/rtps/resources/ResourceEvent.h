@@ -21,17 +21,17 @@
 #define RESOURCEEVENT_H_
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
-#include <thread>
-#include <asio.hpp>
+#include <cstdint>
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
-class RTPSParticipantImpl;
+class TimerWheel;
 
 /**
  * Class ResourceEvent used to manage the temporal events.
+ * All the timed events of a participant are entries of the same timer wheel.
  *@ingroup MANAGEMENT_MODULE
  */
 class ResourceEvent {
@@ -40,38 +40,24 @@ public:
 	virtual ~ResourceEvent();
 
     /**
-    * Method to initialize the thread.
-    * @param p
+    * Method to initialize the threads running the events.
+    * @param num_threads Number of threads. Zero is taken as one.
     */
-    void init_thread(RTPSParticipantImpl*p);
+    void init_thread(uint32_t num_threads = 1);
 
 	/**
-	* Get the associated IO service
-	* @return Associated IO service
+	* Get the timer wheel where the events are scheduled
+	* @return Associated timer wheel
 	*/
-	asio::io_service& getIOService() { return *mp_io_service; }
-
-    std::thread& getThread() { return *mp_b_thread; }
+	TimerWheel& getTimerWheel() { return *mp_timer_wheel; }
 
 private:
 
-	//!Thread
-	std::thread* mp_b_thread;
-	//!IO service
-	asio::io_service* mp_io_service;
-	//!
-	void * mp_work;
-
-	/**
-	 * Task to announce the correctness of the thread.
-	 */
-	void announce_thread();
-
-	//!Method to run the tasks
-	void run_io_service();
+	ResourceEvent(const ResourceEvent&) = delete;
+	const ResourceEvent& operator=(const ResourceEvent&) = delete;
 
-	//!Pointer to the RTPSParticipantImpl.
-	RTPSParticipantImpl* mp_RTPSParticipantImpl;
+	//!Timer wheel
+	TimerWheel* mp_timer_wheel;
 };
 }
 }
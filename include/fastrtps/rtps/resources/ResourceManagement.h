@@ -32,7 +32,8 @@ namespace rtps{
 typedef enum MemoryManagementPolicy{
     PREALLOCATED_MEMORY_MODE, //!< Preallocated memory. Size set to the data type maximum. Largest memory footprint but smalles allocation count.
     PREALLOCATED_WITH_REALLOC_MEMORY_MODE, //!< Default size preallocated, requires reallocation when a bigger message arrives. Smaller memory footprint at the cost of an increased allocation count.
-    DYNAMIC_RESERVE_MEMORY_MODE //< Dynamic allocation at the time of message arrival. Least memory footprint but highest allocation count.
+    DYNAMIC_RESERVE_MEMORY_MODE, //< Dynamic allocation at the time of message arrival. Least memory footprint but highest allocation count.
+    PREALLOCATED_WITH_ARENA_MEMORY_MODE //!< Preallocated changes whose payloads come from power-of-two size classes recycled by the history. No allocations in steady state, even with variable sizes, at the cost of up to twice the memory per payload.
 }MemoryManagementPolicy_t;
 
 
@@ -20,9 +20,7 @@
 #ifndef TIMEDEVENT_H_
 #define TIMEDEVENT_H_
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
-#include <thread>
 #include <cstdint>
-#include <asio.hpp>
 #include "../common/Time_t.h"
 
 namespace eprosima {
@@ -30,6 +28,7 @@ namespace fastrtps{
 namespace rtps {
 
 class TimedEventImpl;
+class ResourceEvent;
 
 /**
  * Timed Event class used to define any timed events.
@@ -56,12 +55,11 @@ public:
     };
 	
 	/**
-	* @param service IO service to run the event.
-   * @param event_thread starting thread for identification.
+	* @param resource Event resource of the participant, whose timer wheel runs the event.
 	* @param milliseconds Interval of the timedEvent.
    * @param autodestruction Self-destruct mode flag.
 	*/
-    TimedEvent(asio::io_service &service, const std::thread& event_thread, double milliseconds, TimedEvent::AUTODESTRUCTION_MODE autodestruction = TimedEvent::NONE);
+    TimedEvent(ResourceEvent& resource, double milliseconds, TimedEvent::AUTODESTRUCTION_MODE autodestruction = TimedEvent::NONE);
 	virtual ~TimedEvent();
 	
 	/**
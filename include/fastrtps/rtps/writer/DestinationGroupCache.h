@@ -0,0 +1,100 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DestinationGroupCache.h
+ *
+ */
+#ifndef DESTINATIONGROUPCACHE_H_
+#define DESTINATIONGROUPCACHE_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#include <map>
+#include <vector>
+#include "../common/Guid.h"
+#include "../common/Locator.h"
+
+namespace eprosima
+{
+    namespace fastrtps
+    {
+        namespace rtps
+        {
+            //! Destination of the submessages addressed to a set of readers.
+            struct DestinationGroup
+            {
+                DestinationGroup() : expectsInlineQos(false) {}
+
+                std::vector<GUID_t> guids;
+                LocatorList_t locators;
+                bool expectsInlineQos;
+            };
+
+            /**
+             * Destinations of the sets of readers a writer sends to, computed only the first time each set is used.
+             * The cache is bounded: it is emptied when it reaches its limit.
+             * It is not thread safe: the writer mutex protects it.
+             * @ingroup WRITER_MODULE
+             */
+            template<class Reader>
+            class DestinationGroupCache
+            {
+                public:
+
+                    //! Default limit of sets of readers cached.
+                    static const size_t default_max_groups = 256;
+
+                    explicit DestinationGroupCache(size_t max_groups = default_max_groups) : max_groups_(max_groups) {}
+
+                    /*!
+                     * @brief Returns the destination of a set of readers, computing it if it is not cached.
+                     * @param readers Set of readers.
+                     * @param compute Called as compute(readers, group) to fill the destination of a set not cached.
+                     * @return Reference to the destination, valid until the cache is used again.
+                     */
+                    template<class Compute>
+                    const DestinationGroup& get(const std::vector<Reader>& readers, Compute compute)
+                    {
+                        auto found = groups_.find(readers);
+                        if(found != groups_.end())
+                            return found->second;
+
+                        // The sets of readers a writer sends to are few, but nothing bounds them.
+                        if(groups_.size() >= max_groups_)
+                            groups_.clear();
+
+                        DestinationGroup& group = groups_[readers];
+                        compute(readers, group);
+                        return group;
+                    }
+
+                    //! Drops all the destinations, e.g. after a match or unmatch.
+                    void clear() { groups_.clear(); }
+
+                    //! Number of sets of readers cached.
+                    size_t size() const { return groups_.size(); }
+
+                private:
+
+                    std::map<std::vector<Reader>, DestinationGroup> groups_;
+
+                    size_t max_groups_;
+            };
+
+            template<class Reader>
+            const size_t DestinationGroupCache<Reader>::default_max_groups;
+        }
+    }
+}
+#endif
+#endif /* DESTINATIONGROUPCACHE_H_ */
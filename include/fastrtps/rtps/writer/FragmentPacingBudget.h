@@ -0,0 +1,96 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FragmentPacingBudget.h
+ *
+ */
+#ifndef FRAGMENTPACINGBUDGET_H_
+#define FRAGMENTPACINGBUDGET_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include "../flowcontrol/ThroughputControllerDescriptor.h"
+
+namespace eprosima
+{
+    namespace fastrtps
+    {
+        namespace rtps
+        {
+            /**
+             * Bytes of fragments that a writer can still send to one reader in the current pacing period.
+             * @ingroup WRITER_MODULE
+             */
+            class FragmentPacingBudget
+            {
+                public:
+
+                    FragmentPacingBudget() : bytesSent_(0) {}
+
+                    /*!
+                     * @brief Returns the bytes that can still be sent in the current period.
+                     * A new period starts when the previous one is over.
+                     * @param pacing Bytes allowed per period and period length.
+                     * @param now Current time.
+                     */
+                    uint32_t available(const ThroughputControllerDescriptor& pacing,
+                            const std::chrono::steady_clock::time_point& now)
+                    {
+                        if(now - periodStart_ >= std::chrono::milliseconds(pacing.periodMillisecs))
+                        {
+                            periodStart_ = now;
+                            bytesSent_ = 0;
+                        }
+
+                        return bytesSent_ < pacing.bytesPerPeriod ? pacing.bytesPerPeriod - bytesSent_ : 0;
+                    }
+
+                    /*!
+                     * @brief Accounts bytes sent in the current period.
+                     * @param bytes Bytes sent.
+                     */
+                    void sent(uint32_t bytes) { bytesSent_ += bytes; }
+
+                    /*!
+                     * @brief Takes a fragment from the bytes left in a period, if it fits.
+                     * A period always lets at least one fragment through, even if it is larger than the whole period.
+                     * @param length Length of the fragment.
+                     * @param available Bytes left in the period. Reduced by the fragment when it is taken.
+                     * @param pacing Bytes allowed per period and period length.
+                     * @return True if the fragment can be sent now. False if it has to wait for the next period.
+                     */
+                    static bool take(uint32_t length, uint32_t& available, const ThroughputControllerDescriptor& pacing)
+                    {
+                        if(length > available && available < pacing.bytesPerPeriod)
+                            return false;
+
+                        available -= (std::min)(length, available);
+                        return true;
+                    }
+
+                private:
+
+                    //! Bytes sent in the current period.
+                    uint32_t bytesSent_;
+
+                    //! Start of the current period.
+                    std::chrono::steady_clock::time_point periodStart_;
+            };
+        }
+    }
+}
+#endif
+#endif /* FRAGMENTPACINGBUDGET_H_ */
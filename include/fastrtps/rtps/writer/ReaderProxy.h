@@ -27,7 +27,9 @@
 #include "../common/SequenceNumber.h"
 #include "../common/CacheChange.h"
 #include "../common/FragmentNumber.h"
+#include "../common/SequenceNumberWindow.h"
 #include "../attributes/WriterAttributes.h"
+#include "FragmentPacingBudget.h"
 
 #include <set>
 
@@ -68,6 +70,12 @@ namespace eprosima
 
                 bool change_is_acked(const SequenceNumber_t& sequence_number);
 
+                /*!
+                 * @brief Whether the reader has requested again a change pending to be sent to it.
+                 * @param sequence_number Sequence number of the change.
+                 */
+                bool change_is_repair(const SequenceNumber_t& sequence_number) const;
+
                 /**
                  * Mark all changes up to the one indicated by the seqNum as Acknowledged.
                  * If seqNum == 30, changes 1-29 are marked as ack.
@@ -78,9 +86,9 @@ namespace eprosima
                 /**
                  * Mark all changes in the vector as requested.
                  * @param seqNumSet Vector of sequenceNumbers
-                 * @return False if any change was set REQUESTED.
+                 * @return Number of changes set REQUESTED.
                  */
-                bool requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet);
+                uint32_t requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet);
 
                 /*!
                  * @brief Lists all unsent changes. These changes are also relevants and valid.
@@ -145,7 +153,7 @@ namespace eprosima
                  * @brief Adds requested fragments. These fragments will be sent in next NackResponseDelay.
                  * @param[in] frag_set set containing the requested fragments to be sent.
                  * @param[in] sequence_number Sequence number to be paired with the requested fragments.
-                 * @return True if there is at least one requested fragment. False in other case.
+                 * @return True if at least one of the requested fragments was already sent. False in other case.
                  */
                 bool requested_fragment_set(SequenceNumber_t sequence_number, const FragmentNumberSet_t& frag_set);
 
@@ -161,6 +169,11 @@ namespace eprosima
                  */
                 void setLastNackfragCount(uint32_t lastNackfragCount) { lastNackfragCount_ = lastNackfragCount; }
 
+                /*!
+                 * @brief Returns the pacing budget of the fragments sent to this reader.
+                 */
+                FragmentPacingBudget& fragment_pacing() { return fragmentPacing_; }
+
                 //! Timed Event to manage the Acknack response delay.
                 NackResponseDelay* mp_nackResponse;
                 //! Timed Event to manage the delay to mark a change as UNACKED after sending it.
@@ -177,17 +190,56 @@ namespace eprosima
 
                 SequenceNumber_t get_low_mark() const { return changesFromRLowMark_; }
 
+                /*!
+                 * @brief Whether the writer waits for the acknowledgements of this reader.
+                 * False for best-effort readers and for reliable readers dropped for being too slow.
+                 */
+                bool waits_for_acknowledgement() const { return active_ && m_att.endpoint.reliabilityKind == RELIABLE; }
+
+                //! Whether the reader has not been dropped by the writer.
+                bool is_active() const { return active_; }
+
+                /*!
+                 * @brief Stops waiting for the acknowledgements of this reader.
+                 * All its pending changes are acknowledged on its behalf and the next ones are sent as best-effort.
+                 */
+                void deactivate();
+
+                //! Waits again for the acknowledgements of this reader.
+                void activate() { active_ = true; }
+
+                //! First change the reader had not acknowledged when it was dropped.
+                const SequenceNumber_t& dropped_low_mark() const { return droppedLowMark_; }
+
                 //!Mutex
                 std::recursive_mutex* mp_mutex;
 
-                std::set<ChangeForReader_t, ChangeForReaderCmp> m_changesForReader;
+                //!Changes and their state for this reader, indexed by sequence number.
+                SequenceNumberWindow<ChangeForReader_t> m_changesForReader;
 
                 //!Set of the changes and its state.
                 private:
                 //! Last  NACKFRAG count.
                 uint32_t lastNackfragCount_;
 
+                //! Bytes of fragments that can still be sent in the current pacing period.
+                FragmentPacingBudget fragmentPacing_;
+
                 SequenceNumber_t changesFromRLowMark_;
+
+                //! False while the writer does not wait for the acknowledgements of this reader.
+                bool active_;
+
+                //! First change not acknowledged by the reader when it was deactivated.
+                SequenceNumber_t droppedLowMark_;
+
+                /**
+                 * Reports to the writer a change of the low mark or of whether there are changes not acknowledged.
+                 * Called with the writer mutex taken.
+                 * @param previous_low_mark Low mark before the operation.
+                 * @param had_changes Whether there were changes before the operation.
+                 */
+                void ack_state_changed(const SequenceNumber_t& previous_low_mark, bool had_changes);
             };
         }
     } /* namespace rtps */
@@ -0,0 +1,158 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReadersAckState.h
+ *
+ */
+#ifndef READERSACKSTATE_H_
+#define READERSACKSTATE_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#include <algorithm>
+#include <set>
+#include "../common/CacheChange.h"
+#include "../common/SequenceNumber.h"
+
+namespace eprosima
+{
+    namespace fastrtps
+    {
+        namespace rtps
+        {
+            /**
+             * Acknowledgement state of all the readers matched with a writer, updated incrementally
+             * every time the low mark of a reader changes.
+             * It is not thread safe: the writer mutex protects it.
+             * @ingroup WRITER_MODULE
+             */
+            class ReadersAckState
+            {
+                public:
+
+                    ReadersAckState() : readers_with_changes_(0) {}
+
+                    /*!
+                     * @brief Adds a reader.
+                     * @param low_mark Last change acknowledged by the reader.
+                     * @param has_changes Whether the reader has changes not acknowledged yet.
+                     */
+                    void add_reader(const SequenceNumber_t& low_mark, bool has_changes)
+                    {
+                        low_marks_.insert(low_mark);
+                        if(has_changes)
+                            ++readers_with_changes_;
+                    }
+
+                    /*!
+                     * @brief Removes a reader.
+                     * @param low_mark Last change acknowledged by the reader.
+                     * @param has_changes Whether the reader has changes not acknowledged yet.
+                     */
+                    void remove_reader(const SequenceNumber_t& low_mark, bool has_changes)
+                    {
+                        auto it = low_marks_.find(low_mark);
+                        if(it != low_marks_.end())
+                            low_marks_.erase(it);
+                        if(has_changes)
+                            --readers_with_changes_;
+                    }
+
+                    /*!
+                     * @brief Updates the state of a reader after an operation on it.
+                     * @param previous_low_mark Low mark before the operation.
+                     * @param had_changes Whether there were changes not acknowledged before the operation.
+                     * @param low_mark Low mark after the operation.
+                     * @param has_changes Whether there are changes not acknowledged after the operation.
+                     */
+                    void reader_changed(const SequenceNumber_t& previous_low_mark, bool had_changes,
+                            const SequenceNumber_t& low_mark, bool has_changes)
+                    {
+                        if(previous_low_mark != low_mark)
+                        {
+                            remove_reader(previous_low_mark, false);
+                            add_reader(low_mark, false);
+                        }
+
+                        if(had_changes != has_changes)
+                        {
+                            if(has_changes)
+                                ++readers_with_changes_;
+                            else
+                                --readers_with_changes_;
+                        }
+                    }
+
+                    //! Last change acknowledged by all the readers, or the default sequence number without readers.
+                    SequenceNumber_t low_mark() const
+                    {
+                        return low_marks_.empty() ? SequenceNumber_t() : *low_marks_.begin();
+                    }
+
+                    //! Whether no reader has changes not acknowledged yet.
+                    bool all_acked() const { return readers_with_changes_ == 0; }
+
+                    /*!
+                     * @brief Whether a change is known to be acknowledged by all the readers from the low marks alone.
+                     * @param sequence_number Sequence number of the change.
+                     */
+                    bool is_acked_by_all(const SequenceNumber_t& sequence_number) const
+                    {
+                        return !low_marks_.empty() && sequence_number <= *low_marks_.begin();
+                    }
+
+                    //! Last change notified as acknowledged by all.
+                    const SequenceNumber_t& last_notified() const { return last_notified_; }
+
+                    /*!
+                     * @brief Records that the changes up to a sequence number were notified as acknowledged by all.
+                     * @param sequence_number Last change notified. Ignored if older than the last one recorded.
+                     */
+                    void notified(const SequenceNumber_t& sequence_number)
+                    {
+                        if(last_notified_ < sequence_number)
+                            last_notified_ = sequence_number;
+                    }
+
+                    /*!
+                     * @brief Finds the first change not notified yet as acknowledged by all.
+                     * @param begin Begin of the changes, ordered by sequence number.
+                     * @param end End of the changes.
+                     * @return Iterator to the first change after the last one notified.
+                     */
+                    template<class ChangeIterator>
+                    ChangeIterator first_not_notified(ChangeIterator begin, ChangeIterator end) const
+                    {
+                        return std::upper_bound(begin, end, last_notified_,
+                                [](const SequenceNumber_t& sequence_number, const CacheChange_t* change)
+                                {
+                                    return sequence_number < change->sequenceNumber;
+                                });
+                    }
+
+                private:
+
+                    //! Low marks of the readers. The first one is the last change acknowledged by all.
+                    std::multiset<SequenceNumber_t> low_marks_;
+
+                    //! Number of readers with changes not acknowledged yet.
+                    size_t readers_with_changes_;
+
+                    //! Last change notified as acknowledged by all.
+                    SequenceNumber_t last_notified_;
+            };
+        }
+    }
+}
+#endif
+#endif /* READERSACKSTATE_H_ */
@@ -22,9 +22,12 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include "RTPSWriter.h"
+#include "DestinationGroupCache.h"
+#include "ReadersAckState.h"
 #include "timedevent/PeriodicHeartbeat.h"
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 
 namespace eprosima
 {
@@ -33,6 +36,7 @@ namespace eprosima
         namespace rtps
         {
             class ReaderProxy;
+            class FragmentPacingDelay;
 
             /**
              * Class StatefulWriter, specialization of RTPSWriter that maintains information of each matched Reader.
@@ -62,6 +66,10 @@ namespace eprosima
 
                 //! Vector containin all the associated ReaderProxies.
                 std::vector<ReaderProxy*> matched_readers;
+                //! The associated ReaderProxies indexed by the GUID of their reader.
+                std::unordered_map<GUID_t, ReaderProxy*> matched_readers_by_guid_;
+                //! Acknowledgement state of the associated ReaderProxies.
+                ReadersAckState readers_ack_state_;
                 //!EntityId used to send the HB.(only for builtin types performance)
                 EntityId_t m_HBReaderEntityId;
                 // TODO Join this mutex when main mutex would not be recursive.
@@ -197,6 +205,36 @@ namespace eprosima
 
                 void check_acked_status();
 
+                /**
+                 * Updates the acknowledgement indexes after an operation on a ReaderProxy.
+                 * Called by the ReaderProxy with the writer mutex taken.
+                 */
+                void reader_ack_state_changed_nts(const SequenceNumber_t& previous_low_mark, bool had_changes,
+                        const SequenceNumber_t& low_mark, bool has_changes);
+
+                /**
+                 * Stops waiting for the acknowledgements of the readers holding back the oldest change.
+                 * Called with the writer mutex taken.
+                 * @return True if some reader was dropped.
+                 */
+                bool drop_slowest_readers_nts();
+
+                /**
+                 * Returns the destination of a set of readers, computing it only the first time it is used
+                 * after a match or unmatch. Readers sharing a multicast locator are reached through it.
+                 * @param remoteReaders Readers, in the order of matched_readers.
+                 * @param unicastOnly Whether the multicast locators of the readers are left aside.
+                 */
+                const DestinationGroup& destination_group_nts(const std::vector<ReaderProxy*>& remoteReaders,
+                        bool unicastOnly);
+
+                /**
+                 * Sends a change, or one of its fragments, to some readers and updates its status for them.
+                 * @return True if some of the readers waits for its acknowledgement.
+                 */
+                bool send_to_readers_nts(RTPSMessageGroup& group, CacheChange_t* change, FragmentNumber_t fragmentNumber,
+                        const std::vector<ReaderProxy*>& remoteReaders, const DestinationGroup& destinations);
+
                 bool disableHeartbeatPiggyback_;
 
                 const uint32_t sendBufferSize_;
@@ -205,6 +243,24 @@ namespace eprosima
 
                 std::vector<std::unique_ptr<FlowController> > m_controllers;
 
+                //! Send in turn one fragment of each change pending to be sent.
+                const bool interleaveFragments_;
+
+                //! Limit of bytes of fragments sent to each reader per period.
+                const ThroughputControllerDescriptor readerFragmentThroughput_;
+
+                //! Drop the slowest readers instead of blocking when the history is full.
+                const bool dropSlowestReader_;
+
+                //! Destinations of the sets of readers changes were sent to since the last match or unmatch.
+                DestinationGroupCache<ReaderProxy*> destination_groups_;
+
+                //! Unicast destinations of the sets of readers changes were sent again to.
+                DestinationGroupCache<ReaderProxy*> repair_destination_groups_;
+
+                //! Timed Event to resume the fragments held back by the pacing. Only created when fragments are paced.
+                FragmentPacingDelay* mp_fragmentPacing;
+
                 StatefulWriter& operator=(const StatefulWriter&) = delete;
             };
         } /* namespace rtps */
@@ -26,11 +26,13 @@
 #include "ReaderLocator.h"
 
 #include <list>
+#include <memory>
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+template<class T> class RTPSWriterCollector;
 
 /**
  * Class StatelessWriter, specialization of RTPSWriter that manages writers that don't keep state of the matched readers.
@@ -90,9 +92,6 @@ class StatelessWriter : public RTPSWriter
 
     bool add_locator(Locator_t& loc);
 
-    void update_unsent_changes(ReaderLocator& reader_locator,
-            const SequenceNumber_t& seqNum, const FragmentNumber_t fragNum);
-
     //!Reset the unsent changes.
     void unsent_changes_reset();
 
@@ -116,9 +115,42 @@ class StatelessWriter : public RTPSWriter
 
     void update_locators_nts_(const GUID_t& optionalGuid);
 
+    //! Recomputes the destinations of the changes that go to every reader locator.
+    void update_all_destinations_nts_();
+
+    /**
+     * Marks a change, or a fragment of it, as sent to a reader locator. Marked entries are removed from
+     * the unsent changes by remove_sent_changes_nts_().
+     * @param reader_locator Reader locator the change was sent to.
+     * @param cursor Position in the unsent changes of the reader locator to start searching from.
+     * Sent changes are marked in order, so it only moves forward.
+     * @return True if the whole change has been sent.
+     */
+    bool mark_as_sent_nts_(ReaderLocator& reader_locator, size_t& cursor,
+            const SequenceNumber_t& seqNum, const FragmentNumber_t fragNum);
+
+    void remove_sent_changes_nts_();
+
     std::vector<ReaderLocator> reader_locators, fixed_locators;
     std::vector<RemoteReaderAttributes> m_matched_readers;
     std::vector<std::unique_ptr<FlowController> > m_controllers;
+
+    //! Builtin readers this writer addresses. Empty for user writers, which address the matched readers.
+    std::vector<GUID_t> m_builtin_guids;
+
+    //! Readers addressed by a change that goes to every reader locator.
+    std::vector<GUID_t> m_all_destination_guids;
+    //! Locators of a change that goes to every reader locator.
+    LocatorList_t m_all_destination_locators;
+    //! Whether any reader locator expects inline QoS.
+    bool m_all_destinations_expect_inline_qos;
+
+    // Working storage of send_any_unsent_changes(), kept between calls so sending does not allocate memory.
+    std::unique_ptr<RTPSWriterCollector<ReaderLocator*>> m_changes_to_send;
+    std::vector<GUID_t> m_destination_guids;
+    LocatorList_t m_destination_locators;
+    std::vector<size_t> m_unsent_cursors;
+    std::vector<CacheChange_t*> m_sent_changes;
 };
 }
 } /* namespace rtps */
@@ -0,0 +1,64 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FragmentPacingDelay.h
+ *
+ */
+
+#ifndef FRAGMENTPACINGDELAY_H_
+#define FRAGMENTPACINGDELAY_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "../../resources/TimedEvent.h"
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+class StatefulWriter;
+
+/**
+ * FragmentPacingDelay class, used to resume the sending of fragments held back by the per reader pacing
+ * once the pacing period is over.
+ * @ingroup WRITER_MODULE
+ */
+class FragmentPacingDelay : public TimedEvent
+{
+public:
+	virtual ~FragmentPacingDelay();
+	/**
+	*
+	* @param p_SFW
+	* @param intervalmillisec
+	*/
+	FragmentPacingDelay(StatefulWriter* p_SFW, double intervalmillisec);
+
+	/**
+	* Method invoked when the event occurs
+	*
+	* @param code Code representing the status of the event
+	* @param msg Message associated to the event
+	*/
+	void event(EventCode code, const char* msg= nullptr);
+
+	//!Writer whose fragments are paced
+	StatefulWriter* mp_SFW;
+};
+
+}
+}
+} /* namespace eprosima */
+#endif
+#endif /* FRAGMENTPACINGDELAY_H_ */
@@ -30,6 +30,40 @@
 namespace eprosima {
 namespace fastrtps {
 
+/**
+ * Whether a sample has already been read, used to select the samples to read or take from a Subscriber.
+ * @ingroup FASTRTPS_MODULE
+ */
+enum SampleStateKind : uint8_t
+{
+    READ_SAMPLE_STATE = 0x01,       //!< The sample has already been read.
+    NOT_READ_SAMPLE_STATE = 0x02    //!< The sample has not been read yet.
+};
+
+//! Combination of SampleStateKind values.
+typedef uint8_t SampleStateMask;
+
+//! Every sample state.
+const SampleStateMask ANY_SAMPLE_STATE = READ_SAMPLE_STATE | NOT_READ_SAMPLE_STATE;
+
+/**
+ * State of the instance of a sample, given by the kind of the last sample received for the instance.
+ * @ingroup FASTRTPS_MODULE
+ */
+enum InstanceStateKind : uint8_t
+{
+    ALIVE_INSTANCE_STATE = 0x01,                //!< The last sample was an ALIVE one.
+    NOT_ALIVE_DISPOSED_INSTANCE_STATE = 0x02,   //!< The instance was disposed.
+    NOT_ALIVE_NO_WRITERS_INSTANCE_STATE = 0x04  //!< The instance was unregistered.
+};
+
+//! Combination of InstanceStateKind values.
+typedef uint8_t InstanceStateMask;
+
+//! Every instance state.
+const InstanceStateMask ANY_INSTANCE_STATE = ALIVE_INSTANCE_STATE | NOT_ALIVE_DISPOSED_INSTANCE_STATE |
+    NOT_ALIVE_NO_WRITERS_INSTANCE_STATE;
+
 /**
  * Class SampleInfo_t with information that is provided along a sample when reading data from a Subscriber.
  * @ingroup FASTRTPS_MODULE
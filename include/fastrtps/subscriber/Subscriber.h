@@ -21,7 +21,9 @@
 #define SUBSCRIBER_H_
 
 #include "../rtps/common/Guid.h"
+#include "../rtps/common/Statistics.h"
 #include "../attributes/SubscriberAttributes.h"
+#include "SampleInfo.h"
 
 
 
@@ -29,7 +31,6 @@ namespace eprosima {
 namespace fastrtps {
 
 class SubscriberImpl;
-class SampleInfo_t;
 
 /**
  * Class Subscriber, contains the public API that allows the user to control the reception of messages.
@@ -74,6 +75,84 @@ class RTPS_DllAPI Subscriber
      */
     bool takeNextData(void* data,SampleInfo_t* info);
 
+    /**
+     * Take next Data from the Subscriber without deserializing it, only for plain types (see TopicDataType::is_plain).
+     * The sample is read in place, from the payload where it was received, until it is given back with return_loan.
+     * @param[out] data Pointer to the loaned sample, or nullptr if the sample is not ALIVE and there is nothing to read.
+     * @param info Pointer to a SampleInfo_t structure that informs you about your sample.
+     * @return True if a sample was taken.
+     */
+    bool take_loaned(void*& data, SampleInfo_t* info);
+
+    /**
+     * Give back a sample taken with take_loaned, which must not be accessed anymore.
+     * @param data Pointer to the loaned sample.
+     * @return True if the pointer was a loaned sample.
+     */
+    bool return_loan(void* data);
+
+    /**
+     * Read, in a single call, the available samples in the given states. The samples remain in the subscriber.
+     * @param data Array of at least max_samples objects of the topic type (see TopicDataType::createData)
+     * where the samples are stored.
+     * @param info Array of at least max_samples SampleInfo_t structures, or nullptr.
+     * @param max_samples Maximum number of samples to read.
+     * @param sample_states Mask of the SampleStateKind of the samples to read.
+     * @param instance_states Mask of the InstanceStateKind of the samples to read.
+     * @return Number of samples read.
+     */
+    size_t read(void** data, SampleInfo_t* info, size_t max_samples,
+            SampleStateMask sample_states = ANY_SAMPLE_STATE, InstanceStateMask instance_states = ANY_INSTANCE_STATE);
+
+    /**
+     * Take, in a single call, the available samples in the given states. The samples are removed from the subscriber.
+     * @param data Array of at least max_samples objects of the topic type (see TopicDataType::createData)
+     * where the samples are stored.
+     * @param info Array of at least max_samples SampleInfo_t structures, or nullptr.
+     * @param max_samples Maximum number of samples to take.
+     * @param sample_states Mask of the SampleStateKind of the samples to take.
+     * @param instance_states Mask of the InstanceStateKind of the samples to take.
+     * @return Number of samples taken.
+     */
+    size_t take(void** data, SampleInfo_t* info, size_t max_samples,
+            SampleStateMask sample_states = ANY_SAMPLE_STATE, InstanceStateMask instance_states = ANY_INSTANCE_STATE);
+
+    /**
+     * Same as read, only for the samples of an instance of a keyed topic.
+     * @param handle Instance handle of the samples.
+     * @return Number of samples read.
+     */
+    size_t read_instance(void** data, SampleInfo_t* info, size_t max_samples, const rtps::InstanceHandle_t& handle,
+            SampleStateMask sample_states = ANY_SAMPLE_STATE, InstanceStateMask instance_states = ANY_INSTANCE_STATE);
+
+    /**
+     * Same as take, only for the samples of an instance of a keyed topic.
+     * @param handle Instance handle of the samples.
+     * @return Number of samples taken.
+     */
+    size_t take_instance(void** data, SampleInfo_t* info, size_t max_samples, const rtps::InstanceHandle_t& handle,
+            SampleStateMask sample_states = ANY_SAMPLE_STATE, InstanceStateMask instance_states = ANY_INSTANCE_STATE);
+
+    /**
+     * Same as read, for the instance with the smallest handle greater than the given one that has samples
+     * in the given states. Calling it with the handle of the returned samples iterates over the instances.
+     * @param previous Instance handle returned by the previous call, or c_InstanceHandle_Unknown to start.
+     * @return Number of samples read. Zero when there are no more instances.
+     */
+    size_t read_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+            const rtps::InstanceHandle_t& previous,
+            SampleStateMask sample_states = ANY_SAMPLE_STATE, InstanceStateMask instance_states = ANY_INSTANCE_STATE);
+
+    /**
+     * Same as take, for the instance with the smallest handle greater than the given one that has samples
+     * in the given states. Calling it with the handle of the returned samples iterates over the instances.
+     * @param previous Instance handle returned by the previous call, or c_InstanceHandle_Unknown to start.
+     * @return Number of samples taken. Zero when there are no more instances.
+     */
+    size_t take_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+            const rtps::InstanceHandle_t& previous,
+            SampleStateMask sample_states = ANY_SAMPLE_STATE, InstanceStateMask instance_states = ANY_INSTANCE_STATE);
+
 
     /**
      * Update the Attributes of the subscriber;
@@ -102,6 +181,12 @@ class RTPS_DllAPI Subscriber
      */
     uint64_t getUnreadCount() const;
 
+    /**
+     * Get the traffic handled by the associated RTPSReader since it was created.
+     * @return Snapshot of the statistics of the reader.
+     */
+    rtps::EndpointStatistics get_statistics() const;
+
     private:
 
     SubscriberImpl* mp_impl;
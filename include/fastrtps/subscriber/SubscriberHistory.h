@@ -26,6 +26,9 @@
 #include "../qos/QosPolicies.h"
 #include "SampleInfo.h"
 
+#include <deque>
+#include <unordered_map>
+
 
 
 namespace eprosima {
@@ -46,8 +49,8 @@ class SubscriberHistory: public rtps::ReaderHistory
 {
     public:
 
-        typedef std::pair<rtps::InstanceHandle_t,std::vector<rtps::CacheChange_t*>> t_p_I_Change;
-        typedef std::vector<t_p_I_Change> t_v_Inst_Caches;
+        typedef std::deque<rtps::CacheChange_t*> t_Inst_Changes;
+        typedef std::unordered_map<rtps::InstanceHandle_t, t_Inst_Changes> t_m_Inst_Caches;
 
         /**
          * Constructor. Requires information about the subscriner
@@ -80,13 +83,55 @@ class SubscriberHistory: public rtps::ReaderHistory
         bool takeNextData(void* data, SampleInfo_t* info);
         ///@}
 
+        /**
+         * Reads or takes, holding the lock once, the available samples in the given states.
+         * @param data Array of at least max_samples objects of the topic type where the samples are deserialized.
+         * @param info Array of at least max_samples SampleInfo_t, or nullptr.
+         * @param max_samples Maximum number of samples.
+         * @param take Whether the samples leave the history.
+         * @param handle Instance of the samples, or nullptr for the samples of every instance.
+         * @param sample_states Sample states of the samples.
+         * @param instance_states Instance states of the samples.
+         * @return Number of samples returned.
+         */
+        size_t get_samples(void** data, SampleInfo_t* info, size_t max_samples, bool take,
+                const rtps::InstanceHandle_t* handle, SampleStateMask sample_states, InstanceStateMask instance_states);
+
+        /**
+         * Same as get_samples, for the instance with the smallest handle greater than the given one
+         * that has samples in the given states.
+         * @param previous Handle of the previous instance, or c_InstanceHandle_Unknown to start by the first one.
+         * @return Number of samples returned.
+         */
+        size_t get_next_instance_samples(void** data, SampleInfo_t* info, size_t max_samples, bool take,
+                const rtps::InstanceHandle_t& previous, SampleStateMask sample_states,
+                InstanceStateMask instance_states);
+
+        /**
+         * Takes the next change without deserializing it. The change leaves the history but is not released
+         * to the pool until its loan is returned.
+         * @param[out] data Pointer to the sample inside the payload, or nullptr if the change is not ALIVE.
+         * @param info Pointer to a SampleInfo_t object where you want to store the information about the sample.
+         * @return True if a change was taken.
+         */
+        bool take_loaned(void*& data, SampleInfo_t* info);
+
+        /**
+         * Releases the change of a sample taken with take_loaned.
+         * @param data Pointer to the loaned sample.
+         * @return True if the sample was loaned.
+         */
+        bool return_loan(void* data);
+
         /**
          * This method is called to remove a change from the SubscriberHistory.
          * @param change Pointer to the CacheChange_t.
-         * @param vit Pointer to the iterator of the key-ordered cacheChange vector.
+         * @param vit Pointer to the iterator of the instance of the change.
+         * @param release Whether the change goes back to the pool. Otherwise the caller becomes its owner.
          * @return True if removed.
          */
-        bool remove_change_sub(rtps::CacheChange_t* change,t_v_Inst_Caches::iterator* vit=nullptr);
+        bool remove_change_sub(rtps::CacheChange_t* change,t_m_Inst_Caches::iterator* vit=nullptr,
+                bool release = true);
 
         //!Increase the unread count.
         inline void increaseUnreadCount()
@@ -113,8 +158,8 @@ class SubscriberHistory: public rtps::ReaderHistory
 
         //!Number of unread CacheChange_t.
         uint64_t m_unreadCacheCount;
-        //!Vector of pointer to the CacheChange_t divided by key.
-        t_v_Inst_Caches m_keyedChanges;
+        //!Changes of each instance, ordered by sequence number and indexed by instance handle.
+        t_m_Inst_Caches m_keyedChanges;
         //!HistoryQosPolicy values.
         HistoryQosPolicy m_historyQos;
         //!ResourceLimitsQosPolicy values.
@@ -125,8 +170,26 @@ class SubscriberHistory: public rtps::ReaderHistory
         //!Type object to deserialize Key
         void * mp_getKeyObject;
 
+        //!Changes taken with take_loaned whose loans have not been returned yet.
+        std::vector<rtps::CacheChange_t*> m_loanedChanges;
+
+        //!Changes selected by get_samples, kept to reuse its capacity.
+        std::vector<std::pair<rtps::CacheChange_t*, rtps::WriterProxy*>> m_selectedChanges;
+
+        //!Changes found by select_change whose writer is no longer matched, removed after the selection.
+        std::vector<rtps::CacheChange_t*> m_unpairedChanges;
+
+        InstanceStateKind instance_state(rtps::CacheChange_t* change) const;
+
+        bool select_change(rtps::CacheChange_t* change, SampleStateMask sample_states,
+                InstanceStateMask instance_states, rtps::WriterProxy** wp);
+
+        void remove_unpaired_changes();
+
+
+        bool find_Key(rtps::CacheChange_t* a_change,t_m_Inst_Caches::iterator* vecPairIterrator);
 
-        bool find_Key(rtps::CacheChange_t* a_change,t_v_Inst_Caches::iterator* vecPairIterrator);
+        void fill_sample_info(rtps::CacheChange_t* change, rtps::WriterProxy* wp, void* data, SampleInfo_t* info);
 };
 
 } /* namespace fastrtps */
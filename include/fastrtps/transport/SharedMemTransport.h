@@ -0,0 +1,141 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_H
+#define SHAREDMEM_TRANSPORT_H
+
+#include "TransportInterface.h"
+#include "SharedMemTransportDescriptor.h"
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <memory>
+#include <chrono>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class SharedMemSegment;
+
+/**
+ * Transport for participants running on the same host. Each input channel is a shared memory segment,
+ * named after its port, holding a lock-free queue of messages. Sending to a port copies the message
+ * directly into the queue of the process listening on it, without going through the network stack.
+ *
+ *    - Locators of this transport are of kind LOCATOR_KIND_SHM and only their port is meaningful.
+ *       They are never announced through discovery: the NetworkFactory maps local unicast UDP
+ *       locators to the shared memory channel with the same port, so a remote participant listening
+ *       on the same host is reached through shared memory when it also has this transport registered,
+ *       and through UDP otherwise.
+ *
+ *    - Only available on POSIX systems. On other platforms init() fails and the transport is not registered.
+ * @ingroup TRANSPORT_MODULE
+ */
+class SharedMemTransport : public TransportInterface
+{
+public:
+
+   RTPS_DllAPI SharedMemTransport(const SharedMemTransportDescriptor&);
+
+   virtual ~SharedMemTransport();
+
+   bool init() override;
+
+   //! Checks whether this transport owns the segment of the given port.
+   virtual bool IsInputChannelOpen(const Locator_t&) const override;
+
+   //! Checks whether the output channel of the given port has been opened.
+   virtual bool IsOutputChannelOpen(const Locator_t&) const override;
+
+   //! Checks for SHM kind.
+   virtual bool IsLocatorSupported(const Locator_t&) const override;
+
+   //! Reports whether Locators are of SHM kind and correspond to the same port.
+   virtual bool DoLocatorsMatch(const Locator_t&, const Locator_t&) const override;
+
+   //! All remote locators are reachable through the output channel of port 0.
+   virtual Locator_t RemoteToMainLocal(const Locator_t&) const override;
+
+   //! Creates the shared memory segment of the given port.
+   virtual bool OpenInputChannel(const Locator_t&) override;
+
+   virtual bool OpenOutputChannel(Locator_t&) override;
+
+   //! Removes the shared memory segment of the given port.
+   virtual bool CloseInputChannel(const Locator_t&) override;
+
+   //! Unblocks the threads waiting on Receive for the given port.
+   virtual bool ReleaseInputChannel(const Locator_t&) override;
+
+   virtual bool CloseOutputChannel(const Locator_t&) override;
+
+   /**
+    * Copies the message into the segment of the remote port. Fails without blocking when there is no
+    * segment for that port, or its queue is full, so the caller can fall back to another transport.
+    * @param sendBuffer Slice into the raw data to send.
+    * @param sendBufferSize Size of the raw data. It must not exceed the maxMessageSize of the descriptor.
+    * @param localLocator Locator mapping to the channel we're sending from.
+    * @param remoteLocator Locator describing the remote port we're sending to.
+    */
+   virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+                     const Locator_t& remoteLocator) override;
+
+   /**
+    * Blocking Receive from the segment of the given port.
+    * @param[out] remoteLocator Filled with the UDPv4 loopback address and the port of the sender channel.
+    */
+   virtual bool Receive(octet* receiveBuffer, uint32_t receiveBufferCapacity, uint32_t& receiveBufferSize,
+                        const Locator_t& localLocator, Locator_t& remoteLocator) override;
+
+   virtual LocatorList_t NormalizeLocator(const Locator_t& locator) override;
+
+   virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
+
+   //! Shared memory locators always refer to this host.
+   virtual bool is_local_locator(const Locator_t& locator) const override;
+
+   SharedMemTransportDescriptor get_configuration() { return mConfiguration_; }
+
+protected:
+
+   //! Input channel, together with the flag that keeps its Receive operation running.
+   struct InputChannel;
+
+   SharedMemTransportDescriptor mConfiguration_;
+
+   mutable std::recursive_mutex mOutputMapMutex;
+   mutable std::recursive_mutex mInputMapMutex;
+
+   //! Ports of the open output channels.
+   std::set<uint32_t> mOutputChannels;
+
+   //! Segments owned by this transport, one per input port.
+   std::map<uint32_t, std::shared_ptr<InputChannel> > mInputChannels;
+
+   //! Segments of the remote ports this transport has sent to.
+   std::map<uint32_t, std::shared_ptr<SharedMemSegment> > mRemoteSegments;
+
+   //! Remote ports without a segment, and when to look for it again.
+   std::map<uint32_t, std::chrono::steady_clock::time_point> mMissingSegments;
+
+   std::shared_ptr<SharedMemSegment> GetRemoteSegment(uint32_t port);
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
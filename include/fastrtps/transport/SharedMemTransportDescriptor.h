@@ -0,0 +1,51 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_DESCRIPTOR
+#define SHAREDMEM_TRANSPORT_DESCRIPTOR
+
+#include "TransportInterface.h"
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * Transport configuration
+ *
+ * - queueSize:     number of messages each input channel is able to hold until they are received.
+ *
+ * - maxMessageSize: size of each message slot of the queues. The participant uses the biggest maxMessageSize
+ *                  of all its registered transports, so it should not exceed the one of the UDP transports.
+ * @ingroup TRANSPORT_MODULE
+ */
+typedef struct SharedMemTransportDescriptor: public TransportDescriptorInterface {
+   /**
+    * Number of messages each input channel queue is able to hold. It is rounded up to a power of two.
+    * Default value: 32.
+    */
+   uint32_t queueSize;
+
+   virtual ~SharedMemTransportDescriptor(){}
+
+   RTPS_DllAPI SharedMemTransportDescriptor();
+
+   RTPS_DllAPI SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t);
+} SharedMemTransportDescriptor;
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
@@ -22,6 +22,22 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+/**
+ * Reception buffer used on batched receptions through TransportInterface::ReceiveBatch.
+ * @ingroup TRANSPORT_MODULE
+ */
+struct TransportReceiveBuffer
+{
+    //! Pointer to the buffer where the datagram will be stored.
+    octet* buffer;
+    //! Capacity of the buffer.
+    uint32_t capacity;
+    //! Final size of the received datagram.
+    uint32_t size;
+    //! Address of the remote sender.
+    Locator_t remoteLocator;
+};
+
 
 /**
  * Interface against which to implement a transport layer, decoupled from FastRTPS internals.
@@ -109,6 +125,40 @@ public:
    virtual bool Receive(octet* receiveBuffer, uint32_t receiveBufferCapacity, uint32_t& receiveBufferSize,
                         const Locator_t& localLocator, Locator_t& remoteLocator) = 0;
 
+   /**
+    * Blocking send of the same buffer to several remote destinations, through the outbound channel that maps to
+    * the localLocator. Transports able to move several datagrams on a single system call should override it.
+    * The default implementation calls Send once per destination.
+    * @return True if the buffer was sent to at least one destination.
+    */
+   virtual bool SendBatch(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+                          const LocatorList_t& remoteLocators)
+   {
+      bool success = false;
+      for (auto it = remoteLocators.begin(); it != remoteLocators.end(); ++it)
+         success |= Send(sendBuffer, sendBufferSize, localLocator, *it);
+      return success;
+   }
+
+   /**
+    * Blocking receive of up to bufferCount datagrams, on the inbound channel that maps to the localLocator.
+    * Blocks until at least one datagram is available, and then returns all the ones that can be received without
+    * blocking again. The default implementation calls Receive once.
+    * @param buffers Array of reception buffers. The size and remote locator of the used ones are filled.
+    * @param bufferCount Number of elements in the array.
+    * @return Number of datagrams received. Zero on error or when the channel is being closed.
+    */
+   virtual uint32_t ReceiveBatch(TransportReceiveBuffer* buffers, uint32_t bufferCount, const Locator_t& localLocator)
+   {
+      if (bufferCount == 0 ||
+            !Receive(buffers[0].buffer, buffers[0].capacity, buffers[0].size, localLocator, buffers[0].remoteLocator))
+         return 0;
+      return 1;
+   }
+
+   //! Maximum number of datagrams this transport moves on a single call to ReceiveBatch.
+   virtual uint32_t MaxBatchSize() const { return 1; }
+
    virtual LocatorList_t NormalizeLocator(const Locator_t& locator) = 0;
 
    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) = 0;
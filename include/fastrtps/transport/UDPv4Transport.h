@@ -165,6 +165,22 @@ public:
    virtual bool Receive(octet* receiveBuffer, uint32_t receiveBufferCapacity, uint32_t& receiveBufferSize,
                         const Locator_t& localLocator, Locator_t& remoteLocator) override;
 
+   /**
+    * Blocking Send of the same buffer to several destinations. When batching is enabled on the descriptor,
+    * the datagrams for all the destinations are handed to the kernel with sendmmsg.
+    */
+   virtual bool SendBatch(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+                          const LocatorList_t& remoteLocators) override;
+
+   /**
+    * Blocking Receive of several datagrams. When batching is enabled on the descriptor, all the
+    * datagrams already queued on the socket are received with a single recvmmsg call.
+    */
+   virtual uint32_t ReceiveBatch(TransportReceiveBuffer* buffers, uint32_t bufferCount,
+                                 const Locator_t& localLocator) override;
+
+   virtual uint32_t MaxBatchSize() const override;
+
    virtual LocatorList_t NormalizeLocator(const Locator_t& locator) override;
 
    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
@@ -210,6 +226,11 @@ protected:
                           uint32_t sendBufferSize,
                           const Locator_t& remoteLocator,
                           asio::ip::udp::socket& socket);
+
+   bool SendBatchThroughSocket(const octet* sendBuffer,
+                               uint32_t sendBufferSize,
+                               const LocatorList_t& remoteLocators,
+                               SocketInfo& socket);
 };
 
 } // namespace rtps
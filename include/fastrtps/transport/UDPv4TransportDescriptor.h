@@ -29,6 +29,8 @@ namespace rtps{
  *                  fail.
  *
  * - interfaceWhiteList: Lists the allowed interfaces.
+ *
+ * - maxBatchSize:  maximum number of datagrams moved on each system call.
  * @ingroup TRANSPORT_MODULE
  */
 typedef struct UDPv4TransportDescriptor: public TransportDescriptorInterface {
@@ -40,6 +42,11 @@ typedef struct UDPv4TransportDescriptor: public TransportDescriptorInterface {
    std::vector<std::string> interfaceWhiteList;
    //! Specified time to live (8bit - 255 max TTL)
    uint8_t TTL;
+   /**
+    * Maximum number of datagrams moved on a single system call (recvmmsg/sendmmsg).
+    * Only supported on Linux. Value 1 disables batching. Default value: 1.
+    */
+   uint32_t maxBatchSize;
 
    virtual ~UDPv4TransportDescriptor(){}
 
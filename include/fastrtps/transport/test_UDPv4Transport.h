@@ -37,6 +37,10 @@ public:
 
    virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator, const Locator_t& remoteLocator);
 
+   // Batched sends go through Send, so the drop criteria are evaluated for every destination.
+   virtual bool SendBatch(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+         const LocatorList_t& remoteLocators);
+
    // Handle to a persistent log of dropped packets. Defaults to length 0 (no logging) to prevent wasted resources.
    RTPS_DllAPI static std::vector<std::vector<octet> > DropLog;
    RTPS_DllAPI static uint32_t DropLogLength;
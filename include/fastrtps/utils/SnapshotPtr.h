@@ -0,0 +1,119 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SnapshotPtr.h
+ *
+ */
+
+#ifndef SNAPSHOTPTR_H_
+#define SNAPSHOTPTR_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Immutable value read without locking and replaced as a whole.
+ * Readers take a snapshot and keep using it as long as they hold it. Writers build a new value and publish it.
+ * Every published value counts itself as alive until its last snapshot is released, so a writer can wait until
+ * no reader holds any value but the current one, not only the one it has just replaced, before destroying the
+ * objects they refer to. The wait blocks on a condition variable signalled by the release of each value.
+ * Calls to publish and publish_and_wait must be serialized by the caller.
+ * @ingroup UTILITIESMODULE
+ */
+template<typename T>
+class SnapshotPtr
+{
+    public:
+
+        explicit SnapshotPtr(std::shared_ptr<const T>&& value) : values_(std::make_shared<AliveValues>()),
+            current_(track(std::move(value)))
+        {
+        }
+
+        //! Current value. It stays valid while the returned pointer is held.
+        std::shared_ptr<const T> get() const
+        {
+            return std::atomic_load(&current_);
+        }
+
+        //! Replaces the current value without waiting for the readers of the previous ones.
+        void publish(std::shared_ptr<const T>&& value)
+        {
+            std::atomic_exchange(&current_, track(std::move(value)));
+        }
+
+        /**
+         * Replaces the current value and waits until no reader holds a previous one.
+         * Objects only referenced by previous values can be destroyed safely afterwards.
+         */
+        void publish_and_wait(std::shared_ptr<const T>&& value)
+        {
+            publish(std::move(value));
+
+            std::unique_lock<std::mutex> lock(values_->mutex);
+            values_->released.wait(lock, [this]() { return values_->count <= 1; });
+        }
+
+    private:
+
+        //! Number of published values still held by someone, the current one included.
+        struct AliveValues
+        {
+            AliveValues() : count(0) {}
+
+            std::mutex mutex;
+            std::condition_variable released;
+            size_t count;
+        };
+
+        //! Releases a published value and signals it. It keeps the count alive if the SnapshotPtr goes first.
+        struct Release
+        {
+            void operator()(const T*)
+            {
+                value.reset();
+
+                std::lock_guard<std::mutex> guard(values->mutex);
+                --values->count;
+                values->released.notify_all();
+            }
+
+            std::shared_ptr<const T> value;
+            std::shared_ptr<AliveValues> values;
+        };
+
+        std::shared_ptr<const T> track(std::shared_ptr<const T>&& value)
+        {
+            {
+                std::lock_guard<std::mutex> guard(values_->mutex);
+                ++values_->count;
+            }
+
+            const T* pointer = value.get();
+            return std::shared_ptr<const T>(pointer, Release{std::move(value), values_});
+        }
+
+        std::shared_ptr<AliveValues> values_;
+        std::shared_ptr<const T> current_;
+};
+
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SNAPSHOTPTR_H_
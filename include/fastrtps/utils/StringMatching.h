@@ -37,6 +37,10 @@ class StringMatching
          * It checks the string specified by the input argument to see if it matches the pattern specified by the pattern argument.
          */
         static bool matchString(const char* pattern,const char* input);
+        /** Static method to check whether a string contains wildcard characters.
+         * Two strings without wildcards match only if they are equal.
+         */
+        static bool hasWildcards(const char* str);
 };
 }
 } /* namespace rtps */
@@ -121,6 +121,10 @@ class XMLParser
     RTPS_DllAPI static XMLP_ret getXMLReaderQosPolicies(tinyxml2::XMLElement* elem, ReaderQos& qos, uint8_t ident);
     RTPS_DllAPI static XMLP_ret getXMLPublishModeQos(tinyxml2::XMLElement* elem, PublishModeQosPolicy& publishMode,
                                                      uint8_t ident);
+    RTPS_DllAPI static XMLP_ret getXMLFragmentSchedulingQos(tinyxml2::XMLElement* elem,
+                                                     FragmentSchedulingQosPolicy& fragmentScheduling, uint8_t ident);
+    RTPS_DllAPI static XMLP_ret getXMLSlowReaderQos(tinyxml2::XMLElement* elem,
+                                                    SlowReaderQosPolicy& slowReader, uint8_t ident);
     RTPS_DllAPI static XMLP_ret getXMLGroupDataQos(tinyxml2::XMLElement* elem, GroupDataQosPolicy& groupData, uint8_t ident);
     RTPS_DllAPI static XMLP_ret getXMLTopicDataQos(tinyxml2::XMLElement* elem, TopicDataQosPolicy& topicData, uint8_t ident);
     RTPS_DllAPI static XMLP_ret getXMLPartitionQos(tinyxml2::XMLElement* elem, PartitionQosPolicy& partition, uint8_t ident);
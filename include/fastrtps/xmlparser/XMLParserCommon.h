@@ -58,6 +58,10 @@ extern const char* DEF_OUT_LOC_LIST;
 extern const char* DEF_SEND_PORT;
 extern const char* SEND_SOCK_BUF_SIZE;
 extern const char* LIST_SOCK_BUF_SIZE;
+extern const char* LIST_WORKER_THREADS;
+extern const char* LIST_BUF_POOL_SIZE;
+extern const char* ASYNC_SEND_THREADS;
+extern const char* EVENT_THREADS;
 extern const char* BUILTIN;
 extern const char* PORT;
 extern const char* USER_DATA;
@@ -92,6 +96,7 @@ extern const char* VALUE;
 extern const char* PROPAGATE;
 extern const char* PREALLOCATED;
 extern const char* PREALLOCATED_WITH_REALLOC;
+extern const char* PREALLOCATED_WITH_ARENA;
 extern const char* DYNAMIC;
 extern const char* LOCATOR;
 extern const char* KIND;
@@ -101,6 +106,7 @@ extern const char* UDPv4;
 extern const char* UDPv6;
 extern const char* INIT_ACKNACK_DELAY;
 extern const char* HEARTB_RESP_DELAY;
+extern const char* FRAG_SAMPLE_TIMEOUT;
 extern const char* INIT_HEARTB_DELAY;
 extern const char* HEARTB_PERIOD;
 extern const char* NACK_RESP_DELAY;
@@ -132,9 +138,20 @@ extern const char* PARTITION;
 extern const char* TOPIC_DATA;
 extern const char* GROUP_DATA;
 extern const char* PUB_MODE;
+extern const char* FRAG_SCHEDULING;
+extern const char* SLOW_READER;
 
 extern const char* SYNCHRONOUS;
 extern const char* ASYNCHRONOUS;
+extern const char* PRIORITY;
+extern const char* LOW_PRIORITY;
+extern const char* NORMAL_PRIORITY;
+extern const char* HIGH_PRIORITY;
+extern const char* SEQUENTIAL;
+extern const char* INTERLEAVED;
+extern const char* BYTES_PER_READER;
+extern const char* BLOCK;
+extern const char* DROP_SLOWEST;
 extern const char* NAMES;
 extern const char* INSTANCE;
 extern const char* GROUP;
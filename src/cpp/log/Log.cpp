@@ -4,20 +4,27 @@
 
 #include <fastrtps/log/Log.h>
 #include <fastrtps/log/StdoutConsumer.h>
+#include "LogRing.h"
 #include <iostream>
 
 using namespace std;
 namespace eprosima {
 namespace fastrtps {
 
+const size_t Log::MaxMessageSize;
+const size_t Log::QueueCapacity;
+
 struct Log::Resources Log::mResources;
 
 Log::Resources::Resources():
+   mLogs(new LogRing(Log::QueueCapacity)),
    mDefaultConsumer(new StdoutConsumer),
    mLogging(false),
-   mWork(false),
+   mSleeping(false),
+   mReportedDrops(0),
    mFilenames(false),
    mFunctions(true),
+   mFilterGeneration(1),
    mVerbosity(Log::Error)
 {
 }
@@ -35,8 +42,12 @@ void Log::RegisterConsumer(std::unique_ptr<LogConsumer> consumer)
 
 void Log::Reset()
 {
+   {
+      std::unique_lock<std::mutex> filterGuard(mResources.mCategoryFilterMutex);
+      mResources.mCategoryFilter.reset();
+      ++mResources.mFilterGeneration;
+   }
    std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
-   mResources.mCategoryFilter.reset();
    mResources.mFilenameFilter.reset();
    mResources.mErrorStringFilter.reset();
    mResources.mFilenames = false;
@@ -47,36 +58,53 @@ void Log::Reset()
 
 void Log::Run() 
 {
+   Entry entry;
    std::unique_lock<std::mutex> guard(mResources.mCvMutex);
    while (mResources.mLogging) 
    {
-      while (mResources.mWork) 
-      {
-         mResources.mWork = false;
-         guard.unlock();
+      guard.unlock();
 
-         mResources.mLogs.Swap();
-         while (!mResources.mLogs.Empty())
+      while (mResources.mLogs->Pop(entry))
+      {
+         std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
+         if (Preprocess(entry))
          {
-            std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
-            if (Preprocess(mResources.mLogs.Front()))
-            {
-               for (auto& consumer: mResources.mConsumers)
-                  consumer->Consume(mResources.mLogs.Front());
+            for (auto& consumer: mResources.mConsumers)
+               consumer->Consume(entry);
 
-               mResources.mDefaultConsumer->Consume(mResources.mLogs.Front());
-            }
-
-            mResources.mLogs.Pop();
+            mResources.mDefaultConsumer->Consume(entry);
          }
-
-         guard.lock();
       }
-      if (mResources.mLogging)
+
+      ReportDrops();
+
+      guard.lock();
+      // Producers only notify when this flag is set, so the ring has to be checked again after setting it.
+      mResources.mSleeping = true;
+      if (mResources.mLogging && mResources.mLogs->Empty())
          mResources.mCv.wait(guard);
+      mResources.mSleeping = false;
    }
 }
 
+void Log::ReportDrops()
+{
+   uint64_t dropped = mResources.mLogs->Dropped();
+   if (dropped == mResources.mReportedDrops)
+      return;
+
+   std::stringstream ss;
+   ss << "Dropped " << (dropped - mResources.mReportedDrops) << " log entries because the queue was full";
+   mResources.mReportedDrops = dropped;
+
+   Entry entry{ss.str(), Log::Context{nullptr, 0, nullptr, "LOG"}, Log::Kind::Warning};
+   std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
+   for (auto& consumer: mResources.mConsumers)
+      consumer->Consume(entry);
+
+   mResources.mDefaultConsumer->Consume(entry);
+}
+
 void Log::ReportFilenames(bool report)
 {
    std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
@@ -91,8 +119,7 @@ void Log::ReportFunctions(bool report)
 
 bool Log::Preprocess(Log::Entry& entry)
 {
-   if (mResources.mCategoryFilter && !regex_search(entry.context.category, *mResources.mCategoryFilter))
-      return false;
+   // The category filter has already been applied by IsEnabled.
    if (mResources.mFilenameFilter && !regex_search(entry.context.filename, *mResources.mFilenameFilter))
       return false;
    if (mResources.mErrorStringFilter && !regex_search(entry.message, *mResources.mErrorStringFilter))
@@ -110,7 +137,6 @@ void Log::KillThread()
    {
       std::unique_lock<std::mutex> guard(mResources.mCvMutex);
       mResources.mLogging = false;
-      mResources.mWork = false;
    }
    if (mResources.mLoggingThread) 
    {
@@ -125,8 +151,31 @@ void Log::KillThread()
    }
 }
 
+bool Log::IsEnabled(Log::Kind kind, CategoryCache& cache, const char* category)
+{
+   if (kind > mResources.mVerbosity)
+      return false;
+
+   uint32_t state = cache.state.load(std::memory_order_relaxed);
+   if ((state >> 1) != mResources.mFilterGeneration.load(std::memory_order_acquire))
+   {
+      std::unique_lock<std::mutex> filterGuard(mResources.mCategoryFilterMutex);
+      bool enabled = !mResources.mCategoryFilter || regex_search(category, *mResources.mCategoryFilter);
+      state = (mResources.mFilterGeneration << 1) | (enabled ? 1u : 0u);
+      cache.state.store(state, std::memory_order_relaxed);
+   }
+
+   return (state & 1u) != 0;
+}
+
 void Log::QueueLog(const std::string& message, const Log::Context& context, Log::Kind kind)
 {
+   QueueLog(message.data(), message.size(), context, kind);
+}
+
+void Log::QueueLog(const char* message, size_t length, const Log::Context& context, Log::Kind kind)
+{
+   if (!mResources.mLogging)
    {
       std::unique_lock<std::mutex> guard(mResources.mCvMutex);
       if (!mResources.mLogging && !mResources.mLoggingThread) 
@@ -136,12 +185,21 @@ void Log::QueueLog(const std::string& message, const Log::Context& context, Log:
       }
    }
 
-   mResources.mLogs.Push(Log::Entry{message, context, kind});
+   // A full ring counts the entry as dropped, and the logging thread is woken up all the same to report it.
+   mResources.mLogs->Push(message, length, context, kind);
+
+   // Pairs with the logging thread setting mSleeping before checking the ring for the last time.
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (mResources.mSleeping)
    {
       std::unique_lock<std::mutex> guard(mResources.mCvMutex);
-      mResources.mWork = true;
+      mResources.mCv.notify_all();
    }
-   mResources.mCv.notify_all();
+}
+
+uint64_t Log::GetDroppedEntries()
+{
+   return mResources.mLogs->Dropped();
 }
 
 Log::Kind Log::GetVerbosity()
@@ -157,8 +215,9 @@ void Log::SetVerbosity(Log::Kind kind)
 
 void Log::SetCategoryFilter(const std::regex& filter)
 {
-   std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
+   std::unique_lock<std::mutex> filterGuard(mResources.mCategoryFilterMutex);
    mResources.mCategoryFilter.reset(new std::regex(filter));
+   ++mResources.mFilterGeneration;
 }
 
 void Log::SetFilenameFilter(const std::regex& filter)
@@ -0,0 +1,148 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef _FASTRTPS_LOG_LOGRING_H_
+#define _FASTRTPS_LOG_LOGRING_H_
+
+#include <fastrtps/log/Log.h>
+
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Bounded ring of preformatted log records, written by any number of threads and read by the logging thread.
+ * Each slot carries a sequence number telling whether it is free for the producer claiming that position
+ * or ready for the consumer, so pushing only takes a compare-and-swap on the write position and never blocks.
+ * When the ring is full the record is dropped and counted.
+ */
+class LogRing
+{
+public:
+
+   //! @param capacity Number of records. It is rounded up to a power of two.
+   explicit LogRing(size_t capacity) :
+      mRecords(RoundUp(capacity)), mMask(mRecords.size() - 1), mWritePos(0), mReadPos(0), mDropped(0)
+   {
+      for (size_t i = 0; i < mRecords.size(); ++i)
+         mRecords[i].sequence.store(i, std::memory_order_relaxed);
+   }
+
+   /**
+    * Copies a record into the ring. Messages longer than Log::MaxMessageSize are truncated.
+    * @return False if the ring was full and the record has been dropped.
+    */
+   bool Push(const char* message, size_t length, const Log::Context& context, Log::Kind kind)
+   {
+      Record* record = nullptr;
+      size_t pos = mWritePos.load(std::memory_order_relaxed);
+
+      for (;;)
+      {
+         record = &mRecords[pos & mMask];
+         size_t sequence = record->sequence.load(std::memory_order_acquire);
+         intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+         if (diff == 0)
+         {
+            if (mWritePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+               break;
+         }
+         else if (diff < 0)
+         {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+         }
+         else
+            pos = mWritePos.load(std::memory_order_relaxed);
+      }
+
+      if (length > Log::MaxMessageSize)
+         length = Log::MaxMessageSize;
+
+      memcpy(record->message, message, length);
+      record->length = length;
+      record->context = context;
+      record->kind = kind;
+      record->sequence.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+
+   /**
+    * Takes the oldest record into an entry. Only the logging thread may call it.
+    * @return False if the ring is empty.
+    */
+   bool Pop(Log::Entry& entry)
+   {
+      Record& record = mRecords[mReadPos & mMask];
+      if (record.sequence.load(std::memory_order_acquire) != mReadPos + 1)
+         return false;
+
+      entry.message.assign(record.message, record.length);
+      entry.context = record.context;
+      entry.kind = record.kind;
+      record.sequence.store(mReadPos + mMask + 1, std::memory_order_release);
+      ++mReadPos;
+      return true;
+   }
+
+   //! Whether there are records ready for the consumer.
+   bool Empty() const
+   {
+      return mRecords[mReadPos & mMask].sequence.load(std::memory_order_seq_cst) != mReadPos + 1;
+   }
+
+   //! Number of records dropped since the ring was created.
+   uint64_t Dropped() const
+   {
+      return mDropped.load(std::memory_order_relaxed);
+   }
+
+private:
+
+   struct Record
+   {
+      Record() : sequence(0), length(0), kind(Log::Kind::Error) {}
+
+      std::atomic<size_t> sequence;
+      size_t length;
+      Log::Context context;
+      Log::Kind kind;
+      char message[Log::MaxMessageSize];
+   };
+
+   static size_t RoundUp(size_t capacity)
+   {
+      size_t size = 2;
+      while (size < capacity)
+         size <<= 1;
+      return size;
+   }
+
+   std::vector<Record> mRecords;
+   const size_t mMask;
+
+   std::atomic<size_t> mWritePos;
+   size_t mReadPos;
+   std::atomic<uint64_t> mDropped;
+};
+
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
@@ -171,6 +171,15 @@ Publisher* ParticipantImpl::createPublisher(PublisherAttributes& att,
     watt.endpoint.unicastLocatorList = att.unicastLocatorList;
     watt.endpoint.outLocatorList = att.outLocatorList;
     watt.mode = att.qos.m_publishMode.kind == eprosima::fastrtps::SYNCHRONOUS_PUBLISH_MODE ? SYNCHRONOUS_WRITER : ASYNCHRONOUS_WRITER;
+    watt.asyncPriority = att.qos.m_publishMode.priority == eprosima::fastrtps::HIGH_PRIORITY_PUBLISH_MODE ? HIGH_PRIORITY_WRITER :
+        (att.qos.m_publishMode.priority == eprosima::fastrtps::LOW_PRIORITY_PUBLISH_MODE ? LOW_PRIORITY_WRITER : NORMAL_PRIORITY_WRITER);
+    watt.interleaveFragments = att.qos.m_fragmentScheduling.kind == eprosima::fastrtps::INTERLEAVED_FRAGMENT_SCHEDULING;
+    watt.dropSlowestReader = att.qos.m_slowReader.kind == eprosima::fastrtps::DROP_SLOWEST_READER;
+    if(att.qos.m_fragmentScheduling.bytesPerReaderPerPeriod > 0)
+    {
+        watt.readerFragmentThroughput = ThroughputControllerDescriptor(att.qos.m_fragmentScheduling.bytesPerReaderPerPeriod,
+                att.qos.m_fragmentScheduling.periodMillisecs);
+    }
     watt.endpoint.properties = att.properties;
     if(att.getEntityID()>0)
     {
@@ -44,6 +44,18 @@ bool Publisher::write(void* Data, WriteParams &wparams) {
     return mp_impl->create_new_change_with_params(ALIVE, Data, wparams);
 }
 
+bool Publisher::loan_sample(void*& sample)
+{
+    logInfo(PUBLISHER,"Loaning sample");
+    return mp_impl->loan_sample(sample);
+}
+
+bool Publisher::return_loan(void* sample)
+{
+    logInfo(PUBLISHER,"Returning loaned sample");
+    return mp_impl->return_loan(sample);
+}
+
 bool Publisher::dispose(void* Data)
 {
     logInfo(PUBLISHER,"Disposing of Data");
@@ -83,4 +95,9 @@ const GUID_t& Publisher::getGuid()
 PublisherAttributes Publisher::getAttributes() const
 {
     return mp_impl->getAttributes();
-}
\ No newline at end of file
+}
+
+EndpointStatistics Publisher::get_statistics() const
+{
+    return mp_impl->get_statistics();
+}
@@ -98,7 +98,7 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
     //HISTORY WITH KEY
     else if(mp_pubImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
     {
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if(find_Key(change,&vit))
         {
             logInfo(RTPS_HISTORY,"Found key: "<< vit->first);
@@ -131,14 +131,20 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
 
             if(add)
             {
+                // Listed in its instance before the writer sees it, because the writer may remove it
+                // as soon as it is acknowledged.
+                vit->second.push_back(change);
                 if(this->add_change(change))
                 {
                     logInfo(RTPS_HISTORY,this->mp_pubImpl->getGuid().entityId <<" Change "
                             << change->sequenceNumber << " added with key: "<<change->instanceHandle
                             << " and "<<change->serializedPayload.length<< " bytes");
-                    vit->second.push_back(change);
                     returnedValue =  true;
                 }
+                else
+                {
+                    vit->second.pop_back();
+                }
             }
         }
     }
@@ -154,46 +160,37 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
     return returnedValue;
 }
 
-bool PublisherHistory::find_Key(CacheChange_t* a_change,t_v_Inst_Caches::iterator* vit_out)
+bool PublisherHistory::find_Key(CacheChange_t* a_change, t_m_Inst_Caches::iterator* vit_out)
 {
-    t_v_Inst_Caches::iterator vit;
-    bool found = false;
-    for(vit= m_keyedChanges.begin();vit!=m_keyedChanges.end();++vit)
+    t_m_Inst_Caches::iterator vit = m_keyedChanges.find(a_change->instanceHandle);
+    if(vit != m_keyedChanges.end())
     {
-        if(a_change->instanceHandle == vit->first)
-        {
-            *vit_out = vit;
-            return true;
-        }
+        *vit_out = vit;
+        return true;
     }
-    if(!found)
+
+    if((int)m_keyedChanges.size() >= m_resourceLimitsQos.max_instances)
     {
-        if((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
-        {
-            t_p_I_Change newpair;
-            newpair.first = a_change->instanceHandle;
-            m_keyedChanges.push_back(newpair);
-            *vit_out = m_keyedChanges.end()-1;
-            return true;
-        }
-        else
+        // Only reached with all the instances in use, so the scan does not happen on every sample.
+        for(vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
         {
-            for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+            if(vit->second.empty())
             {
-                if (vit->second.size() == 0)
-                {
-                    m_keyedChanges.erase(vit);
-                    t_p_I_Change newpair;
-                    newpair.first = a_change->instanceHandle;
-                    m_keyedChanges.push_back(newpair);
-                    *vit_out = m_keyedChanges.end() - 1;
-                    return true;
-                }
+                break;
             }
-            logWarning(SUBSCRIBER, "History has reached the maximum number of instances" << endl;)
         }
+
+        if(vit == m_keyedChanges.end())
+        {
+            logWarning(RTPS_HISTORY, "History has reached the maximum number of instances");
+            return false;
+        }
+
+        m_keyedChanges.erase(vit);
     }
-    return false;
+
+    *vit_out = m_keyedChanges.emplace(a_change->instanceHandle, t_Inst_Changes()).first;
+    return true;
 }
 
 
@@ -232,7 +229,7 @@ bool PublisherHistory::removeMinChange()
     return false;
 }
 
-bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_v_Inst_Caches::iterator* vit_in)
+bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_m_Inst_Caches::iterator* vit_in)
 {
 
     if(mp_writer == nullptr || mp_mutex == nullptr)
@@ -254,14 +251,10 @@ bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_v_Inst_Caches::
     }
     else
     {
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if(vit_in!=nullptr)
             vit = *vit_in;
-        else if(this->find_Key(change,&vit))
-        {
-
-        }
-        else
+        else if((vit = m_keyedChanges.find(change->instanceHandle)) == m_keyedChanges.end())
             return false;
         for(auto chit = vit->second.begin();
                 chit!= vit->second.end();++chit)
@@ -69,6 +69,17 @@ PublisherImpl::~PublisherImpl()
         logInfo(PUBLISHER, this->getGuid().entityId << " in topic: " << this->m_att.topic.topicName);
     }
 
+    // Loans never written nor returned go back to the pool of the history.
+    if(mp_writer != nullptr)
+    {
+        std::unique_lock<std::recursive_mutex> lock(*mp_writer->getMutex());
+        for(CacheChange_t* ch : loaned_changes_)
+        {
+            m_history.release_Cache(ch);
+        }
+        loaned_changes_.clear();
+    }
+
     RTPSDomain::removeRTPSWriter(mp_writer);
     delete(this->mp_userPublisher);
 }
@@ -109,10 +120,22 @@ bool PublisherImpl::create_new_change_with_params(ChangeKind_t changeKind, void*
     // Block lowlevel writer
     std::unique_lock<std::recursive_mutex> lock(*mp_writer->getMutex());
 
-    CacheChange_t* ch = mp_writer->new_change(mp_type->getSerializedSizeProvider(data), changeKind, handle);
+    // A loaned sample is already stored in the payload of its change.
+    CacheChange_t* ch = changeKind == ALIVE ? remove_loan(data) : nullptr;
+    bool loaned = ch != nullptr;
+
+    if(loaned)
+    {
+        ch->instanceHandle = handle;
+    }
+    else
+    {
+        ch = mp_writer->new_change(mp_type->getSerializedSizeProvider(data), changeKind, handle);
+    }
+
     if(ch != nullptr)
     {
-        if(changeKind == ALIVE)
+        if(changeKind == ALIVE && !loaned)
         {
             //If these two checks are correct, we asume the cachechange is valid and thwn we can write to it.
             if(!mp_type->serialize(data, &ch->serializedPayload))
@@ -184,6 +207,69 @@ bool PublisherImpl::create_new_change_with_params(ChangeKind_t changeKind, void*
     return false;
 }
 
+bool PublisherImpl::loan_sample(void*& sample)
+{
+    if(!mp_type->is_plain())
+    {
+        logError(PUBLISHER, "Type " << mp_type->getName() << " is not plain, its samples cannot be loaned");
+        return false;
+    }
+
+    std::unique_lock<std::recursive_mutex> lock(*mp_writer->getMutex());
+
+    CacheChange_t* ch = nullptr;
+    if(!m_history.reserve_Cache(&ch, mp_type->m_typeSize))
+    {
+        logWarning(PUBLISHER, "Problem reserving Cache from the History to loan a sample");
+        return false;
+    }
+
+    ch->kind = ALIVE;
+    ch->writerGUID = mp_writer->getGuid();
+
+    // Encapsulation as written by the serialization of plain types, in the endianness of this host.
+    SerializedPayload_t& payload = ch->serializedPayload;
+    payload.encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+    payload.data[0] = 0;
+    payload.data[1] = static_cast<octet>(payload.encapsulation);
+    payload.data[2] = 0;
+    payload.data[3] = 0;
+    payload.length = mp_type->m_typeSize;
+
+    loaned_changes_.push_back(ch);
+    sample = payload.data + 4;
+    return true;
+}
+
+bool PublisherImpl::return_loan(void* sample)
+{
+    std::unique_lock<std::recursive_mutex> lock(*mp_writer->getMutex());
+
+    CacheChange_t* ch = remove_loan(sample);
+    if(ch == nullptr)
+    {
+        logWarning(PUBLISHER, "Returned sample was not loaned by this publisher");
+        return false;
+    }
+
+    m_history.release_Cache(ch);
+    return true;
+}
+
+CacheChange_t* PublisherImpl::remove_loan(void* sample)
+{
+    for(auto it = loaned_changes_.begin(); it != loaned_changes_.end(); ++it)
+    {
+        if((*it)->serializedPayload.data + 4 == sample)
+        {
+            CacheChange_t* ch = *it;
+            loaned_changes_.erase(it);
+            return ch;
+        }
+    }
+
+    return nullptr;
+}
 
 bool PublisherImpl::removeMinSeqChange()
 {
@@ -199,6 +285,11 @@ const GUID_t& PublisherImpl::getGuid()
 {
     return mp_writer->getGuid();
 }
+
+EndpointStatistics PublisherImpl::get_statistics() const
+{
+    return mp_writer->get_statistics();
+}
 //
 bool PublisherImpl::updateAttributes(PublisherAttributes& att)
 {
@@ -24,6 +24,7 @@
 
 #include <fastrtps/rtps/common/Locator.h>
 #include <fastrtps/rtps/common/Guid.h>
+#include <fastrtps/rtps/common/Statistics.h>
 
 #include <fastrtps/attributes/PublisherAttributes.h>
 
@@ -82,6 +83,21 @@ class PublisherImpl
      */
     bool create_new_change_with_params(rtps::ChangeKind_t kind, void* Data, rtps::WriteParams &wparams);
 
+    /**
+     * Reserves a change to hold a sample of a plain type, which is loaned to the user until it is
+     * written or returned.
+     * @param[out] sample Pointer to the sample, inside the payload of the change.
+     * @return True if correct.
+     */
+    bool loan_sample(void*& sample);
+
+    /**
+     * Releases the change of a loaned sample that is not going to be written.
+     * @param sample Pointer to the loaned sample.
+     * @return True if the sample was loaned.
+     */
+    bool return_loan(void* sample);
+
     /**
      * Removes the cache change with the minimum sequence number
      * @return True if correct.
@@ -113,6 +129,12 @@ class PublisherImpl
      */
     inline const PublisherAttributes& getAttributes(){ return m_att; };
 
+    /**
+     * Get the statistics of the RTPSWriter.
+     * @return Snapshot of the statistics of the writer
+     */
+    rtps::EndpointStatistics get_statistics() const;
+
     /**
      * Get topic data type
      * @return Topic data type
@@ -151,6 +173,16 @@ class PublisherImpl
 	rtps::RTPSParticipant* mp_rtpsParticipant;
 
     uint32_t high_mark_for_frag_;
+
+    //! Changes holding the loaned samples. Protected by the mutex of the writer.
+    std::vector<rtps::CacheChange_t*> loaned_changes_;
+
+    /**
+     * Stops tracking the change of a loaned sample.
+     * @param sample Pointer to the sample.
+     * @return The change holding the sample, or nullptr if it was not loaned.
+     */
+    rtps::CacheChange_t* remove_loan(void* sample);
 };
 
 
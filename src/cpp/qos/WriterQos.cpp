@@ -158,6 +158,11 @@ bool WriterQos::checkQos() const
             return false;
         }
     }
+    if(m_fragmentScheduling.bytesPerReaderPerPeriod > 0 && m_fragmentScheduling.periodMillisecs == 0)
+    {
+        logError(RTPS_QOS_CHECK,"WRITERQOS: Fragment pacing needs a period greater than zero.");
+        return false;
+    }
     return true;
 }
 
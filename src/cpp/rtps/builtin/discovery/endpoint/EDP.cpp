@@ -40,6 +40,7 @@
 #include <fastrtps/log/Log.h>
 
 #include <mutex>
+#include <algorithm>
 
 using namespace eprosima::fastrtps;
 
@@ -259,53 +260,7 @@ bool EDP::validMatching(const WriterProxyData* wdata, const ReaderProxyData* rda
         return false;
     }
     //Partition check:
-    bool matched = false;
-    if(wdata->m_qos.m_partition.names.empty() && rdata->m_qos.m_partition.names.empty())
-    {
-        matched = true;
-    }
-    else if(wdata->m_qos.m_partition.names.empty() && rdata->m_qos.m_partition.names.size()>0)
-    {
-        for(std::vector<std::string>::const_iterator rnameit = rdata->m_qos.m_partition.names.begin();
-                rnameit!=rdata->m_qos.m_partition.names.end();++rnameit)
-        {
-            if(rnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else if(wdata->m_qos.m_partition.names.size()>0 && rdata->m_qos.m_partition.names.empty() )
-    {
-        for(std::vector<std::string>::const_iterator wnameit = wdata->m_qos.m_partition.names.begin();
-                wnameit !=  wdata->m_qos.m_partition.names.end();++wnameit)
-        {
-            if(wnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else
-    {
-        for(std::vector<std::string>::const_iterator wnameit = wdata->m_qos.m_partition.names.begin();
-                wnameit !=  wdata->m_qos.m_partition.names.end();++wnameit)
-        {
-            for(std::vector<std::string>::const_iterator rnameit = rdata->m_qos.m_partition.names.begin();
-                    rnameit!=rdata->m_qos.m_partition.names.end();++rnameit)
-            {
-                if(StringMatching::matchString(wnameit->c_str(),rnameit->c_str()))
-                {
-                    matched = true;
-                    break;
-                }
-            }
-            if(matched)
-                break;
-        }
-    }
+    bool matched = validPartitions(wdata->m_qos.m_partition, rdata->m_qos.m_partition);
     if(!matched) //Different partitions
         logWarning(RTPS_EDP,"INCOMPATIBLE QOS (topic: "<< rdata->topicName() <<"): Different Partitions");
     return matched;
@@ -347,58 +302,43 @@ bool EDP::validMatching(const ReaderProxyData* rdata, const WriterProxyData* wda
         return false;
     }
     //Partition check:
-    bool matched = false;
-    if(rdata->m_qos.m_partition.names.empty() && wdata->m_qos.m_partition.names.empty())
-    {
-        matched = true;
-    }
-    else if(rdata->m_qos.m_partition.names.empty() && wdata->m_qos.m_partition.names.size()>0)
-    {
-        for(std::vector<std::string>::const_iterator rnameit = wdata->m_qos.m_partition.names.begin();
-                rnameit!=wdata->m_qos.m_partition.names.end();++rnameit)
-        {
-            if(rnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else if(rdata->m_qos.m_partition.names.size()>0 && wdata->m_qos.m_partition.names.empty() )
-    {
-        for(std::vector<std::string>::const_iterator wnameit = rdata->m_qos.m_partition.names.begin();
-                wnameit !=  rdata->m_qos.m_partition.names.end();++wnameit)
-        {
-            if(wnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else
+    bool matched = validPartitions(wdata->m_qos.m_partition, rdata->m_qos.m_partition);
+    if(!matched) //Different partitions
+        logWarning(RTPS_EDP, "INCOMPATIBLE QOS (topic: " <<  wdata->topicName() << "): Different Partitions");
+
+    return matched;
+
+}
+
+bool EDP::validPartitions(const PartitionQosPolicy& wpartition, const PartitionQosPolicy& rpartition)
+{
+    const std::vector<std::string>& wnames = wpartition.names;
+    const std::vector<std::string>& rnames = rpartition.names;
+
+    // An empty list stands for the default partition, whose name is the empty string.
+    if(wnames.empty() && rnames.empty())
+        return true;
+    if(wnames.empty())
+        return std::find(rnames.begin(), rnames.end(), std::string()) != rnames.end();
+    if(rnames.empty())
+        return std::find(wnames.begin(), wnames.end(), std::string()) != wnames.end();
+
+    for(const std::string& wname : wnames)
     {
-        for(std::vector<std::string>::const_iterator wnameit = rdata->m_qos.m_partition.names.begin();
-                wnameit !=  rdata->m_qos.m_partition.names.end();++wnameit)
+        bool wpattern = StringMatching::hasWildcards(wname.c_str());
+        for(const std::string& rname : rnames)
         {
-            for(std::vector<std::string>::const_iterator rnameit = wdata->m_qos.m_partition.names.begin();
-                    rnameit!=wdata->m_qos.m_partition.names.end();++rnameit)
+            if(!wpattern && !StringMatching::hasWildcards(rname.c_str()))
             {
-                if(StringMatching::matchString(wnameit->c_str(),rnameit->c_str()))
-                {
-                    matched = true;
-                    break;
-                }
+                if(wname == rname)
+                    return true;
             }
-            if(matched)
-                break;
+            else if(StringMatching::matchString(wname.c_str(), rname.c_str()))
+                return true;
         }
     }
-    if(!matched) //Different partitions
-        logWarning(RTPS_EDP, "INCOMPATIBLE QOS (topic: " <<  wdata->topicName() << "): Different Partitions");
-
-    return matched;
 
+    return false;
 }
 
 //TODO Estas cuatro funciones comparten codigo comun (2 a 2) y se podrían seguramente combinar.
@@ -410,55 +350,52 @@ bool EDP::pairingReader(RTPSReader* R, const ParticipantProxyData& pdata, const
     logInfo(RTPS_EDP, rdata.guid() <<" in topic: \"" << rdata.topicName() <<"\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
 
-    for(std::vector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-            pit!=mp_PDP->ParticipantProxiesEnd(); ++pit)
+    // Only the writers on the same topic can match.
+    std::vector<DiscoveredEndpoint<WriterProxyData>> candidates = mp_PDP->getWritersInTopic(rdata.topicName());
+    for(const DiscoveredEndpoint<WriterProxyData>& candidate : candidates)
     {
-        for(std::vector<WriterProxyData*>::iterator wdatait = (*pit)->m_writers.begin();
-                wdatait != (*pit)->m_writers.end(); ++wdatait)
-        {
-            bool valid = validMatching(&rdata, *wdatait);
+        bool valid = validMatching(&rdata, candidate.data);
 
-            if(valid)
-            {
+        if(valid)
+        {
 #if HAVE_SECURITY
-                if(!mp_RTPSParticipant->security_manager().discovered_writer(R->m_guid, (*pit)->m_guid,
-                            **wdatait, R->getAttributes()->security_attributes()))
-                {
-                    logError(RTPS_EDP, "Security manager returns an error for reader " << R->getGuid());
-                }
+            if(!mp_RTPSParticipant->security_manager().discovered_writer(R->m_guid, candidate.participant->m_guid,
+                        *candidate.data, R->getAttributes()->security_attributes()))
+            {
+                logError(RTPS_EDP, "Security manager returns an error for reader " << R->getGuid());
+            }
 #else
-                if(R->matched_writer_add((*wdatait)->toRemoteWriterAttributes()))
+            if(R->matched_writer_add(candidate.data->toRemoteWriterAttributes()))
+            {
+                logInfo(RTPS_EDP, "Valid Matching to writerProxy: " << candidate.data->guid());
+                //MATCHED AND ADDED CORRECTLY:
+                if(R->getListener()!=nullptr)
                 {
-                    logInfo(RTPS_EDP, "Valid Matching to writerProxy: " << (*wdatait)->guid());
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(R->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = MATCHED_MATCHING;
-                        info.remoteEndpointGuid = (*wdatait)->guid();
-                        R->getListener()->onReaderMatched(R,info);
-                    }
+                    MatchingInfo info;
+                    info.status = MATCHED_MATCHING;
+                    info.remoteEndpointGuid = candidate.data->guid();
+                    R->getListener()->onReaderMatched(R,info);
                 }
-#endif
             }
-            else
+#endif
+        }
+        else
+        {
+            //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
+            if(R->matched_writer_is_matched(candidate.data->toRemoteWriterAttributes())
+                    && R->matched_writer_remove(candidate.data->toRemoteWriterAttributes()))
             {
-                //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
-                if(R->matched_writer_is_matched((*wdatait)->toRemoteWriterAttributes())
-                        && R->matched_writer_remove((*wdatait)->toRemoteWriterAttributes()))
-                {
 #if HAVE_SECURITY
-                    mp_RTPSParticipant->security_manager().remove_writer(R->getGuid(), pdata.m_guid, (*wdatait)->guid());
+                mp_RTPSParticipant->security_manager().remove_writer(R->getGuid(), pdata.m_guid, candidate.data->guid());
 #endif
 
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(R->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = REMOVED_MATCHING;
-                        info.remoteEndpointGuid = (*wdatait)->guid();
-                        R->getListener()->onReaderMatched(R,info);
-                    }
+                //MATCHED AND ADDED CORRECTLY:
+                if(R->getListener()!=nullptr)
+                {
+                    MatchingInfo info;
+                    info.status = REMOVED_MATCHING;
+                    info.remoteEndpointGuid = candidate.data->guid();
+                    R->getListener()->onReaderMatched(R,info);
                 }
             }
         }
@@ -474,54 +411,51 @@ bool EDP::pairingWriter(RTPSWriter* W, const ParticipantProxyData& pdata, const
     logInfo(RTPS_EDP, W->getGuid() << " in topic: \"" << wdata.topicName() <<"\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
 
-    for(std::vector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-            pit!=mp_PDP->ParticipantProxiesEnd(); ++pit)
+    // Only the readers on the same topic can match.
+    std::vector<DiscoveredEndpoint<ReaderProxyData>> candidates = mp_PDP->getReadersInTopic(wdata.topicName());
+    for(const DiscoveredEndpoint<ReaderProxyData>& candidate : candidates)
     {
-        for(std::vector<ReaderProxyData*>::iterator rdatait = (*pit)->m_readers.begin();
-                rdatait!=(*pit)->m_readers.end(); ++rdatait)
-        {
-            bool valid = validMatching(&wdata, *rdatait);
+        bool valid = validMatching(&wdata, candidate.data);
 
-            if(valid)
-            {
+        if(valid)
+        {
 #if HAVE_SECURITY
-                if(!mp_RTPSParticipant->security_manager().discovered_reader(W->getGuid(), (*pit)->m_guid,
-                            **rdatait, W->getAttributes()->security_attributes()))
-                {
-                    logError(RTPS_EDP, "Security manager returns an error for writer " << W->getGuid());
-                }
+            if(!mp_RTPSParticipant->security_manager().discovered_reader(W->getGuid(), candidate.participant->m_guid,
+                        *candidate.data, W->getAttributes()->security_attributes()))
+            {
+                logError(RTPS_EDP, "Security manager returns an error for writer " << W->getGuid());
+            }
 #else
-                if(W->matched_reader_add((*rdatait)->toRemoteReaderAttributes()))
+            if(W->matched_reader_add(candidate.data->toRemoteReaderAttributes()))
+            {
+                logInfo(RTPS_EDP,"Valid Matching to readerProxy: " << candidate.data->guid());
+                //MATCHED AND ADDED CORRECTLY:
+                if(W->getListener()!=nullptr)
                 {
-                    logInfo(RTPS_EDP,"Valid Matching to readerProxy: " << (*rdatait)->guid());
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(W->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = MATCHED_MATCHING;
-                        info.remoteEndpointGuid = (*rdatait)->guid();
-                        W->getListener()->onWriterMatched(W,info);
-                    }
+                    MatchingInfo info;
+                    info.status = MATCHED_MATCHING;
+                    info.remoteEndpointGuid = candidate.data->guid();
+                    W->getListener()->onWriterMatched(W,info);
                 }
-#endif
             }
-            else
+#endif
+        }
+        else
+        {
+            //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
+            if(W->matched_reader_is_matched(candidate.data->toRemoteReaderAttributes()) &&
+                    W->matched_reader_remove(candidate.data->toRemoteReaderAttributes()))
             {
-                //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
-                if(W->matched_reader_is_matched((*rdatait)->toRemoteReaderAttributes()) &&
-                        W->matched_reader_remove((*rdatait)->toRemoteReaderAttributes()))
-                {
 #if HAVE_SECURITY
-                    mp_RTPSParticipant->security_manager().remove_reader(W->getGuid(), pdata.m_guid, (*rdatait)->guid());
+                mp_RTPSParticipant->security_manager().remove_reader(W->getGuid(), pdata.m_guid, candidate.data->guid());
 #endif
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(W->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = REMOVED_MATCHING;
-                        info.remoteEndpointGuid = (*rdatait)->guid();
-                        W->getListener()->onWriterMatched(W,info);
-                    }
+                //MATCHED AND ADDED CORRECTLY:
+                if(W->getListener()!=nullptr)
+                {
+                    MatchingInfo info;
+                    info.status = REMOVED_MATCHING;
+                    info.remoteEndpointGuid = candidate.data->guid();
+                    W->getListener()->onWriterMatched(W,info);
                 }
             }
         }
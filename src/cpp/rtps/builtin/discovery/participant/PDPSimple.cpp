@@ -52,6 +52,7 @@
 #include <fastrtps/log/Log.h>
 
 #include <mutex>
+#include <algorithm>
 
 using namespace eprosima::fastrtps;
 
@@ -197,8 +198,9 @@ bool PDPSimple::initPDP(RTPSParticipantImpl* part)
         return false;
     //UPDATE METATRAFFIC.
     mp_builtin->updateMetatrafficLocators(this->mp_SPDPReader->getAttributes()->unicastLocatorList);
-    m_participantProxies.push_back(new ParticipantProxyData());
-    initializeParticipantProxyData(m_participantProxies.front());
+    ParticipantProxyData* local_data = new ParticipantProxyData();
+    initializeParticipantProxyData(local_data);
+    addParticipantProxy(local_data);
 
     //INIT EDP
     if(m_discovery.use_STATIC_EndpointDiscoveryProtocol)
@@ -340,41 +342,25 @@ void PDPSimple::announceParticipantState(bool new_change, bool dispose)
 bool PDPSimple::lookupReaderProxyData(const GUID_t& reader, ReaderProxyData& rdata, ParticipantProxyData& pdata)
 {
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end();++pit)
-    {
-        for (auto rit = (*pit)->m_readers.begin();
-                rit != (*pit)->m_readers.end();++rit)
-        {
-            if((*rit)->guid() == reader)
-            {
-                rdata.copy(*rit);
-                pdata.copy(**pit);
-                return true;
-            }
-        }
-    }
-    return false;
+    const DiscoveredEndpoint<ReaderProxyData>* endpoint = m_readerIndex.find(reader);
+    if(endpoint == nullptr)
+        return false;
+
+    rdata.copy(endpoint->data);
+    pdata.copy(*endpoint->participant);
+    return true;
 }
 
 bool PDPSimple::lookupWriterProxyData(const GUID_t& writer, WriterProxyData& wdata, ParticipantProxyData& pdata)
 {
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end(); ++pit)
-    {
-        for (auto wit = (*pit)->m_writers.begin();
-                wit != (*pit)->m_writers.end(); ++wit)
-        {
-            if((*wit)->guid() == writer)
-            {
-                wdata.copy(*wit);
-                pdata.copy(**pit);
-                return true;
-            }
-        }
-    }
-    return false;
+    const DiscoveredEndpoint<WriterProxyData>* endpoint = m_writerIndex.find(writer);
+    if(endpoint == nullptr)
+        return false;
+
+    wdata.copy(endpoint->data);
+    pdata.copy(*endpoint->participant);
+    return true;
 }
 
 bool PDPSimple::removeReaderProxyData(const GUID_t& reader_guid)
@@ -382,23 +368,17 @@ bool PDPSimple::removeReaderProxyData(const GUID_t& reader_guid)
     logInfo(RTPS_PDP, "Removing reader proxy data " << reader_guid);
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end(); ++pit)
-    {
-        for (auto rit = (*pit)->m_readers.begin();
-                rit != (*pit)->m_readers.end(); ++rit)
-        {
-            if((*rit)->guid() == reader_guid)
-            {
-                mp_EDP->unpairReaderProxy((*pit)->m_guid, reader_guid);
-                delete *rit;
-                (*pit)->m_readers.erase(rit);
-                return true;
-            }
-        }
-    }
+    DiscoveredEndpoint<ReaderProxyData> endpoint;
+    if(!m_readerIndex.remove(reader_guid, endpoint))
+        return false;
 
-    return false;
+    ParticipantProxyData* participant = endpoint.participant;
+    ReaderProxyData* rdata = endpoint.data;
+
+    mp_EDP->unpairReaderProxy(participant->m_guid, reader_guid);
+    participant->m_readers.erase(std::find(participant->m_readers.begin(), participant->m_readers.end(), rdata));
+    delete rdata;
+    return true;
 }
 
 bool PDPSimple::removeWriterProxyData(const GUID_t& writer_guid)
@@ -406,23 +386,50 @@ bool PDPSimple::removeWriterProxyData(const GUID_t& writer_guid)
     logInfo(RTPS_PDP, "Removing writer proxy data " << writer_guid);
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end(); ++pit)
-    {
-        for (auto wit = (*pit)->m_writers.begin();
-                wit != (*pit)->m_writers.end(); ++wit)
-        {
-            if((*wit)->guid() == writer_guid)
-            {
-                mp_EDP->unpairWriterProxy((*pit)->m_guid, writer_guid);
-                delete *wit;
-                (*pit)->m_writers.erase(wit);
-                return true;
-            }
-        }
-    }
+    DiscoveredEndpoint<WriterProxyData> endpoint;
+    if(!m_writerIndex.remove(writer_guid, endpoint))
+        return false;
 
-    return false;
+    ParticipantProxyData* participant = endpoint.participant;
+    WriterProxyData* wdata = endpoint.data;
+
+    mp_EDP->unpairWriterProxy(participant->m_guid, writer_guid);
+    participant->m_writers.erase(std::find(participant->m_writers.begin(), participant->m_writers.end(), wdata));
+    delete wdata;
+    return true;
+}
+
+std::vector<DiscoveredEndpoint<ReaderProxyData>> PDPSimple::getReadersInTopic(const std::string& topic_name) const
+{
+    std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
+    return m_readerIndex.in_topic(topic_name);
+}
+
+std::vector<DiscoveredEndpoint<WriterProxyData>> PDPSimple::getWritersInTopic(const std::string& topic_name) const
+{
+    std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
+    return m_writerIndex.in_topic(topic_name);
+}
+
+void PDPSimple::addParticipantProxy(ParticipantProxyData* pdata)
+{
+    m_participantProxies.push_back(pdata);
+    m_participantsByPrefix[pdata->m_guid.guidPrefix] = pdata;
+}
+
+void PDPSimple::unindexParticipantProxy(ParticipantProxyData* pdata)
+{
+    auto pit = m_participantsByPrefix.find(pdata->m_guid.guidPrefix);
+    if(pit != m_participantsByPrefix.end() && pit->second == pdata)
+        m_participantsByPrefix.erase(pit);
+
+    DiscoveredEndpoint<ReaderProxyData> reader;
+    for(ReaderProxyData* rdata : pdata->m_readers)
+        m_readerIndex.remove(rdata->guid(), reader);
+
+    DiscoveredEndpoint<WriterProxyData> writer;
+    for(WriterProxyData* wdata : pdata->m_writers)
+        m_writerIndex.remove(wdata->guid(), writer);
 }
 
 
@@ -518,41 +525,36 @@ bool PDPSimple::addReaderProxyData(ReaderProxyData* rdata, ParticipantProxyData&
 
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
-    {
-        if((*pit)->m_guid.guidPrefix == rdata->guid().guidPrefix)
-        {
-            // Set locators information if not defined by ReaderProxyData.
-            if(rdata->unicastLocatorList().empty() && rdata->multicastLocatorList().empty())
-            {
-                rdata->unicastLocatorList((*pit)->m_defaultUnicastLocatorList);
-                rdata->multicastLocatorList((*pit)->m_defaultMulticastLocatorList);
-            }
-            // Set as alive.
-            rdata->isAlive(true);
+    auto pit = m_participantsByPrefix.find(rdata->guid().guidPrefix);
+    if(pit == m_participantsByPrefix.end())
+        return false;
 
-            // Copy participant data to be used outside.
-            pdata.copy(**pit);
+    ParticipantProxyData* participant = pit->second;
 
-            // Check that it is not already there:
-            for(std::vector<ReaderProxyData*>::iterator rit = (*pit)->m_readers.begin();
-                    rit!=(*pit)->m_readers.end();++rit)
-            {
-                if((*rit)->guid().entityId == rdata->guid().entityId)
-                {
-                    (*rit)->update(rdata);
-                    return true;
-                }
-            }
+    // Set locators information if not defined by ReaderProxyData.
+    if(rdata->unicastLocatorList().empty() && rdata->multicastLocatorList().empty())
+    {
+        rdata->unicastLocatorList(participant->m_defaultUnicastLocatorList);
+        rdata->multicastLocatorList(participant->m_defaultMulticastLocatorList);
+    }
+    // Set as alive.
+    rdata->isAlive(true);
 
-            ReaderProxyData* newRPD = new ReaderProxyData(*rdata);
-            (*pit)->m_readers.push_back(newRPD);
-            return true;
-        }
+    // Copy participant data to be used outside.
+    pdata.copy(*participant);
+
+    // Check that it is not already there:
+    const DiscoveredEndpoint<ReaderProxyData>* endpoint = m_readerIndex.find(rdata->guid());
+    if(endpoint != nullptr)
+    {
+        endpoint->data->update(rdata);
+        return true;
     }
 
-    return false;
+    ReaderProxyData* newRPD = new ReaderProxyData(*rdata);
+    participant->m_readers.push_back(newRPD);
+    m_readerIndex.add(participant, newRPD);
+    return true;
 }
 
 bool PDPSimple::addWriterProxyData(WriterProxyData* wdata, ParticipantProxyData& pdata)
@@ -561,40 +563,36 @@ bool PDPSimple::addWriterProxyData(WriterProxyData* wdata, ParticipantProxyData&
 
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
-    {
-        if((*pit)->m_guid.guidPrefix == wdata->guid().guidPrefix)
-        {
-            // Set locators information if not defined by ReaderProxyData.
-            if(wdata->unicastLocatorList().empty() && wdata->multicastLocatorList().empty())
-            {
-                wdata->unicastLocatorList((*pit)->m_defaultUnicastLocatorList);
-                wdata->multicastLocatorList((*pit)->m_defaultMulticastLocatorList);
-            }
-            // Set as alive.
-            wdata->isAlive(true);
+    auto pit = m_participantsByPrefix.find(wdata->guid().guidPrefix);
+    if(pit == m_participantsByPrefix.end())
+        return false;
 
-            // Copy participant data to be used outside.
-            pdata.copy(**pit);
+    ParticipantProxyData* participant = pit->second;
 
-            //CHECK THAT IT IS NOT ALREADY THERE:
-            for(std::vector<WriterProxyData*>::iterator wit = (*pit)->m_writers.begin();
-                    wit!=(*pit)->m_writers.end();++wit)
-            {
-                if((*wit)->guid().entityId == wdata->guid().entityId)
-                {
-                    (*wit)->update(wdata);
-                    return true;
-                }
-            }
+    // Set locators information if not defined by ReaderProxyData.
+    if(wdata->unicastLocatorList().empty() && wdata->multicastLocatorList().empty())
+    {
+        wdata->unicastLocatorList(participant->m_defaultUnicastLocatorList);
+        wdata->multicastLocatorList(participant->m_defaultMulticastLocatorList);
+    }
+    // Set as alive.
+    wdata->isAlive(true);
 
-            WriterProxyData* newWPD = new WriterProxyData(*wdata);
-            (*pit)->m_writers.push_back(newWPD);
-            return true;
-        }
+    // Copy participant data to be used outside.
+    pdata.copy(*participant);
+
+    //CHECK THAT IT IS NOT ALREADY THERE:
+    const DiscoveredEndpoint<WriterProxyData>* endpoint = m_writerIndex.find(wdata->guid());
+    if(endpoint != nullptr)
+    {
+        endpoint->data->update(wdata);
+        return true;
     }
-    return false;
+
+    WriterProxyData* newWPD = new WriterProxyData(*wdata);
+    participant->m_writers.push_back(newWPD);
+    m_writerIndex.add(participant, newWPD);
+    return true;
 }
 
 void PDPSimple::assignRemoteEndpoints(ParticipantProxyData* pdata)
@@ -697,6 +695,7 @@ bool PDPSimple::removeRemoteParticipant(GUID_t& partGUID)
         {
             pdata = *pit;
             m_participantProxies.erase(pit);
+            unindexParticipantProxy(pdata);
             break;
         }
     }
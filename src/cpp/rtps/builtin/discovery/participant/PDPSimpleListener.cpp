@@ -109,7 +109,7 @@ void PDPSimpleListener::onNewCacheChangeAdded(RTPSReader* reader, const CacheCha
                         pdata,
                         TimeConv::Time_t2MilliSecondsDouble(pdata->m_leaseDuration));
                 pdata->mp_leaseDurationTimer->restart_timer();
-                this->mp_SPDP->m_participantProxies.push_back(pdata);
+                this->mp_SPDP->addParticipantProxy(pdata);
                 lock.unlock();
 
                 mp_SPDP->assignRemoteEndpoints(&participant_data);
@@ -41,8 +41,7 @@ namespace rtps {
 RemoteParticipantLeaseDuration::RemoteParticipantLeaseDuration(PDPSimple* p_SPDP,
         ParticipantProxyData* pdata,
         double interval):
-    TimedEvent(p_SPDP->getRTPSParticipant()->getEventResource().getIOService(),
-            p_SPDP->getRTPSParticipant()->getEventResource().getThread(), interval, TimedEvent::ON_SUCCESS),
+    TimedEvent(p_SPDP->getRTPSParticipant()->getEventResource(), interval, TimedEvent::ON_SUCCESS),
     mp_PDP(p_SPDP),
     mp_participantProxyData(pdata)
     {
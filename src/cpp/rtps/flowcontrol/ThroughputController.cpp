@@ -45,9 +45,9 @@ void ThroughputController::operator()(RTPSWriterCollector<ReaderLocator*>& chang
 {
     std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
 
-    auto it = changesToSend.items().begin();
+    auto it = changesToSend.begin();
 
-    while(it != changesToSend.items().end())
+    while(it != changesToSend.end())
     {
         if(!process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber))
             break;
@@ -55,16 +55,16 @@ void ThroughputController::operator()(RTPSWriterCollector<ReaderLocator*>& chang
         ++it;
     }
 
-    changesToSend.items().erase(it, changesToSend.items().end());
+    changesToSend.erase(it, changesToSend.end());
 }
 
 void ThroughputController::operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend)
 {
     std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
 
-    auto it = changesToSend.items().begin();
+    auto it = changesToSend.begin();
 
-    while(it != changesToSend.items().end())
+    while(it != changesToSend.end())
     {
         if(!process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber))
             break;
@@ -72,7 +72,7 @@ void ThroughputController::operator()(RTPSWriterCollector<ReaderProxy*>& changes
         ++it;
     }
 
-    changesToSend.items().erase(it, changesToSend.items().end());
+    changesToSend.erase(it, changesToSend.end());
 }
 
 bool ThroughputController::process_change_nts_(CacheChange_t* change, const SequenceNumber_t& /*seqNum*/,
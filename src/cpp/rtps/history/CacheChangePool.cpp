@@ -22,6 +22,7 @@
 #include <fastrtps/log/Log.h>
 
 #include <mutex>
+#include <cmath>
 
 #include <cassert>
 
@@ -30,27 +31,65 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+/*!
+ * Locates a position of the table of preallocated changes.
+ * @param index Position in the table.
+ * @param[out] offset Position inside the returned segment.
+ * @return Segment holding the position. Segment i starts at position 2^i - 1.
+ */
+static inline uint32_t segment_of(uint32_t index, uint32_t& offset)
+{
+    uint64_t n = static_cast<uint64_t>(index) + 1;
+    uint32_t segment = 0;
+    while((n >> (segment + 1)) != 0)
+    {
+        ++segment;
+    }
+    offset = static_cast<uint32_t>(n - (static_cast<uint64_t>(1) << segment));
+    return segment;
+}
 
 CacheChangePool::~CacheChangePool()
 {
     logInfo(RTPS_UTILS,"ChangePool destructor");
-    //Deletion process does not depend on the memory management policy
-    for(std::vector<CacheChange_t*>::iterator it = m_allCaches.begin();it!=m_allCaches.end();++it)
+    //Deletion process depends on where the memory management policy keeps the changes
+    if(memoryMode == DYNAMIC_RESERVE_MEMORY_MODE)
+    {
+        for(std::vector<CacheChange_t*>::iterator it = m_allCaches.begin();it!=m_allCaches.end();++it)
+        {
+            delete(*it);
+        }
+    }
+    else
+    {
+        uint32_t pool_size = m_pool_size;
+        for(uint32_t i = 0; i < pool_size; ++i)
+        {
+            delete(get_preallocated(i));
+        }
+    }
+
+    for(uint32_t i = 0; i < c_maxSegments; ++i)
     {
-        delete(*it);
+        delete[] m_segments[i].load();
     }
     delete(mp_mutex);
 }
 
-CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy) : mp_mutex(new std::mutex()), memoryMode(memoryPolicy)
+CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy) :
+    m_pool_size(0), m_freeHead(0), m_freeCount(0), mp_mutex(new std::mutex()), memoryMode(memoryPolicy)
 {
     //Common for all modes: Set the payload size (maximum allowed), size and size limit
     ++pool_size;
     logInfo(RTPS_UTILS,"Creating CacheChangePool of size: "<< pool_size << " with payload of size: " << payload_size);
 
+    for(uint32_t i = 0; i < c_maxSegments; ++i)
+    {
+        m_segments[i].store(nullptr);
+    }
+
     m_payload_size = payload_size;
     m_initial_payload_size = payload_size;
-    m_pool_size = 0;
     if(max_pool_size > 0)
     {
         if (pool_size > max_pool_size)
@@ -76,6 +115,10 @@ CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32
         case DYNAMIC_RESERVE_MEMORY_MODE:
             logInfo(RTPS_UTILS,"Dynamic Mode is active, CacheChanges are allocated on request");
             break;
+        case PREALLOCATED_WITH_ARENA_MEMORY_MODE:
+            logInfo(RTPS_UTILS,"Arena Mode is active, preallocating pool_size elements. Payloads are recycled by size class");
+            allocateGroup(pool_size);
+            break;
     }
 }
 
@@ -97,52 +140,51 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, const std::function<ui
 
 bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
 {
-    std::lock_guard<std::mutex> guard(*this->mp_mutex);
-
-    switch(memoryMode)
+    if(memoryMode == DYNAMIC_RESERVE_MEMORY_MODE)
     {
-        case PREALLOCATED_MEMORY_MODE:
-            if(m_freeCaches.empty())
-            {
-                if (!allocateGroup((uint16_t)(ceil((float)m_pool_size / 10) + 10)))
-                {
-                    return false;
-                }
-            }
-            *chan = m_freeCaches.back();
-            m_freeCaches.erase(m_freeCaches.end()-1);
-            break;
-
-        case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
-            if(m_freeCaches.empty())
-            {
-                if (!allocateGroup((uint16_t)(ceil((float)m_pool_size / 10) + 10)))
-                {
-                    return false;
-                }
-            }
-            *chan = m_freeCaches.back();
-            m_freeCaches.erase(m_freeCaches.end()-1);
+        std::lock_guard<std::mutex> guard(*this->mp_mutex);
+        *chan = allocateSingle(dataSize); //Allocates a single, empty CacheChange. Allocated on Copy
+        return *chan != nullptr;
+    }
 
-            // TODO(Ricardo) Improve reallocation.
-            try
-            {
-                (*chan)->serializedPayload.reserve(dataSize);
-            }
-            catch(std::bad_alloc& ex)
+    // Preallocated modes only lock to grow the pool when there are no free changes.
+    *chan = pop_free();
+    if(*chan == nullptr)
+    {
+        std::lock_guard<std::mutex> guard(*this->mp_mutex);
+        // Other threads may release or allocate changes meanwhile.
+        while((*chan = pop_free()) == nullptr)
+        {
+            if (!allocateGroup((uint16_t)(ceil((float)m_pool_size / 10) + 10)))
             {
-                logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
-                delete(*chan);
-                *chan = nullptr;
                 return false;
             }
+        }
+    }
 
-            break;
-
-        case DYNAMIC_RESERVE_MEMORY_MODE:
-            *chan = allocateSingle(dataSize); //Allocates a single, empty CacheChange. Allocated on Copy
-            if(*chan == nullptr) return false;
-            break;
+    if(memoryMode == PREALLOCATED_WITH_ARENA_MEMORY_MODE)
+    {
+        if(!m_arena.acquire((*chan)->serializedPayload, dataSize))
+        {
+            push_free(*chan);
+            *chan = nullptr;
+            return false;
+        }
+    }
+    else if(memoryMode == PREALLOCATED_WITH_REALLOC_MEMORY_MODE)
+    {
+        // TODO(Ricardo) Improve reallocation.
+        try
+        {
+            (*chan)->serializedPayload.reserve(dataSize);
+        }
+        catch(std::bad_alloc& ex)
+        {
+            logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
+            push_free(*chan);
+            *chan = nullptr;
+            return false;
+        }
     }
 
     return true;
@@ -150,24 +192,14 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
 
 void CacheChangePool::release_Cache(CacheChange_t* ch)
 {
-    std::lock_guard<std::mutex> guard(*this->mp_mutex);
+    // The payload goes back to the arena before the change is reused.
+    if(memoryMode == PREALLOCATED_WITH_ARENA_MEMORY_MODE)
+        m_arena.release(ch->serializedPayload);
 
     switch(memoryMode)
     {
+        case PREALLOCATED_WITH_ARENA_MEMORY_MODE:
         case PREALLOCATED_MEMORY_MODE:
-            ch->kind = ALIVE;
-            ch->sequenceNumber.high = 0;
-            ch->sequenceNumber.low = 0;
-            ch->writerGUID = c_Guid_Unknown;
-            ch->serializedPayload.length = 0;
-            ch->serializedPayload.pos = 0;
-            for(uint8_t i=0;i<16;++i)
-                ch->instanceHandle.value[i] = 0;
-            ch->isRead = 0;
-            ch->sourceTimestamp.seconds = 0;
-            ch->sourceTimestamp.fraction = 0;
-            m_freeCaches.push_back(ch);
-            break;
         case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
             ch->kind = ALIVE;
             ch->sequenceNumber.high = 0;
@@ -180,23 +212,26 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
             ch->isRead = 0;
             ch->sourceTimestamp.seconds = 0;
             ch->sourceTimestamp.fraction = 0;
-            m_freeCaches.push_back(ch);
+            push_free(ch);
             break;
         case DYNAMIC_RESERVE_MEMORY_MODE:
-            // Find pointer in CacheChange vector, remove element, then delete it
-            std::vector<CacheChange_t*>::iterator target = m_allCaches.begin();	
-            target = find(m_allCaches.begin(),m_allCaches.end(), ch);
-            if(target != m_allCaches.end())
             {
-                m_allCaches.erase(target);
-            }else{
-                logInfo(RTPS_UTILS,"Tried to release a CacheChange that is not logged in the Pool");
-                break;
+                std::lock_guard<std::mutex> guard(*this->mp_mutex);
+
+                // Move the last change to the position of the released one, then delete it
+                uint32_t index = ch->pool_index_;
+                if(index >= m_allCaches.size() || m_allCaches[index] != ch)
+                {
+                    logInfo(RTPS_UTILS,"Tried to release a CacheChange that is not logged in the Pool");
+                    break;
+                }
+                m_allCaches[index] = m_allCaches.back();
+                m_allCaches[index]->pool_index_ = index;
+                m_allCaches.pop_back();
+                delete(ch);
+                --m_pool_size;
             }
-            delete(ch);
-            --m_pool_size;
             break;
-
     }
 }
 
@@ -223,10 +258,22 @@ bool CacheChangePool::allocateGroup(uint32_t group_size)
     }
     for(uint32_t i = 0; i < reserved; ++i)
     {
-        CacheChange_t* ch = new CacheChange_t(m_payload_size);
-        m_allCaches.push_back(ch);
-        m_freeCaches.push_back(ch);
+        uint32_t index = m_pool_size;
+        uint32_t offset = 0;
+        uint32_t segment = segment_of(index, offset);
+        CacheChange_t** changes = m_segments[segment].load(std::memory_order_relaxed);
+        if(changes == nullptr)
+        {
+            changes = new CacheChange_t*[static_cast<size_t>(1) << segment];
+            m_segments[segment].store(changes, std::memory_order_release);
+        }
+
+        // In arena mode payloads only get a buffer while the change is reserved.
+        CacheChange_t* ch = new CacheChange_t(memoryMode == PREALLOCATED_WITH_ARENA_MEMORY_MODE ? 0 : m_payload_size);
+        ch->pool_index_ = index;
+        changes[offset] = ch;
         ++m_pool_size;
+        push_free(ch);
         added = true;
     }
     if (!added)
@@ -257,6 +304,7 @@ CacheChange_t* CacheChangePool::allocateSingle(uint32_t dataSize)
     if((m_max_pool_size == 0) | (m_pool_size < m_max_pool_size)) { //If no limit or curren changes < max changes
         ++m_pool_size;
         ch = new CacheChange_t(dataSize);
+        ch->pool_index_ = static_cast<uint32_t>(m_allCaches.size());
         m_allCaches.push_back(ch);
         added = true;
     }
@@ -270,6 +318,52 @@ CacheChange_t* CacheChangePool::allocateSingle(uint32_t dataSize)
     return ch;
 }
 
+CacheChange_t* CacheChangePool::get_preallocated(uint32_t index) const
+{
+    uint32_t offset = 0;
+    uint32_t segment = segment_of(index, offset);
+    return m_segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+CacheChange_t* CacheChangePool::pop_free()
+{
+    uint64_t head = m_freeHead.load(std::memory_order_acquire);
+
+    for(;;)
+    {
+        uint32_t first = static_cast<uint32_t>(head);
+        if(first == 0)
+        {
+            return nullptr;
+        }
+
+        // The change may be taken by another thread meanwhile, but then the counter makes the exchange fail.
+        CacheChange_t* ch = get_preallocated(first - 1);
+        uint64_t next = ((head >> 32) + 1) << 32 | ch->pool_next_.load(std::memory_order_relaxed);
+        if(m_freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            --m_freeCount;
+            return ch;
+        }
+    }
+}
+
+void CacheChangePool::push_free(CacheChange_t* ch)
+{
+    uint64_t head = m_freeHead.load(std::memory_order_relaxed);
+    uint64_t next = 0;
+
+    // Counted before being visible, so that a concurrent pop never takes the count below zero.
+    ++m_freeCount;
+
+    do
+    {
+        ch->pool_next_.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        next = ((head >> 32) + 1) << 32 | (ch->pool_index_ + 1);
+    }
+    while(!m_freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
 }
 } /* namespace rtps */
 } /* namespace eprosima */
@@ -0,0 +1,149 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadArena.cpp
+ *
+ */
+
+#include <fastrtps/rtps/history/PayloadArena.h>
+#include <fastrtps/rtps/common/SerializedPayload.h>
+#include <fastrtps/log/Log.h>
+
+#include <cstdlib>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+const uint32_t PayloadArena::c_minClassSize;
+const uint32_t PayloadArena::c_numClasses;
+
+PayloadArena::PayloadArena()
+{
+}
+
+PayloadArena::~PayloadArena()
+{
+    for(uint32_t i = 0; i < c_numClasses; ++i)
+    {
+        for(octet* buffer : m_classes[i].buffers)
+        {
+            free(buffer);
+        }
+    }
+}
+
+uint32_t PayloadArena::class_to_hold(uint32_t size)
+{
+    uint32_t size_class = 0;
+    while(size_class + 1 < c_numClasses && (static_cast<uint64_t>(c_minClassSize) << size_class) < size)
+    {
+        ++size_class;
+    }
+    return size_class;
+}
+
+uint32_t PayloadArena::class_within(uint32_t capacity)
+{
+    uint32_t size_class = 0;
+    while(size_class + 1 < c_numClasses && (static_cast<uint64_t>(c_minClassSize) << (size_class + 1)) <= capacity)
+    {
+        ++size_class;
+    }
+    return size_class;
+}
+
+bool PayloadArena::acquire(SerializedPayload_t& payload, uint32_t size)
+{
+    if(size > (c_minClassSize << (c_numClasses - 1)))
+    {
+        logError(RTPS_HISTORY, "Payload of " << size << " bytes is bigger than the biggest size class");
+        return false;
+    }
+
+    if(payload.data != nullptr)
+    {
+        release(payload);
+    }
+
+    uint32_t size_class = class_to_hold(size);
+    octet* buffer = nullptr;
+
+    {
+        std::lock_guard<std::mutex> guard(m_classes[size_class].mutex);
+        if(!m_classes[size_class].buffers.empty())
+        {
+            buffer = m_classes[size_class].buffers.back();
+            m_classes[size_class].buffers.pop_back();
+        }
+    }
+
+    uint32_t class_size = c_minClassSize << size_class;
+    if(buffer == nullptr)
+    {
+        buffer = (octet*)malloc(class_size);
+        if(buffer == nullptr)
+        {
+            logError(RTPS_HISTORY, "Failed to allocate a payload buffer of " << class_size << " bytes");
+            return false;
+        }
+    }
+
+    payload.data = buffer;
+    payload.max_size = class_size;
+    payload.length = 0;
+    payload.pos = 0;
+    return true;
+}
+
+void PayloadArena::release(SerializedPayload_t& payload)
+{
+    if(payload.data == nullptr)
+    {
+        return;
+    }
+
+    // The payload may have reallocated its buffer, so it goes to the class it is still big enough for.
+    if(payload.max_size < c_minClassSize)
+    {
+        free(payload.data);
+    }
+    else
+    {
+        uint32_t size_class = class_within(payload.max_size);
+        std::lock_guard<std::mutex> guard(m_classes[size_class].mutex);
+        m_classes[size_class].buffers.push_back(payload.data);
+    }
+
+    payload.data = nullptr;
+    payload.max_size = 0;
+    payload.length = 0;
+    payload.pos = 0;
+}
+
+size_t PayloadArena::get_freeBuffersSize()
+{
+    size_t count = 0;
+    for(uint32_t i = 0; i < c_numClasses; ++i)
+    {
+        std::lock_guard<std::mutex> guard(m_classes[i].mutex);
+        count += m_classes[i].buffers.size();
+    }
+    return count;
+}
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
@@ -37,6 +37,8 @@
 
 #include <limits>
 #include <cassert>
+#include <algorithm>
+#include <thread>
 
 
 #include <fastrtps/log/Log.h>
@@ -50,13 +52,16 @@ namespace fastrtps{
 namespace rtps {
 
 
-MessageReceiver::MessageReceiver(RTPSParticipantImpl* participant) : participant_(participant) {}
+MessageReceiver::MessageReceiver(RTPSParticipantImpl* participant) :
+    endpoints_(std::make_shared<const EndpointTable>()),
+    participant_(participant) {}
 
 MessageReceiver::MessageReceiver(RTPSParticipantImpl* participant, uint32_t rec_buffer_size) :
     m_rec_msg(rec_buffer_size),
 #if HAVE_SECURITY
     m_crypto_msg(rec_buffer_size),
 #endif
+    endpoints_(std::make_shared<const EndpointTable>()),
     participant_(participant)
     {
     }
@@ -80,60 +85,90 @@ void MessageReceiver::init(uint32_t rec_buffer_size){
 MessageReceiver::~MessageReceiver()
 {
     logInfo(RTPS_MSG_IN,"");
-    assert(AssociatedWriters.size() == 0);
-    assert(AssociatedReaders.size() == 0);
+    assert(endpoints()->writers.size() == 0);
+    assert(endpoints()->readers.size() == 0);
+}
+
+std::shared_ptr<const MessageReceiver::EndpointTable> MessageReceiver::endpoints() const
+{
+    return endpoints_.get();
 }
 
 void MessageReceiver::associateEndpoint(Endpoint *to_add){
-    bool found = false;
     std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<EndpointTable> table = std::make_shared<EndpointTable>(*endpoints());
+    const EntityId_t& entityId = to_add->getGuid().entityId;
     if(to_add->getAttributes()->endpointKind == WRITER)
     {
-        for(auto it = AssociatedWriters.begin(); it != AssociatedWriters.end(); ++it)
-        {
-            if( (*it) == (RTPSWriter*)to_add )
-            {
-                found = true;
-                break;
-            }
-        }
-        if(!found) AssociatedWriters.push_back((RTPSWriter*)to_add);
+        RTPSWriter* writer = (RTPSWriter*)to_add;
+        if(std::find(table->writers.begin(), table->writers.end(), writer) != table->writers.end())
+            return;
+        table->writers.push_back(writer);
+        table->writersByEntity[entityId].push_back(writer);
     }
     else
     {
-        for(auto it = AssociatedReaders.begin(); it != AssociatedReaders.end(); ++it)
-        {
-            if( (*it) == (RTPSReader*)to_add )
-            {
-                found = true;
-                break;
-            }
-        }
-        if(!found) AssociatedReaders.push_back((RTPSReader*)to_add);
+        RTPSReader* reader = (RTPSReader*)to_add;
+        if(std::find(table->readers.begin(), table->readers.end(), reader) != table->readers.end())
+            return;
+        table->readers.push_back(reader);
+        table->readersByEntity[entityId].push_back(reader);
     }
-    return;
+    endpoints_.publish(std::move(table));
 }
-void MessageReceiver::removeEndpoint(Endpoint *to_remove){
 
+void MessageReceiver::removeEndpoint(Endpoint *to_remove){
     std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<EndpointTable> table = std::make_shared<EndpointTable>(*endpoints());
+    const EntityId_t& entityId = to_remove->getGuid().entityId;
     if(to_remove->getAttributes()->endpointKind == WRITER){
         RTPSWriter* var = (RTPSWriter *)to_remove;
-        for(auto it=AssociatedWriters.begin(); it !=AssociatedWriters.end(); ++it){
-            if ((*it) == var){
-                AssociatedWriters.erase(it);
-                break;
-            }
-        }
+        auto it = std::find(table->writers.begin(), table->writers.end(), var);
+        if(it == table->writers.end())
+            return;
+        table->writers.erase(it);
+        auto& same_entity = table->writersByEntity[entityId];
+        same_entity.erase(std::remove(same_entity.begin(), same_entity.end(), var), same_entity.end());
+        if(same_entity.empty())
+            table->writersByEntity.erase(entityId);
     }else{
         RTPSReader *var = (RTPSReader *)to_remove;
-        for(auto it=AssociatedReaders.begin(); it !=AssociatedReaders.end(); ++it){
-            if ((*it) == var){
-                AssociatedReaders.erase(it);
-                break;
-            }
+        auto it = std::find(table->readers.begin(), table->readers.end(), var);
+        if(it == table->readers.end())
+            return;
+        table->readers.erase(it);
+        auto& same_entity = table->readersByEntity[entityId];
+        same_entity.erase(std::remove(same_entity.begin(), same_entity.end(), var), same_entity.end());
+        if(same_entity.empty())
+            table->readersByEntity.erase(entityId);
+    }
+    // Processing methods keep their snapshot alive until they finish with the submessage, and any table
+    // replaced since the last removal may still list the removed endpoint.
+    endpoints_.publish_and_wait(std::move(table));
+}
+
+const std::vector<RTPSReader*>* MessageReceiver::readers_directed_to(const EndpointTable& table,
+        const EntityId_t& readerID)
+{
+    if(readerID == c_EntityId_Unknown)
+        return table.readers.empty() ? nullptr : &table.readers;
+
+    auto it = table.readersByEntity.find(readerID);
+    return it == table.readersByEntity.end() ? nullptr : &it->second;
+}
+
+RTPSWriter* MessageReceiver::find_writer(const EndpointTable& table, const GUID_t& writerGUID)
+{
+    auto it = table.writersByEntity.find(writerGUID.entityId);
+    if(it != table.writersByEntity.end())
+    {
+        for(RTPSWriter* writer : it->second)
+        {
+            if(writer->getGuid() == writerGUID)
+                return writer;
         }
     }
-    return;
+    return nullptr;
 }
 
 
@@ -155,13 +190,13 @@ void MessageReceiver::reset(){
     multicastReplyLocatorList.push_back(defUniLoc);
 }
 
-void MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefix,
+bool MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefix,
         Locator_t* loc, CDRMessage_t*msg)
 {
     if(msg->length < RTPSMESSAGE_HEADER_SIZE)
     {
         logWarning(RTPS_MSG_IN,IDSTRING"Received message too short, ignoring");
-        return;
+        return false;
     }
 
     this->reset();
@@ -177,7 +212,7 @@ void MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefi
     else
     {
         logWarning(RTPS_MSG_IN,IDSTRING"Locator kind invalid");
-        return;
+        return false;
     }
 
     for(uint8_t i = n_start;i<16;i++)
@@ -190,7 +225,7 @@ void MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefi
     //Once everything is set, the reading begins:
     if(!checkRTPSHeader(msg))
     {
-        return;
+        return false;
     }
 
 #if HAVE_SECURITY
@@ -200,7 +235,7 @@ void MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefi
     int decode_ret = participant_->security_manager().decode_rtps_message(*msg, *auxiliary_buffer, sourceGuidPrefix);
 
     if(decode_ret < 0)
-        return;
+        return false;
     else if(decode_ret == 0)
     {
         // Swap
@@ -225,7 +260,7 @@ void MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefi
 
         if(decode_ret < 0)
         {
-            return;
+            return false;
         }
         else if(decode_ret == 0)
         {
@@ -235,13 +270,13 @@ void MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefi
 
         //First 4 bytes must contain: ID | flags | octets to next header
         if(!readSubmessageHeader(submessage, &submsgh))
-            return;
+            return false;
 
         if(submessage->pos + submsgh.submessageLength > submessage->length)
         {
             logWarning(RTPS_MSG_IN,IDSTRING"SubMsg of invalid length ("<<submsgh.submessageLength
                     << ") with current msg position/length (" << submessage->pos << "/" << submessage->length << ")");
-            return;
+            return false;
         }
         if(submsgh.submessageLength == 0) //THIS IS THE LAST SUBMESSAGE
         {
@@ -379,6 +414,8 @@ void MessageReceiver::processCDRMsg(const GuidPrefix_t& RTPSParticipantguidprefi
             break;
         }
     }
+
+    return true;
 }
 
 bool MessageReceiver::checkRTPSHeader(CDRMessage_t*msg) //check and proccess the RTPS Header
@@ -433,7 +470,7 @@ bool MessageReceiver::readSubmessageHeader(CDRMessage_t* msg, SubmessageHeader_t
 
 bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh, bool* last)
 {
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpoints();
 
     //READ and PROCESS
     if(smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -472,19 +509,22 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
 
     RTPSReader* firstReader = nullptr;
-    if(AssociatedReaders.empty())
+    if(table->readers.empty())
     {
         logWarning(RTPS_MSG_IN,IDSTRING"Data received when NO readers are listening");
         return false;
     }
 
-    for(std::vector<RTPSReader*>::iterator it=AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    const std::vector<RTPSReader*>* readers = readers_directed_to(*table, readerID);
+    if(readers != nullptr)
     {
-        if((*it)->acceptMsgDirectedTo(readerID)) //add
+        for(RTPSReader* reader : *readers)
         {
-            firstReader = *it;
-            break;
+            if(reader->acceptMsgDirectedTo(readerID)) //add
+            {
+                firstReader = reader;
+                break;
+            }
         }
     }
     if(firstReader == nullptr) //Reader not found
@@ -596,14 +636,15 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<AssociatedReaders.size());
+    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<readers->size());
     //Look for the correct reader to add the change
-    for(std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    for(RTPSReader* reader : *readers)
     {
-        if((*it)->acceptMsgDirectedTo(readerID))
+        if(reader->acceptMsgDirectedTo(readerID))
         {
-            (*it)->processDataMsg(&ch);
+            EndpointStatisticsCounters::add(reader->statistics_counters().data_received);
+            EndpointStatisticsCounters::add(reader->statistics_counters().bytes_received, ch.serializedPayload.length);
+            reader->processDataMsg(&ch);
         }
     }
 
@@ -616,7 +657,7 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t* smh, bool* last)
 {
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpoints();
 
     //READ and PROCESS
     if (smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -648,20 +689,23 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
     valid &= CDRMessage::readEntityId(msg, &readerID);
 
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
-    if(AssociatedReaders.empty())
+    if(table->readers.empty())
     {
         logWarning(RTPS_MSG_IN, IDSTRING"Data received when NO readers are listening");
         return false;
     }
 
     RTPSReader* firstReader = nullptr;
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    const std::vector<RTPSReader*>* readers = readers_directed_to(*table, readerID);
+    if (readers != nullptr)
     {
-        if ((*it)->acceptMsgDirectedTo(readerID)) //add
+        for (RTPSReader* reader : *readers)
         {
-            firstReader = *it;
-            break;
+            if (reader->acceptMsgDirectedTo(readerID)) //add
+            {
+                firstReader = reader;
+                break;
+            }
         }
     }
 
@@ -746,10 +790,8 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
         {
             ch.serializedPayload.length = payload_size;
 
-            // TODO Mejorar el reubicar el vector de fragmentos.
             ch.setFragmentSize(fragmentSize);
-            ch.getDataFragments()->clear();
-            ch.getDataFragments()->resize(fragmentsInSubmessage, ChangeFragmentStatus_t::PRESENT);
+            ch.getDataFragments().assign(fragmentsInSubmessage, true);
 
             ch.serializedPayload.data = &msg->buffer[msg->pos];
             ch.serializedPayload.length = payload_size;
@@ -796,14 +838,15 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
         ch.sourceTimestamp = this->timestamp;
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << AssociatedReaders.size());
+    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << readers->size());
     //Look for the correct reader to add the change
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    for (RTPSReader* reader : *readers)
     {
-        if ((*it)->acceptMsgDirectedTo(readerID))
+        if (reader->acceptMsgDirectedTo(readerID))
         {
-            (*it)->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
+            EndpointStatisticsCounters::add(reader->statistics_counters().data_frag_received);
+            EndpointStatisticsCounters::add(reader->statistics_counters().bytes_received, ch.serializedPayload.length);
+            reader->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
         }
     }
 
@@ -843,14 +886,18 @@ bool MessageReceiver::proc_Submsg_Heartbeat(CDRMessage_t* msg,SubmessageHeader_t
     uint32_t HBCount;
     CDRMessage::readUInt32(msg,&HBCount);
 
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpoints();
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    const std::vector<RTPSReader*>* readers = readers_directed_to(*table, readerGUID.entityId);
+    if(readers != nullptr)
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
+        for(RTPSReader* reader : *readers)
         {
-            (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+            if(reader->acceptMsgDirectedTo(readerGUID.entityId))
+            {
+                EndpointStatisticsCounters::add(reader->statistics_counters().heartbeats_received);
+                reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+            }
         }
     }
     //Is the final message?
@@ -884,28 +931,26 @@ bool MessageReceiver::proc_Submsg_Acknack(CDRMessage_t* msg,SubmessageHeader_t*
     if(smh->submessageLength == 0)
         *last = true;
 
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpoints();
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    RTPSWriter* writer = find_writer(*table, writerGUID);
+    if(writer != nullptr)
     {
-        if((*it)->getGuid() == writerGUID)
+        if(writer->getAttributes()->reliabilityKind == RELIABLE)
         {
-            if((*it)->getAttributes()->reliabilityKind == RELIABLE)
-            {
-                StatefulWriter* SF = (StatefulWriter*)(*it);
-                SF->process_acknack(readerGUID, Ackcount, SNSet, finalFlag);
-                return true;
-            }
-            else
-            {
-                logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to NOT stateful writer ");
-                return false;
-            }
+            StatefulWriter* SF = (StatefulWriter*)writer;
+            EndpointStatisticsCounters::add(SF->statistics_counters().acknacks_received);
+            SF->process_acknack(readerGUID, Ackcount, SNSet, finalFlag);
+            return true;
+        }
+        else
+        {
+            logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to NOT stateful writer ");
+            return false;
         }
     }
-    logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to UNKNOWN writer (I loooked through "
-            << AssociatedWriters.size() << " writers in this ListenResource)");
+    logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to UNKNOWN writer ("
+            << table->writers.size() << " writers in this ListenResource)");
     return false;
 }
 
@@ -936,13 +981,17 @@ bool MessageReceiver::proc_Submsg_Gap(CDRMessage_t* msg,SubmessageHeader_t* smh,
     if(gapStart <= SequenceNumber_t(0, 0))
         return false;
 
-    std::lock_guard<std::mutex> guard(mtx);
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    std::shared_ptr<const EndpointTable> table = endpoints();
+    const std::vector<RTPSReader*>* readers = readers_directed_to(*table, readerGUID.entityId);
+    if(readers != nullptr)
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
+        for(RTPSReader* reader : *readers)
         {
-            (*it)->processGapMsg(writerGUID, gapStart, gapList);
+            if(reader->acceptMsgDirectedTo(readerGUID.entityId))
+            {
+                EndpointStatisticsCounters::add(reader->statistics_counters().gaps_received);
+                reader->processGapMsg(writerGUID, gapStart, gapList);
+            }
         }
     }
 
@@ -1048,48 +1097,47 @@ bool MessageReceiver::proc_Submsg_NackFrag(CDRMessage_t*msg, SubmessageHeader_t*
     if (smh->submessageLength == 0)
         *last = true;
 
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpoints();
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    RTPSWriter* writer = find_writer(*table, writerGUID);
+    if (writer != nullptr)
     {
         //Look for the readerProxy the acknack is from
-        std::lock_guard<std::recursive_mutex> guardW(*(*it)->getMutex());
-        if ((*it)->getGuid() == writerGUID)
+        std::lock_guard<std::recursive_mutex> guardW(*writer->getMutex());
+        if (writer->getAttributes()->reliabilityKind == RELIABLE)
         {
-            if ((*it)->getAttributes()->reliabilityKind == RELIABLE)
+            StatefulWriter* SF = (StatefulWriter*)writer;
+            EndpointStatisticsCounters::add(SF->statistics_counters().nack_frags_received);
+
+            for (auto rit = SF->matchedReadersBegin(); rit != SF->matchedReadersEnd(); ++rit)
             {
-                StatefulWriter* SF = (StatefulWriter*)(*it);
+                std::lock_guard<std::recursive_mutex> guardReaderProxy(*(*rit)->mp_mutex);
 
-                for (auto rit = SF->matchedReadersBegin(); rit != SF->matchedReadersEnd(); ++rit)
+                if ((*rit)->m_att.guid == readerGUID)
                 {
-                    std::lock_guard<std::recursive_mutex> guardReaderProxy(*(*rit)->mp_mutex);
-
-                    if ((*rit)->m_att.guid == readerGUID)
+                    if ((*rit)->getLastNackfragCount() < Ackcount)
                     {
-                        if ((*rit)->getLastNackfragCount() < Ackcount)
+                        (*rit)->setLastNackfragCount(Ackcount);
+                        // TODO Not doing Acknowledged.
+                        if((*rit)->requested_fragment_set(writerSN, fnState))
                         {
-                            (*rit)->setLastNackfragCount(Ackcount);
-                            // TODO Not doing Acknowledged.
-                            if((*rit)->requested_fragment_set(writerSN, fnState))
-                            {
-                                (*rit)->mp_nackResponse->restart_timer();
-                            }
+                            EndpointStatisticsCounters::add(SF->statistics_counters().retransmissions);
+                            (*rit)->mp_nackResponse->restart_timer();
                         }
-                        break;
                     }
+                    break;
                 }
-                return true;
-            }
-            else
-            {
-                logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
-                return false;
             }
+            return true;
+        }
+        else
+        {
+            logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+            return false;
         }
     }
-    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to UNKNOWN writer (I looked through "
-            << AssociatedWriters.size() << " writers in this ListenResource)");
+    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to UNKNOWN writer ("
+            << table->writers.size() << " writers in this ListenResource)");
     return false;
 }
 
@@ -1119,18 +1167,21 @@ bool MessageReceiver::proc_Submsg_HeartbeatFrag(CDRMessage_t*msg, SubmessageHead
 
     // XXX TODO VALIDATE DATA?
 
-    std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        /* XXX TODO PROCESS
-           if ((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-           {
-           (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
-           }
-           */
-    }
+    /* XXX TODO PROCESS
+       std::shared_ptr<const EndpointTable> table = endpoints();
+       const std::vector<RTPSReader*>* readers = readers_directed_to(*table, readerGUID.entityId);
+       if (readers != nullptr)
+       {
+       for (RTPSReader* reader : *readers)
+       {
+       if (reader->acceptMsgDirectedTo(readerGUID.entityId))
+       {
+       reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+       }
+       }
+       }
+       */
 
     //Is the final message?
     if (smh->submessageLength == 0)
@@ -108,20 +108,19 @@ bool compare_remote_participants(const std::vector<GuidPrefix_t>& remote_partici
     return false;
 }
 
-std::vector<GuidPrefix_t> get_participants_from_endpoints(const std::vector<GUID_t> endpoints)
+void get_participants_from_endpoints(const std::vector<GUID_t>& endpoints,
+        std::vector<GuidPrefix_t>& participants)
 {
-    std::vector<GuidPrefix_t> participants;
+    participants.clear();
 
     for(auto& endpoint : endpoints)
     {
         if(std::find(participants.begin(), participants.end(), endpoint.guidPrefix) == participants.end())
             participants.push_back(endpoint.guidPrefix);
     }
-
-    return participants;
 }
 
-EntityId_t get_entity_id(const std::vector<GUID_t> endpoints)
+EntityId_t get_entity_id(const std::vector<GUID_t>& endpoints)
 {
     if(endpoints.size() == 0)
         return EntityId_t::unknown();
@@ -142,11 +141,17 @@ RTPSMessageGroup::RTPSMessageGroup(RTPSParticipantImpl* participant, Endpoint* e
 #if HAVE_SECURITY
     , type_(type), encrypt_msg_(&msg_group.rtpsmsg_encrypt_)
 #endif
+    , current_locators_(msg_group.current_locators_),
+    current_remote_participants_(msg_group.current_remote_participants_),
+    remote_participants_(msg_group.remote_participants_)
 {
     assert(participant);
     assert(endpoint);
     (void)type;
 
+    current_locators_.clear();
+    current_remote_participants_.clear();
+
     // Init RTPS message.
     reset_to_header();
 
@@ -219,36 +224,33 @@ void RTPSMessageGroup::send()
         }
 #endif
 
-        for(const auto& lit : current_locators_)
-        {
-            participant_->sendSync(full_msg_, endpoint_, lit);
-        }
+        participant_->sendSync(full_msg_, endpoint_, current_locators_);
 
         currentBytesSent_ += full_msg_->length;
     }
 }
 
 void RTPSMessageGroup::flush_and_reset(const LocatorList_t& locator_list,
-        std::vector<GuidPrefix_t>&& remote_participants)
+        std::vector<GuidPrefix_t>& remote_participants)
 {
     // Flush
     flush();
 
     // Reset
     current_locators_ = locator_list;
-    current_remote_participants_ = std::move(remote_participants);
+    current_remote_participants_.swap(remote_participants);
     current_dst_ = GuidPrefix_t();
 }
 
 void RTPSMessageGroup::check_and_maybe_flush(const LocatorList_t& locator_list,
         const std::vector<GUID_t>& remote_endpoints)
 {
-    std::vector<GuidPrefix_t> remote_participants = get_participants_from_endpoints(remote_endpoints);
+    get_participants_from_endpoints(remote_endpoints, remote_participants_);
 
     CDRMessage::initCDRMsg(submessage_msg_);
 
-    if(!check_preconditions(locator_list, remote_participants))
-        flush_and_reset(locator_list, std::move(remote_participants));
+    if(!check_preconditions(locator_list, remote_participants_))
+        flush_and_reset(locator_list, remote_participants_);
 
     add_info_dst_in_buffer(submessage_msg_, remote_endpoints);
 }
@@ -448,7 +450,12 @@ bool RTPSMessageGroup::add_data(const CacheChange_t& change, const std::vector<G
     }
 #endif
 
-    return insert_submessage(remote_readers);
+    if(!insert_submessage(remote_readers))
+        return false;
+
+    EndpointStatisticsCounters::add(endpoint_->statistics_counters().data_sent);
+    EndpointStatisticsCounters::add(endpoint_->statistics_counters().bytes_sent, change.serializedPayload.length);
+    return true;
 }
 
 bool RTPSMessageGroup::add_data_frag(const CacheChange_t& change, const uint32_t fragment_number,
@@ -545,7 +552,12 @@ bool RTPSMessageGroup::add_data_frag(const CacheChange_t& change, const uint32_t
     }
 #endif
 
-    return insert_submessage(remote_readers);
+    if(!insert_submessage(remote_readers))
+        return false;
+
+    EndpointStatisticsCounters::add(endpoint_->statistics_counters().data_frag_sent);
+    EndpointStatisticsCounters::add(endpoint_->statistics_counters().bytes_sent, fragment_size);
+    return true;
 }
 
 bool RTPSMessageGroup::add_heartbeat(const std::vector<GUID_t>& remote_readers, const SequenceNumber_t& firstSN,
@@ -593,7 +605,11 @@ bool RTPSMessageGroup::add_heartbeat(const std::vector<GUID_t>& remote_readers,
     }
 #endif
 
-    return insert_submessage(remote_readers);
+    if(!insert_submessage(remote_readers))
+        return false;
+
+    EndpointStatisticsCounters::add(endpoint_->statistics_counters().heartbeats_sent);
+    return true;
 }
 
 // TODO (Ricardo) Check with standard 8.3.7.4.5
@@ -653,6 +669,8 @@ bool RTPSMessageGroup::add_gap(std::set<SequenceNumber_t>& changesSeqNum,
         if(!insert_submessage(remote_readers))
             break;
 
+        EndpointStatisticsCounters::add(endpoint_->statistics_counters().gaps_sent);
+
         ++gap_n;
         ++seqit;
     }
@@ -702,7 +720,11 @@ bool RTPSMessageGroup::add_acknack(const GUID_t& remote_writer, SequenceNumberSe
     }
 #endif
 
-    return insert_submessage(std::vector<GUID_t>{remote_writer});
+    if(!insert_submessage(std::vector<GUID_t>{remote_writer}))
+        return false;
+
+    EndpointStatisticsCounters::add(endpoint_->statistics_counters().acknacks_sent);
+    return true;
 }
 
 bool RTPSMessageGroup::add_nackfrag(const GUID_t& remote_writer, SequenceNumber_t& writerSN,
@@ -747,7 +769,11 @@ bool RTPSMessageGroup::add_nackfrag(const GUID_t& remote_writer, SequenceNumber_
     }
 #endif
 
-    return insert_submessage(std::vector<GUID_t>{remote_writer});
+    if(!insert_submessage(std::vector<GUID_t>{remote_writer}))
+        return false;
+
+    EndpointStatisticsCounters::add(endpoint_->statistics_counters().nack_frags_sent);
+    return true;
 }
 
 } /* namespace rtps */
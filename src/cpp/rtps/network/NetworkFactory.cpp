@@ -15,6 +15,7 @@
 #include <fastrtps/rtps/network/NetworkFactory.h>
 #include <fastrtps/transport/UDPv4Transport.h>
 #include <fastrtps/transport/UDPv6Transport.h>
+#include <fastrtps/transport/SharedMemTransport.h>
 #include <fastrtps/transport/test_UDPv4Transport.h>
 #include <utility>
 #include <limits>
@@ -25,7 +26,25 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
-NetworkFactory::NetworkFactory() : maxMessageSizeBetweenTransports_(0),
+static bool IsUnicastLocator(const Locator_t& locator)
+{
+    if(locator.kind == LOCATOR_KIND_UDPv4)
+        return locator.address[12] < 224 || locator.address[12] > 239;
+    if(locator.kind == LOCATOR_KIND_UDPv6)
+        return locator.address[0] != 0xFF;
+    return false;
+}
+
+static Locator_t SharedMemLocator(uint32_t port)
+{
+    Locator_t locator;
+    locator.kind = LOCATOR_KIND_SHM;
+    locator.port = port;
+    LOCATOR_ADDRESS_INVALID(locator.address);
+    return locator;
+}
+
+NetworkFactory::NetworkFactory() : mSharedMemTransport(nullptr), maxMessageSizeBetweenTransports_(0),
     minSendBufferSize_(std::numeric_limits<uint32_t>::max())
 {
 }
@@ -88,6 +107,18 @@ bool NetworkFactory::BuildReceiverResources (const Locator_t& local, std::vector
         }
     }
 
+    // Participants running on this host will reach the same port through shared memory.
+    if(returnedValue && mSharedMemTransport != nullptr && IsUnicastLocator(local))
+    {
+        Locator_t shared_memory_locator = SharedMemLocator(local.port);
+        if(!mSharedMemTransport->IsInputChannelOpen(shared_memory_locator))
+        {
+            ReceiverResource newReceiverResource(*mSharedMemTransport, shared_memory_locator);
+            if(newReceiverResource.mValid)
+                returned_resources_list.push_back(std::move(newReceiverResource));
+        }
+    }
+
     return returnedValue;
 }
 
@@ -127,6 +158,17 @@ void NetworkFactory::RegisterTransport(const TransportDescriptorInterface* descr
         }
     }
 
+    if (auto concrete = dynamic_cast<const SharedMemTransportDescriptor*> (descriptor))
+    {
+        std::unique_ptr<SharedMemTransport> transport(new SharedMemTransport(*concrete));
+        if(mSharedMemTransport == nullptr && transport->init())
+        {
+            mSharedMemTransport = transport.get();
+            mRegisteredTransports.emplace_back(std::move(transport));
+            wasRegistered = true;
+        }
+    }
+
     if(wasRegistered)
     {
         if(descriptor->maxMessageSize > maxMessageSizeBetweenTransports_)
@@ -198,6 +240,15 @@ bool NetworkFactory::is_local_locator(const Locator_t& locator) const
     return false;
 }
 
+bool NetworkFactory::get_shared_memory_locator(const Locator_t& remote, Locator_t& shared_memory_locator) const
+{
+    if(mSharedMemTransport == nullptr || remote.port == 0 || !IsUnicastLocator(remote) || !is_local_locator(remote))
+        return false;
+
+    shared_memory_locator = SharedMemLocator(remote.port);
+    return true;
+}
+
 size_t NetworkFactory::numberOfRegisteredTransports() const
 {
     return mRegisteredTransports.size();
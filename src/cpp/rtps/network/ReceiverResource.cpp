@@ -20,7 +20,8 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
-ReceiverResource::ReceiverResource(TransportInterface& transport, const Locator_t& locator)
+ReceiverResource::ReceiverResource(TransportInterface& transport, const Locator_t& locator) : mMaxBatchSize(1),
+   mLocator(locator), mDatagramsReceived(0), mBytesReceived(0), mDatagramsDropped(0)
 {
    // Internal channel is opened and assigned to this resource.
    mValid = transport.OpenInputChannel(locator);
@@ -32,6 +33,9 @@ ReceiverResource::ReceiverResource(TransportInterface& transport, const Locator_
    Close = [&transport,locator](){ transport.CloseInputChannel(locator); };
    ReceiveFromAssociatedChannel = [&transport, locator](octet* receiveBuffer, uint32_t receiveBufferCapacity, uint32_t& receiveBufferSize, Locator_t& origin)-> bool
                                   { return transport.Receive(receiveBuffer, receiveBufferCapacity, receiveBufferSize, locator, origin); };
+   ReceiveBatchFromAssociatedChannel = [&transport, locator](TransportReceiveBuffer* buffers, uint32_t bufferCount)-> uint32_t
+                                  { return transport.ReceiveBatch(buffers, bufferCount, locator); };
+   mMaxBatchSize = transport.MaxBatchSize();
    LocatorMapsToManagedChannel = [&transport, locator](const Locator_t& locatorToCheck) -> bool
                                  { return transport.DoLocatorsMatch(locator, locatorToCheck); };
 }
@@ -47,11 +51,31 @@ bool ReceiverResource::Receive(octet* receiveBuffer, uint32_t receiveBufferCapac
    return false;
 }
 
-ReceiverResource::ReceiverResource(ReceiverResource&& rValueResource)
+uint32_t ReceiverResource::ReceiveBatch(TransportReceiveBuffer* buffers, uint32_t bufferCount)
+{
+   if (ReceiveBatchFromAssociatedChannel)
+   {
+      return ReceiveBatchFromAssociatedChannel(buffers, bufferCount);
+   }
+
+   return 0;
+}
+
+uint32_t ReceiverResource::MaxBatchSize() const
+{
+   return mMaxBatchSize;
+}
+
+ReceiverResource::ReceiverResource(ReceiverResource&& rValueResource) : mMaxBatchSize(rValueResource.mMaxBatchSize),
+   mLocator(rValueResource.mLocator),
+   mDatagramsReceived(rValueResource.mDatagramsReceived.load()),
+   mBytesReceived(rValueResource.mBytesReceived.load()),
+   mDatagramsDropped(rValueResource.mDatagramsDropped.load())
 {
    Cleanup.swap(rValueResource.Cleanup);
    Close.swap(rValueResource.Close);
    ReceiveFromAssociatedChannel.swap(rValueResource.ReceiveFromAssociatedChannel);
+   ReceiveBatchFromAssociatedChannel.swap(rValueResource.ReceiveBatchFromAssociatedChannel);
    LocatorMapsToManagedChannel.swap(rValueResource.LocatorMapsToManagedChannel);
 }
 
@@ -70,6 +94,27 @@ void ReceiverResource::Abort()
    }
 }
 
+void ReceiverResource::CountReceived(uint32_t size)
+{
+   mDatagramsReceived.fetch_add(1, std::memory_order_relaxed);
+   mBytesReceived.fetch_add(size, std::memory_order_relaxed);
+}
+
+void ReceiverResource::CountDropped()
+{
+   mDatagramsDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+ReceiverStatistics ReceiverResource::Statistics() const
+{
+   ReceiverStatistics statistics;
+   statistics.locator = mLocator;
+   statistics.datagrams_received = mDatagramsReceived.load(std::memory_order_relaxed);
+   statistics.bytes_received = mBytesReceived.load(std::memory_order_relaxed);
+   statistics.datagrams_dropped = mDatagramsDropped.load(std::memory_order_relaxed);
+   return statistics;
+}
+
 ReceiverResource::~ReceiverResource()
 {
    if(Cleanup)
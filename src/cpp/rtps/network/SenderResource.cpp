@@ -30,6 +30,8 @@ SenderResource::SenderResource(TransportInterface& transport, Locator_t& locator
    Cleanup = [&transport,locator](){ transport.CloseOutputChannel(locator); };
    SendThroughAssociatedChannel = [&transport, locator](const octet* data, uint32_t dataSize, const Locator_t& destination)-> bool
                                   { return transport.Send(data,dataSize, locator, destination); };
+   SendBatchThroughAssociatedChannel = [&transport, locator](const octet* data, uint32_t dataSize, const LocatorList_t& destinations)-> bool
+                                  { return transport.SendBatch(data,dataSize, locator, destinations); };
    LocatorMapsToManagedChannel = [&transport, locator](const Locator_t& locatorToCheck) -> bool
                                  { return transport.DoLocatorsMatch(locator, locatorToCheck); };
    ManagedChannelMapsToRemote = [&transport, locator](const Locator_t& locatorToCheck) -> bool
@@ -43,11 +45,19 @@ bool SenderResource::Send(const octet* data, uint32_t dataLength, const Locator_
    return false;
 }
 
+bool SenderResource::SendBatch(const octet* data, uint32_t dataLength, const LocatorList_t& destinationLocators)
+{
+   if (SendBatchThroughAssociatedChannel)
+      return SendBatchThroughAssociatedChannel(data, dataLength, destinationLocators);
+   return false;
+}
+
 SenderResource::SenderResource(SenderResource&& rValueResource)
 {
     mValid = rValueResource.mValid;
     Cleanup.swap(rValueResource.Cleanup); 
     SendThroughAssociatedChannel.swap(rValueResource.SendThroughAssociatedChannel);
+    SendBatchThroughAssociatedChannel.swap(rValueResource.SendBatchThroughAssociatedChannel);
     LocatorMapsToManagedChannel.swap(rValueResource.LocatorMapsToManagedChannel);
     ManagedChannelMapsToRemote.swap(rValueResource.ManagedChannelMapsToRemote);
 }
@@ -119,6 +119,11 @@ bool RTPSParticipant::get_remote_reader_info(const GUID_t& readerGuid, ReaderPro
     return mp_impl->get_remote_reader_info(readerGuid, returnedInfo);
 }
 
+ParticipantStatistics RTPSParticipant::get_statistics() const
+{
+    return mp_impl->get_statistics();
+}
+
 } /* namespace rtps */
 } /* namespace fastrtps */
 } /* namespace eprosima */
@@ -24,6 +24,7 @@
 
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 #include <fastrtps/rtps/resources/AsyncWriterThread.h>
+#include "../resources/AsyncSendScheduler.h"
 
 #include <fastrtps/rtps/messages/MessageReceiver.h>
 
@@ -94,8 +95,8 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
         RTPSParticipant* par,
         RTPSParticipantListener* plisten): m_att(PParam), m_guid(guidP ,c_EntityId_RTPSParticipant),
     mp_event_thr(nullptr),
+    mp_async_scheduler(new AsyncSendScheduler(PParam.asyncSendThreads)),
     mp_builtinProtocols(nullptr),
-    mp_ResourceSemaphore(new Semaphore(0)),
     IdCounter(0),
 #if HAVE_SECURITY
     m_security_manager(this),
@@ -123,7 +124,7 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
     Locator_t loc;
     loc.port = PParam.defaultSendPort;
     mp_event_thr = new ResourceEvent();
-    mp_event_thr->init_thread(this);
+    mp_event_thr->init_thread(PParam.eventThreads);
 
     // Throughput controller, if the descriptor has valid values
     if (PParam.throughputController.bytesPerPeriod != UINT32_MAX &&
@@ -266,13 +267,13 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
         We create the resources for these Locators now. Furthermore, in case these resources are taken,
         we create them on another Locator and then update de defaultList.
         */
-    createReceiverResources(m_att.defaultUnicastLocatorList, true);
+    createReceiverResources(m_att.defaultUnicastLocatorList, true, true);
 
     if(!hasLocatorsDefined){
         logInfo(RTPS_PARTICIPANT,m_att.getName()<<" Created with NO default Unicast Locator List, adding Locators: "<<m_att.defaultUnicastLocatorList);
     }
     //Multicast
-    createReceiverResources(m_att.defaultMulticastLocatorList, true);
+    createReceiverResources(m_att.defaultMulticastLocatorList, true, true);
 
     //Check if defaultOutLocatorsExist, create some if they don't
     hasLocatorsDefined = true;
@@ -308,10 +309,18 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
         newSendersBuffer.clear();
     }
 
+    //Shared memory output channel, only built when the transport is registered
+    Locator_t sharedMemLocator;
+    sharedMemLocator.kind = LOCATOR_KIND_SHM;
+    std::vector<SenderResource> sharedMemSenders = m_network_Factory.BuildSenderResources(sharedMemLocator);
+
     m_send_resources_mutex.lock();
     for(auto mit=newSenders.begin(); mit!=newSenders.end();++mit){
         m_senderResource.push_back(std::move(*mit));
     }
+    for(auto mit=sharedMemSenders.begin(); mit!=sharedMemSenders.end();++mit){
+        m_sharedMemSenderResource.push_back(std::move(*mit));
+    }
     m_send_resources_mutex.unlock();
     m_att.defaultOutLocatorList = defcopy;
 
@@ -352,6 +361,10 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     for(auto& block : m_receiverResourcelist)
     {
         block.resourceAlive = false;
+        if(block.mp_workers != nullptr)
+        {
+            block.mp_workers->stop();
+        }
         block.Receiver.Abort();
         block.m_thread->join();
         delete block.m_thread;
@@ -373,16 +386,20 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     m_security_manager.destroy();
 #endif
 
+    // All writers are gone, so the sender threads can be stopped.
+    delete(this->mp_async_scheduler);
+
     // Destruct message receivers
     for(auto& block : m_receiverResourcelist)
     {
         delete block.mp_receiver;
+        delete block.mp_workers;
     }
     m_receiverResourcelist.clear();
 
-    delete(this->mp_ResourceSemaphore);
     delete(this->mp_userParticipant);
     m_senderResource.clear();
+    m_sharedMemSenderResource.clear();
 
     delete(this->mp_event_thr);
 
@@ -531,7 +548,7 @@ bool RTPSParticipantImpl::createWriter(RTPSWriter** WriterOut,
 
     // Asynchronous thread runs regardless of mode because of
     // nack response duties.
-    AsyncWriterThread::addWriter(*SWriter);
+    AsyncWriterThread::addWriter(*SWriter, param.asyncPriority);
 
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
     m_allWriterList.push_back(SWriter);
@@ -716,7 +733,7 @@ void RTPSParticipantImpl::disableReader(RTPSReader *reader)
     m_receiverResourcelistMutex.lock();
     for(auto it = m_receiverResourcelist.begin(); it != m_receiverResourcelist.end(); ++it)
     {
-        (*it).mp_receiver->removeEndpoint(reader);
+        (*it).removeEndpoint(reader);
     }
     m_receiverResourcelistMutex.unlock();
 }
@@ -817,8 +834,8 @@ bool RTPSParticipantImpl::createAndAssociateReceiverswithEndpoint(Endpoint * pen
         //Default unicast
         pend->getAttributes()->unicastLocatorList = m_att.defaultUnicastLocatorList;
     }
-    createReceiverResources(pend->getAttributes()->unicastLocatorList, false);
-    createReceiverResources(pend->getAttributes()->multicastLocatorList, false);
+    createReceiverResources(pend->getAttributes()->unicastLocatorList, false, true);
+    createReceiverResources(pend->getAttributes()->multicastLocatorList, false, true);
 
     // Associate the Endpoint with ReceiverResources inside ReceiverControlBlocks
     assignEndpointListenResources(pend);
@@ -827,6 +844,12 @@ bool RTPSParticipantImpl::createAndAssociateReceiverswithEndpoint(Endpoint * pen
 
 void RTPSParticipantImpl::performListenOperation(ReceiverControlBlock *receiver, Locator_t input_locator)
 {
+    if(receiver->Receiver.MaxBatchSize() > 1)
+    {
+        performBatchedListenOperation(receiver, input_locator);
+        return;
+    }
+
     while(receiver->resourceAlive)
     {
         // Blocking receive.
@@ -838,7 +861,115 @@ void RTPSParticipantImpl::performListenOperation(ReceiverControlBlock *receiver,
         }
 
         // Processes the data through the CDR Message interface.
-        receiver->mp_receiver->processCDRMsg(getGuid().guidPrefix, &input_locator, &receiver->mp_receiver->m_rec_msg);
+        receiver->Receiver.CountReceived(msg.length);
+        if(!receiver->mp_receiver->processCDRMsg(getGuid().guidPrefix, &input_locator, &msg))
+        {
+            receiver->Receiver.CountDropped();
+        }
+    }
+}
+
+void RTPSParticipantImpl::performBatchedListenOperation(ReceiverControlBlock *receiver, Locator_t input_locator)
+{
+    uint32_t batch_size = receiver->Receiver.MaxBatchSize();
+
+    // First buffer is the one of the MessageReceiver. The rest are allocated once for the whole life of the thread.
+    std::vector<CDRMessage_t*> msgs;
+    msgs.reserve(batch_size);
+    msgs.push_back(&receiver->mp_receiver->m_rec_msg);
+    for(uint32_t i = 1; i < batch_size; ++i)
+    {
+        msgs.push_back(new CDRMessage_t(receiver->mp_receiver->m_rec_msg.max_size));
+    }
+
+    std::vector<TransportReceiveBuffer> buffers(batch_size);
+
+    while(receiver->resourceAlive)
+    {
+        for(uint32_t i = 0; i < batch_size; ++i)
+        {
+            CDRMessage::initCDRMsg(msgs[i]);
+            buffers[i].buffer = msgs[i]->buffer;
+            buffers[i].capacity = msgs[i]->max_size;
+            buffers[i].size = 0;
+            buffers[i].remoteLocator = input_locator;
+        }
+
+        // Blocking receive.
+        uint32_t received = receiver->Receiver.ReceiveBatch(buffers.data(), batch_size);
+
+        // Processes the data through the CDR Message interface.
+        for(uint32_t i = 0; i < received; ++i)
+        {
+            if(buffers[i].size == 0)
+            {
+                continue;
+            }
+
+            msgs[i]->length = buffers[i].size;
+            receiver->Receiver.CountReceived(msgs[i]->length);
+            if(!receiver->mp_receiver->processCDRMsg(getGuid().guidPrefix, &buffers[i].remoteLocator, msgs[i]))
+            {
+                receiver->Receiver.CountDropped();
+            }
+        }
+    }
+
+    for(uint32_t i = 1; i < batch_size; ++i)
+    {
+        delete msgs[i];
+    }
+}
+
+void RTPSParticipantImpl::performPooledListenOperation(ReceiverControlBlock *receiver, Locator_t input_locator)
+{
+    uint32_t batch_size = receiver->Receiver.MaxBatchSize();
+    std::vector<ReceiverWorkerPool::Slot*> slots(batch_size, nullptr);
+    std::vector<TransportReceiveBuffer> buffers(batch_size);
+
+    while(receiver->resourceAlive)
+    {
+        // Waits for a free buffer. Returns nullptr when the pool is being stopped.
+        slots[0] = receiver->mp_workers->acquire();
+        if(slots[0] == nullptr)
+        {
+            break;
+        }
+
+        // The rest of the batch is filled with the buffers that are free right now.
+        uint32_t count = 1;
+        while(count < batch_size && (slots[count] = receiver->mp_workers->try_acquire()) != nullptr)
+        {
+            ++count;
+        }
+
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            CDRMessage::initCDRMsg(&slots[i]->msg);
+            buffers[i].buffer = slots[i]->msg.buffer;
+            buffers[i].capacity = slots[i]->msg.max_size;
+            buffers[i].size = 0;
+            buffers[i].remoteLocator = input_locator;
+        }
+
+        // Blocking receive.
+        uint32_t received = receiver->Receiver.ReceiveBatch(buffers.data(), count);
+
+        // Decoding happens on the worker threads.
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            if(i < received && buffers[i].size > 0)
+            {
+                slots[i]->msg.length = buffers[i].size;
+                slots[i]->origin = buffers[i].remoteLocator;
+                receiver->Receiver.CountReceived(slots[i]->msg.length);
+                receiver->mp_workers->dispatch(slots[i]);
+            }
+            else
+            {
+                receiver->mp_workers->release(slots[i]);
+            }
+        }
     }
 }
 
@@ -863,7 +994,7 @@ bool RTPSParticipantImpl::assignEndpoint2LocatorList(Endpoint* endp,LocatorList_
             //std::lock_guard<std::mutex> guard((*it).mtx);
             if ((*it).Receiver.SupportsLocator(*lit)){
                 //Supported! Take mutex and update lists - We maintain reader/writer discrimination just in case
-                (*it).mp_receiver->associateEndpoint(endp);
+                (*it).associateEndpoint(endp);
                 // end association between reader/writer and the receive resources
             }
 
@@ -901,8 +1032,11 @@ bool RTPSParticipantImpl::createSendResources(Endpoint *pend)
     return true;
 }
 
-void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation)
+void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation, bool UseWorkerPool)
 {
+    const uint32_t max_message_size = m_network_Factory.get_max_message_size_between_transports();
+    UseWorkerPool = UseWorkerPool && (m_att.listenWorkerThreads > 0);
+
     std::vector<ReceiverResource> newItemsBuffer;
 
     for(auto it_loc = Locator_list.begin(); it_loc != Locator_list.end(); ++it_loc)
@@ -924,14 +1058,27 @@ void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, b
             std::lock_guard<std::mutex> lock(m_receiverResourcelistMutex);
             //Push the new items into the ReceiverResource buffer
             m_receiverResourcelist.push_back(ReceiverControlBlock(std::move(*it_buffer)));
-            //Create and init the MessageReceiver
-            m_receiverResourcelist.back().mp_receiver = new MessageReceiver(this,
-                    m_network_Factory.get_max_message_size_between_transports());
-            m_receiverResourcelist.back().mp_receiver->init(m_network_Factory.get_max_message_size_between_transports());
-
-            //Init the thread
-            m_receiverResourcelist.back().m_thread = new std::thread(&RTPSParticipantImpl::performListenOperation, this,
-                    &(m_receiverResourcelist.back()),(*it_loc));
+
+            if(UseWorkerPool)
+            {
+                //Create the worker pool, which owns a MessageReceiver per worker
+                m_receiverResourcelist.back().mp_workers = new ReceiverWorkerPool(this,
+                        &m_receiverResourcelist.back().Receiver, m_att.listenWorkerThreads, m_att.listenBufferPoolSize, max_message_size);
+
+                //Init the thread
+                m_receiverResourcelist.back().m_thread = new std::thread(&RTPSParticipantImpl::performPooledListenOperation,
+                        this, &(m_receiverResourcelist.back()), (*it_loc));
+            }
+            else
+            {
+                //Create and init the MessageReceiver
+                m_receiverResourcelist.back().mp_receiver = new MessageReceiver(this, max_message_size);
+                m_receiverResourcelist.back().mp_receiver->init(max_message_size);
+
+                //Init the thread
+                m_receiverResourcelist.back().m_thread = new std::thread(&RTPSParticipantImpl::performListenOperation, this,
+                        &(m_receiverResourcelist.back()),(*it_loc));
+            }
         }
         newItemsBuffer.clear();
     }
@@ -943,7 +1090,7 @@ bool RTPSParticipantImpl::deleteUserEndpoint(Endpoint* p_endpoint)
 {
     m_receiverResourcelistMutex.lock();
     for(auto it=m_receiverResourcelist.begin();it!=m_receiverResourcelist.end();++it){
-        (*it).mp_receiver->removeEndpoint(p_endpoint);
+        (*it).removeEndpoint(p_endpoint);
     }
     m_receiverResourcelistMutex.unlock();
 
@@ -1073,9 +1220,31 @@ std::vector<std::string> RTPSParticipantImpl::getParticipantNames() const {
     return participant_names;
 }
 
+bool RTPSParticipantImpl::sendThroughSharedMemory(CDRMessage_t* msg, const Locator_t& shared_mem_loc)
+{
+    for (auto it = m_sharedMemSenderResource.begin(); it != m_sharedMemSenderResource.end(); ++it)
+    {
+        if ((*it).Send(msg->buffer, msg->length, shared_mem_loc))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void RTPSParticipantImpl::sendSync(CDRMessage_t* msg, Endpoint *pend, const Locator_t& destination_loc)
 {
     std::lock_guard<std::mutex> guard(m_send_resources_mutex);
+
+    Locator_t sharedMemLocator;
+    if (!m_sharedMemSenderResource.empty() &&
+            m_network_Factory.get_shared_memory_locator(destination_loc, sharedMemLocator) &&
+            sendThroughSharedMemory(msg, sharedMemLocator))
+    {
+        return;
+    }
+
     for (auto it = m_senderResource.begin(); it != m_senderResource.end(); ++it)
     {
         bool sendThroughResource = false;
@@ -1095,6 +1264,61 @@ void RTPSParticipantImpl::sendSync(CDRMessage_t* msg, Endpoint *pend, const Loca
     }
 }
 
+void RTPSParticipantImpl::sendSync(CDRMessage_t* msg, Endpoint *pend, const LocatorList_t& destination_locs)
+{
+    std::lock_guard<std::mutex> guard(m_send_resources_mutex);
+
+    // Destinations in this host reached through shared memory are removed from the batch.
+    const LocatorList_t* destinations = &destination_locs;
+    if (!m_sharedMemSenderResource.empty())
+    {
+        // Several addresses of the same host may point to the same port. It only receives the message once.
+        LocatorList_t& remainingLocators = m_remainingLocators;
+        std::vector<uint32_t>& sharedMemPorts = m_sharedMemPorts;
+        remainingLocators.clear();
+        sharedMemPorts.clear();
+        for (auto lit = destination_locs.begin(); lit != destination_locs.end(); ++lit)
+        {
+            Locator_t sharedMemLocator;
+            if (!m_network_Factory.get_shared_memory_locator(*lit, sharedMemLocator))
+            {
+                remainingLocators.push_back(*lit);
+            }
+            else if (std::find(sharedMemPorts.begin(), sharedMemPorts.end(), sharedMemLocator.port) == sharedMemPorts.end())
+            {
+                if (sendThroughSharedMemory(msg, sharedMemLocator))
+                    sharedMemPorts.push_back(sharedMemLocator.port);
+                else
+                    remainingLocators.push_back(*lit);
+            }
+        }
+        destinations = &remainingLocators;
+    }
+
+    if (destinations->begin() == destinations->end())
+    {
+        return;
+    }
+
+    for (auto it = m_senderResource.begin(); it != m_senderResource.end(); ++it)
+    {
+        bool sendThroughResource = false;
+        for (auto sit = pend->m_att.outLocatorList.begin(); sit != pend->m_att.outLocatorList.end(); ++sit)
+        {
+            if ((*it).SupportsLocator((*sit)))
+            {
+                sendThroughResource = true;
+                break;
+            }
+        }
+
+        if (sendThroughResource)
+        {
+            (*it).SendBatch(msg->buffer, msg->length, *destinations);
+        }
+    }
+}
+
 void RTPSParticipantImpl::announceRTPSParticipantState()
 {
     return mp_builtinProtocols->announceRTPSParticipantState();
@@ -1127,22 +1351,6 @@ bool RTPSParticipantImpl::newRemoteEndpointDiscovered(const GUID_t& pguid, int16
     return mp_builtinProtocols->mp_PDP->newRemoteEndpointStaticallyDiscovered(pguid,userDefinedId,kind);
 }
 
-void RTPSParticipantImpl::ResourceSemaphorePost()
-{
-    if(mp_ResourceSemaphore != nullptr)
-    {
-        mp_ResourceSemaphore->post();
-    }
-}
-
-void RTPSParticipantImpl::ResourceSemaphoreWait()
-{
-    if (mp_ResourceSemaphore != nullptr)
-    {
-        mp_ResourceSemaphore->wait();
-    }
-
-}
 
 void RTPSParticipantImpl::assertRemoteRTPSParticipantLiveliness(const GuidPrefix_t& guidP)
 {
@@ -1227,6 +1435,26 @@ bool RTPSParticipantImpl::get_remote_reader_info(const GUID_t& readerGuid, Reade
     return false;
 }
 
+ParticipantStatistics RTPSParticipantImpl::get_statistics()
+{
+    ParticipantStatistics statistics;
+
+    {
+        std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+        for(RTPSWriter* writer : m_allWriterList)
+            statistics.endpoints += writer->get_statistics();
+        for(RTPSReader* reader : m_allReaderList)
+            statistics.endpoints += reader->get_statistics();
+    }
+
+    std::lock_guard<std::mutex> guard(m_receiverResourcelistMutex);
+    statistics.receivers.reserve(m_receiverResourcelist.size());
+    for(const ReceiverControlBlock& block : m_receiverResourcelist)
+        statistics.receivers.push_back(block.Receiver.Statistics());
+
+    return statistics;
+}
+
 IPersistenceService* RTPSParticipantImpl::get_persistence_service(const EndpointAttributes& param)
 {
     IPersistenceService* ret_val;
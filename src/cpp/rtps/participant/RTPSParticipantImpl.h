@@ -44,6 +44,7 @@
 #include <fastrtps/rtps/network/SenderResource.h>
 #include <fastrtps/rtps/messages/MessageReceiver.h>
 #include <fastrtps/rtps/security/accesscontrol/ParticipantSecurityAttributes.h>
+#include "ReceiverWorkerPool.h"
 
 #if HAVE_SECURITY
 #include "../security/SecurityManager.h"
@@ -62,7 +63,7 @@ namespace rtps {
 class RTPSParticipant;
 class RTPSParticipantListener;
 class ResourceEvent;
-class AsyncWriterThread;
+class AsyncSendScheduler;
 class BuiltinProtocols;
 struct CDRMessage_t;
 class Endpoint;
@@ -88,21 +89,43 @@ class IPersistenceService;
    -A mutex for the lists
    The idea is to create the thread that performs blocking calllto ReceiverResource.Receive and processes the message
    from the Receiver, so the Transport Layer does not need to be aware of the existence of what is using it.
+   When the participant is configured with listen worker threads, the message processing is handed to a
+   ReceiverWorkerPool instead, and the MessageReceivers live inside the pool (one per worker).
 
 */
 typedef struct ReceiverControlBlock
 {
     ReceiverResource Receiver;
     MessageReceiver* mp_receiver; //Associated Readers/Writers inside of MessageReceiver
+    ReceiverWorkerPool* mp_workers; //Only used when messages are processed outside the listening thread
     std::thread* m_thread;
     std::atomic<bool> resourceAlive;
-    ReceiverControlBlock(ReceiverResource&& rec):Receiver(std::move(rec)), mp_receiver(nullptr), m_thread(nullptr), resourceAlive(true)
+    ReceiverControlBlock(ReceiverResource&& rec):Receiver(std::move(rec)), mp_receiver(nullptr), mp_workers(nullptr),
+        m_thread(nullptr), resourceAlive(true)
     {
     }
-    ReceiverControlBlock(ReceiverControlBlock&& origen):Receiver(std::move(origen.Receiver)), mp_receiver(origen.mp_receiver), m_thread(origen.m_thread), resourceAlive(true)
+    ReceiverControlBlock(ReceiverControlBlock&& origen):Receiver(std::move(origen.Receiver)), mp_receiver(origen.mp_receiver),
+        mp_workers(origen.mp_workers), m_thread(origen.m_thread), resourceAlive(true)
     {
         origen.m_thread = nullptr;
         origen.mp_receiver = nullptr;
+        origen.mp_workers = nullptr;
+    }
+
+    void associateEndpoint(Endpoint* to_add)
+    {
+        if(mp_workers != nullptr)
+            mp_workers->associateEndpoint(to_add);
+        else
+            mp_receiver->associateEndpoint(to_add);
+    }
+
+    void removeEndpoint(Endpoint* to_remove)
+    {
+        if(mp_workers != nullptr)
+            mp_workers->removeEndpoint(to_remove);
+        else
+            mp_receiver->removeEndpoint(to_remove);
     }
 
     private:
@@ -166,14 +189,14 @@ class RTPSParticipantImpl
          * @return RTPSParticipant ID
          */
         inline uint32_t getRTPSParticipantID() const { return (uint32_t)m_att.participantID;};
-        //!Post to the resource semaphore
-        void ResourceSemaphorePost();
-        //!Wait for the resource semaphore
-        void ResourceSemaphoreWait();
         //!Get Pointer to the Event Resource.
         ResourceEvent& getEventResource();
+        //!Get the scheduler running the asynchronous sends of the writers of this participant.
+        AsyncSendScheduler& async_send_scheduler() const { return *mp_async_scheduler; }
         //!Send Method - Deprecated - Stays here for reference purposes
         void sendSync(CDRMessage_t* msg, Endpoint *pend, const Locator_t& destination_loc);
+        //!Send Method to several destinations, letting each transport batch the datagrams.
+        void sendSync(CDRMessage_t* msg, Endpoint *pend, const LocatorList_t& destination_locs);
         //!Get the participant Mutex
         std::recursive_mutex* getParticipantMutex() const {return mp_mutex;};
         /**
@@ -228,6 +251,9 @@ class RTPSParticipantImpl
 
         bool get_remote_reader_info(const GUID_t& readerGuid, ReaderProxyData& returnedInfo);
 
+        //! Sums the statistics of all the endpoints and collects those of the receiver resources.
+        ParticipantStatistics get_statistics();
+
         NetworkFactory& network_factory() { return m_network_Factory; }
 
         uint32_t get_min_network_send_buffer_size() { return m_network_Factory.get_min_send_buffer_size(); }
@@ -241,10 +267,10 @@ class RTPSParticipantImpl
         // ResourceSend* mp_send_thr;
         //! Event Resource
         ResourceEvent* mp_event_thr;
+        //! Sender threads of the asynchronous writes
+        AsyncSendScheduler* mp_async_scheduler;
         //! BuiltinProtocols of this RTPSParticipant
         BuiltinProtocols* mp_builtinProtocols;
-        //!Semaphore to wait for the listen thread creation.
-        Semaphore* mp_ResourceSemaphore;
         //!Id counter to correctly assign the ids to writers and readers.
         uint32_t IdCounter;
         //!Writer List.
@@ -275,6 +301,12 @@ class RTPSParticipantImpl
         //!SenderResource List
         std::mutex m_send_resources_mutex;
         std::vector<SenderResource> m_senderResource;
+        //!SenderResources of the shared memory transport, used for destinations in this host
+        std::vector<SenderResource> m_sharedMemSenderResource;
+        //!Destinations of the batch being sent not reached through shared memory, reused by every send
+        LocatorList_t m_remainingLocators;
+        //!Shared memory ports already sent to in the batch being sent, reused by every send
+        std::vector<uint32_t> m_sharedMemPorts;
 
         //!Participant Listener
         RTPSParticipantListener* mp_participantListener;
@@ -320,6 +352,28 @@ class RTPSParticipantImpl
           */
         void performListenOperation(ReceiverControlBlock *receiver, Locator_t input_locator);
 
+        /** Sends through the shared memory transport. m_send_resources_mutex must be locked by the caller.
+          @param msg - Message to send
+          @param shared_mem_loc - Shared memory locator of the destination
+          @return false when the destination has no shared memory channel or it is full, so the message
+          has to be sent through other transports
+          */
+        bool sendThroughSharedMemory(CDRMessage_t* msg, const Locator_t& shared_mem_loc);
+
+        /** Variant of performListenOperation used when the transport is able to receive several messages on each
+          call. The additional reception buffers are owned by the listening thread.
+          @param receiver - Control block of the ReceiverResource
+          @param input_locator - Locator that triggered the creation of the resource
+          */
+        void performBatchedListenOperation(ReceiverControlBlock *receiver, Locator_t input_locator);
+
+        /** Function to be called from a new thread when the ReceiverResource has a ReceiverWorkerPool. It only
+          drains the ReceiverResource into the buffers of the pool, which decodes the messages in its own threads.
+          @param receiver - Control block of the ReceiverResource
+          @param input_locator - Locator that triggered the creation of the resource
+          */
+        void performPooledListenOperation(ReceiverControlBlock *receiver, Locator_t input_locator);
+
         /** Create non-existent SendResources based on the Locator list of the entity
           @param pend - Pointer to the endpoint whose SenderResources are to be created
           */
@@ -459,9 +513,10 @@ class RTPSParticipantImpl
           some and updating the list. DOES NOT associate endpoints with it.
           @param Locator_list - Locator list to be used to create the ReceiverResources
           @param ApplyMutation - True if we want to create a Resource with a "similar" locator if the one we provide is unavailable
+          @param UseWorkerPool - True if the messages should be processed by listen worker threads, when configured
           */
         static const int MutationTries = 100;
-        void createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation);
+        void createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation, bool UseWorkerPool = false);
 
         bool networkFactoryHasRegisteredTransports() const;
 
@@ -0,0 +1,236 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceiverWorkerPool.cpp
+ */
+
+#include "ReceiverWorkerPool.h"
+#include "RTPSParticipantImpl.h"
+
+#include <fastrtps/rtps/messages/MessageReceiver.h>
+#include <fastrtps/log/Log.h>
+
+#include <cassert>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+ReceiverWorkerPool::ReceiverWorkerPool(RTPSParticipantImpl* participant, ReceiverResource* resource,
+        uint32_t num_workers, uint32_t num_buffers, uint32_t max_message_size) :
+    participant_(participant), resource_(resource), running_(true)
+{
+    assert(num_workers > 0);
+
+    // At least one buffer per worker, so none of them starves.
+    if(num_buffers < num_workers)
+    {
+        num_buffers = num_workers;
+    }
+
+    slots_.reserve(num_buffers);
+    free_slots_.reserve(num_buffers);
+    for(uint32_t i = 0; i < num_buffers; ++i)
+    {
+        Slot* slot = new Slot(max_message_size);
+        slot->index = i;
+        slots_.push_back(slot);
+        free_slots_.push_back(i);
+    }
+
+    workers_.reserve(num_workers);
+    for(uint32_t i = 0; i < num_workers; ++i)
+    {
+        Worker* worker = new Worker(num_buffers);
+        worker->receiver = new MessageReceiver(participant_, max_message_size);
+        worker->receiver->init(max_message_size);
+        workers_.push_back(worker);
+    }
+
+    for(Worker* worker : workers_)
+    {
+        worker->thread = new std::thread(&ReceiverWorkerPool::run, this, worker);
+    }
+
+    logInfo(RTPS_MSG_IN, "Created receiver worker pool with " << num_workers << " workers and "
+            << num_buffers << " buffers of size " << max_message_size);
+}
+
+ReceiverWorkerPool::~ReceiverWorkerPool()
+{
+    stop();
+
+    for(Worker* worker : workers_)
+    {
+        delete worker->receiver;
+        delete worker;
+    }
+
+    for(Slot* slot : slots_)
+    {
+        delete slot;
+    }
+}
+
+ReceiverWorkerPool::Slot* ReceiverWorkerPool::acquire()
+{
+    std::unique_lock<std::mutex> lock(free_mutex_);
+    free_cv_.wait(lock, [&]() { return !free_slots_.empty() || !running_; });
+
+    if(!running_)
+    {
+        return nullptr;
+    }
+
+    Slot* slot = slots_[free_slots_.back()];
+    free_slots_.pop_back();
+    return slot;
+}
+
+ReceiverWorkerPool::Slot* ReceiverWorkerPool::try_acquire()
+{
+    std::lock_guard<std::mutex> lock(free_mutex_);
+
+    if(!running_ || free_slots_.empty())
+    {
+        return nullptr;
+    }
+
+    Slot* slot = slots_[free_slots_.back()];
+    free_slots_.pop_back();
+    return slot;
+}
+
+void ReceiverWorkerPool::release(Slot* slot)
+{
+    std::unique_lock<std::mutex> lock(free_mutex_);
+    free_slots_.push_back(slot->index);
+    lock.unlock();
+    free_cv_.notify_one();
+}
+
+void ReceiverWorkerPool::dispatch(Slot* slot)
+{
+    if(slot->msg.length < RTPSMESSAGE_HEADER_SIZE)
+    {
+        release(slot);
+        return;
+    }
+
+    Worker* worker = workers_[select_worker(slot->msg)];
+
+    std::unique_lock<std::mutex> lock(worker->mtx);
+    // The ring has room for every buffer of the pool, so it never overflows.
+    uint32_t capacity = static_cast<uint32_t>(worker->ring.size());
+    worker->ring[(worker->head + worker->count) % capacity] = slot->index;
+    ++worker->count;
+    lock.unlock();
+    worker->cv.notify_one();
+}
+
+void ReceiverWorkerPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(free_mutex_);
+        if(!running_)
+        {
+            return;
+        }
+        running_ = false;
+    }
+    free_cv_.notify_all();
+
+    for(Worker* worker : workers_)
+    {
+        {
+            std::lock_guard<std::mutex> lock(worker->mtx);
+        }
+        worker->cv.notify_all();
+    }
+
+    for(Worker* worker : workers_)
+    {
+        if(worker->thread != nullptr)
+        {
+            worker->thread->join();
+            delete worker->thread;
+            worker->thread = nullptr;
+        }
+    }
+}
+
+void ReceiverWorkerPool::associateEndpoint(Endpoint* to_add)
+{
+    for(Worker* worker : workers_)
+    {
+        worker->receiver->associateEndpoint(to_add);
+    }
+}
+
+void ReceiverWorkerPool::removeEndpoint(Endpoint* to_remove)
+{
+    for(Worker* worker : workers_)
+    {
+        worker->receiver->removeEndpoint(to_remove);
+    }
+}
+
+uint32_t ReceiverWorkerPool::select_worker(const CDRMessage_t& msg) const
+{
+    // The GuidPrefix of the source participant follows the protocol version and the vendor id.
+    const octet* prefix = &msg.buffer[8];
+
+    // FNV-1a over the 12 octets of the GuidPrefix.
+    uint32_t hash = 2166136261U;
+    for(uint32_t i = 0; i < 12; ++i)
+    {
+        hash ^= prefix[i];
+        hash *= 16777619U;
+    }
+
+    return hash % static_cast<uint32_t>(workers_.size());
+}
+
+void ReceiverWorkerPool::run(Worker* worker)
+{
+    const GuidPrefix_t& local_prefix = participant_->getGuid().guidPrefix;
+
+    while(true)
+    {
+        std::unique_lock<std::mutex> lock(worker->mtx);
+        worker->cv.wait(lock, [&]() { return worker->count > 0 || !running_; });
+
+        if(!running_)
+        {
+            break;
+        }
+
+        Slot* slot = slots_[worker->ring[worker->head]];
+        worker->head = (worker->head + 1) % static_cast<uint32_t>(worker->ring.size());
+        --worker->count;
+        lock.unlock();
+
+        if(!worker->receiver->processCDRMsg(local_prefix, &slot->origin, &slot->msg))
+        {
+            resource_->CountDropped();
+        }
+
+        release(slot);
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
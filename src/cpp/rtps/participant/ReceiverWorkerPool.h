@@ -0,0 +1,153 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceiverWorkerPool.h
+ */
+
+#ifndef _RTPS_PARTICIPANT_RECEIVERWORKERPOOL_H_
+#define _RTPS_PARTICIPANT_RECEIVERWORKERPOOL_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+#include <fastrtps/rtps/common/Locator.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class RTPSParticipantImpl;
+class MessageReceiver;
+class ReceiverResource;
+class Endpoint;
+
+/**
+ * Decouples the reception of datagrams from their processing.
+ * The listening thread of a ReceiverResource only drains the socket into a preallocated ring of
+ * CDRMessage_t buffers, and a set of worker threads, each one with its own MessageReceiver, decode
+ * and dispatch the submessages.
+ * All messages coming from the same source participant are always processed by the same worker,
+ * so the order in which the submessages of a remote writer are delivered is preserved.
+ * @ingroup MANAGEMENT_MODULE
+ */
+class ReceiverWorkerPool
+{
+    public:
+
+        //! Reception buffer together with the locator it was received from.
+        struct Slot
+        {
+            Slot(uint32_t max_message_size) : msg(max_message_size), index(0) {}
+
+            CDRMessage_t msg;
+            Locator_t origin;
+            uint32_t index;
+        };
+
+        /**
+         * @param participant Participant owning the listen resource.
+         * @param resource Listen resource, where the datagrams dropped by the workers are accounted.
+         * @param num_workers Number of worker threads.
+         * @param num_buffers Number of preallocated reception buffers.
+         * @param max_message_size Size of each reception buffer.
+         */
+        ReceiverWorkerPool(RTPSParticipantImpl* participant, ReceiverResource* resource, uint32_t num_workers,
+                uint32_t num_buffers, uint32_t max_message_size);
+
+        ~ReceiverWorkerPool();
+
+        /**
+         * Takes a free reception buffer, blocking while all of them are in use.
+         * @return Pointer to the buffer, or nullptr when the pool has been stopped.
+         */
+        Slot* acquire();
+
+        /**
+         * Takes a free reception buffer without blocking.
+         * @return Pointer to the buffer, or nullptr when none is free or the pool has been stopped.
+         */
+        Slot* try_acquire();
+
+        //! Gives back a buffer that was acquired but will not be dispatched.
+        void release(Slot* slot);
+
+        /**
+         * Hands a filled buffer to the worker in charge of its source participant.
+         * The buffer returns to the free ring once the worker has processed it.
+         */
+        void dispatch(Slot* slot);
+
+        //! Stops the worker threads, unblocking any thread waiting on acquire().
+        void stop();
+
+        //! Associates an endpoint with the MessageReceiver of every worker.
+        void associateEndpoint(Endpoint* to_add);
+
+        //! Removes an endpoint from the MessageReceiver of every worker.
+        void removeEndpoint(Endpoint* to_remove);
+
+    private:
+
+        ReceiverWorkerPool(const ReceiverWorkerPool&) = delete;
+        const ReceiverWorkerPool& operator=(const ReceiverWorkerPool&) = delete;
+
+        //! Fixed-capacity queue of slot indexes pending to be processed by one worker.
+        struct Worker
+        {
+            Worker(uint32_t capacity) : ring(capacity), head(0), count(0),
+                receiver(nullptr), thread(nullptr) {}
+
+            std::vector<uint32_t> ring;
+            uint32_t head;
+            uint32_t count;
+            std::mutex mtx;
+            std::condition_variable cv;
+            MessageReceiver* receiver;
+            std::thread* thread;
+        };
+
+        void run(Worker* worker);
+
+        uint32_t select_worker(const CDRMessage_t& msg) const;
+
+        RTPSParticipantImpl* participant_;
+
+        ReceiverResource* resource_;
+
+        std::vector<Slot*> slots_;
+
+        std::vector<Worker*> workers_;
+
+        //! Indexes of the buffers that are not in use.
+        std::vector<uint32_t> free_slots_;
+
+        std::mutex free_mutex_;
+
+        std::condition_variable free_cv_;
+
+        std::atomic<bool> running_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif // _RTPS_PARTICIPANT_RECEIVERWORKERPOOL_H_
@@ -15,32 +15,55 @@
 #include "FragmentedChangePitStop.h"
 #include <fastrtps/rtps/common/CacheChange.h>
 #include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/utils/TimeConversion.h>
+#include <fastrtps/log/Log.h>
+
+#include <algorithm>
+#include <cstring>
 
 using namespace eprosima::fastrtps::rtps;
 
-CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change, uint32_t sampleSize, uint32_t fragmentStartingNum)
+FragmentedChangePitStop::FragmentedChangePitStop(RTPSReader *parent, const Duration_t& timeout) :
+    parent_(parent), timeout_(std::chrono::steady_clock::duration::zero()),
+    next_stale_check_(std::chrono::steady_clock::now())
 {
-    CacheChange_t* returnedValue = nullptr;
+    if(timeout != c_TimeInfinite)
+    {
+        int64_t milliseconds = TimeConv::Time_t2MilliSecondsInt64(timeout);
+        if(milliseconds > 0)
+            timeout_ = std::chrono::milliseconds(milliseconds);
+    }
+}
 
-    // Search CacheChange_t with the sample sequence number.
-    auto range = changes_.equal_range(ChangeInPit(incoming_change));
+FragmentedChangePitStop::~FragmentedChangePitStop()
+{
+    for(auto& change : changes_)
+        parent_->releaseCache(change.second.change_);
+}
 
-    auto original_change_cit = range.first;
+CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change, uint32_t sampleSize, uint32_t fragmentStartingNum)
+{
+    CacheChange_t* returnedValue = nullptr;
+    auto now = std::chrono::steady_clock::now();
 
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(original_change_cit != changes_.end())
+    // Discard samples that stopped receiving fragments before they grow the pit stop.
+    if(timeout_ != std::chrono::steady_clock::duration::zero() && now >= next_stale_check_)
     {
-        for(; original_change_cit != range.second; ++original_change_cit)
-        {
-            if(original_change_cit->getChange()->writerGUID == incoming_change->writerGUID)
-                break;
-        }
+        remove_changes_not_updated_since_(now - timeout_);
+        next_stale_check_ = now + timeout_;
     }
-    else
-        original_change_cit = range.second;
+
+    const uint32_t fragment_size = incoming_change->getFragmentSize();
+    const uint32_t fragments_in_submessage = incoming_change->getFragmentCount();
+
+    if(fragment_size == 0 || fragments_in_submessage == 0 || fragmentStartingNum == 0)
+        return nullptr;
+
+    // Search CacheChange_t with the sample writer GUID_t and sequence number.
+    auto original_change_it = changes_.find(ChangeKey(incoming_change->writerGUID, incoming_change->sequenceNumber));
 
     // If not found an existing CacheChange_t, reserve one and insert.
-    if(original_change_cit == range.second)
+    if(original_change_it == changes_.end())
     {
         CacheChange_t* original_change = nullptr;
 
@@ -60,48 +83,62 @@ CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change,
         original_change->setFragmentSize(incoming_change->getFragmentSize());
 
         // Insert
-        original_change_cit = changes_.insert(ChangeInPit(original_change));
+        original_change_it = changes_.emplace(ChangeKey(incoming_change->writerGUID, incoming_change->sequenceNumber),
+                ChangeInPit{original_change, now}).first;
+    }
+
+    CacheChange_t* original_change = original_change_it->second.change_;
+    FragmentBitmap_t& fragments = original_change->getDataFragments();
+
+    if(original_change->getFragmentSize() != fragment_size)
+    {
+        logWarning(RTPS_MSG_IN, "Fragment size " << fragment_size << " of sample " << incoming_change->sequenceNumber <<
+                " differs from previous fragments (" << original_change->getFragmentSize() << ")");
+        return nullptr;
     }
 
+    const uint32_t first = fragmentStartingNum - 1;
+    const uint32_t last = std::min(first + fragments_in_submessage, fragments.size());
+    const uint32_t sample_length = original_change->serializedPayload.length;
     bool was_updated = false;
-    for (uint32_t count = (fragmentStartingNum - 1); count < (fragmentStartingNum - 1) + incoming_change->getFragmentCount(); ++count)
+
+    // Consecutive fragments not present yet are copied at once into their final place.
+    uint32_t position = fragments.find_next(first, false);
+    while(position < last)
     {
-        if(original_change_cit->getChange()->getDataFragments()->at(count) == ChangeFragmentStatus_t::NOT_PRESENT)
+        uint32_t run_end = std::min(fragments.find_next(position, true), last);
+        uint32_t offset = position * fragment_size;
+        // Last fragment may be shorter than the others.
+        uint32_t length = std::min(run_end * fragment_size, sample_length) - offset;
+        uint32_t incoming_offset = (position - first) * fragment_size;
+
+        if(incoming_offset + length > incoming_change->serializedPayload.length)
         {
-            // All cases minus last fragment.
-            if (count + 1 != original_change_cit->getChange()->getFragmentCount())
-            {
-                memcpy(original_change_cit->getChange()->serializedPayload.data + count * original_change_cit->getChange()->getFragmentSize(),
-                        incoming_change->serializedPayload.data + (count - (fragmentStartingNum - 1)) * incoming_change->getFragmentSize(), incoming_change->getFragmentSize());
-            }
-            // Last fragment is a special case when copying.
-            else
-            {
-                memcpy(original_change_cit->getChange()->serializedPayload.data + count * original_change_cit->getChange()->getFragmentSize(),
-                        incoming_change->serializedPayload.data + (count - (fragmentStartingNum - 1)) * incoming_change->getFragmentSize(), original_change_cit->getChange()->serializedPayload.length - (count * original_change_cit->getChange()->getFragmentSize()));
-            }
-
-            original_change_cit->getChange()->getDataFragments()->at(count) = ChangeFragmentStatus_t::PRESENT;
-
-            was_updated = true;
+            logWarning(RTPS_MSG_IN, "Fragments of sample " << incoming_change->sequenceNumber <<
+                    " exceed the received payload");
+            break;
         }
+
+        memcpy(original_change->serializedPayload.data + offset,
+                incoming_change->serializedPayload.data + incoming_offset, length);
+
+        for(; position < run_end; ++position)
+            fragments.set(position);
+
+        was_updated = true;
+        position = fragments.find_next(run_end, false);
     }
 
     // If was updated, check if it is completed.
     if(was_updated)
     {
-        auto fit = original_change_cit->getChange()->getDataFragments()->begin();
-        for(; fit != original_change_cit->getChange()->getDataFragments()->end(); ++fit)
-        {
-            if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                break;
-        }
+        original_change_it->second.last_update_ = now;
 
         // If it is completed, return CacheChange_t and remove information.
-        if(fit == original_change_cit->getChange()->getDataFragments()->end())
+        if(fragments.all())
         {
-            returnedValue = original_change_cit->getChange();
-            changes_.erase(original_change_cit);
+            returnedValue = original_change;
+            changes_.erase(original_change_it);
         }
     }
 
@@ -110,73 +147,78 @@ CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change,
 
 CacheChange_t* FragmentedChangePitStop::find(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
 {
-    CacheChange_t* returnedValue = nullptr;
+    auto it = changes_.find(ChangeKey(writer_guid, sequence_number));
 
-    auto range = changes_.equal_range(ChangeInPit(sequence_number));
+    if(it != changes_.end())
+        return it->second.change_;
 
-    auto cit = range.first;
+    return nullptr;
+}
 
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(cit != changes_.end())
+bool FragmentedChangePitStop::try_to_remove(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
+{
+    auto it = changes_.find(ChangeKey(writer_guid, sequence_number));
+
+    if(it != changes_.end())
     {
-        for(; cit != range.second; ++cit)
-        {
-            if(cit->getChange()->writerGUID == writer_guid)
-            {
-                returnedValue = cit->getChange();
-                break;
-            }
-        }
+        // Destroy CacheChange_t.
+        parent_->releaseCache(it->second.change_);
+        changes_.erase(it);
+        return true;
     }
 
-    return returnedValue;
+    return false;
 }
 
-bool FragmentedChangePitStop::try_to_remove(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
+bool FragmentedChangePitStop::try_to_remove_until(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
 {
     bool returnedValue = false;
 
-    auto range = changes_.equal_range(ChangeInPit(sequence_number));
-
-    auto cit = range.first;
-
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(cit != changes_.end())
+    auto it = changes_.begin();
+    while(it != changes_.end())
     {
-        for(; cit != range.second; ++cit)
+        if(it->first.sequence_number_ < sequence_number &&
+                it->first.writer_guid_ == writer_guid)
         {
-            if(cit->getChange()->writerGUID == writer_guid)
-            {
-                // Destroy CacheChange_t.
-                parent_->releaseCache(cit->getChange());
-                changes_.erase(cit);
-                returnedValue = true;
-                break;
-            }
+            // Destroy CacheChange_t.
+            parent_->releaseCache(it->second.change_);
+            it = changes_.erase(it);
+            returnedValue = true;
         }
+        else
+            ++it;
     }
 
     return returnedValue;
 }
 
-bool FragmentedChangePitStop::try_to_remove_until(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
+size_t FragmentedChangePitStop::remove_stale_changes()
 {
-    bool returnedValue = false;
+    if(timeout_ == std::chrono::steady_clock::duration::zero())
+        return 0;
+
+    return remove_changes_not_updated_since_(std::chrono::steady_clock::now() - timeout_);
+}
+
+size_t FragmentedChangePitStop::remove_changes_not_updated_since_(const std::chrono::steady_clock::time_point& limit)
+{
+    size_t removed = 0;
 
-    auto cit = changes_.begin();
-    while(cit != changes_.end())
+    auto it = changes_.begin();
+    while(it != changes_.end())
     {
-        if(cit->getChange()->sequenceNumber < sequence_number &&
-                cit->getChange()->writerGUID == writer_guid)
+        if(it->second.last_update_ < limit)
         {
-            // Destroy CacheChange_t.
-            parent_->releaseCache(cit->getChange());
-            cit = changes_.erase(cit);
-            returnedValue = true;
+            logInfo(RTPS_MSG_IN, "Discarding uncompleted sample " << it->first.sequence_number_ << " of writer " <<
+                    it->first.writer_guid_ << " (" << it->second.change_->getDataFragments().count() << "/" <<
+                    it->second.change_->getFragmentCount() << " fragments)");
+            parent_->releaseCache(it->second.change_);
+            it = changes_.erase(it);
+            ++removed;
         }
         else
-            ++cit;
+            ++it;
     }
 
-    return returnedValue;
+    return removed;
 }
@@ -20,8 +20,10 @@
 
 #include <fastrtps/fastrtps_dll.h>
 #include <fastrtps/rtps/common/CacheChange.h>
+#include <fastrtps/rtps/common/Time_t.h>
 
-#include <unordered_set>
+#include <chrono>
+#include <unordered_map>
 
 namespace eprosima
 {
@@ -34,58 +36,47 @@ namespace eprosima
 
             /*!
              * @brief Manages not completed fragmented CacheChanges in reader side.
+             * Fragments are copied straight into the payload of the CacheChange_t that will be delivered,
+             * one copy per run of consecutive fragments received, and the received ones are tracked with a bitmap.
+             * Samples not receiving fragments during a configurable time are discarded to bound the used memory.
              * @remarks This class is non thread-safe.
              */
             class FragmentedChangePitStop
             {
+                /*!
+                 * @brief Key of the not completed CacheChanges.
+                 */
+                struct ChangeKey
+                {
+                    ChangeKey(const GUID_t& writer_guid, const SequenceNumber_t& sequence_number) :
+                        writer_guid_(writer_guid), sequence_number_(sequence_number) {}
+
+                    bool operator==(const ChangeKey& key) const
+                    {
+                        return sequence_number_ == key.sequence_number_ && writer_guid_ == key.writer_guid_;
+                    }
+
+                    GUID_t writer_guid_;
+                    SequenceNumber_t sequence_number_;
+                };
+
+                struct ChangeKeyHash
+                {
+                    std::size_t operator()(const ChangeKey& key) const
+                    {
+                        return std::hash<GUID_t>{}(key.writer_guid_) ^ (SequenceNumberHash{}(key.sequence_number_) * 31);
+                    }
+                };
+
                 /*!
                  * @brief Objects used by FragmentedChangePitStop internally.
                  */
-                class ChangeInPit
+                struct ChangeInPit
                 {
-                    public:
-
-                        /*!
-                         * @brief Relates a CacheChange_t with this ChangeInPit.
-                         * This constructor has to be used if the ChangeInPit will be used to be stored in a container.
-                         * @param change Related CacheChange_t.
-                         */
-                        ChangeInPit(CacheChange_t* change) : sequence_number_(change->sequenceNumber), change_(change) {};
-
-                        /*!
-                         * @brief Constructor used to generated a simple key for searching in a container.
-                         * @param sequence_number SequenceNumber_t used as key.
-                         * @remarks Not use this constructor if the object will be stored in a container.
-                         */
-                        ChangeInPit(const SequenceNumber_t &sequence_number) : sequence_number_(sequence_number), change_(nullptr) {};
-
-                        ChangeInPit(const ChangeInPit& cip) : sequence_number_(cip.sequence_number_), change_(cip.change_) {};
-
-                        CacheChange_t* getChange() const { return change_; }
-
-                        bool operator==(const ChangeInPit& cip) const
-                        {
-                            return sequence_number_ == cip.sequence_number_;
-                        }
-
-                    private:
-
-                        ChangeInPit& operator=(const ChangeInPit& cip) = delete;
-
-                        const SequenceNumber_t sequence_number_;
-                        CacheChange_t* change_;
-
-                    public:
-                        /*!
-                         * @brief Defined the STD hash function for ChangeInPit.
-                         */
-                        struct ChangeInPitHash
-                        {
-                            std::size_t operator()(const ChangeInPit& cip) const
-                            {
-                                return SequenceNumberHash{}(cip.sequence_number_);
-                            }
-                        };
+                    CacheChange_t* change_;
+
+                    //! Last time a new fragment of the change was received.
+                    std::chrono::steady_clock::time_point last_update_;
                 };
 
                 public:
@@ -94,8 +85,12 @@ namespace eprosima
                  * @brief Default constructor.
                  * @param parent RTPSReader managing this object.
                  * It is necessary the access to reserve a new CacheChange_t.
+                 * @param timeout Time a not completed CacheChange_t is kept without receiving new fragments.
+                 * c_TimeInfinite keeps them until they are removed explicitly.
                  */
-                FragmentedChangePitStop(RTPSReader *parent) : parent_(parent) {}
+                FragmentedChangePitStop(RTPSReader *parent, const Duration_t& timeout = c_TimeInfinite);
+
+                ~FragmentedChangePitStop();
 
                 /*!
                  * @brief Process incomming fragments.
@@ -136,12 +131,31 @@ namespace eprosima
                  */
                 bool try_to_remove_until(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid);
 
+                /*!
+                 * @brief Removes the CacheChange_t that have not received new fragments during the timeout.
+                 * It is also called when processing fragments. The reader calls it periodically for the case
+                 * no fragments are being received.
+                 * @return Number of CacheChange_t removed.
+                 */
+                size_t remove_stale_changes();
+
+                //! @return Number of CacheChange_t waiting to be completed.
+                size_t size() const { return changes_.size(); }
+
                 private:
 
-                std::unordered_multiset<ChangeInPit, ChangeInPit::ChangeInPitHash> changes_;
+                size_t remove_changes_not_updated_since_(const std::chrono::steady_clock::time_point& limit);
+
+                std::unordered_map<ChangeKey, ChangeInPit, ChangeKeyHash> changes_;
 
                 RTPSReader* parent_;
 
+                //! Zero when the CacheChange_t are never discarded.
+                std::chrono::steady_clock::duration timeout_;
+
+                //! Next time the pit stop will look for stale CacheChange_t when processing fragments.
+                std::chrono::steady_clock::time_point next_stale_check_;
+
                 FragmentedChangePitStop(const FragmentedChangePitStop&) = delete;
 
                 FragmentedChangePitStop& operator=(const FragmentedChangePitStop&) = delete;
@@ -21,6 +21,9 @@
 #include <fastrtps/rtps/history/ReaderHistory.h>
 #include <fastrtps/log/Log.h>
 #include "FragmentedChangePitStop.h"
+#include <fastrtps/rtps/reader/timedevent/FragmentedSampleTimeout.h>
+#include <fastrtps/utils/TimeConversion.h>
+#include "../participant/RTPSParticipantImpl.h"
 
 #include <fastrtps/rtps/reader/ReaderListener.h>
 #include "CompoundReaderListener.h"
@@ -39,17 +42,28 @@ RTPSReader::RTPSReader(RTPSParticipantImpl*pimpl,GUID_t& guid,
     m_acceptMessagesToUnknownReaders(true),
     m_acceptMessagesFromUnkownWriters(true),
     m_expectsInlineQos(att.expectsInlineQos),
-    fragmentedChangePitStop_(nullptr)
+    fragmentedChangePitStop_(nullptr),
+    fragmentedSampleTimeout_(nullptr)
     {
         mp_history->mp_reader = this;
         mp_history->mp_mutex = mp_mutex;
-        fragmentedChangePitStop_ = new FragmentedChangePitStop(this);
+        fragmentedChangePitStop_ = new FragmentedChangePitStop(this, att.times.fragmentedSampleTimeout);
+        if(att.times.fragmentedSampleTimeout != c_TimeInfinite)
+        {
+            double interval = TimeConv::Time_t2MilliSecondsDouble(att.times.fragmentedSampleTimeout);
+            if(interval > 0)
+            {
+                fragmentedSampleTimeout_ = new FragmentedSampleTimeout(this, pimpl->getEventResource(), interval);
+                fragmentedSampleTimeout_->restart_timer();
+            }
+        }
         logInfo(RTPS_READER,"RTPSReader created correctly");
     }
 
 RTPSReader::~RTPSReader()
 {
     logInfo(RTPS_READER,"Removing reader "<<this->getGuid().entityId;);
+    delete fragmentedSampleTimeout_;
     delete fragmentedChangePitStop_;
     mp_history->mp_reader = nullptr;
     mp_history->mp_mutex = nullptr;
@@ -102,6 +116,12 @@ CacheChange_t* RTPSReader::findCacheInFragmentedCachePitStop(const SequenceNumbe
     return fragmentedChangePitStop_->find(sequence_number, writer_guid);
 }
 
+size_t RTPSReader::remove_stale_fragmented_changes()
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    return fragmentedChangePitStop_->remove_stale_changes();
+}
+
 void RTPSReader::add_persistence_guid(const RemoteWriterAttributes& wdata)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
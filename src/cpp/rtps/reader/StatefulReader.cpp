@@ -596,6 +596,19 @@ bool StatefulReader::nextUntakenCache(CacheChange_t** change,WriterProxy** wpout
     return takeok;
 }
 
+bool StatefulReader::is_change_available(CacheChange_t* change, WriterProxy** wpout)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    WriterProxy* wp;
+    if(!this->matched_writer_lookup(change->writerGUID, &wp))
+        return false;
+
+    if(wpout != nullptr)
+        *wpout = wp;
+
+    return wp->available_changes_max() >= change->sequenceNumber;
+}
+
 // TODO Porque elimina aqui y no cuando hay unpairing
 bool StatefulReader::nextUnreadCache(CacheChange_t** change,WriterProxy** wpout)
 {
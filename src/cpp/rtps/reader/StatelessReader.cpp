@@ -145,6 +145,12 @@ bool StatelessReader::nextUnreadCache(CacheChange_t** change,WriterProxy** /*wpo
     return false;
 }
 
+bool StatelessReader::is_change_available(CacheChange_t* /*change*/, WriterProxy** wpout)
+{
+    if(wpout != nullptr)
+        *wpout = nullptr;
+    return true;
+}
 
 bool StatelessReader::change_removed_by_history(CacheChange_t* /*ch*/, WriterProxy* /*prox*/)
 {
@@ -43,38 +43,29 @@ void WriterProxy::for_each_set_status_from(decltype(WriterProxy::m_changesFromW)
     while(it != last)
     {
         if(it->getStatus() == status)
-        {
-            ChangeFromWriter_t newch(*it);
-            newch.setStatus(new_status);
-
-            auto hint = m_changesFromW.erase(it);
-
-            it = m_changesFromW.insert(hint, newch);
-        }
+            it->setStatus(new_status);
 
         ++it;
     }
 }
 
-void WriterProxy::for_each_set_status_from_and_maybe_remove(decltype(WriterProxy::m_changesFromW)::iterator first,
+size_t WriterProxy::for_each_set_status_from_and_maybe_remove(decltype(WriterProxy::m_changesFromW)::iterator first,
         decltype(WriterProxy::m_changesFromW)::iterator last,
         ChangeFromWriterStatus_t status,
         ChangeFromWriterStatus_t orstatus,
         ChangeFromWriterStatus_t new_status)
 {
+    size_t changed = 0;
     auto it = first;
     while(it != last)
     {
         if(it->getStatus() == status || it->getStatus() == orstatus)
         {
+            ++changed;
+
             if(it != m_changesFromW.begin())
             {
-                ChangeFromWriter_t newch(*it);
-                newch.setStatus(new_status);
-
-                auto hint = m_changesFromW.erase(it);
-
-                it = m_changesFromW.insert(hint, newch);
+                it->setStatus(new_status);
                 ++it;
                 continue;
             }
@@ -88,6 +79,8 @@ void WriterProxy::for_each_set_status_from_and_maybe_remove(decltype(WriterProxy
             it = m_changesFromW.erase(it);
         }
     }
+
+    return changed;
 }
 
 static const int WRITERPROXY_LIVELINESS_PERIOD_MULTIPLIER = 1;
@@ -155,12 +148,12 @@ void WriterProxy::missing_changes_update(const SequenceNumber_t& seqNum)
             // Add requetes sequence number.
             ChangeFromWriter_t newch(seqNum);
             newch.setStatus(ChangeFromWriterStatus_t::MISSING);
-            m_changesFromW.insert(m_changesFromW.end(), newch);
+            m_changesFromW.insert(newch);
         }
         else
         {
             // Find it. Must be there.
-            auto last_it = m_changesFromW.find(ChangeFromWriter_t(seqNum));
+            auto last_it = m_changesFromW.find(seqNum);
             assert(last_it != m_changesFromW.end());
             for_each_set_status_from(m_changesFromW.begin(), ++last_it,
                     ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING);
@@ -190,7 +183,7 @@ bool WriterProxy::maybe_add_changes_from_writer_up_to(const SequenceNumber_t& se
         {
             ChangeFromWriter_t newch(lastSeqNum);
             newch.setStatus(default_status);
-            m_changesFromW.insert(m_changesFromW.end(), newch);
+            m_changesFromW.insert(newch);
         }
     }
 
@@ -207,6 +200,16 @@ void WriterProxy::lost_changes_update(const SequenceNumber_t& seqNum)
     {
         if(m_changesFromW.size() == 0 || m_changesFromW.rbegin()->getSequenceNumber() < seqNum)
         {
+            // Every change up to seqNum not received yet is lost.
+            uint64_t lost = (seqNum - changesFromWLowMark_).to64long() - 1;
+            for(const auto& ch : m_changesFromW)
+            {
+                if(ch.getStatus() == RECEIVED)
+                    --lost;
+            }
+            if(lost > 0)
+                EndpointStatisticsCounters::add(mp_SFR->statistics_counters().samples_lost, lost);
+
             // Remove all because lost or received.
             m_changesFromW.clear();
             // Any in container, then not insert new lost.
@@ -215,11 +218,13 @@ void WriterProxy::lost_changes_update(const SequenceNumber_t& seqNum)
         else
         {
             // Find it. Must be there.
-            auto last_it = m_changesFromW.find(ChangeFromWriter_t(seqNum));
+            auto last_it = m_changesFromW.find(seqNum);
             assert(last_it != m_changesFromW.end());
-            for_each_set_status_from_and_maybe_remove(m_changesFromW.begin(), last_it,
+            size_t lost = for_each_set_status_from_and_maybe_remove(m_changesFromW.begin(), last_it,
                     ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING,
                     ChangeFromWriterStatus_t::LOST);
+            if(lost > 0)
+                EndpointStatisticsCounters::add(mp_SFR->statistics_counters().samples_lost, lost);
             // Next could need to be removed.
             cleanup();
         }
@@ -262,7 +267,7 @@ bool WriterProxy::received_change_set(const SequenceNumber_t& seqNum, bool is_re
             ChangeFromWriter_t chfw(seqNum);
             chfw.setStatus(RECEIVED);
             chfw.setRelevance(is_relevance);
-            m_changesFromW.insert(m_changesFromW.end(), chfw);
+            m_changesFromW.insert(chfw);
         }
         // Else not insert
         else
@@ -271,7 +276,7 @@ bool WriterProxy::received_change_set(const SequenceNumber_t& seqNum, bool is_re
     // Else it has to be found and change state.
     else
     {
-        auto chit = m_changesFromW.find(ChangeFromWriter_t(seqNum));
+        auto chit = m_changesFromW.find(seqNum);
 
         // Has to be in the container.
         assert(chit != m_changesFromW.end());
@@ -280,13 +285,8 @@ bool WriterProxy::received_change_set(const SequenceNumber_t& seqNum, bool is_re
         {
             if(chit->getStatus() != RECEIVED)
             {
-                ChangeFromWriter_t newch(*chit);
-                newch.setStatus(RECEIVED);
-                newch.setRelevance(is_relevance);
-
-                auto hint = m_changesFromW.erase(chit);
-
-                m_changesFromW.insert(hint, newch);
+                chit->setStatus(RECEIVED);
+                chit->setRelevance(is_relevance);
             }
             else
                 return false;
@@ -312,7 +312,7 @@ const std::vector<ChangeFromWriter_t> WriterProxy::missing_changes()
     std::vector<ChangeFromWriter_t> returnedValue;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(auto ch : m_changesFromW)
+    for(const auto& ch : m_changesFromW)
     {
         if(ch.getStatus() == MISSING)
         {
@@ -332,15 +332,18 @@ bool WriterProxy::change_was_received(const SequenceNumber_t& seq_num)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    if(seq_num <= changesFromWLowMark_)
-        return true;
+    bool received = seq_num <= changesFromWLowMark_;
 
-    auto chit = m_changesFromW.find(ChangeFromWriter_t(seq_num));
+    if(!received)
+    {
+        auto chit = m_changesFromW.find(seq_num);
+        received = chit != m_changesFromW.end() && chit->getStatus() == RECEIVED;
+    }
 
-    if(chit != m_changesFromW.end() && chit->getStatus() == RECEIVED)
-        return true;
+    if(received)
+        EndpointStatisticsCounters::add(mp_SFR->statistics_counters().duplicates_received);
 
-    return false;
+    return received;
 }
 
 const SequenceNumber_t WriterProxy::available_changes_max() const
@@ -384,7 +387,7 @@ void WriterProxy::setNotValid(const SequenceNumber_t& seqNum)
     if(seqNum <= changesFromWLowMark_)
         return;
 
-    auto chit = m_changesFromW.find(ChangeFromWriter_t(seqNum));
+    auto chit = m_changesFromW.find(seqNum);
 
     // Element must be in the container. In other case, bug.
     assert(chit != m_changesFromW.end());
@@ -395,12 +398,7 @@ void WriterProxy::setNotValid(const SequenceNumber_t& seqNum)
     // Cannot be in the beginning because process of cleanup
     assert(chit != m_changesFromW.begin());
 
-    ChangeFromWriter_t newch(*chit);
-    newch.notValid();
-
-    auto hint = m_changesFromW.erase(chit);
-
-    m_changesFromW.insert(hint, newch);
+    chit->notValid();
 }
 
 void WriterProxy::cleanup()
@@ -420,7 +418,7 @@ bool WriterProxy::areThereMissing()
     bool returnedValue = false;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(auto ch : m_changesFromW)
+    for(const auto& ch : m_changesFromW)
     {
         if(ch.getStatus() == ChangeFromWriterStatus_t::MISSING)
         {
@@ -0,0 +1,66 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FragmentedSampleTimeout.cpp
+ *
+ */
+
+#include <fastrtps/rtps/reader/timedevent/FragmentedSampleTimeout.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+
+#include <fastrtps/log/Log.h>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps{
+
+FragmentedSampleTimeout::~FragmentedSampleTimeout()
+{
+    destroy();
+}
+
+FragmentedSampleTimeout::FragmentedSampleTimeout(RTPSReader* reader, ResourceEvent& resource, double interval):
+    TimedEvent(resource, interval), reader_(reader)
+{
+}
+
+void FragmentedSampleTimeout::event(EventCode code, const char* msg)
+{
+    // Unused in release mode.
+    (void)msg;
+
+    if(code == EVENT_SUCCESS)
+    {
+        size_t removed = reader_->remove_stale_fragmented_changes();
+        if(removed > 0)
+        {
+            logInfo(RTPS_READER, "Discarded " << removed << " uncompleted samples");
+        }
+
+        restart_timer();
+    }
+    else if(code == EVENT_ABORT)
+    {
+        logInfo(RTPS_READER, "FragmentedSampleTimeout aborted");
+    }
+    else
+    {
+        logInfo(RTPS_READER, "message: " << msg);
+    }
+}
+
+}
+}
+}
@@ -41,8 +41,7 @@ HeartbeatResponseDelay::~HeartbeatResponseDelay()
 }
 
 HeartbeatResponseDelay::HeartbeatResponseDelay(WriterProxy* p_WP,double interval):
-    TimedEvent(p_WP->mp_SFR->getRTPSParticipant()->getEventResource().getIOService(),
-            p_WP->mp_SFR->getRTPSParticipant()->getEventResource().getThread(), interval),
+    TimedEvent(p_WP->mp_SFR->getRTPSParticipant()->getEventResource(), interval),
     mp_WP(p_WP), m_cdrmessages(p_WP->mp_SFR->getRTPSParticipant()->getMaxMessageSize(),
             p_WP->mp_SFR->getRTPSParticipant()->getGuid().guidPrefix)
 {
@@ -113,30 +112,22 @@ void HeartbeatResponseDelay::event(EventCode code, const char* msg)
             {
                 FragmentNumberSet_t frag_sns;
 
+                const FragmentBitmap_t& fragments = cit->getDataFragments();
+
                 //  Search first fragment not present.
-                uint32_t frag_num = 0;
-                auto fit = cit->getDataFragments()->begin();
-                for(; fit != cit->getDataFragments()->end(); ++fit)
-                {
-                    ++frag_num;
-                    if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                        break;
-                }
+                uint32_t position = fragments.find_next(0, false);
 
                 // Never should happend.
-                assert(frag_num != 0);
-                assert(fit != cit->getDataFragments()->end());
+                assert(position < fragments.size());
 
                 // Store FragmentNumberSet_t base.
-                frag_sns.base = frag_num;
+                frag_sns.base = position + 1;
 
                 // Fill the FragmentNumberSet_t bitmap.
-                for(; fit != cit->getDataFragments()->end(); ++fit)
+                for(; position < fragments.size(); position = fragments.find_next(position + 1, false))
                 {
-                    if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                        frag_sns.add(frag_num);
-
-                    ++frag_num;
+                    if(!frag_sns.add(position + 1))
+                        break;
                 }
 
                 ++mp_WP->mp_SFR->m_nackfragCount;
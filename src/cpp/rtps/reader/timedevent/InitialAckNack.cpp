@@ -44,8 +44,7 @@ InitialAckNack::~InitialAckNack()
 }
 
 InitialAckNack::InitialAckNack(WriterProxy* wp, double interval):
-    TimedEvent(wp->mp_SFR->getRTPSParticipant()->getEventResource().getIOService(),
-            wp->mp_SFR->getRTPSParticipant()->getEventResource().getThread(), interval),
+    TimedEvent(wp->mp_SFR->getRTPSParticipant()->getEventResource(), interval),
     m_cdrmessages(wp->mp_SFR->getRTPSParticipant()->getMaxMessageSize(),
             wp->mp_SFR->getRTPSParticipant()->getGuid().guidPrefix), wp_(wp)
 {
@@ -36,8 +36,7 @@ namespace rtps {
 
 
 WriterProxyLiveliness::WriterProxyLiveliness(WriterProxy* p_WP,double interval):
-TimedEvent(p_WP->mp_SFR->getRTPSParticipant()->getEventResource().getIOService(),
-p_WP->mp_SFR->getRTPSParticipant()->getEventResource().getThread(), interval, TimedEvent::ON_SUCCESS),
+TimedEvent(p_WP->mp_SFR->getRTPSParticipant()->getEventResource(), interval, TimedEvent::ON_SUCCESS),
 mp_WP(p_WP)
 {
 
@@ -0,0 +1,182 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file AsyncSendScheduler.cpp
+ */
+
+#include "AsyncSendScheduler.h"
+
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <fastrtps/log/Log.h>
+
+#include <algorithm>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+const size_t AsyncSendScheduler::c_num_priorities;
+
+AsyncSendScheduler::AsyncSendScheduler(uint32_t num_threads) :
+    num_threads_(num_threads > 0 ? num_threads : 1), running_(true)
+{
+}
+
+AsyncSendScheduler::~AsyncSendScheduler()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        running_ = false;
+    }
+    work_cv_.notify_all();
+
+    for(std::thread* thread : threads_)
+    {
+        thread->join();
+        delete thread;
+    }
+}
+
+bool AsyncSendScheduler::add_writer(RTPSWriter* writer, RTPSWriterAsyncPriority priority)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if(!items_.emplace(writer, WorkItem(writer, priority)).second)
+    {
+        return false;
+    }
+
+    if(threads_.empty())
+    {
+        threads_.reserve(num_threads_);
+        for(uint32_t i = 0; i < num_threads_; ++i)
+        {
+            threads_.push_back(new std::thread(&AsyncSendScheduler::run, this));
+        }
+
+        logInfo(RTPS_WRITER, "Started " << num_threads_ << " asynchronous sender threads");
+    }
+
+    return true;
+}
+
+bool AsyncSendScheduler::remove_writer(RTPSWriter* writer)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto it = items_.find(writer);
+    if(it == items_.end())
+    {
+        return false;
+    }
+
+    WorkItem& item = it->second;
+    idle_cv_.wait(lock, [&]() { return !item.running; });
+
+    if(item.queued)
+    {
+        std::deque<WorkItem*>& queue = queues_[item.priority];
+        queue.erase(std::find(queue.begin(), queue.end(), &item));
+    }
+
+    items_.erase(it);
+    return true;
+}
+
+void AsyncSendScheduler::wake_up(const RTPSWriter* writer)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    auto it = items_.find(writer);
+    if(it != items_.end())
+    {
+        schedule(it->second);
+    }
+}
+
+void AsyncSendScheduler::wake_up_all()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    for(auto& pair : items_)
+    {
+        schedule(pair.second);
+    }
+}
+
+void AsyncSendScheduler::schedule(WorkItem& item)
+{
+    if(item.running)
+    {
+        item.rerun = true;
+    }
+    else if(!item.queued)
+    {
+        item.queued = true;
+        queues_[item.priority].push_back(&item);
+        work_cv_.notify_one();
+    }
+}
+
+AsyncSendScheduler::WorkItem* AsyncSendScheduler::next_item()
+{
+    for(size_t priority = c_num_priorities; priority > 0; --priority)
+    {
+        std::deque<WorkItem*>& queue = queues_[priority - 1];
+        if(!queue.empty())
+        {
+            WorkItem* item = queue.front();
+            queue.pop_front();
+            return item;
+        }
+    }
+
+    return nullptr;
+}
+
+void AsyncSendScheduler::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(running_)
+    {
+        WorkItem* item = next_item();
+        if(item == nullptr)
+        {
+            work_cv_.wait(lock);
+            continue;
+        }
+
+        item->queued = false;
+        item->running = true;
+        item->rerun = false;
+        lock.unlock();
+
+        item->writer->send_any_unsent_changes();
+
+        lock.lock();
+        item->running = false;
+        if(item->rerun)
+        {
+            item->rerun = false;
+            schedule(*item);
+        }
+        idle_cv_.notify_all();
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,133 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file AsyncSendScheduler.h
+ */
+
+#ifndef _RTPS_RESOURCES_ASYNCSENDSCHEDULER_H_
+#define _RTPS_RESOURCES_ASYNCSENDSCHEDULER_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastrtps/rtps/attributes/WriterAttributes.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class RTPSWriter;
+
+/**
+ * Runs the asynchronous sends of the writers of one participant on a pool of threads.
+ * Each writer has a work item that is queued when the writer is woken up. Workers always take the
+ * oldest item of the highest priority class with pending work, so writers of the same class are served
+ * in turns, and a writer is never run by two workers at the same time: a wake up received while it is
+ * running makes it be queued again once it finishes.
+ * The threads are created when the first writer is added.
+ * @ingroup MANAGEMENT_MODULE
+ */
+class AsyncSendScheduler
+{
+    public:
+
+        //! @param num_threads Number of sender threads. Zero is taken as one.
+        AsyncSendScheduler(uint32_t num_threads);
+
+        ~AsyncSendScheduler();
+
+        /**
+         * Registers a writer, so it can be woken up.
+         * @param writer Writer to be added.
+         * @param priority Priority class of the writer.
+         * @return False if the writer was already registered.
+         */
+        bool add_writer(RTPSWriter* writer, RTPSWriterAsyncPriority priority);
+
+        /**
+         * Unregisters a writer, waiting for any send of it in progress to finish.
+         * It must not be called from the sender threads.
+         * @return False if the writer was not registered.
+         */
+        bool remove_writer(RTPSWriter* writer);
+
+        //! Queues the pending sends of a writer. Writers that are not registered are ignored.
+        void wake_up(const RTPSWriter* writer);
+
+        //! Queues the pending sends of all the registered writers.
+        void wake_up_all();
+
+    private:
+
+        AsyncSendScheduler(const AsyncSendScheduler&) = delete;
+        const AsyncSendScheduler& operator=(const AsyncSendScheduler&) = delete;
+
+        struct WorkItem
+        {
+            WorkItem(RTPSWriter* w, RTPSWriterAsyncPriority p) : writer(w), priority(p),
+                queued(false), running(false), rerun(false) {}
+
+            RTPSWriter* writer;
+            RTPSWriterAsyncPriority priority;
+            //! The item is waiting in the queue of its class.
+            bool queued;
+            //! A worker is running the sends of the writer.
+            bool running;
+            //! The writer was woken up while running.
+            bool rerun;
+        };
+
+        //! Number of priority classes.
+        static const size_t c_num_priorities = HIGH_PRIORITY_WRITER + 1;
+
+        void run();
+
+        //! Queues an item, with the mutex taken.
+        void schedule(WorkItem& item);
+
+        //! Takes the next item to run, with the mutex taken.
+        WorkItem* next_item();
+
+        uint32_t num_threads_;
+
+        std::vector<std::thread*> threads_;
+
+        std::unordered_map<const RTPSWriter*, WorkItem> items_;
+
+        //! Queued items, one queue per priority class.
+        std::deque<WorkItem*> queues_[c_num_priorities];
+
+        std::mutex mutex_;
+
+        //! Signals the workers that there are queued items.
+        std::condition_variable work_cv_;
+
+        //! Signals remove_writer that an item has finished running.
+        std::condition_variable idle_cv_;
+
+        bool running_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif // _RTPS_RESOURCES_ASYNCSENDSCHEDULER_H_
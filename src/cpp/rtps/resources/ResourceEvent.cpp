@@ -18,11 +18,8 @@
  */
 
 #include <fastrtps/rtps/resources/ResourceEvent.h>
+#include "TimerWheel.h"
 
-#include <asio.hpp>
-#include <thread>
-#include <functional>
-#include <rtps/participant/RTPSParticipantImpl.h>
 #include <fastrtps/log/Log.h>
 
 namespace eprosima {
@@ -31,43 +28,20 @@ namespace rtps {
 
 
 ResourceEvent::ResourceEvent():
-    mp_b_thread(nullptr),
-    mp_io_service(nullptr),
-    mp_work(nullptr),
-    mp_RTPSParticipantImpl(nullptr)
+    mp_timer_wheel(new TimerWheel())
     {
-        mp_io_service = new asio::io_service();
-        mp_work = (void*)new asio::io_service::work(*mp_io_service);
     }
 
 ResourceEvent::~ResourceEvent() {
-    logInfo(RTPS_PARTICIPANT,"Removing event thread");
-    mp_io_service->stop();
-    mp_b_thread->join();
-    delete(mp_b_thread);
-    delete((asio::io_service::work*)mp_work);
-    delete(mp_io_service);
-
-}
-
-void ResourceEvent::run_io_service()
-{
-    mp_io_service->run();
+    logInfo(RTPS_PARTICIPANT,"Removing event threads");
+    mp_timer_wheel->stop();
+    delete(mp_timer_wheel);
 }
 
-void ResourceEvent::init_thread(RTPSParticipantImpl* pimpl)
+void ResourceEvent::init_thread(uint32_t num_threads)
 {
-    mp_RTPSParticipantImpl = pimpl;
-    mp_b_thread = new std::thread(&ResourceEvent::run_io_service,this);
-    mp_io_service->post(std::bind(&ResourceEvent::announce_thread,this));
-    mp_RTPSParticipantImpl->ResourceSemaphoreWait();
-}
-
-void ResourceEvent::announce_thread()
-{
-    logInfo(RTPS_PARTICIPANT,"Thread: " << std::this_thread::get_id() << " created and waiting for tasks.");
-    mp_RTPSParticipantImpl->ResourceSemaphorePost();
-
+    mp_timer_wheel->start(num_threads);
+    logInfo(RTPS_PARTICIPANT,"Created " << (num_threads > 0 ? num_threads : 1) << " event threads");
 }
 }
 } /* namespace */
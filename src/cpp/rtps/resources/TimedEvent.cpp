@@ -18,6 +18,7 @@
  */
 
 #include <fastrtps/rtps/resources/TimedEvent.h>
+#include <fastrtps/rtps/resources/ResourceEvent.h>
 #include "TimedEventImpl.h"
 
 
@@ -26,9 +27,9 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
-    TimedEvent::TimedEvent(asio::io_service &service, const std::thread& event_thread, double milliseconds, TimedEvent::AUTODESTRUCTION_MODE autodestruction)
+TimedEvent::TimedEvent(ResourceEvent& resource, double milliseconds, TimedEvent::AUTODESTRUCTION_MODE autodestruction)
 {
-	mp_impl = new TimedEventImpl(this, service, event_thread, std::chrono::microseconds((int64_t)(milliseconds*1000)), autodestruction);
+	mp_impl = new TimedEventImpl(this, resource.getTimerWheel(), std::chrono::microseconds((int64_t)(milliseconds*1000)), autodestruction);
 }
 
 TimedEvent::~TimedEvent()
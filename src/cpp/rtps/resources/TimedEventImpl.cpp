@@ -23,49 +23,14 @@
 #include <fastrtps/utils/TimeConversion.h>
 
 #include <cassert>
-#include <functional>
-#include <atomic>
-#include <system_error>
-
-namespace eprosima
-{
-    namespace fastrtps
-    {
-        namespace rtps
-        {
-            class TimerState
-            {
-                public:
-
-                    typedef enum
-                    {
-                        INACTIVE = 0,
-                        WAITING,
-                        CANCELLED,
-                        RUNNING,
-                        DESTROYED
-                    } StateCode;
-
-                    TimerState(TimedEvent::AUTODESTRUCTION_MODE autodestruction) : code_(INACTIVE),
-                    autodestruction_(autodestruction), forwardRestart_(false) {}
-
-                    std::atomic<StateCode> code_;
-
-                    TimedEvent::AUTODESTRUCTION_MODE autodestruction_;
-
-                    bool forwardRestart_;
-            };
-        }
-    }
-}
 
 using namespace eprosima::fastrtps::rtps;
 
-TimedEventImpl::TimedEventImpl(TimedEvent* event, asio::io_service &service, const std::thread& event_thread, std::chrono::microseconds interval, TimedEvent::AUTODESTRUCTION_MODE autodestruction) :
-timer_(service, interval), m_interval_microsec(interval), mp_event(event),
-autodestruction_(autodestruction), state_(std::make_shared<TimerState>(autodestruction)), event_thread_id_(event_thread.get_id())
+TimedEventImpl::TimedEventImpl(TimedEvent* event, TimerWheel& wheel, std::chrono::microseconds interval, TimedEvent::AUTODESTRUCTION_MODE autodestruction) :
+wheel_(wheel), m_interval_microsec(interval), mp_event(event),
+autodestruction_(autodestruction), state_(INACTIVE), forwardRestart_(false), sequence_(0),
+deadline_(TimerWheel::clock::now())
 {
-	//TIME_INFINITE(m_timeInfinite);
 }
 
 TimedEventImpl::~TimedEventImpl()
@@ -74,80 +39,65 @@ TimedEventImpl::~TimedEventImpl()
 
 void TimedEventImpl::destroy()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
-    // Exchange state to avoid race conditions. Any state will go to state TimerState::DESTROYED.
-    TimerState::StateCode code = state_.get()->code_.exchange(TimerState::DESTROYED, std::memory_order_relaxed);
-
-    // code's value cannot be TimerState::DESTROYED. In this case other destructor was called.
-    assert(code != TimerState::DESTROYED);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
 
-    // If the event is waiting, cancel it.
-    if(code == TimerState::WAITING)
-        timer_.cancel();
+        // state_'s value cannot be DESTROYED. In this case other destructor was called.
+        assert(state_ != DESTROYED);
+        state_ = DESTROYED;
+    }
 
-    // If the event is waiting or running, wait it finishes.
-    // Don't wait if it is the event thread.
-    if(code == TimerState::RUNNING && event_thread_id_ != std::this_thread::get_id())
-        cond_.wait(lock);
+    // Unschedule the event and wait if it is running in other thread.
+    // It doesn't wait if it is called from the event itself.
+    wheel_.remove(*this);
 }
 
 
-/* In this function we don't need to exchange the state,
+/* In this function we don't need to wait for a running event,
  * because this function try to cancel, but if the event is running
  * in the middle of the operation, it doesn't bother.
  */
 void TimedEventImpl::cancel_timer()
 {
-    TimerState::StateCode code = TimerState::WAITING;
-
-    // Lock timer to protect state_ and timer_ objects.
     std::unique_lock<std::mutex> lock(mutex_);
 
-    // Exchange state to avoid race conditions. Only TimerState::WAITING state can be set to TimerState::CANCELLED.
-    bool ret = state_.get()->code_.compare_exchange_strong(code, TimerState::CANCELLED, std::memory_order_relaxed);
+    // Only a waiting event can be cancelled.
+    if(state_ != WAITING)
+        return;
+
+    wheel_.cancel(*this);
 
-    if(ret)
+    // Alert to user.
+    mp_event->event(TimedEvent::EVENT_ABORT, nullptr);
+
+    // If autodestruction is TimedEvent::ALLWAYS, the event is deleted from the timer thread.
+    if(autodestruction_ == TimedEvent::ALLWAYS)
     {
-        // Unattach the event state from future event execution.
-        state_.reset(new TimerState(autodestruction_));
-        // Cancel the event.
-        timer_.cancel();
-        // Alert to user.
-        mp_event->event(TimedEvent::EVENT_ABORT, nullptr);
+        state_ = CANCELLED;
+        schedule(std::chrono::microseconds(0));
     }
+    else
+        state_ = INACTIVE;
 }
 
 void TimedEventImpl::restart_timer()
 {
-    // Lock timer to protect state_ and timer_ objects.
     std::unique_lock<std::mutex> lock(mutex_);
 
-    // Get current state.
-    TimerState::StateCode code = state_.get()->code_.load(std::memory_order_relaxed);
+    // If the event is being destroyed or cancelled for deletion, don't start other event.
+    // If the event is already waiting, don't start other event.
+    if(state_ == DESTROYED || state_ == CANCELLED || state_ == WAITING)
+        return;
 
-    // if the code is executed in the event thread, and the event is being destroyed, don't start other event.
-    // if the code indicate an event is already waiting, don't start other event.
-    if(code != TimerState::DESTROYED && code != TimerState::WAITING)
+    // If the event is running, it is scheduled again when it finishes.
+    if(state_ == RUNNING)
     {
-        bool restartTimer = true;
-
-        // If there is an event running, desattach state and set to not notify.
-        if(code == TimerState::RUNNING)
-        {
-            if(state_.get()->forwardRestart_)
-                restartTimer = false;
-            else
-                state_.get()->forwardRestart_ = true;
-        }
-        else
-            state_.get()->code_.store(TimerState::WAITING, std::memory_order_relaxed);
-
-        if(restartTimer)
-        {
-            timer_.expires_from_now(m_interval_microsec);
-            timer_.async_wait(std::bind(&TimedEventImpl::event,this,std::placeholders::_1, state_));
-        }
+        forwardRestart_ = true;
+        return;
     }
+
+    state_ = WAITING;
+    schedule(m_interval_microsec);
 }
 
 bool TimedEventImpl::update_interval(const Duration_t& inter)
@@ -164,59 +114,53 @@ bool TimedEventImpl::update_interval_millisec(double time_millisec)
 	return true;
 }
 
-void TimedEventImpl::event(const std::error_code& ec, const std::shared_ptr<TimerState>& state)
+void TimedEventImpl::schedule(std::chrono::microseconds delay)
 {
-    TimerState::StateCode scode = TimerState::WAITING;
+    deadline_ = TimerWheel::clock::now() + delay;
+    sequence_ = wheel_.schedule(*this, delay);
+}
 
-    // First step is exchange the state, to prevent race condition from the destruction case.
-    bool ret =  state.get()->code_.compare_exchange_strong(scode, TimerState::RUNNING, std::memory_order_relaxed);
+void TimedEventImpl::expired(uint64_t sequence)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
 
-    // Check bad preconditions
-    assert(!(ret && scode == TimerState::DESTROYED));
+    // Expirations scheduled before the last restart or cancellation are ignored.
+    if(sequence != sequence_)
+        return;
 
-    if(scode != TimerState::WAITING || !ret || ec == asio::error::operation_aborted)
+    if(state_ == CANCELLED)
     {
-        // If autodestruction is TimedEvent::ALLWAYS, delete the event.
-        if(scode != TimerState::DESTROYED && state.get()->autodestruction_ == TimedEvent::ALLWAYS)
-        {
-            delete this->mp_event;
-        }
-
+        lock.unlock();
+        delete this->mp_event;
         return;
     }
 
-    TimedEvent::EventCode code = TimedEvent::EVENT_MSG;
-    std::string message;
+    if(state_ != WAITING)
+        return;
+
+    state_ = RUNNING;
+    forwardRestart_ = false;
+    lock.unlock();
 
-    if(!ec)
-        code = TimedEvent::EVENT_SUCCESS;
-    else
-        message = ec.message();
+    this->mp_event->event(TimedEvent::EVENT_SUCCESS, nullptr);
 
-    this->mp_event->event(code, message.c_str());
+    lock.lock();
 
-    // If the destructor is waiting, signal it.
-    std::unique_lock<std::mutex> lock(mutex_);
+    if(state_ == DESTROYED)
+        return;
 
-    scode = TimerState::RUNNING;
-    if(!state.get()->forwardRestart_)
+    if(forwardRestart_)
     {
-        ret =  state.get()->code_.compare_exchange_strong(scode, TimerState::INACTIVE, std::memory_order_relaxed);
+        forwardRestart_ = false;
+        state_ = WAITING;
+        schedule(m_interval_microsec);
     }
     else
-    {
-        state.get()->forwardRestart_ = false;
-        ret =  state.get()->code_.compare_exchange_strong(scode, TimerState::WAITING, std::memory_order_relaxed);
-    }
-
-    if(scode == TimerState::DESTROYED)
-        cond_.notify_one();
+        state_ = INACTIVE;
 
-    //Unlock mutex
     lock.unlock();
 
-    if(state.get()->autodestruction_ == TimedEvent::ALLWAYS ||
-            (code == TimedEvent::EVENT_SUCCESS && state.get()->autodestruction_ == TimedEvent::ON_SUCCESS))
+    if(autodestruction_ == TimedEvent::ALLWAYS || autodestruction_ == TimedEvent::ON_SUCCESS)
     {
         delete this->mp_event;
     }
@@ -25,24 +25,10 @@
 
 #include <fastrtps/rtps/common/Time_t.h>
 #include <fastrtps/rtps/resources/TimedEvent.h>
+#include "TimerWheel.h"
 
-#include <memory>
-
-#include <asio/io_service.hpp>
-#include <asio/steady_timer.hpp>
-#include <asio/deadline_timer.hpp>
-#include <asio/placeholders.hpp>
-#include <asio/io_service.hpp>
-
-#include <fastrtps/utils/Semaphore.h>
-
-#include <thread>
-#include <functional>
 #include <mutex>
-#include <condition_variable>
-#include <system_error>
-
-
+#include <chrono>
 
 namespace eprosima
 {
@@ -50,37 +36,32 @@ namespace eprosima
     {
         namespace rtps
         {
-            class TimerState;
-
             /**
              * Timed Event class used to define any timed events.
              * All timedEvents must be a specification of this class, implementing the event method.
+             * The event is an entry of the timer wheel of the participant.
              *@ingroup MANAGEMENT_MODULE
              */
-            class TimedEventImpl
+            class TimedEventImpl : public TimerWheel::Entry
             {
                 public:
 
                     ~TimedEventImpl();
 
                     /**
-                     * @param serv IO service
-                     * @param milliseconds Interval of the timedEvent.
+                     * @param ev Event notified.
+                     * @param wheel Timer wheel where the event is scheduled.
+                     * @param interval Interval of the timedEvent.
+                     * @param autodestruction Self-destruct mode flag.
                      */
-                    TimedEventImpl(TimedEvent* ev, asio::io_service &service, const std::thread& event_thread, std::chrono::microseconds interval, TimedEvent::AUTODESTRUCTION_MODE autodestruction);
+                    TimedEventImpl(TimedEvent* ev, TimerWheel& wheel, std::chrono::microseconds interval, TimedEvent::AUTODESTRUCTION_MODE autodestruction);
 
-                    /**
-                     * Method invoked when the event occurs. Abstract method.
-                     *
-                     * @param code Code representing the status of the event
-                     * @param msg Message associated to the event
-                     */
-                    void event(const std::error_code& ec, const std::shared_ptr<TimerState>& state);
+                protected:
 
+                    void expired(uint64_t sequence) override;
 
-                protected:
-                    //!Pointer to the timer.
-                    asio::steady_timer timer_;
+                    //!Timer wheel where the event is scheduled.
+                    TimerWheel& wheel_;
                     //!Interval to be used in the timed Event.
                     std::chrono::microseconds m_interval_microsec;
                     //!TimedEvent pointer
@@ -129,19 +110,33 @@ namespace eprosima
                     double getRemainingTimeMilliSec()
                     {
                         std::unique_lock<std::mutex> lock(mutex_);
-                        return static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(timer_.expires_from_now()).count());
+                        return static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    deadline_ - TimerWheel::clock::now()).count());
                     }
 
                 private:
 
+                    typedef enum
+                    {
+                        INACTIVE = 0,
+                        WAITING,
+                        CANCELLED,
+                        RUNNING,
+                        DESTROYED
+                    } StateCode;
+
+                    //!Schedules the event in the wheel. Called with mutex_ taken.
+                    void schedule(std::chrono::microseconds delay);
+
                     TimedEvent::AUTODESTRUCTION_MODE autodestruction_;
-                    //Duration_t m_timeInfinite;
                     std::mutex mutex_;
-                    std::condition_variable cond_;
-
-                    std::shared_ptr<TimerState> state_;
 
-                    std::thread::id event_thread_id_;
+                    StateCode state_;
+                    //!Restart requested while the event was running.
+                    bool forwardRestart_;
+                    //!Sequence of the last expiration scheduled. Older ones are ignored.
+                    uint64_t sequence_;
+                    TimerWheel::clock::time_point deadline_;
             };
 
 
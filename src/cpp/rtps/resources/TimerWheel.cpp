@@ -0,0 +1,327 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ * @file TimerWheel.cpp
+ */
+
+#include "TimerWheel.h"
+
+#include <limits>
+
+using namespace eprosima::fastrtps::rtps;
+
+TimerWheel::TimerWheel(std::chrono::microseconds tick) :
+    tick_(tick.count() > 0 ? tick : std::chrono::microseconds(1)),
+    origin_(clock::now()),
+    running_(false),
+    current_tick_(0),
+    scheduled_count_(0),
+    last_sequence_(0),
+    timed_waiter_(false),
+    wakeup_tick_(0)
+{
+}
+
+TimerWheel::~TimerWheel()
+{
+    stop();
+}
+
+void TimerWheel::start(uint32_t num_threads)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if(!threads_.empty())
+        return;
+
+    if(num_threads == 0)
+        num_threads = 1;
+
+    running_ = true;
+    for(uint32_t i = 0; i < num_threads; ++i)
+        threads_.emplace_back(&TimerWheel::run, this);
+}
+
+void TimerWheel::stop()
+{
+    std::vector<std::thread> threads;
+
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        running_ = false;
+        threads.swap(threads_);
+        cv_.notify_all();
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+}
+
+uint64_t TimerWheel::schedule(Entry& entry, std::chrono::microseconds delay)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if(entry.list_ != nullptr)
+        unlink(entry);
+
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - origin_).count();
+    int64_t delay_us = delay.count() > 0 ? delay.count() : 0;
+
+    // With nothing in the slots there is nothing to move down, so the wheel catches up at once.
+    if(scheduled_count_ == 0)
+    {
+        uint64_t now = static_cast<uint64_t>(elapsed / tick_.count());
+        if(now > current_tick_)
+            current_tick_ = now;
+    }
+
+    // Rounded up, so the entry never expires early.
+    entry.expiry_ = static_cast<uint64_t>((elapsed + delay_us + tick_.count() - 1) / tick_.count());
+    entry.sequence_ = ++last_sequence_;
+    insert(entry);
+
+    if(entry.expiry_ < wakeup_tick_)
+        cv_.notify_all();
+
+    return entry.sequence_;
+}
+
+bool TimerWheel::cancel(Entry& entry)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if(entry.list_ == nullptr)
+        return false;
+
+    unlink(entry);
+    return true;
+}
+
+void TimerWheel::remove(Entry& entry)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if(entry.list_ != nullptr)
+        unlink(entry);
+
+    std::thread::id this_thread = std::this_thread::get_id();
+    dispatch_cv_.wait(lock, [&]()
+    {
+        for(Dispatch* dispatch = entry.dispatch_; dispatch != nullptr; dispatch = dispatch->next)
+            if(dispatch->thread != this_thread)
+                return false;
+        return true;
+    });
+
+    // Only the expiration run by this thread may be left. It must not touch the entry anymore.
+    for(Dispatch* dispatch = entry.dispatch_; dispatch != nullptr; dispatch = dispatch->next)
+        dispatch->removed = true;
+    entry.dispatch_ = nullptr;
+}
+
+void TimerWheel::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(running_)
+    {
+        advance(now_tick());
+
+        Entry* entry = expired_.head;
+        if(entry != nullptr)
+        {
+            unlink(*entry);
+
+            Dispatch dispatch{std::this_thread::get_id(), false, entry->dispatch_};
+            entry->dispatch_ = &dispatch;
+            uint64_t sequence = entry->sequence_;
+
+            // Another thread looks after the wheel while this one runs the expiration.
+            if(threads_.size() > 1)
+                cv_.notify_one();
+
+            lock.unlock();
+            entry->expired(sequence);
+            lock.lock();
+
+            if(!dispatch.removed)
+            {
+                Dispatch** link = &entry->dispatch_;
+                while(*link != &dispatch)
+                    link = &(*link)->next;
+                *link = dispatch.next;
+                dispatch_cv_.notify_all();
+            }
+
+            continue;
+        }
+
+        if(timed_waiter_)
+        {
+            cv_.wait(lock);
+            continue;
+        }
+
+        timed_waiter_ = true;
+
+        if(scheduled_count_ == 0)
+        {
+            wakeup_tick_ = std::numeric_limits<uint64_t>::max();
+            cv_.wait(lock);
+        }
+        else
+        {
+            wakeup_tick_ = next_tick();
+            cv_.wait_until(lock, origin_ + std::chrono::microseconds(tick_.count() *
+                        static_cast<int64_t>(wakeup_tick_)));
+        }
+
+        timed_waiter_ = false;
+        wakeup_tick_ = 0;
+    }
+}
+
+uint64_t TimerWheel::now_tick() const
+{
+    return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - origin_).count() / tick_.count());
+}
+
+void TimerWheel::advance(uint64_t tick)
+{
+    while(current_tick_ < tick)
+    {
+        if(scheduled_count_ == 0)
+        {
+            current_tick_ = tick;
+            break;
+        }
+
+        ++current_tick_;
+
+        // Move down the upper level slots the wheel has got to, from the highest one.
+        uint32_t top = 0;
+        while(top + 1 < c_levels &&
+                (current_tick_ & ((uint64_t(1) << (c_slot_bits * (top + 1))) - 1)) == 0)
+            ++top;
+
+        for(uint32_t level = top; level > 0; --level)
+        {
+            List& slot = slots_[level][(current_tick_ >> (c_slot_bits * level)) & c_slot_mask];
+            Entry* entry = slot.head;
+            slot.head = slot.tail = nullptr;
+
+            while(entry != nullptr)
+            {
+                Entry* next = entry->next_;
+                entry->prev_ = entry->next_ = nullptr;
+                entry->list_ = nullptr;
+                --scheduled_count_;
+                insert(*entry);
+                entry = next;
+            }
+        }
+
+        List& slot = slots_[0][current_tick_ & c_slot_mask];
+        if(slot.head != nullptr)
+        {
+            for(Entry* entry = slot.head; entry != nullptr; entry = entry->next_)
+            {
+                entry->list_ = &expired_;
+                --scheduled_count_;
+            }
+
+            if(expired_.tail != nullptr)
+            {
+                expired_.tail->next_ = slot.head;
+                slot.head->prev_ = expired_.tail;
+            }
+            else
+                expired_.head = slot.head;
+            expired_.tail = slot.tail;
+
+            slot.head = slot.tail = nullptr;
+        }
+    }
+}
+
+void TimerWheel::insert(Entry& entry)
+{
+    if(entry.expiry_ <= current_tick_)
+    {
+        append(expired_, entry);
+        return;
+    }
+
+    const uint64_t span = uint64_t(1) << (c_slot_bits * c_levels);
+    uint64_t delta = entry.expiry_ - current_tick_;
+    uint64_t expiry = entry.expiry_;
+
+    uint32_t level = 0;
+    while(level + 1 < c_levels && delta >= (uint64_t(1) << (c_slot_bits * (level + 1))))
+        ++level;
+
+    // Beyond the last level, the entry waits in its farthest slot and is placed again from there.
+    if(delta >= span)
+        expiry = current_tick_ + span - 1;
+
+    append(slots_[level][(expiry >> (c_slot_bits * level)) & c_slot_mask], entry);
+    ++scheduled_count_;
+}
+
+void TimerWheel::append(List& list, Entry& entry)
+{
+    entry.list_ = &list;
+    entry.next_ = nullptr;
+    entry.prev_ = list.tail;
+
+    if(list.tail != nullptr)
+        list.tail->next_ = &entry;
+    else
+        list.head = &entry;
+    list.tail = &entry;
+}
+
+void TimerWheel::unlink(Entry& entry)
+{
+    List& list = *entry.list_;
+
+    if(&list != &expired_)
+        --scheduled_count_;
+
+    if(entry.prev_ != nullptr)
+        entry.prev_->next_ = entry.next_;
+    else
+        list.head = entry.next_;
+
+    if(entry.next_ != nullptr)
+        entry.next_->prev_ = entry.prev_;
+    else
+        list.tail = entry.prev_;
+
+    entry.prev_ = entry.next_ = nullptr;
+    entry.list_ = nullptr;
+}
+
+uint64_t TimerWheel::next_tick() const
+{
+    // Level 0 slots until the next move down of level 1.
+    uint64_t boundary = (current_tick_ | c_slot_mask) + 1;
+
+    for(uint64_t tick = current_tick_ + 1; tick < boundary; ++tick)
+        if(slots_[0][tick & c_slot_mask].head != nullptr)
+            return tick;
+
+    return boundary;
+}
@@ -0,0 +1,194 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ * @file TimerWheel.h
+ */
+
+#ifndef _RTPS_RESOURCES_TIMERWHEEL_H_
+#define _RTPS_RESOURCES_TIMERWHEEL_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <cstdint>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Hierarchical timing wheel shared by all the timed events of a participant.
+ * Time is divided in ticks. Level 0 has one slot per tick and each upper level has one slot per whole turn
+ * of the level below it; entries of an upper level slot are moved down when the wheel gets to that slot.
+ * Entries are intrusive nodes of doubly linked lists, so scheduling and cancelling never allocate
+ * and take constant time. Entries expiring in the same tick are dispatched in the same pass, in the
+ * order they were scheduled.
+ * Expirations are dispatched by a pool of threads, without holding any lock of the wheel.
+ * @ingroup MANAGEMENT_MODULE
+ */
+class TimerWheel
+{
+    struct List;
+    struct Dispatch;
+
+    public:
+
+        typedef std::chrono::steady_clock clock;
+
+        /**
+         * Node of the wheel. Timers derive from it and are notified through expired().
+         */
+        class Entry
+        {
+            friend class TimerWheel;
+
+            public:
+
+                Entry() : prev_(nullptr), next_(nullptr), list_(nullptr), expiry_(0), sequence_(0),
+                    dispatch_(nullptr) {}
+
+                virtual ~Entry() {}
+
+            protected:
+
+                /**
+                 * Called from a thread of the wheel when the entry expires.
+                 * @param sequence Value returned by the TimerWheel::schedule call that armed this expiration.
+                 * Implementations use it to discard expirations that were already being dispatched when
+                 * the entry was rescheduled.
+                 */
+                virtual void expired(uint64_t sequence) = 0;
+
+            private:
+
+                Entry(const Entry&) = delete;
+                const Entry& operator=(const Entry&) = delete;
+
+                Entry* prev_;
+                Entry* next_;
+                List* list_;
+                uint64_t expiry_;
+                uint64_t sequence_;
+                Dispatch* dispatch_;
+        };
+
+        //! @param tick Resolution of the wheel.
+        explicit TimerWheel(std::chrono::microseconds tick = std::chrono::milliseconds(1));
+
+        //! Stops the threads. Entries still scheduled are left as they are.
+        ~TimerWheel();
+
+        /**
+         * Creates the threads dispatching the expirations. Calls after the first one are ignored.
+         * @param num_threads Number of threads. Zero is taken as one.
+         */
+        void start(uint32_t num_threads);
+
+        //! Stops and joins the threads.
+        void stop();
+
+        /**
+         * Schedules an entry, replacing its previous expiration if it was already scheduled.
+         * The entry never expires before the delay has elapsed.
+         * @return Sequence number that will be given to Entry::expired.
+         */
+        uint64_t schedule(Entry& entry, std::chrono::microseconds delay);
+
+        /**
+         * Unschedules an entry. An expiration already being dispatched is not waited for.
+         * @return True if the entry was scheduled.
+         */
+        bool cancel(Entry& entry);
+
+        /**
+         * Unschedules an entry and waits for any expiration of it being dispatched by another thread.
+         * Called from the expiration of the entry itself, it returns immediately and the entry may be
+         * destroyed before expired() returns.
+         */
+        void remove(Entry& entry);
+
+    private:
+
+        TimerWheel(const TimerWheel&) = delete;
+        const TimerWheel& operator=(const TimerWheel&) = delete;
+
+        static const uint32_t c_levels = 4;
+        static const uint32_t c_slot_bits = 8;
+        static const uint64_t c_slots = 1u << c_slot_bits;
+        static const uint64_t c_slot_mask = c_slots - 1;
+
+        struct List
+        {
+            List() : head(nullptr), tail(nullptr) {}
+
+            Entry* head;
+            Entry* tail;
+        };
+
+        //! Lives in the stack of a thread dispatching an expiration, linked from the entry.
+        struct Dispatch
+        {
+            std::thread::id thread;
+            bool removed;
+            Dispatch* next;
+        };
+
+        void run();
+
+        uint64_t now_tick() const;
+
+        void advance(uint64_t tick);
+
+        void insert(Entry& entry);
+
+        static void append(List& list, Entry& entry);
+
+        void unlink(Entry& entry);
+
+        //! Tick of the next level 0 slot with entries or of the next move down of an upper level.
+        uint64_t next_tick() const;
+
+        const std::chrono::microseconds tick_;
+        const clock::time_point origin_;
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::condition_variable dispatch_cv_;
+        std::vector<std::thread> threads_;
+        bool running_;
+
+        List slots_[c_levels][c_slots];
+        //! Entries ready to be dispatched.
+        List expired_;
+        //! Last tick processed.
+        uint64_t current_tick_;
+        //! Entries in the slots.
+        uint64_t scheduled_count_;
+        uint64_t last_sequence_;
+
+        //! Whether a thread is waiting for the next expiration. The others wait for a notification.
+        bool timed_waiter_;
+        //! Tick the timed waiter wakes up at.
+        uint64_t wakeup_tick_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif // _RTPS_RESOURCES_TIMERWHEEL_H_
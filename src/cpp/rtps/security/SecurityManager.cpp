@@ -416,7 +416,7 @@ bool SecurityManager::restore_discovered_participant_info(const GUID_t& remote_p
     SecurityException exception;
     bool returned_value = false;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
     auto dp_it = discovered_participants_.find(remote_participant_key);
 
     if(dp_it != discovered_participants_.end())
@@ -547,7 +547,7 @@ void SecurityManager::remove_participant(const ParticipantProxyData& participant
     // Unmatch from builtin endpoints.
     unmatch_builtin_endpoints(participant_data);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
     auto dp_it = discovered_participants_.find(participant_data.m_guid);
 
     if(dp_it != discovered_participants_.end())
@@ -1351,7 +1351,7 @@ void SecurityManager::process_participant_volatile_message_secure(const CacheCha
         ParticipantCryptoHandle* remote_participant_crypto = nullptr;
 
         // Search remote participant crypto handle.
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<StripedMutex> lock(mutex_);
         auto dp_it = discovered_participants_.find(remote_participant_key);
 
         if(dp_it != discovered_participants_.end())
@@ -1831,7 +1831,7 @@ bool SecurityManager::encode_rtps_message(const CDRMessage_t& input_message, CDR
 
     assert(receiving_list.size() > 0);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    StripedMutex::SharedLock lock(mutex_);
 
     std::vector<ParticipantCryptoHandle*> receiving_crypto_list;
     for(const auto remote_participant : receiving_list)
@@ -1875,7 +1875,7 @@ int SecurityManager::decode_rtps_message(const CDRMessage_t& message, CDRMessage
     // Init output buffer
     CDRMessage::initCDRMsg(&out_message);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    StripedMutex::SharedLock lock(mutex_);
 
     ParticipantCryptoHandle* remote_participant_crypto_handle = nullptr;
 
@@ -2013,7 +2013,7 @@ bool SecurityManager::register_local_writer(const GUID_t& writer_guid, const Pro
 
         if(writer_handle != nullptr && !writer_handle->nil())
         {
-            std::unique_lock<std::mutex> lock(mutex_);
+            std::unique_lock<StripedMutex> lock(mutex_);
             writer_handles_.emplace(writer_guid, writer_handle);
         }
         else
@@ -2038,7 +2038,7 @@ bool SecurityManager::register_local_builtin_writer(const GUID_t& writer_guid, E
 
         if(writer_handle != nullptr && !writer_handle->nil())
         {
-            std::unique_lock<std::mutex> lock(mutex_);
+            std::unique_lock<StripedMutex> lock(mutex_);
             writer_handles_.emplace(writer_guid, writer_handle);
         }
         else
@@ -2056,7 +2056,7 @@ bool SecurityManager::unregister_local_writer(const GUID_t& writer_guid)
     if(crypto_plugin_ == nullptr)
         return false;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
     auto local_writer = writer_handles_.find(writer_guid);
 
     if(local_writer != writer_handles_.end())
@@ -2171,7 +2171,7 @@ bool SecurityManager::register_local_reader(const GUID_t& reader_guid, const Pro
 
         if(reader_handle != nullptr && !reader_handle->nil())
         {
-            std::unique_lock<std::mutex> lock(mutex_);
+            std::unique_lock<StripedMutex> lock(mutex_);
             reader_handles_.emplace(reader_guid, reader_handle);
         }
         else
@@ -2196,7 +2196,7 @@ bool SecurityManager::register_local_builtin_reader(const GUID_t& reader_guid, E
 
         if(reader_handle != nullptr && !reader_handle->nil())
         {
-            std::unique_lock<std::mutex> lock(mutex_);
+            std::unique_lock<StripedMutex> lock(mutex_);
             reader_handles_.emplace(reader_guid, reader_handle);
         }
         else
@@ -2214,7 +2214,7 @@ bool SecurityManager::unregister_local_reader(const GUID_t& reader_guid)
     if(crypto_plugin_ == nullptr)
         return false;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
     auto local_reader = reader_handles_.find(reader_guid);
 
     if(local_reader != reader_handles_.end())
@@ -2249,7 +2249,7 @@ void SecurityManager::remove_reader(const GUID_t& writer_guid, const GUID_t& /*r
     if(crypto_plugin_ == nullptr)
         return;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
 
     auto local_writer = writer_handles_.find(writer_guid);
 
@@ -2280,7 +2280,7 @@ bool SecurityManager::discovered_builtin_reader(const GUID_t& writer_guid, const
 bool SecurityManager::discovered_reader(const GUID_t& writer_guid, const GUID_t& remote_participant_key,
         ReaderProxyData& remote_reader_data, const EndpointSecurityAttributes& security_attributes, bool is_builtin)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
     PermissionsHandle* remote_permissions = nullptr;
     ParticipantCryptoHandle* remote_participant_crypto_handle = nullptr;
     SharedSecretHandle* shared_secret_handle = &SharedSecretHandle::nil_handle;
@@ -2532,7 +2532,7 @@ void SecurityManager::remove_writer(const GUID_t& reader_guid, const GUID_t& /*r
     if(crypto_plugin_ == nullptr)
         return;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
 
     auto local_reader = reader_handles_.find(reader_guid);
 
@@ -2563,7 +2563,7 @@ bool SecurityManager::discovered_builtin_writer(const GUID_t& reader_guid, const
 bool SecurityManager::discovered_writer(const GUID_t& reader_guid, const GUID_t& remote_participant_key,
         WriterProxyData& remote_writer_data, const EndpointSecurityAttributes& security_attributes, bool is_builtin)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
     PermissionsHandle* remote_permissions = nullptr;
     ParticipantCryptoHandle* remote_participant_crypto_handle = nullptr;
     SharedSecretHandle* shared_secret_handle = &SharedSecretHandle::nil_handle;
@@ -2810,7 +2810,7 @@ bool SecurityManager::encode_writer_submessage(const CDRMessage_t& input_message
     if(crypto_plugin_ == nullptr)
         return false;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    StripedMutex::SharedLock lock(mutex_);
 
     const auto& wr_it = writer_handles_.find(writer_guid);
 
@@ -2858,7 +2858,7 @@ bool SecurityManager::encode_reader_submessage(const CDRMessage_t& input_message
     if(crypto_plugin_ == nullptr)
         return false;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    StripedMutex::SharedLock lock(mutex_);
 
     const auto& rd_it = reader_handles_.find(reader_guid);
 
@@ -2909,7 +2909,7 @@ int SecurityManager::decode_rtps_submessage(CDRMessage_t& message, CDRMessage_t&
     if(crypto_plugin_ == nullptr)
         return 0;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    StripedMutex::SharedLock lock(mutex_);
 
     const GUID_t remote_participant_key(sending_participant, c_EntityId_RTPSParticipant);
     ParticipantCryptoHandle* remote_participant_crypto_handle = nullptr;
@@ -2982,7 +2982,7 @@ bool SecurityManager::encode_serialized_payload(const SerializedPayload_t& paylo
     if(crypto_plugin_ == nullptr)
         return false;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    StripedMutex::SharedLock lock(mutex_);
 
     const auto& wr_it = writer_handles_.find(writer_guid);
 
@@ -3018,7 +3018,7 @@ bool SecurityManager::decode_serialized_payload(const SerializedPayload_t& secur
     if(crypto_plugin_ == nullptr)
         return false;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    StripedMutex::SharedLock lock(mutex_);
 
     const auto& rd_it = reader_handles_.find(reader_guid);
 
@@ -3134,7 +3134,7 @@ bool SecurityManager::participant_authorized(const ParticipantProxyData& partici
             // Store cryptography info
             if(participant_crypto_handle != nullptr && !participant_crypto_handle->nil())
             {
-                std::unique_lock<std::mutex> lock(mutex_);
+                std::unique_lock<StripedMutex> lock(mutex_);
 
                 // Check there is a pending crypto message.
                 auto pending = remote_participant_pending_messages_.find(participant_data.m_guid);
@@ -3204,7 +3204,7 @@ bool SecurityManager::participant_authorized(const ParticipantProxyData& partici
         }
         else
         {
-            std::unique_lock<std::mutex> lock(mutex_);
+            std::unique_lock<StripedMutex> lock(mutex_);
 
             // Store shared_secret.
             auto dp_it = discovered_participants_.find(participant_data.m_guid);
@@ -3252,7 +3252,7 @@ uint32_t SecurityManager::calculate_extra_size_for_rtps_message()
     if(crypto_plugin_ == nullptr)
         return 0;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
 
     return crypto_plugin_->cryptotransform()->calculate_extra_size_for_rtps_message(static_cast<uint32_t>(discovered_participants_.size()));
 }
@@ -3262,7 +3262,7 @@ uint32_t SecurityManager::calculate_extra_size_for_rtps_submessage(const GUID_t&
     if(crypto_plugin_ == nullptr)
         return 0;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
 
     auto wr_it = writer_handles_.find(writer_guid);
 
@@ -3283,7 +3283,7 @@ uint32_t SecurityManager::calculate_extra_size_for_encoded_payload(const GUID_t&
     if(crypto_plugin_ == nullptr)
         return 0;
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<StripedMutex> lock(mutex_);
 
     auto wr_it = writer_handles_.find(writer_guid);
 
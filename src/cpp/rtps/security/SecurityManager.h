@@ -25,6 +25,7 @@
 #include <fastrtps/rtps/reader/ReaderListener.h>
 #include <fastrtps/rtps/common/SequenceNumber.h>
 #include "timedevent/HandshakeMessageTokenResent.h"
+#include "common/StripedMutex.h"
 #include <fastrtps/rtps/common/SerializedPayload.h>
 #include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
 #include <fastrtps/rtps/builtin/data/WriterProxyData.h>
@@ -416,7 +417,8 @@ class SecurityManager
 
         GUID_t auth_source_guid;
 
-        std::mutex mutex_;
+        //! Encoding and decoding only take the stripe of their thread, so they run in parallel.
+        StripedMutex mutex_;
 
         std::atomic<int64_t> auth_last_sequence_number_;
 
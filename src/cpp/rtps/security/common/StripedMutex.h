@@ -0,0 +1,97 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file StripedMutex.h
+ *
+*/
+
+#ifndef _RTPS_SECURITY_COMMON_STRIPEDMUTEX_H_
+#define _RTPS_SECURITY_COMMON_STRIPEDMUTEX_H_
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+namespace security {
+
+/**
+ * Mutex split in stripes. Shared owners lock only the stripe of their thread, so threads of different stripes
+ * go on in parallel, while exclusive owners lock all the stripes.
+ * It is meant for data read on hot paths and rarely modified.
+ * Exclusive ownership follows BasicLockable, so it can be used with std::unique_lock and std::lock_guard.
+ */
+class StripedMutex
+{
+    public:
+
+        //! Locks the stripe of the calling thread for as long as the object lives.
+        class SharedLock
+        {
+            public:
+
+                explicit SharedLock(StripedMutex& mutex) :
+                    stripe_(mutex.stripes_[std::hash<std::thread::id>()(std::this_thread::get_id()) % stripe_count])
+                {
+                    stripe_.lock();
+                }
+
+                ~SharedLock()
+                {
+                    stripe_.unlock();
+                }
+
+                SharedLock(const SharedLock&) = delete;
+                SharedLock& operator=(const SharedLock&) = delete;
+
+            private:
+
+                std::mutex& stripe_;
+        };
+
+        StripedMutex() = default;
+
+        StripedMutex(const StripedMutex&) = delete;
+        StripedMutex& operator=(const StripedMutex&) = delete;
+
+        //! Locks all the stripes, always in the same order.
+        void lock()
+        {
+            for(auto& stripe : stripes_)
+                stripe.lock();
+        }
+
+        void unlock()
+        {
+            for(auto stripe = stripes_.rbegin(); stripe != stripes_.rend(); ++stripe)
+                stripe->unlock();
+        }
+
+    private:
+
+        static const size_t stripe_count = 8;
+
+        std::array<std::mutex, stripe_count> stripes_;
+};
+
+} //namespace security
+} //namespace rtps
+} //namespace fastrtps
+} //namespace eprosima
+
+#endif // _RTPS_SECURITY_COMMON_STRIPEDMUTEX_H_
@@ -24,8 +24,7 @@ using namespace eprosima::fastrtps::rtps::security;
 
 HandshakeMessageTokenResent::HandshakeMessageTokenResent(SecurityManager& security_manager,
         const GUID_t& remote_participant_key, double interval) :
-    TimedEvent(security_manager.participant()->getEventResource().getIOService(),
-            security_manager.participant()->getEventResource().getThread(), interval),
+    TimedEvent(security_manager.participant()->getEventResource(), interval),
     security_manager_(security_manager), remote_participant_key_(remote_participant_key)
 {
 }
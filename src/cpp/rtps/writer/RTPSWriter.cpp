@@ -179,6 +179,7 @@ bool RTPSWriter::encrypt_cachechange(CacheChange_t* change)
             + 20 /*SecureDataHeader*/ + 4 + ((2* 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1 ) /* SecureDataBodey*/
             + 16 + 4 /*SecureDataTag*/ &&
             (mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::PREALLOCATED_WITH_REALLOC_MEMORY_MODE ||
+            mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::PREALLOCATED_WITH_ARENA_MEMORY_MODE ||
             mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE))
         {
             encrypt_payload_.data = (octet*)realloc(encrypt_payload_.data, change->serializedPayload.length +
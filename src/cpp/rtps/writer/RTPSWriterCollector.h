@@ -24,12 +24,22 @@
 #include <fastrtps/rtps/common/CacheChange.h>
 
 #include <vector>
+#include <algorithm>
+#include <utility>
 #include <cassert>
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+ * Collects the changes, or fragments of changes, that a writer has to send, ordered by sequence number
+ * and fragment number, each one with the remote readers it is addressed to.
+ * When fragments are interleaved they are ordered by fragment number first, so whole changes go before any
+ * fragment and one fragment of each change is sent in turn.
+ * Items are kept in a vector whose elements are reused when the collector is cleared, so a collector
+ * that lives as long as its writer stops allocating memory once it has grown to the usual load.
+ */
 template<class T>
 class RTPSWriterCollector
 {
@@ -55,74 +65,136 @@ class RTPSWriterCollector
 
             CacheChange_t* cacheChange;
 
-            mutable std::vector<T> remoteReaders;
+            std::vector<T> remoteReaders;
         };
 
-        struct ItemCmp
-        {
-            bool operator()(const Item& a, const Item& b) const
-            {
-                if(a.sequenceNumber < b.sequenceNumber)
-                    return true;
-                else if(a.sequenceNumber == b.sequenceNumber)
-                    if(a.fragmentNumber < b.fragmentNumber)
-                        return true;
+        typedef typename std::vector<Item>::iterator iterator;
 
-                return false;
-            }
-        };
-
-        typedef std::set<Item, ItemCmp> ItemSet;
+        explicit RTPSWriterCollector(bool interleaveFragments = false) : mBegin_(0), mEnd_(0),
+            mInterleaveFragments_(interleaveFragments) {}
 
-        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t optionalFragmentsNotSent)
+        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t& optionalFragmentsNotSent)
         {
             if(change->getFragmentSize() > 0)
             {
                 for(auto sn = optionalFragmentsNotSent.get_begin(); sn != optionalFragmentsNotSent.get_end(); ++sn)
                 {
-                    assert(*sn <= change->getDataFragments()->size());
-                    auto it = mItems_.emplace(change->sequenceNumber, *sn, change);
-                    it.first->remoteReaders.push_back(remoteReader);
+                    assert(*sn <= change->getFragmentCount());
+                    get_item_(change, *sn).remoteReaders.push_back(remoteReader);
                 }
             }
             else
             {
-                auto it = mItems_.emplace(change->sequenceNumber, 0, change);
-                it.first->remoteReaders.push_back(remoteReader);
+                get_item_(change, 0).remoteReaders.push_back(remoteReader);
             }
         }
 
+        //! Adds a single fragment of a change.
+        void add_fragment(CacheChange_t* change, FragmentNumber_t fragNum, const T& remoteReader)
+        {
+            assert(fragNum != 0 && fragNum <= change->getFragmentCount());
+            get_item_(change, fragNum).remoteReaders.push_back(remoteReader);
+        }
+
         bool empty()
         {
-            return mItems_.empty();
+            return mBegin_ == mEnd_;
         }
 
         size_t size()
         {
-            return mItems_.size();
+            return mEnd_ - mBegin_;
         }
 
+        //! Takes out the first item.
         Item pop()
         {
-            auto it = mItems_.begin();
-            Item ret = *it;
-            mItems_.erase(it);
+            assert(!empty());
+            Item ret = mItems_[mBegin_];
+            if(++mBegin_ == mEnd_)
+                mBegin_ = mEnd_ = 0;
             return ret;
         }
 
+        //! Removes all the items, keeping their storage for later use.
         void clear()
         {
-            return mItems_.clear();
+            mBegin_ = mEnd_ = 0;
         }
 
-        ItemSet& items()
+        iterator begin()
         {
-            return mItems_;
+            return mItems_.begin() + mBegin_;
+        }
+
+        iterator end()
+        {
+            return mItems_.begin() + mEnd_;
+        }
+
+        //! Removes a range of items, keeping their storage for later use.
+        void erase(iterator first, iterator last)
+        {
+            std::rotate(first, last, end());
+            mEnd_ -= static_cast<size_t>(last - first);
+            if(mBegin_ == mEnd_)
+                mBegin_ = mEnd_ = 0;
         }
 
     private:
 
-        ItemSet mItems_;
+        //! Finds the item of a change or fragment, creating it in its place if it is not there.
+        Item& get_item_(CacheChange_t* change, FragmentNumber_t fragNum)
+        {
+            const SequenceNumber_t& seqNum = change->sequenceNumber;
+            const bool interleave = mInterleaveFragments_;
+            auto is_before = [interleave](const Item& item, const std::pair<SequenceNumber_t, FragmentNumber_t>& key)
+            {
+                if(interleave && item.fragmentNumber != key.second)
+                    return item.fragmentNumber < key.second;
+
+                return item.sequenceNumber < key.first ||
+                    (item.sequenceNumber == key.first && item.fragmentNumber < key.second);
+            };
+            std::pair<SequenceNumber_t, FragmentNumber_t> key(seqNum, fragNum);
+
+            // Changes are usually collected in order, so try the last position first.
+            iterator pos = end();
+            if(!empty() && !is_before(*(pos - 1), key))
+            {
+                pos = std::lower_bound(begin(), end(), key, is_before);
+                if(pos->sequenceNumber == seqNum && pos->fragmentNumber == fragNum)
+                    return *pos;
+            }
+
+            size_t index = static_cast<size_t>(pos - mItems_.begin());
+
+            if(mEnd_ == mItems_.size())
+            {
+                mItems_.emplace_back(seqNum, fragNum, change);
+            }
+            else
+            {
+                Item& spare = mItems_[mEnd_];
+                spare.sequenceNumber = seqNum;
+                spare.fragmentNumber = fragNum;
+                spare.cacheChange = change;
+                spare.remoteReaders.clear();
+            }
+
+            ++mEnd_;
+            std::rotate(mItems_.begin() + index, mItems_.begin() + (mEnd_ - 1), mItems_.begin() + mEnd_);
+            return mItems_[index];
+        }
+
+        //! Storage of the items. The ones in [mBegin_, mEnd_) are in use, and the rest are kept for reuse.
+        std::vector<Item> mItems_;
+
+        size_t mBegin_;
+
+        size_t mEnd_;
+
+        const bool mInterleaveFragments_;
 };
 
 } // namespace rtps
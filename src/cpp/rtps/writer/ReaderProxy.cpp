@@ -37,7 +37,7 @@ using namespace eprosima::fastrtps::rtps;
 ReaderProxy::ReaderProxy(const RemoteReaderAttributes& rdata,const WriterTimes& times,StatefulWriter* SW) :
     m_att(rdata), mp_SFW(SW),
     mp_nackResponse(nullptr), mp_nackSupression(nullptr), m_lastAcknackCount(0),
-    mp_mutex(new std::recursive_mutex()), lastNackfragCount_(0)
+    mp_mutex(new std::recursive_mutex()), lastNackfragCount_(0), active_(true)
 {
     if(rdata.endpoint.reliabilityKind == RELIABLE)
     {
@@ -82,11 +82,15 @@ void ReaderProxy::addChange(const ChangeForReader_t& change)
     // For best effort readers, changes are acked when being sent
     if(m_changesForReader.size() == 0 && change.getStatus() == ACKNOWLEDGED)
     {
+        SequenceNumber_t previous_low_mark = changesFromRLowMark_;
         changesFromRLowMark_ = change.getSequenceNumber();
+        ack_state_changed(previous_low_mark, false);
         return;
     }
 
+    bool had_changes = !m_changesForReader.empty();
     m_changesForReader.insert(change);
+    ack_state_changed(changesFromRLowMark_, had_changes);
     //TODO (Ricardo) Remove this functionality from here. It is not his place.
     if (change.getStatus() == UNSENT)
         AsyncWriterThread::wakeUp(mp_SFW);
@@ -105,20 +109,30 @@ bool ReaderProxy::change_is_acked(const SequenceNumber_t& sequence_number)
     if(sequence_number <= changesFromRLowMark_)
         return true;
 
-    auto chit = m_changesForReader.find(ChangeForReader_t(sequence_number));
+    auto chit = m_changesForReader.find(sequence_number);
     assert(chit != m_changesForReader.end());
 
     return !chit->isRelevant() || chit->getStatus() == ACKNOWLEDGED;
 }
 
+bool ReaderProxy::change_is_repair(const SequenceNumber_t& sequence_number) const
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+
+    auto chit = m_changesForReader.find(sequence_number);
+    return chit != m_changesForReader.end() && chit->isRepair();
+}
+
 void ReaderProxy::acked_changes_set(const SequenceNumber_t& seqNum)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
     SequenceNumber_t future_low_mark = seqNum;
+    SequenceNumber_t previous_low_mark = changesFromRLowMark_;
+    bool had_changes = !m_changesForReader.empty();
 
     if(seqNum > changesFromRLowMark_)
     {
-        auto chit = m_changesForReader.find(seqNum);
+        auto chit = m_changesForReader.lower_bound(seqNum);
         m_changesForReader.erase(m_changesForReader.begin(), chit);
     }
     else
@@ -145,7 +159,7 @@ void ReaderProxy::acked_changes_set(const SequenceNumber_t& seqNum)
             }
             else
             {
-                ChangeForReader_t cr;
+                ChangeForReader_t cr(current_sequence);
                 cr.setStatus(UNACKNOWLEDGED);
                 cr.notValid();
                 m_changesForReader.insert(cr);
@@ -154,32 +168,36 @@ void ReaderProxy::acked_changes_set(const SequenceNumber_t& seqNum)
     }
 
     changesFromRLowMark_ = future_low_mark - 1;
+    ack_state_changed(previous_low_mark, had_changes);
+}
+
+void ReaderProxy::deactivate()
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    active_ = false;
+    droppedLowMark_ = changesFromRLowMark_ + 1;
+    acked_changes_set(mp_SFW->next_sequence_number());
 }
 
-bool ReaderProxy::requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet)
+uint32_t ReaderProxy::requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet)
 {
-    bool isSomeoneWasSetRequested = false;
+    uint32_t requested = 0;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
     for(std::vector<SequenceNumber_t>::iterator sit=seqNumSet.begin();sit!=seqNumSet.end();++sit)
     {
-        auto chit = m_changesForReader.find(ChangeForReader_t(*sit));
+        auto chit = m_changesForReader.find(*sit);
 
         if(chit != m_changesForReader.end())
         {
-            ChangeForReader_t newch(*chit);
-            newch.setStatus(REQUESTED);
-            newch.markAllFragmentsAsUnsent();
-
-            auto hint = m_changesForReader.erase(chit);
-
-            m_changesForReader.insert(hint, newch);
-
-            isSomeoneWasSetRequested = true;
+            chit->setStatus(REQUESTED);
+            chit->markAllFragmentsAsUnsent();
+            chit->markAsRepair();
+            ++requested;
         }
     }
 
-    if(isSomeoneWasSetRequested)
+    if(requested > 0)
     {
         logInfo(RTPS_WRITER,"Requested Changes: " << seqNumSet);
     }
@@ -189,7 +207,7 @@ bool ReaderProxy::requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet
                    << " not found (low mark: " << changesFromRLowMark_ << ")");
     }
 
-    return isSomeoneWasSetRequested;
+    return requested;
 }
 
 
@@ -202,7 +220,7 @@ std::vector<ChangeForReader_t*> ReaderProxy::get_unsent_changes()
 
     for(auto &change_for_reader : m_changesForReader)
         if(change_for_reader.getStatus() == UNSENT)
-            unsent_changes.push_back(const_cast<ChangeForReader_t*>(&change_for_reader));
+            unsent_changes.push_back(&change_for_reader);
 
     return unsent_changes;
 }
@@ -225,23 +243,22 @@ void ReaderProxy::set_change_to_status(const SequenceNumber_t& seq_num, ChangeFo
     if(seq_num <= changesFromRLowMark_)
         return;
 
-    auto it = m_changesForReader.find(ChangeForReader_t(seq_num));
+    auto it = m_changesForReader.find(seq_num);
     bool mustWakeUpAsyncThread = false;
 
     if(it != m_changesForReader.end())
     {
         if(status == ACKNOWLEDGED && it == m_changesForReader.begin())
         {
+            SequenceNumber_t previous_low_mark = changesFromRLowMark_;
             m_changesForReader.erase(it);
             changesFromRLowMark_ = seq_num;
+            ack_state_changed(previous_low_mark, true);
         }
         else
         {
-            ChangeForReader_t newch(*it);
-            newch.setStatus(status);
+            it->setStatus(status);
             if (status == UNSENT) mustWakeUpAsyncThread = true;
-            auto hint = m_changesForReader.erase(it);
-            m_changesForReader.insert(hint, newch);
         }
     }
 
@@ -255,22 +272,19 @@ bool ReaderProxy::mark_fragment_as_sent_for_change(const CacheChange_t* change,
         return false;
 
     bool allFragmentsSent = false;
-    auto it = m_changesForReader.find(ChangeForReader_t(change->sequenceNumber));
+    auto it = m_changesForReader.find(change->sequenceNumber);
 
     bool mustWakeUpAsyncThread = false; 
 
     if(it != m_changesForReader.end())
     {
-        ChangeForReader_t newch(*it);
-        newch.markFragmentsAsSent(fragment);
-        if (newch.getUnsentFragments().isSetEmpty())
+        it->markFragmentsAsSent(fragment);
+        if (!it->hasUnsentFragments())
         {
             allFragmentsSent = true;
         }
         else
             mustWakeUpAsyncThread = true;
-        auto hint = m_changesForReader.erase(it);
-        m_changesForReader.insert(hint, newch);
     }
 
     if (mustWakeUpAsyncThread)
@@ -283,6 +297,8 @@ void ReaderProxy::convert_status_on_all_changes(ChangeForReaderStatus_t previous
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
     bool mustWakeUpAsyncThread = false;
+    SequenceNumber_t previous_low_mark = changesFromRLowMark_;
+    bool had_changes = !m_changesForReader.empty();
 
     auto it = m_changesForReader.begin();
     while(it != m_changesForReader.end())
@@ -297,23 +313,29 @@ void ReaderProxy::convert_status_on_all_changes(ChangeForReaderStatus_t previous
             }
             else
             {
-                ChangeForReader_t newch(*it);
-                newch.setStatus(next);
+                it->setStatus(next);
                 if (next == UNSENT && previous != UNSENT)
                     mustWakeUpAsyncThread = true;
-                auto hint = m_changesForReader.erase(it);
-
-                it = m_changesForReader.insert(hint, newch);
             }
         }
 
         ++it;
     }
 
+    ack_state_changed(previous_low_mark, had_changes);
+
     if (mustWakeUpAsyncThread)
         AsyncWriterThread::wakeUp(mp_SFW);
 }
 
+void ReaderProxy::ack_state_changed(const SequenceNumber_t& previous_low_mark, bool had_changes)
+{
+    bool has_changes = !m_changesForReader.empty();
+
+    if(previous_low_mark != changesFromRLowMark_ || had_changes != has_changes)
+        mp_SFW->reader_ack_state_changed_nts(previous_low_mark, had_changes, changesFromRLowMark_, has_changes);
+}
+
 //TODO(Ricardo)
 //void ReaderProxy::setNotValid(const CacheChange_t* change)
 void ReaderProxy::setNotValid(CacheChange_t* change)
@@ -324,7 +346,7 @@ void ReaderProxy::setNotValid(CacheChange_t* change)
     if(m_changesForReader.size() == 0 || change->sequenceNumber < m_changesForReader.begin()->getSequenceNumber())
         return;
 
-    auto chit = m_changesForReader.find(ChangeForReader_t(change));
+    auto chit = m_changesForReader.find(change->sequenceNumber);
 
     // Element must be in the container. In other case, bug.
     assert(chit != m_changesForReader.end());
@@ -335,26 +357,16 @@ void ReaderProxy::setNotValid(CacheChange_t* change)
 
         // if it is the first element, set state to unacknowledge because from now reader has to confirm
         // it will not be expecting it.
-        ChangeForReader_t newch(*chit);
-        newch.setStatus(UNACKNOWLEDGED);
-        newch.notValid();
-
-        auto hint = m_changesForReader.erase(chit);
-
-        m_changesForReader.insert(hint, newch);
+        chit->setStatus(UNACKNOWLEDGED);
+        chit->notValid();
     }
     else
     {
         // In case its state is not ACKNOWLEDGED, set it to UNACKNOWLEDGE because from now reader has to confirm
         // it will not be expecting it.
-        ChangeForReader_t newch(*chit);
         if (chit->getStatus() != ACKNOWLEDGED)
-            newch.setStatus(UNACKNOWLEDGED);
-        newch.notValid();
-
-        auto hint = m_changesForReader.erase(chit);
-
-        m_changesForReader.insert(hint, newch);
+            chit->setStatus(UNACKNOWLEDGED);
+        chit->notValid();
     }
 }
 
@@ -398,20 +410,19 @@ bool ReaderProxy::requested_fragment_set(SequenceNumber_t sequence_number, const
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
     // Locate the outbound change referenced by the NACK_FRAG
-    auto changeIter = std::find_if(m_changesForReader.begin(), m_changesForReader.end(), 
-            [sequence_number](const ChangeForReader_t& change)
-            {return change.getSequenceNumber() == sequence_number;});
-    if (changeIter == m_changesForReader.end())
+    auto changeIter = m_changesForReader.find(sequence_number);
+    if (changeIter == m_changesForReader.end() || !changeIter->isValid())
+        return false;
+
+    // Only the fragments the reader misses are sent again. Those still pending to be sent need nothing.
+    if (!changeIter->markFragmentsAsUnsent(frag_set))
         return false;
 
-    ChangeForReader_t newch(*changeIter);
-    auto hint = m_changesForReader.erase(changeIter);
-    newch.markFragmentsAsUnsent(frag_set);
+    changeIter->markAsRepair();
 
     // If it was UNSENT, we shouldn't switch back to REQUESTED to prevent stalling.
-    if (newch.getStatus() != UNSENT)
-        newch.setStatus(REQUESTED);
-    m_changesForReader.insert(hint, newch);
+    if (changeIter->getStatus() != UNSENT)
+        changeIter->setStatus(REQUESTED);
 
     return true;
 }
@@ -31,6 +31,7 @@
 #include <fastrtps/rtps/writer/timedevent/PeriodicHeartbeat.h>
 #include <fastrtps/rtps/writer/timedevent/NackSupressionDuration.h>
 #include <fastrtps/rtps/writer/timedevent/NackResponseDelay.h>
+#include <fastrtps/rtps/writer/timedevent/FragmentPacingDelay.h>
 
 #include <fastrtps/rtps/history/WriterHistory.h>
 
@@ -40,11 +41,19 @@
 #include "RTPSWriterCollector.h"
 #include "StatefulWriterOrganizer.h"
 
+#include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <vector>
 
 using namespace eprosima::fastrtps::rtps;
 
+static uint32_t fragment_length(const CacheChange_t* change, FragmentNumber_t fragment_number)
+{
+    uint32_t offset = (fragment_number - 1) * change->getFragmentSize();
+    return std::min<uint32_t>(change->getFragmentSize(), change->serializedPayload.length - offset);
+}
+
 
 StatefulWriter::StatefulWriter(RTPSParticipantImpl* pimpl,GUID_t& guid,
         WriterAttributes& att,WriterHistory* hist,WriterListener* listen):
@@ -53,7 +62,11 @@ StatefulWriter::StatefulWriter(RTPSParticipantImpl* pimpl,GUID_t& guid,
     all_acked_(false), may_remove_change_(0),
     disableHeartbeatPiggyback_(att.disableHeartbeatPiggyback),
     sendBufferSize_(pimpl->get_min_network_send_buffer_size()),
-    currentUsageSendBufferSize_(static_cast<int32_t>(pimpl->get_min_network_send_buffer_size()))
+    currentUsageSendBufferSize_(static_cast<int32_t>(pimpl->get_min_network_send_buffer_size())),
+    interleaveFragments_(att.interleaveFragments),
+    readerFragmentThroughput_(att.readerFragmentThroughput),
+    dropSlowestReader_(att.dropSlowestReader),
+    mp_fragmentPacing(nullptr)
 {
     m_heartbeatCount = 0;
     if(guid.entityId == c_EntityId_SEDPPubWriter)
@@ -65,6 +78,9 @@ StatefulWriter::StatefulWriter(RTPSParticipantImpl* pimpl,GUID_t& guid,
     else
         m_HBReaderEntityId = c_EntityId_Unknown;
     mp_periodicHB = new PeriodicHeartbeat(this,TimeConv::Time_t2MilliSecondsDouble(m_times.heartbeatPeriod));
+
+    if(readerFragmentThroughput_.bytesPerPeriod != UINT32_MAX && readerFragmentThroughput_.periodMillisecs != 0)
+        mp_fragmentPacing = new FragmentPacingDelay(this, readerFragmentThroughput_.periodMillisecs);
 }
 
 
@@ -81,6 +97,9 @@ StatefulWriter::~StatefulWriter()
     if(mp_periodicHB !=nullptr)
         delete(mp_periodicHB);
 
+    if(mp_fragmentPacing != nullptr)
+        delete(mp_fragmentPacing);
+
     for(std::vector<ReaderProxy*>::iterator it = matched_readers.begin();
             it!=matched_readers.end();++it)
         delete(*it);
@@ -115,7 +134,7 @@ void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
                 // TODO(Ricardo) Study next case: Not push mode, writer reliable and reader besteffort.
                 if(m_pushMode)
                 {
-                    if((*it)->m_att.endpoint.reliabilityKind == RELIABLE)
+                    if((*it)->waits_for_acknowledgement())
                     {
                         changeForReader.setStatus(UNDERWAY);
                     }
@@ -166,6 +185,7 @@ void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
             this->mp_periodicHB->restart_timer();
             if ( (mp_listener != nullptr) && this->is_acked_by_all(change) )
             {
+                readers_ack_state_.notified(change->sequenceNumber);
                 mp_listener->onWriterChangeReceivedByAll(this, change);
             }
         }
@@ -193,6 +213,7 @@ void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
     else
     {
         logInfo(RTPS_WRITER,"No reader proxy to add change.");
+        readers_ack_state_.notified(change->sequenceNumber);
         if (mp_listener != nullptr)
         {
             mp_listener->onWriterChangeReceivedByAll(this, change);
@@ -224,13 +245,18 @@ void StatefulWriter::send_any_unsent_changes()
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    RTPSWriterCollector<ReaderProxy*> relevantChanges;
+    RTPSWriterCollector<ReaderProxy*> relevantChanges(interleaveFragments_);
     StatefulWriterOrganizer notRelevantChanges;
+    auto now = std::chrono::steady_clock::now();
+    bool fragmentsHeldBack = false;
+    bool repairsCollected = false;
 
     for(auto remoteReader : matched_readers)
     {
         std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
         std::vector<ChangeForReader_t*> unsentChanges = remoteReader->get_unsent_changes();
+        uint32_t fragmentBytesAvailable = mp_fragmentPacing == nullptr ? UINT32_MAX :
+            remoteReader->fragment_pacing().available(readerFragmentThroughput_, now);
 
         for(auto unsentChange : unsentChanges)
         {
@@ -238,7 +264,29 @@ void StatefulWriter::send_any_unsent_changes()
             {
                 if(m_pushMode)
                 {
-                    relevantChanges.add_change(unsentChange->getChange(), remoteReader, unsentChange->getUnsentFragments());
+                    CacheChange_t* change = unsentChange->getChange();
+                    repairsCollected |= unsentChange->isRepair();
+
+                    if(change->getFragmentSize() == 0)
+                    {
+                        relevantChanges.add_change(change, remoteReader, FragmentNumberSet_t());
+                        continue;
+                    }
+
+                    // Only the fragments not sent yet, as many as the pacing of this reader allows.
+                    const FragmentBitmap_t& unsentFragments = unsentChange->getUnsentFragmentsBitmap();
+                    for(uint32_t position = unsentFragments.find_next(0, true); position < unsentFragments.size();
+                            position = unsentFragments.find_next(position + 1, true))
+                    {
+                        if(!FragmentPacingBudget::take(fragment_length(change, position + 1), fragmentBytesAvailable,
+                                    readerFragmentThroughput_))
+                        {
+                            fragmentsHeldBack = true;
+                            break;
+                        }
+
+                        relevantChanges.add_fragment(change, position + 1, remoteReader);
+                    }
                 }
                 else // Change status to UNACKNOWLEDGED
                 {
@@ -268,89 +316,46 @@ void StatefulWriter::send_any_unsent_changes()
         RTPSMessageGroup group(mp_RTPSParticipant, this,  RTPSMessageGroup::WRITER, m_cdrmessages);
         bool activateHeartbeatPeriod = false;
         uint32_t lastBytesProcessed = 0;
+        std::vector<ReaderProxy*> firstSendReaders;
+        std::vector<ReaderProxy*> repairReaders;
 
         while(!relevantChanges.empty())
         {
             RTPSWriterCollector<ReaderProxy*>::Item changeToSend = relevantChanges.pop();
-            std::vector<GUID_t> remote_readers;
-            std::vector<LocatorList_t> locatorLists;
-            bool expectsInlineQos = false;
-
-            for(auto remoteReader : changeToSend.remoteReaders)
-            {
-                remote_readers.push_back(remoteReader->m_att.guid);
-                LocatorList_t locators(remoteReader->m_att.endpoint.unicastLocatorList);
-                locators.push_back(remoteReader->m_att.endpoint.multicastLocatorList);
-                locatorLists.push_back(locators);
-                expectsInlineQos |= remoteReader->m_att.expectsInlineQos;
-            }
 
             // TODO(Ricardo) Flowcontroller has to be used in RTPSMessageGroup. Study.
             // And controllers are notified about the changes being sent
             FlowController::NotifyControllersChangeSent(changeToSend.cacheChange);
 
-            if(changeToSend.fragmentNumber != 0)
+            if(repairsCollected)
             {
-                if(group.add_data_frag(*changeToSend.cacheChange, changeToSend.fragmentNumber, remote_readers,
-                            mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists),
-                            expectsInlineQos))
+                // First transmissions go to the shared destinations of their readers, repairs to each reader.
+                firstSendReaders.clear();
+                repairReaders.clear();
+                for(auto remoteReader : changeToSend.remoteReaders)
                 {
-                    for(auto remoteReader : changeToSend.remoteReaders)
-                    {
-                        std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
-                        bool allFragmentsSent = remoteReader->mark_fragment_as_sent_for_change(changeToSend.cacheChange, changeToSend.fragmentNumber);
+                    if(remoteReader->change_is_repair(changeToSend.sequenceNumber))
+                        repairReaders.push_back(remoteReader);
+                    else
+                        firstSendReaders.push_back(remoteReader);
+                }
 
-                        if(remoteReader->m_att.endpoint.reliabilityKind == RELIABLE)
-                        {
-                            activateHeartbeatPeriod = true;
-                            assert(remoteReader->mp_nackSupression != nullptr);
-                            if(allFragmentsSent)
-                            {
-                                remoteReader->set_change_to_status(changeToSend.sequenceNumber, UNDERWAY);
-                                remoteReader->mp_nackSupression->restart_timer();
-                            }
-                        }
-                        else
-                        {
-                            if(allFragmentsSent)
-                            {
-                                remoteReader->set_change_to_status(changeToSend.sequenceNumber, ACKNOWLEDGED);
-                            }
-                        }
-                    }
+                if(!firstSendReaders.empty())
+                {
+                    activateHeartbeatPeriod |= send_to_readers_nts(group, changeToSend.cacheChange,
+                            changeToSend.fragmentNumber, firstSendReaders, destination_group_nts(firstSendReaders, false));
                 }
-                else
+                if(!repairReaders.empty())
                 {
-                    logError(RTPS_WRITER, "Error sending fragment (" << changeToSend.sequenceNumber <<
-                            ", " << changeToSend.fragmentNumber << ")");
+                    activateHeartbeatPeriod |= send_to_readers_nts(group, changeToSend.cacheChange,
+                            changeToSend.fragmentNumber, repairReaders, destination_group_nts(repairReaders, true));
                 }
             }
             else
             {
-                if(group.add_data(*changeToSend.cacheChange, remote_readers,
-                            mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists),
-                            expectsInlineQos))
-                {
-                    for(auto remoteReader : changeToSend.remoteReaders)
-                    {
-                        std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
-                        if(remoteReader->m_att.endpoint.reliabilityKind == RELIABLE)
-                        {
-                            remoteReader->set_change_to_status(changeToSend.sequenceNumber, UNDERWAY);
-                            activateHeartbeatPeriod = true;
-                            assert(remoteReader->mp_nackSupression != nullptr);
-                            remoteReader->mp_nackSupression->restart_timer();
-                        }
-                        else
-                        {
-                            remoteReader->set_change_to_status(changeToSend.sequenceNumber, ACKNOWLEDGED);
-                        }
-                    }
-                }
-                else
-                {
-                    logError(RTPS_WRITER, "Error sending change " << changeToSend.sequenceNumber);
-                }
+                activateHeartbeatPeriod |= send_to_readers_nts(group, changeToSend.cacheChange,
+                        changeToSend.fragmentNumber, changeToSend.remoteReaders,
+                        destination_group_nts(changeToSend.remoteReaders, false));
             }
 
             // Heartbeat piggyback.
@@ -375,22 +380,15 @@ void StatefulWriter::send_any_unsent_changes()
 
         for(auto pair : notRelevantChanges.elements())
         {
-            std::vector<GUID_t> remote_readers;
-            std::vector<LocatorList_t> locatorLists;
-
-            for(auto remoteReader : pair.first)
-            {
-                remote_readers.push_back(remoteReader->m_att.guid);
-                LocatorList_t locators(remoteReader->m_att.endpoint.unicastLocatorList);
-                locators.push_back(remoteReader->m_att.endpoint.multicastLocatorList);
-                locatorLists.push_back(locators);
-            }
-            group.add_gap(pair.second, remote_readers,
-                    mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists));
+            const DestinationGroup& destinations = destination_group_nts(pair.first, false);
+            group.add_gap(pair.second, destinations.guids, destinations.locators);
         }
 
         if(activateHeartbeatPeriod)
             this->mp_periodicHB->restart_timer();
+
+        if(fragmentsHeldBack)
+            mp_fragmentPacing->restart_timer();
     }
     else
     {
@@ -405,6 +403,101 @@ void StatefulWriter::send_any_unsent_changes()
 }
 
 
+bool StatefulWriter::send_to_readers_nts(RTPSMessageGroup& group, CacheChange_t* change,
+        FragmentNumber_t fragmentNumber, const std::vector<ReaderProxy*>& remoteReaders,
+        const DestinationGroup& destinations)
+{
+    bool waitingForAcknowledgement = false;
+
+    if(fragmentNumber != 0)
+    {
+        if(group.add_data_frag(*change, fragmentNumber, destinations.guids, destinations.locators,
+                    destinations.expectsInlineQos))
+        {
+            for(auto remoteReader : remoteReaders)
+            {
+                std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
+                bool allFragmentsSent = remoteReader->mark_fragment_as_sent_for_change(change, fragmentNumber);
+                remoteReader->fragment_pacing().sent(fragment_length(change, fragmentNumber));
+
+                if(remoteReader->waits_for_acknowledgement())
+                {
+                    waitingForAcknowledgement = true;
+                    assert(remoteReader->mp_nackSupression != nullptr);
+                    if(allFragmentsSent)
+                    {
+                        remoteReader->set_change_to_status(change->sequenceNumber, UNDERWAY);
+                        remoteReader->mp_nackSupression->restart_timer();
+                    }
+                }
+                else
+                {
+                    if(allFragmentsSent)
+                    {
+                        remoteReader->set_change_to_status(change->sequenceNumber, ACKNOWLEDGED);
+                    }
+                }
+            }
+        }
+        else
+        {
+            logError(RTPS_WRITER, "Error sending fragment (" << change->sequenceNumber <<
+                    ", " << fragmentNumber << ")");
+        }
+    }
+    else
+    {
+        if(group.add_data(*change, destinations.guids, destinations.locators, destinations.expectsInlineQos))
+        {
+            for(auto remoteReader : remoteReaders)
+            {
+                std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
+                if(remoteReader->waits_for_acknowledgement())
+                {
+                    remoteReader->set_change_to_status(change->sequenceNumber, UNDERWAY);
+                    waitingForAcknowledgement = true;
+                    assert(remoteReader->mp_nackSupression != nullptr);
+                    remoteReader->mp_nackSupression->restart_timer();
+                }
+                else
+                {
+                    remoteReader->set_change_to_status(change->sequenceNumber, ACKNOWLEDGED);
+                }
+            }
+        }
+        else
+        {
+            logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
+        }
+    }
+
+    return waitingForAcknowledgement;
+}
+
+const DestinationGroup& StatefulWriter::destination_group_nts(
+        const std::vector<ReaderProxy*>& remoteReaders, bool unicastOnly)
+{
+    auto& groups = unicastOnly ? repair_destination_groups_ : destination_groups_;
+
+    return groups.get(remoteReaders, [this, unicastOnly](const std::vector<ReaderProxy*>& readers,
+                DestinationGroup& destinations)
+            {
+                std::vector<LocatorList_t> locatorLists;
+
+                for(auto remoteReader : readers)
+                {
+                    destinations.guids.push_back(remoteReader->m_att.guid);
+                    LocatorList_t locators(remoteReader->m_att.endpoint.unicastLocatorList);
+                    if(!unicastOnly || locators.empty())
+                        locators.push_back(remoteReader->m_att.endpoint.multicastLocatorList);
+                    locatorLists.push_back(locators);
+                    destinations.expectsInlineQos |= remoteReader->m_att.expectsInlineQos;
+                }
+
+                destinations.locators = mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists);
+            });
+}
+
 /*
  *	MATCHED_READER-RELATED METHODS
  */
@@ -418,19 +511,19 @@ bool StatefulWriter::matched_reader_add(const RemoteReaderAttributes& rdata)
         return false;
     }
 
+    // Check if it is already matched.
+    if(matched_readers_by_guid_.find(rdata.guid) != matched_readers_by_guid_.end())
+    {
+        logInfo(RTPS_WRITER, "Attempting to add existing reader" << endl);
+        return false;
+    }
+
     std::vector<GUID_t> allRemoteReaders;
     std::vector<LocatorList_t> allLocatorLists;
 
-    // Check if it is already matched.
     for(std::vector<ReaderProxy*>::iterator it=matched_readers.begin();it!=matched_readers.end();++it)
     {
         std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-        if((*it)->m_att.guid == rdata.guid)
-        {
-            logInfo(RTPS_WRITER, "Attempting to add existing reader" << endl);
-            return false;
-        }
-
         allRemoteReaders.push_back((*it)->m_att.guid);
         LocatorList_t locators((*it)->m_att.endpoint.unicastLocatorList);
         locators.push_back((*it)->m_att.endpoint.multicastLocatorList);
@@ -444,10 +537,15 @@ bool StatefulWriter::matched_reader_add(const RemoteReaderAttributes& rdata)
     allLocatorLists.push_back(locators);
 
     update_cached_info_nts(std::move(allRemoteReaders), allLocatorLists);
+    destination_groups_.clear();
+    repair_destination_groups_.clear();
 
     ReaderProxy* rp = new ReaderProxy(rdata, m_times, this);
     std::set<SequenceNumber_t> not_relevant_changes;
 
+    // From now on, the proxy reports the changes of its low mark.
+    readers_ack_state_.add_reader(rp->get_low_mark(), false);
+
     SequenceNumber_t current_seq = get_seq_num_min();
     SequenceNumber_t last_seq = get_seq_num_max();
 
@@ -519,6 +617,7 @@ bool StatefulWriter::matched_reader_add(const RemoteReaderAttributes& rdata)
     }
 
     matched_readers.push_back(rp);
+    matched_readers_by_guid_[rp->m_att.guid] = rp;
 
     logInfo(RTPS_WRITER, "Reader Proxy "<< rp->m_att.guid<< " added to " << this->m_guid.entityId << " with "
             <<rp->m_att.endpoint.unicastLocatorList.size()<<"(u)-"
@@ -535,28 +634,30 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
     std::vector<GUID_t> allRemoteReaders;
     std::vector<LocatorList_t> allLocatorLists;
 
-    auto it = matched_readers.begin();
-    while(it != matched_readers.end())
+    auto found = matched_readers_by_guid_.find(rdata.guid);
+    if(found != matched_readers_by_guid_.end())
     {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-
-        if((*it)->m_att.guid == rdata.guid)
-        {
-            logInfo(RTPS_WRITER, "Reader Proxy removed: " << (*it)->m_att.guid);
-            rproxy = std::move(*it);
-            it = matched_readers.erase(it);
+        rproxy = found->second;
+        matched_readers_by_guid_.erase(found);
+        matched_readers.erase(std::find(matched_readers.begin(), matched_readers.end(), rproxy));
 
-            continue;
-        }
+        std::lock_guard<std::recursive_mutex> rguard(*rproxy->mp_mutex);
+        logInfo(RTPS_WRITER, "Reader Proxy removed: " << rproxy->m_att.guid);
+        readers_ack_state_.remove_reader(rproxy->get_low_mark(), rproxy->countChangesForReader() > 0);
+    }
 
+    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
+    {
+        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
         allRemoteReaders.push_back((*it)->m_att.guid);
         LocatorList_t locators((*it)->m_att.endpoint.unicastLocatorList);
         locators.push_back((*it)->m_att.endpoint.multicastLocatorList);
         allLocatorLists.push_back(locators);
-        ++it;
     }
 
     update_cached_info_nts(std::move(allRemoteReaders), allLocatorLists);
+    destination_groups_.clear();
+    repair_destination_groups_.clear();
 
     if(matched_readers.size()==0)
         this->mp_periodicHB->cancel_timer();
@@ -579,29 +680,17 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
 bool StatefulWriter::matched_reader_is_matched(const RemoteReaderAttributes& rdata)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    for(std::vector<ReaderProxy*>::iterator it=matched_readers.begin();it!=matched_readers.end();++it)
-    {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-        if((*it)->m_att.guid == rdata.guid)
-        {
-            return true;
-        }
-    }
-    return false;
+    return matched_readers_by_guid_.find(rdata.guid) != matched_readers_by_guid_.end();
 }
 
 bool StatefulWriter::matched_reader_lookup(GUID_t& readerGuid,ReaderProxy** RP)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    std::vector<ReaderProxy*>::iterator it;
-    for(it=matched_readers.begin();it!=matched_readers.end();++it)
+    auto it = matched_readers_by_guid_.find(readerGuid);
+    if(it != matched_readers_by_guid_.end())
     {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-        if((*it)->m_att.guid == readerGuid)
-        {
-            *RP = *it;
-            return true;
-        }
+        *RP = it->second;
+        return true;
     }
     return false;
 }
@@ -616,6 +705,9 @@ bool StatefulWriter::is_acked_by_all(const CacheChange_t* change) const
         return false;
     }
 
+    if(readers_ack_state_.is_acked_by_all(change->sequenceNumber))
+        return true;
+
     for(auto it = matched_readers.begin(); it!=matched_readers.end(); ++it)
     {
         if(!(*it)->change_is_acked(change->sequenceNumber))
@@ -632,17 +724,7 @@ bool StatefulWriter::wait_for_all_acked(const Duration_t& max_wait)
     std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
     std::unique_lock<std::mutex> all_acked_lock(all_acked_mutex_);
 
-    all_acked_ = true;
-
-    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
-    {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-        if((*it)->countChangesForReader() > 0)
-        {
-            all_acked_ = false;
-            break;
-        }
-    }
+    all_acked_ = readers_ack_state_.all_acked();
     lock.unlock();
 
     if(!all_acked_)
@@ -658,41 +740,19 @@ void StatefulWriter::check_acked_status()
 {
     std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
 
-    bool all_acked = true;
-    SequenceNumber_t min_low_mark;
-
-
-    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
-    {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-
-        if(min_low_mark == SequenceNumber_t() || (*it)->get_low_mark() < min_low_mark)
-        {
-            min_low_mark = (*it)->get_low_mark();
-        }
-
-        if((*it)->countChangesForReader() > 0)
-        {
-            all_acked = false;
-        }
-    }
+    bool all_acked = readers_ack_state_.all_acked();
+    SequenceNumber_t min_low_mark = readers_ack_state_.low_mark();
 
     if(get_seq_num_min() != SequenceNumber_t::unknown())
     {
-        // Inform of samples acked.
-        if(mp_listener != nullptr)
+        // Inform of samples acked since the last time. The history is ordered by sequence number.
+        if(mp_listener != nullptr && readers_ack_state_.last_notified() < min_low_mark)
         {
             std::vector<CacheChange_t*> all_acked_changes;
-            for(SequenceNumber_t current_seq = get_seq_num_min(); current_seq <= min_low_mark; ++current_seq)
+            auto cit = readers_ack_state_.first_not_notified(mp_history->changesBegin(), mp_history->changesEnd());
+            for(; cit != mp_history->changesEnd() && (*cit)->sequenceNumber <= min_low_mark; ++cit)
             {
-                for(std::vector<CacheChange_t*>::iterator cit = mp_history->changesBegin();
-                        cit != mp_history->changesEnd(); ++cit)
-                {
-                    if((*cit)->sequenceNumber == current_seq)
-                    {
-                        all_acked_changes.push_back(*cit);
-                    }
-                }
+                all_acked_changes.push_back(*cit);
             }
             for(auto cit = all_acked_changes.begin(); cit != all_acked_changes.end(); ++cit)
             {
@@ -704,12 +764,23 @@ void StatefulWriter::check_acked_status()
             (min_low_mark - get_seq_num_min()) + 1;
         if (calc > SequenceNumber_t())
         {
-            std::unique_lock<std::mutex> may_lock(may_remove_change_mutex_);
-            may_remove_change_ = 1;
-            may_remove_change_cond_.notify_one();
+            // Volatile changes acked by all the readers are not needed any more.
+            if(getAttributes()->durabilityKind == VOLATILE)
+            {
+                while(get_seq_num_min() != SequenceNumber_t::unknown() && get_seq_num_min() <= min_low_mark &&
+                        mp_history->remove_min_change());
+            }
+            else
+            {
+                std::unique_lock<std::mutex> may_lock(may_remove_change_mutex_);
+                may_remove_change_ = 1;
+                may_remove_change_cond_.notify_one();
+            }
         }
     }
 
+    readers_ack_state_.notified(min_low_mark);
+
     if(all_acked)
     {
         std::unique_lock<std::mutex> all_acked_lock(all_acked_mutex_);
@@ -723,22 +794,19 @@ bool StatefulWriter::try_remove_change(std::chrono::microseconds& microseconds,
 {
     logInfo(RTPS_WRITER, "Starting process try remove change for writer " << getGuid());
 
-    SequenceNumber_t min_low_mark;
-
-    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
-    {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-
-        if(min_low_mark == SequenceNumber_t() || (*it)->get_low_mark() < min_low_mark)
-        {
-            min_low_mark = (*it)->get_low_mark();
-        }
-    }
+    SequenceNumber_t min_low_mark = readers_ack_state_.low_mark();
 
     SequenceNumber_t calc = min_low_mark < get_seq_num_min() ? SequenceNumber_t() :
         (min_low_mark - get_seq_num_min()) + 1;
     unsigned int may_remove_change = 1;
 
+    // In bounded memory mode the readers holding back the oldest change stop being waited for.
+    if(calc <= SequenceNumber_t() && dropSlowestReader_ && drop_slowest_readers_nts())
+    {
+        min_low_mark = readers_ack_state_.low_mark();
+        calc = min_low_mark < get_seq_num_min() ? SequenceNumber_t() : (min_low_mark - get_seq_num_min()) + 1;
+    }
+
     if(calc <= SequenceNumber_t())
     {
         lock.unlock();
@@ -880,39 +948,87 @@ void StatefulWriter::process_acknack(const GUID_t reader_guid, uint32_t ack_coun
 {
     std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
 
-    for(auto remote_reader : matched_readers)
+    auto found = matched_readers_by_guid_.find(reader_guid);
+    if(found == matched_readers_by_guid_.end())
+        return;
+
+    ReaderProxy* remote_reader = found->second;
+    std::lock_guard<std::recursive_mutex> reader_guard(*remote_reader->mp_mutex);
+
+    if(remote_reader->m_lastAcknackCount < ack_count)
     {
-        std::lock_guard<std::recursive_mutex> reader_guard(*remote_reader->mp_mutex);
+        remote_reader->m_lastAcknackCount = ack_count;
 
-        if(remote_reader->m_att.guid == reader_guid)
+        // A dropped reader is waited for again once it has caught up with what it was dropped for and with
+        // what the history still keeps. Its state is rebuilt from its ACKNACK base. Until then its ACKNACKs
+        // are stale, and following them would only bring back the reader to be dropped again.
+        if(!remote_reader->is_active())
         {
-            if(remote_reader->m_lastAcknackCount < ack_count)
-            {
-                remote_reader->m_lastAcknackCount = ack_count;
-                if(sn_set.base != SequenceNumber_t(0, 0))
-                {
-                    // Sequence numbers before Base are set as Acknowledged.
-                    remote_reader->acked_changes_set(sn_set.base);
-                    std::vector<SequenceNumber_t> set_vec = sn_set.get_set();
-                    if (remote_reader->requested_changes_set(set_vec) && remote_reader->mp_nackResponse != nullptr)
-                    {
-                        remote_reader->mp_nackResponse->restart_timer();
-                    }
-                    else if(!final_flag)
-                    {
-                        mp_periodicHB->restart_timer();
-                    }
-                }
-                else if(sn_set.isSetEmpty() && !final_flag)
-                {
-                    send_heartbeat_to_nts(*remote_reader, true, remote_reader->m_att.is_eprosima_endpoint);
-                }
+            SequenceNumber_t reactivation_mark = remote_reader->dropped_low_mark();
+            SequenceNumber_t seq_num_min = get_seq_num_min();
+            if(seq_num_min != c_SequenceNumber_Unknown && reactivation_mark < seq_num_min)
+                reactivation_mark = seq_num_min;
+
+            if(sn_set.base < reactivation_mark)
+                return;
 
-                // Check if all CacheChange are acknowledge, because a user could be waiting
-                // for this, of if VOLATILE should be removed CacheChanges
-                check_acked_status();
+            logInfo(RTPS_WRITER, "Reader " << reader_guid << " acknowledging again to writer " << getGuid());
+            remote_reader->activate();
+        }
+        if(sn_set.base != SequenceNumber_t(0, 0))
+        {
+            // Sequence numbers before Base are set as Acknowledged.
+            remote_reader->acked_changes_set(sn_set.base);
+            std::vector<SequenceNumber_t> set_vec = sn_set.get_set();
+            uint32_t requested = remote_reader->requested_changes_set(set_vec);
+            EndpointStatisticsCounters::add(m_statistics.retransmissions, requested);
+            if (requested > 0 && remote_reader->mp_nackResponse != nullptr)
+            {
+                remote_reader->mp_nackResponse->restart_timer();
+            }
+            else if(!final_flag)
+            {
+                mp_periodicHB->restart_timer();
             }
-            break;
         }
+        else if(sn_set.isSetEmpty() && !final_flag)
+        {
+            send_heartbeat_to_nts(*remote_reader, true, remote_reader->m_att.is_eprosima_endpoint);
+        }
+
+        // Check if all CacheChange are acknowledge, because a user could be waiting
+        // for this, of if VOLATILE should be removed CacheChanges
+        check_acked_status();
     }
 }
+
+bool StatefulWriter::drop_slowest_readers_nts()
+{
+    if(matched_readers.empty())
+        return false;
+
+    SequenceNumber_t min_low_mark = readers_ack_state_.low_mark();
+    bool dropped = false;
+
+    for(auto remote_reader : matched_readers)
+    {
+        std::lock_guard<std::recursive_mutex> reader_guard(*remote_reader->mp_mutex);
+
+        if(remote_reader->is_active() && remote_reader->get_low_mark() == min_low_mark &&
+                remote_reader->countChangesForReader() > 0)
+        {
+            logWarning(RTPS_WRITER, "Reader " << remote_reader->m_att.guid << " too slow for writer " << getGuid()
+                    << ". Not waiting for its acknowledgements any more");
+            remote_reader->deactivate();
+            dropped = true;
+        }
+    }
+
+    return dropped;
+}
+
+void StatefulWriter::reader_ack_state_changed_nts(const SequenceNumber_t& previous_low_mark, bool had_changes,
+        const SequenceNumber_t& low_mark, bool has_changes)
+{
+    readers_ack_state_.reader_changed(previous_low_mark, had_changes, low_mark, has_changes);
+}
@@ -27,7 +27,7 @@
 
 #include <mutex>
 #include <vector>
-#include <set>
+#include <algorithm>
 
 #include <fastrtps/log/Log.h>
 
@@ -38,9 +38,13 @@ namespace rtps {
 
 StatelessWriter::StatelessWriter(RTPSParticipantImpl* pimpl,GUID_t& guid,
         WriterAttributes& att,WriterHistory* hist,WriterListener* listen):
-    RTPSWriter(pimpl,guid,att,hist,listen)
+    RTPSWriter(pimpl,guid,att,hist,listen),
+    m_builtin_guids(get_builtin_guid()),
+    m_all_destinations_expect_inline_qos(false),
+    m_changes_to_send(new RTPSWriterCollector<ReaderLocator*>())
 {
-    mAllRemoteReaders = get_builtin_guid();
+    mAllRemoteReaders = m_builtin_guids;
+    update_all_destinations_nts_();
 }
 
 StatelessWriter::~StatelessWriter()
@@ -155,39 +159,62 @@ bool StatelessWriter::is_acked_by_all(const CacheChange_t* change) const
     return true;
 }
 
-void StatelessWriter::update_unsent_changes(ReaderLocator& reader_locator,
+bool StatelessWriter::mark_as_sent_nts_(ReaderLocator& reader_locator, size_t& cursor,
         const SequenceNumber_t& seqNum, const FragmentNumber_t fragNum)
 {
-    auto it = std::find_if(reader_locator.unsent_changes.begin(),
-            reader_locator.unsent_changes.end(),
-            [seqNum](const ChangeForReader_t& unsent_change)
-            {
-                return seqNum == unsent_change.getSequenceNumber();
-            });
+    std::vector<ChangeForReader_t>& unsent_changes = reader_locator.unsent_changes;
 
-    if(it != reader_locator.unsent_changes.end())
+    while(cursor < unsent_changes.size() && unsent_changes[cursor].getSequenceNumber() < seqNum)
+        ++cursor;
+
+    auto it = unsent_changes.begin() + cursor;
+    if(it == unsent_changes.end() || it->getSequenceNumber() != seqNum)
     {
-        if (fragNum != 0)
-        {
-            it->markFragmentsAsSent(fragNum);
-            FragmentNumberSet_t fragment_sns = it->getUnsentFragments();
-            if(fragment_sns.isSetEmpty())
-                reader_locator.unsent_changes.erase(it);
-        }
-        else
-            reader_locator.unsent_changes.erase(it);
+        // Unsent changes are kept in order, but do not rely on it to find the change.
+        it = std::find_if(unsent_changes.begin(), unsent_changes.end(),
+                [seqNum](const ChangeForReader_t& unsent_change)
+                {
+                    return seqNum == unsent_change.getSequenceNumber();
+                });
+
+        if(it == unsent_changes.end())
+            return false;
     }
+
+    if(fragNum != 0)
+    {
+        it->markFragmentsAsSent(fragNum);
+        if(it->hasUnsentFragments())
+            return false;
+    }
+
+    it->setStatus(UNDERWAY);
+    return true;
+}
+
+void StatelessWriter::remove_sent_changes_nts_()
+{
+    for(auto& reader_locator : reader_locators)
+        reader_locator.unsent_changes.erase(std::remove_if(
+                    reader_locator.unsent_changes.begin(),
+                    reader_locator.unsent_changes.end(),
+                    [](const ChangeForReader_t& unsent_change)
+                    {
+                        return unsent_change.getStatus() == UNDERWAY;
+                    }),
+                    reader_locator.unsent_changes.end());
 }
 
 void StatelessWriter::send_any_unsent_changes()
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    RTPSWriterCollector<ReaderLocator*> changesToSend;
+    RTPSWriterCollector<ReaderLocator*>& changesToSend = *m_changes_to_send;
+    changesToSend.clear();
 
     for(auto& reader_locator : reader_locators)
     {
-        for(auto unsentChange : reader_locator.unsent_changes)
+        for(const auto& unsentChange : reader_locator.unsent_changes)
         {
             changesToSend.add_change(unsentChange.getChange(), &reader_locator, unsentChange.getUnsentFragments());
         }
@@ -204,36 +231,56 @@ void StatelessWriter::send_any_unsent_changes()
     RTPSMessageGroup group(mp_RTPSParticipant, this,  RTPSMessageGroup::WRITER, m_cdrmessages);
     bool bHasListener = mp_listener != nullptr;
 
-    while(!changesToSend.empty())
+    m_unsent_cursors.assign(reader_locators.size(), 0);
+    m_sent_changes.clear();
+
+    for(auto& changeToSend : changesToSend)
     {
-        RTPSWriterCollector<ReaderLocator*>::Item changeToSend = changesToSend.pop();
-        std::vector<GUID_t> remote_readers = get_builtin_guid();
-        std::set<GUID_t> remote_readers_aux;
-        LocatorList_t locatorList;
-        bool expectsInlineQos = false, addGuid = remote_readers.empty();
+        // A change that goes to every reader locator uses the precomputed destinations.
+        bool toAll = changeToSend.remoteReaders.size() == reader_locators.size();
+        const std::vector<GUID_t>* remote_readers = &m_all_destination_guids;
+        const LocatorList_t* locatorList = &m_all_destination_locators;
+        bool expectsInlineQos = m_all_destinations_expect_inline_qos;
+        bool sent = false;
+
+        if(!toAll)
+        {
+            m_destination_guids.assign(m_builtin_guids.begin(), m_builtin_guids.end());
+            m_destination_locators.clear();
+            expectsInlineQos = false;
+            remote_readers = &m_destination_guids;
+            locatorList = &m_destination_locators;
+        }
 
         for(auto* readerLocator : changeToSend.remoteReaders)
         {
-            // Remove the messages selected for sending from the original list,
-            // and update those that were fragmented with the new sent index
-            update_unsent_changes(*readerLocator, changeToSend.sequenceNumber, changeToSend.fragmentNumber);
-
-            if(addGuid)
-                remote_readers_aux.insert(readerLocator->remote_guids.begin(), readerLocator->remote_guids.end());
-            locatorList.push_back(readerLocator->locator);
-            expectsInlineQos |= readerLocator->expectsInlineQos;
+            size_t& cursor = m_unsent_cursors[static_cast<size_t>(readerLocator - reader_locators.data())];
+            sent |= mark_as_sent_nts_(*readerLocator, cursor, changeToSend.sequenceNumber, changeToSend.fragmentNumber);
+
+            if(!toAll)
+            {
+                if(m_builtin_guids.empty())
+                    m_destination_guids.insert(m_destination_guids.end(), readerLocator->remote_guids.begin(),
+                            readerLocator->remote_guids.end());
+                m_destination_locators.push_back(readerLocator->locator);
+                expectsInlineQos |= readerLocator->expectsInlineQos;
+            }
         }
 
-        if(addGuid)
-            remote_readers.assign(remote_readers_aux.begin(), remote_readers_aux.end());
+        if(!toAll && m_builtin_guids.empty())
+        {
+            std::sort(m_destination_guids.begin(), m_destination_guids.end());
+            m_destination_guids.erase(std::unique(m_destination_guids.begin(), m_destination_guids.end()),
+                    m_destination_guids.end());
+        }
 
         // Notify the controllers
         FlowController::NotifyControllersChangeSent(changeToSend.cacheChange);
 
         if(changeToSend.fragmentNumber != 0)
         {
-            if(!group.add_data_frag(*changeToSend.cacheChange, changeToSend.fragmentNumber, remote_readers,
-                        locatorList, expectsInlineQos))
+            if(!group.add_data_frag(*changeToSend.cacheChange, changeToSend.fragmentNumber, *remote_readers,
+                        *locatorList, expectsInlineQos))
             {
                 logError(RTPS_WRITER, "Error sending fragment (" << changeToSend.sequenceNumber <<
                         ", " << changeToSend.fragmentNumber << ")");
@@ -241,16 +288,29 @@ void StatelessWriter::send_any_unsent_changes()
         }
         else
         {
-            if(!group.add_data(*changeToSend.cacheChange, remote_readers,
-                        locatorList, expectsInlineQos))
+            if(!group.add_data(*changeToSend.cacheChange, *remote_readers,
+                        *locatorList, expectsInlineQos))
             {
                 logError(RTPS_WRITER, "Error sending change " << changeToSend.sequenceNumber);
             }
         }
 
-        if (bHasListener && this->is_acked_by_all(changeToSend.cacheChange))
+        // Items of the same change are consecutive.
+        if(bHasListener && sent &&
+                (m_sent_changes.empty() || m_sent_changes.back() != changeToSend.cacheChange))
+        {
+            m_sent_changes.push_back(changeToSend.cacheChange);
+        }
+    }
+
+    changesToSend.clear();
+    remove_sent_changes_nts_();
+
+    for(CacheChange_t* change : m_sent_changes)
+    {
+        if(this->is_acked_by_all(change))
         {
-            mp_listener->onWriterChangeReceivedByAll(this, changeToSend.cacheChange);
+            mp_listener->onWriterChangeReceivedByAll(this, change);
         }
     }
 
@@ -329,6 +389,7 @@ bool StatelessWriter::add_locator(Locator_t& loc)
                 return true;
 
         reader_locators.push_back(newLoc);
+        update_all_destinations_nts_();
         return true;
     }
 #if HAVE_SECURITY
@@ -340,6 +401,26 @@ bool StatelessWriter::add_locator(Locator_t& loc)
 #endif
 }
 
+void StatelessWriter::update_all_destinations_nts_()
+{
+    m_all_destination_guids = m_builtin_guids;
+    m_all_destination_locators.clear();
+    m_all_destinations_expect_inline_qos = false;
+
+    for(const auto& reader_locator : reader_locators)
+    {
+        if(m_builtin_guids.empty())
+            m_all_destination_guids.insert(m_all_destination_guids.end(), reader_locator.remote_guids.begin(),
+                    reader_locator.remote_guids.end());
+        m_all_destination_locators.push_back(reader_locator.locator);
+        m_all_destinations_expect_inline_qos |= reader_locator.expectsInlineQos;
+    }
+
+    std::sort(m_all_destination_guids.begin(), m_all_destination_guids.end());
+    m_all_destination_guids.erase(std::unique(m_all_destination_guids.begin(), m_all_destination_guids.end()),
+            m_all_destination_guids.end());
+}
+
 void StatelessWriter::update_locators_nts_(const GUID_t& optionalGuid)
 {
     std::vector<ReaderLocator> backup(std::move(reader_locators));
@@ -412,6 +493,8 @@ void StatelessWriter::update_locators_nts_(const GUID_t& optionalGuid)
             }
         }
     }
+
+    update_all_destinations_nts_();
 }
 
 bool StatelessWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
@@ -0,0 +1,67 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FragmentPacingDelay.cpp
+ *
+ */
+
+#include <fastrtps/rtps/writer/timedevent/FragmentPacingDelay.h>
+#include <fastrtps/rtps/resources/ResourceEvent.h>
+#include <fastrtps/rtps/resources/AsyncWriterThread.h>
+#include <fastrtps/rtps/writer/StatefulWriter.h>
+#include "../../participant/RTPSParticipantImpl.h"
+
+#include <fastrtps/log/Log.h>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+
+FragmentPacingDelay::~FragmentPacingDelay()
+{
+    destroy();
+}
+
+FragmentPacingDelay::FragmentPacingDelay(StatefulWriter* p_SFW, double millisec):
+TimedEvent(p_SFW->getRTPSParticipant()->getEventResource(), millisec),
+mp_SFW(p_SFW)
+{
+
+}
+
+void FragmentPacingDelay::event(EventCode code, const char* msg)
+{
+
+    // Unused in release mode.
+    (void)msg;
+
+    if(code == EVENT_SUCCESS)
+    {
+        logInfo(RTPS_WRITER,"Resuming paced fragments of writer " << mp_SFW->getGuid());
+        AsyncWriterThread::wakeUp(mp_SFW);
+    }
+    else if(code == EVENT_ABORT)
+    {
+        logInfo(RTPS_WRITER,"Aborted");
+    }
+    else
+    {
+        logInfo(RTPS_WRITER,"Event message: " <<msg);
+    }
+}
+}
+} /* namespace dds */
+} /* namespace eprosima */
@@ -41,8 +41,7 @@ NackResponseDelay::~NackResponseDelay()
 }
 
 NackResponseDelay::NackResponseDelay(ReaderProxy* p_RP,double millisec):
-    TimedEvent(p_RP->mp_SFW->getRTPSParticipant()->getEventResource().getIOService(),
-            p_RP->mp_SFW->getRTPSParticipant()->getEventResource().getThread(), millisec),
+    TimedEvent(p_RP->mp_SFW->getRTPSParticipant()->getEventResource(), millisec),
     mp_RP(p_RP)
 {
 }
@@ -38,8 +38,7 @@ NackSupressionDuration::~NackSupressionDuration()
 }
 
 NackSupressionDuration::NackSupressionDuration(ReaderProxy* p_RP,double millisec):
-TimedEvent(p_RP->mp_SFW->getRTPSParticipant()->getEventResource().getIOService(),
-p_RP->mp_SFW->getRTPSParticipant()->getEventResource().getThread(), millisec),
+TimedEvent(p_RP->mp_SFW->getRTPSParticipant()->getEventResource(), millisec),
 mp_RP(p_RP)
 {
 
@@ -23,16 +23,28 @@
 #include "PermissionsTypes.h"
 #include <fastrtps/rtps/security/accesscontrol/ParticipantSecurityAttributes.h>
 #include <fastrtps/rtps/security/accesscontrol/EndpointSecurityAttributes.h>
+#include <fastrtps/rtps/security/exceptions/SecurityException.h>
 
 #include <openssl/x509.h>
 #include <string>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 namespace security {
 
+/*!
+ * Result of checking the access of a remote endpoint to a topic.
+ */
+struct AccessDecision
+{
+    bool allowed;
+    SecurityException exception;
+};
+
 class AccessPermissions
 {
     public:
@@ -59,6 +71,17 @@ class AccessPermissions
         std::map<std::string, EndpointSecurityAttributes> governance_reader_topic_rules_;
         std::map<std::string, EndpointSecurityAttributes> governance_writer_topic_rules_;
         Grant grant;
+
+        /*!
+         * Decisions already taken with the rules above, by topic name, and by domain and topic name for remote
+         * endpoints. Matching topic expressions is done once for each topic instead of once for each endpoint.
+         * Topic rules point into the maps above, which do not change once the handle is filled.
+         */
+        mutable std::mutex decisions_mutex_;
+        mutable std::unordered_map<std::string, const EndpointSecurityAttributes*> reader_topic_rule_decisions_;
+        mutable std::unordered_map<std::string, const EndpointSecurityAttributes*> writer_topic_rule_decisions_;
+        mutable std::map<std::pair<uint32_t, std::string>, AccessDecision> remote_reader_decisions_;
+        mutable std::map<std::pair<uint32_t, std::string>, AccessDecision> remote_writer_decisions_;
 };
 
 typedef HandleImpl<AccessPermissions> AccessPermissionsHandle;
@@ -83,9 +83,21 @@ static bool is_domain_in_set(const uint32_t domain_id, const Domains& domains)
     return returned_value;
 }
 
+// Decisions kept by each permissions handle before they are discarded.
+static const size_t max_access_decisions = 4096;
+
 static const EndpointSecurityAttributes* is_topic_in_sec_attributes(const std::string& topic_name,
-        const std::map<std::string, EndpointSecurityAttributes>& attributes)
+        const std::map<std::string, EndpointSecurityAttributes>& attributes,
+        std::unordered_map<std::string, const EndpointSecurityAttributes*>& decisions, std::mutex& decisions_mutex)
 {
+    std::lock_guard<std::mutex> guard(decisions_mutex);
+
+    auto decision = decisions.find(topic_name);
+    if(decision != decisions.end())
+    {
+        return decision->second;
+    }
+
     const EndpointSecurityAttributes* returned_value = nullptr;
 
     for(auto& topic : attributes)
@@ -97,6 +109,12 @@ static const EndpointSecurityAttributes* is_topic_in_sec_attributes(const std::s
         }
     }
 
+    if(decisions.size() >= max_access_decisions)
+    {
+        decisions.clear();
+    }
+    decisions.emplace(topic_name, returned_value);
+
     return returned_value;
 }
 
@@ -107,7 +125,7 @@ static bool is_topic_in_criterias(const std::string& topic_name, const std::vect
     for(auto criteria_it = criterias.begin(); !returned_value &&
             criteria_it != criterias.end(); ++criteria_it)
     {
-        for(auto topic : (*criteria_it).topics)
+        for(const auto& topic : (*criteria_it).topics)
         {
             if(StringMatching::matchString(topic.c_str(), topic_name.c_str()))
             {
@@ -120,6 +138,93 @@ static bool is_topic_in_criterias(const std::string& topic_name, const std::vect
     return returned_value;
 }
 
+/*!
+ * Checks the access of a remote endpoint to a topic with the governance and the grant of its participant.
+ * The decision is taken once for each domain and topic, and kept in the permissions handle.
+ */
+static bool check_remote_endpoint(const AccessPermissions& permissions, const uint32_t domain_id,
+        const std::string& topic_name, bool is_writer, SecurityException& exception)
+{
+    auto& decisions = is_writer ? permissions.remote_writer_decisions_ : permissions.remote_reader_decisions_;
+    std::pair<uint32_t, std::string> key(domain_id, topic_name);
+
+    {
+        std::lock_guard<std::mutex> guard(permissions.decisions_mutex_);
+
+        auto decision = decisions.find(key);
+        if(decision != decisions.end())
+        {
+            if(!decision->second.allowed)
+            {
+                exception = decision->second.exception;
+            }
+
+            return decision->second.allowed;
+        }
+    }
+
+    AccessDecision decision{false, SecurityException()};
+    const EndpointSecurityAttributes* attributes = is_writer ?
+        is_topic_in_sec_attributes(topic_name, permissions.governance_writer_topic_rules_,
+                permissions.writer_topic_rule_decisions_, permissions.decisions_mutex_) :
+        is_topic_in_sec_attributes(topic_name, permissions.governance_reader_topic_rules_,
+                permissions.reader_topic_rule_decisions_, permissions.decisions_mutex_);
+
+    if(attributes == nullptr)
+    {
+        decision.exception = _SecurityException_("Not found topic access rule for topic " + topic_name);
+    }
+    else if(!attributes->is_access_protected)
+    {
+        decision.allowed = true;
+    }
+    else
+    {
+        for(const auto& rule : permissions.grant.rules)
+        {
+            if(is_domain_in_set(domain_id, rule.domains))
+            {
+                if(is_topic_in_criterias(topic_name, is_writer ? rule.publishes : rule.subscribes))
+                {
+                    if(rule.allow)
+                    {
+                        decision.allowed = true;
+                    }
+                    else
+                    {
+                        decision.exception = _SecurityException_(topic_name +
+                                std::string(" topic denied by deny rule."));
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        if(!decision.allowed && strlen(decision.exception.what()) == 0)
+        {
+            decision.exception = _SecurityException_(topic_name + std::string(" topic not found in allow rule."));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(permissions.decisions_mutex_);
+
+        if(decisions.size() >= max_access_decisions)
+        {
+            decisions.clear();
+        }
+        decisions.emplace(std::move(key), decision);
+    }
+
+    if(!decision.allowed)
+    {
+        exception = decision.exception;
+    }
+
+    return decision.allowed;
+}
+
 static bool is_partition_in_criterias(const std::string& partition, const std::vector<Criteria>& criterias)
 {
     bool returned_value = false;
@@ -127,7 +232,7 @@ static bool is_partition_in_criterias(const std::string& partition, const std::v
     for(auto criteria_it = criterias.begin(); !returned_value &&
             criteria_it != criterias.end(); ++criteria_it)
     {
-        for(auto part : (*criteria_it).partitions)
+        for(const auto& part : (*criteria_it).partitions)
         {
             if(StringMatching::matchString(partition.c_str(), part.c_str()))
             {
@@ -957,7 +1062,7 @@ bool Permissions::check_create_participant(const PermissionsHandle& local_handle
     }
 
     //Search an allow rule with my domain
-    for(auto rule : lah->grant.rules)
+    for(const auto& rule : lah->grant.rules)
     {
         if(rule.allow)
         {
@@ -992,7 +1097,7 @@ bool Permissions::check_remote_participant(const PermissionsHandle& remote_handl
     }
 
     //Search an allow rule with my domain
-    for(auto rule : rah->grant.rules)
+    for(const auto& rule : rah->grant.rules)
     {
         if(rule.allow)
         {
@@ -1027,7 +1132,8 @@ bool Permissions::check_create_datawriter(const PermissionsHandle& local_handle,
 
     const EndpointSecurityAttributes* attributes = nullptr;
 
-    if((attributes = is_topic_in_sec_attributes(topic_name, lah->governance_writer_topic_rules_)) != nullptr)
+    if((attributes = is_topic_in_sec_attributes(topic_name, lah->governance_writer_topic_rules_,
+                    lah->writer_topic_rule_decisions_, lah->decisions_mutex_)) != nullptr)
     {
         if(!attributes->is_access_protected)
         {
@@ -1041,7 +1147,7 @@ bool Permissions::check_create_datawriter(const PermissionsHandle& local_handle,
     }
 
     // Search topic
-    for(auto rule : lah->grant.rules)
+    for(const auto& rule : lah->grant.rules)
     {
         if(is_topic_in_criterias(topic_name, rule.publishes))
         {
@@ -1103,7 +1209,8 @@ bool Permissions::check_create_datareader(const PermissionsHandle& local_handle,
 
     const EndpointSecurityAttributes* attributes = nullptr;
 
-    if((attributes = is_topic_in_sec_attributes(topic_name, lah->governance_reader_topic_rules_)) != nullptr)
+    if((attributes = is_topic_in_sec_attributes(topic_name, lah->governance_reader_topic_rules_,
+                    lah->reader_topic_rule_decisions_, lah->decisions_mutex_)) != nullptr)
     {
         if(!attributes->is_access_protected)
         {
@@ -1116,7 +1223,7 @@ bool Permissions::check_create_datareader(const PermissionsHandle& local_handle,
         return false;
     }
 
-    for(auto rule : lah->grant.rules)
+    for(const auto& rule : lah->grant.rules)
     {
         if(is_topic_in_criterias(topic_name, rule.subscribes))
         {
@@ -1167,7 +1274,6 @@ bool Permissions::check_remote_datawriter(const PermissionsHandle& remote_handle
         const uint32_t domain_id, const WriterProxyData& publication_data,
         SecurityException& exception)
 {
-    bool returned_value = false;
     const AccessPermissionsHandle& rah = AccessPermissionsHandle::narrow(remote_handle);
 
     if(rah.nil())
@@ -1176,57 +1282,13 @@ bool Permissions::check_remote_datawriter(const PermissionsHandle& remote_handle
         return false;
     }
 
-    const EndpointSecurityAttributes* attributes = nullptr;
-
-    if((attributes = is_topic_in_sec_attributes(publication_data.topicName(),rah->governance_writer_topic_rules_))
-            != nullptr)
-    {
-        if(!attributes->is_access_protected)
-        {
-            return true;
-        }
-    }
-    else
-    {
-        exception = _SecurityException_("Not found topic access rule for topic " + publication_data.topicName());
-        return false;
-    }
-
-    for(auto rule : rah->grant.rules)
-    {
-        if(is_domain_in_set(domain_id, rule.domains))
-        {
-            if(is_topic_in_criterias(publication_data.topicName(), rule.publishes))
-            {
-                if(rule.allow)
-                {
-                    returned_value = true;
-                }
-                else
-                {
-                    exception = _SecurityException_(publication_data.topicName() +
-                            std::string(" topic denied by deny rule."));
-                }
-
-                break;
-            }
-        }
-    }
-
-    if(!returned_value && strlen(exception.what()) == 0)
-    {
-        exception = _SecurityException_(publication_data.topicName() +
-                std::string(" topic not found in allow rule."));
-    }
-
-    return returned_value;
+    return check_remote_endpoint(**rah, domain_id, publication_data.topicName(), true, exception);
 }
 
 bool Permissions::check_remote_datareader(const PermissionsHandle& remote_handle,
         const uint32_t domain_id, const ReaderProxyData& subscription_data,
         SecurityException& exception)
 {
-    bool returned_value = false;
     const AccessPermissionsHandle& rah = AccessPermissionsHandle::narrow(remote_handle);
 
     if(rah.nil())
@@ -1235,50 +1297,7 @@ bool Permissions::check_remote_datareader(const PermissionsHandle& remote_handle
         return false;
     }
 
-    const EndpointSecurityAttributes* attributes = nullptr;
-
-    if((attributes = is_topic_in_sec_attributes(subscription_data.topicName(),rah->governance_reader_topic_rules_))
-            != nullptr)
-    {
-        if(!attributes->is_access_protected)
-        {
-            return true;
-        }
-    }
-    else
-    {
-        exception = _SecurityException_("Not found topic access rule for topic " + subscription_data.topicName());
-        return false;
-    }
-
-    for(auto rule : rah->grant.rules)
-    {
-        if(is_domain_in_set(domain_id, rule.domains))
-        {
-            if(is_topic_in_criterias(subscription_data.topicName(), rule.subscribes))
-            {
-                if(rule.allow)
-                {
-                    returned_value = true;
-                }
-                else
-                {
-                    exception = _SecurityException_(subscription_data.topicName() +
-                            std::string(" topic denied by deny rule."));
-                }
-
-                break;
-            }
-        }
-    }
-
-    if(!returned_value && strlen(exception.what()) == 0)
-    {
-        exception = _SecurityException_(subscription_data.topicName() +
-                std::string(" topic not found in allow rule."));
-    }
-
-    return returned_value;
+    return check_remote_endpoint(**rah, domain_id, subscription_data.topicName(), false, exception);
 }
 
 bool Permissions::get_participant_sec_attributes(const PermissionsHandle& local_handle,
@@ -1304,7 +1323,8 @@ bool Permissions::get_datawriter_sec_attributes(const PermissionsHandle& permiss
     const AccessPermissionsHandle& lah = AccessPermissionsHandle::narrow(permissions_handle);
     const EndpointSecurityAttributes* attr = nullptr;
 
-    if((attr = is_topic_in_sec_attributes(topic_name, lah->governance_writer_topic_rules_))
+    if((attr = is_topic_in_sec_attributes(topic_name, lah->governance_writer_topic_rules_,
+                    lah->writer_topic_rule_decisions_, lah->decisions_mutex_))
             != nullptr)
     {
         attributes = *attr;
@@ -1325,7 +1345,8 @@ bool Permissions::get_datareader_sec_attributes(const PermissionsHandle& permiss
     const AccessPermissionsHandle& lah = AccessPermissionsHandle::narrow(permissions_handle);
     const EndpointSecurityAttributes* attr = nullptr;
 
-    if((attr = is_topic_in_sec_attributes(topic_name, lah->governance_reader_topic_rules_))
+    if((attr = is_topic_in_sec_attributes(topic_name, lah->governance_reader_topic_rules_,
+                    lah->reader_topic_rule_decisions_, lah->decisions_mutex_))
             != nullptr)
     {
         attributes = *attr;
@@ -31,6 +31,7 @@
 #include <fastrtps/log/Log.h>
 
 #include <string.h>
+#include <stdexcept>
 
 #include "AESGCMGMAC_KeyFactory.h"
 
@@ -42,6 +43,37 @@
 using namespace eprosima::fastrtps::rtps;
 using namespace eprosima::fastrtps::rtps::security;
 
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+namespace security {
+
+/*!
+ * Parses the value of the property dds.sec.crypto.maxbytespersession.
+ * A value that is not a non-negative number fitting in 64 bits is ignored and max_bytes is left untouched.
+ */
+static void parse_max_bytes_per_session(const std::string& value, uint64_t& max_bytes)
+{
+    // std::stoull accepts a minus sign and wraps the negated value around.
+    size_t first = value.find_first_not_of(" \t\n\v\f\r");
+    if(first != std::string::npos && value[first] != '-')
+    {
+        try{
+            max_bytes = std::stoull(value);
+            return;
+        }
+        catch(const std::invalid_argument&){}
+        catch(const std::out_of_range&){}
+    }
+
+    logWarning(SECURITY_CRYPTO, "Ignoring invalid dds.sec.crypto.maxbytespersession value " << value);
+}
+
+} //namespace security
+} //namespace rtps
+} //namespace fastrtps
+} //namespace eprosima
+
 AESGCMGMAC_KeyFactory::AESGCMGMAC_KeyFactory(){}
 
 ParticipantCryptoHandle* AESGCMGMAC_KeyFactory::register_local_participant(
@@ -59,6 +91,7 @@ ParticipantCryptoHandle* AESGCMGMAC_KeyFactory::register_local_participant(
     //Fill ParticipantKeyMaterial - This will be used to cipher full rpts messages
     std::array<uint8_t, 4> transformationtype{CRYPTO_TRANSFORMATION_KIND_AES128_GCM}; //Default to AES128_GCM if the user does not specify otherwise
     int maxblockspersession = 32; //Default to key update every 32 usages if the user does not specify otherwise
+    uint64_t maxbytespersession = 0; //Default to no limit on the bytes ciphered with a session key
     if(!participant_properties.empty()){
           for(auto it=participant_properties.begin(); it!=participant_properties.end(); ++it){
               if( (it)->name() == "dds.sec.crypto.cryptotransformkind"){
@@ -76,6 +109,9 @@ ParticipantCryptoHandle* AESGCMGMAC_KeyFactory::register_local_participant(
                       maxblockspersession = std::stoi( (it)->value() );
                   }catch(std::invalid_argument){}
               }
+              if( (it)->name() == "dds.sec.crypto.maxbytespersession"){
+                  parse_max_bytes_per_session((it)->value(), maxbytespersession);
+              }
           }//endfor
     }//endif
 
@@ -96,6 +132,7 @@ ParticipantCryptoHandle* AESGCMGMAC_KeyFactory::register_local_participant(
 
     //Set values related to key update policy
     (*PCrypto)->max_blocks_per_session = maxblockspersession;
+    (*PCrypto)->max_bytes_per_session = maxbytespersession;
     (*PCrypto)->session_block_counter = maxblockspersession+1; //Set to update upon first usage
 
     RAND_bytes( (unsigned char *)( &( (*PCrypto)->session_id ) ), sizeof(uint16_t));
@@ -271,6 +308,7 @@ ParticipantCryptoHandle * AESGCMGMAC_KeyFactory::register_matched_remote_partici
         buffer.master_receiver_specific_key.fill(0); //Specified by standard
 
         (*RPCrypto)->max_blocks_per_session = local_participant_handle->max_blocks_per_session;
+        (*RPCrypto)->max_bytes_per_session = local_participant_handle->max_bytes_per_session;
         (*RPCrypto)->session_block_counter = local_participant_handle->session_block_counter;
         (*RPCrypto)->session_id = std::numeric_limits<uint32_t>::max();
         if((*RPCrypto)->session_id == local_participant_handle->session_id)
@@ -299,6 +337,7 @@ DatawriterCryptoHandle * AESGCMGMAC_KeyFactory::register_local_datawriter(
 
     std::array<uint8_t, 4> transformationtype{CRYPTO_TRANSFORMATION_KIND_AES128_GCM}; //Default to AES128_GCM
     int maxblockspersession = 32; //Default to key update every 32 usages
+    uint64_t maxbytespersession = 0; //Default to no limit on the bytes ciphered with a session key
     if(!datawriter_prop.empty()){
         for(auto it=datawriter_prop.begin(); it!=datawriter_prop.end(); ++it)
         {
@@ -318,6 +357,9 @@ DatawriterCryptoHandle * AESGCMGMAC_KeyFactory::register_local_datawriter(
                     maxblockspersession = std::stoi( (it)->value() );
                 }catch(std::invalid_argument){}
             }
+            if( (it)->name() == "dds.sec.crypto.maxbytespersession"){
+                parse_max_bytes_per_session((it)->value(), maxbytespersession);
+            }
         }//endfor
     }//endif
     (*WCrypto)->transformation_kind = transformationtype;
@@ -336,6 +378,7 @@ DatawriterCryptoHandle * AESGCMGMAC_KeyFactory::register_local_datawriter(
     (*WCrypto)->EntityKeyMaterial.master_receiver_specific_key.fill(0);
 
     (*WCrypto)->max_blocks_per_session = maxblockspersession;
+    (*WCrypto)->max_bytes_per_session = maxbytespersession;
     (*WCrypto)->session_block_counter = maxblockspersession+1; //Set to update upon first usage
     RAND_bytes( (unsigned char *)( &( (*WCrypto)->session_id ) ), sizeof(uint16_t));
 
@@ -395,6 +438,7 @@ DatareaderCryptoHandle * AESGCMGMAC_KeyFactory::register_matched_remote_dataread
     }
 
     (*RRCrypto)->max_blocks_per_session = local_writer_handle->max_blocks_per_session;
+    (*RRCrypto)->max_bytes_per_session = local_writer_handle->max_bytes_per_session;
     (*RRCrypto)->session_block_counter = local_writer_handle->session_block_counter;
     (*RRCrypto)->session_id = std::numeric_limits<uint32_t>::max();
     if((*RRCrypto)->session_id == local_writer_handle->session_id)
@@ -434,6 +478,7 @@ DatareaderCryptoHandle * AESGCMGMAC_KeyFactory::register_local_datareader(
 
     std::array<uint8_t, 4> transformationtype{CRYPTO_TRANSFORMATION_KIND_AES128_GCM}; //Default to AES128_GCM
     int maxblockspersession = 32; //Default to key update every 32 usages
+    uint64_t maxbytespersession = 0; //Default to no limit on the bytes ciphered with a session key
     if(!datareader_properties.empty()){
           for(auto it=datareader_properties.begin(); it!=datareader_properties.end(); ++it){
               if( (it)->name() == "dds.sec.crypto.cryptotransformkind"){
@@ -451,6 +496,9 @@ DatareaderCryptoHandle * AESGCMGMAC_KeyFactory::register_local_datareader(
                       maxblockspersession = std::stoi( (it)->value() );
                   }catch(std::invalid_argument){}
               }
+              if( (it)->name() == "dds.sec.crypto.maxbytespersession"){
+                  parse_max_bytes_per_session((it)->value(), maxbytespersession);
+              }
           }//endfor
     }//endif
 
@@ -471,6 +519,7 @@ DatareaderCryptoHandle * AESGCMGMAC_KeyFactory::register_local_datareader(
     (*RCrypto)->EntityKeyMaterial.master_receiver_specific_key.fill(0);
 
     (*RCrypto)->max_blocks_per_session = maxblockspersession;
+    (*RCrypto)->max_bytes_per_session = maxbytespersession;
     (*RCrypto)->session_block_counter = maxblockspersession+1;
     RAND_bytes( (unsigned char *)( &( (*RCrypto)->session_id ) ), sizeof(uint16_t));
 
@@ -529,6 +578,7 @@ DatawriterCryptoHandle * AESGCMGMAC_KeyFactory::register_matched_remote_datawrit
     }
 
     (*RWCrypto)->max_blocks_per_session = local_reader_handle->max_blocks_per_session;
+    (*RWCrypto)->max_bytes_per_session = local_reader_handle->max_bytes_per_session;
     (*RWCrypto)->session_block_counter = local_reader_handle->session_block_counter;
     (*RWCrypto)->session_id = std::numeric_limits<uint32_t>::max();
     if((*RWCrypto)->session_id == local_reader_handle->session_id)
@@ -24,6 +24,7 @@
 #include <openssl/aes.h>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
+#include <openssl/crypto.h>
 #include <cstring>
 
  // Solve error with Win32 macro
@@ -31,11 +32,263 @@
 #undef max
 #endif
 
+using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 using namespace eprosima::fastrtps::rtps::security;
 
 CONSTEXPR int initialization_vector_suffix_length = 8;
 
+namespace {
+
+/*!
+ * AES-GCM contexts of a thread, each one set up with a cipher and a key.
+ * Setting up a context expands its key, so contexts are kept while their key is in use and
+ * only the initialization vector is set for each operation.
+ * When all of them are in use, the one set up first is replaced.
+ * They are all cleared when a key handle has been destroyed since the last use of the cache. A thread that
+ * does not cipher anymore keeps its keys until it ends.
+ */
+class CipherContextCache
+{
+    public:
+
+        CipherContextCache() : next_(0), generation_(key_material_generation.load(std::memory_order_relaxed)) {}
+
+        ~CipherContextCache()
+        {
+            clear();
+        }
+
+        /*!
+         * Returns a context ready to encrypt, or decrypt, with a key and an initialization vector.
+         * The context belongs to the cache and is valid until the next call.
+         * @return nullptr on error.
+         */
+        EVP_CIPHER_CTX* get(const EVP_CIPHER* cipher, const std::array<uint8_t, 32>& key,
+                const std::array<uint8_t, 12>& initialization_vector, bool encrypt)
+        {
+            uint32_t generation = key_material_generation.load(std::memory_order_relaxed);
+            if(generation != generation_)
+            {
+                clear();
+                generation_ = generation;
+            }
+
+            Entry* entry = nullptr;
+
+            for(auto& candidate : entries_)
+            {
+                if(candidate.context != nullptr && candidate.cipher == cipher && candidate.encrypt == encrypt &&
+                        candidate.key == key)
+                {
+                    entry = &candidate;
+                    break;
+                }
+            }
+
+            if(entry == nullptr)
+            {
+                entry = &entries_[next_];
+                next_ = (next_ + 1) % entries_.size();
+
+                if(entry->context == nullptr && (entry->context = EVP_CIPHER_CTX_new()) == nullptr)
+                    return nullptr;
+
+                entry->cipher = nullptr;
+                if(!EVP_CipherInit_ex(entry->context, cipher, nullptr, key.data(), nullptr, encrypt ? 1 : 0))
+                    return nullptr;
+
+                entry->cipher = cipher;
+                entry->encrypt = encrypt;
+                entry->key = key;
+            }
+
+            if(!EVP_CipherInit_ex(entry->context, nullptr, nullptr, nullptr, initialization_vector.data(), -1))
+                return nullptr;
+
+            return entry->context;
+        }
+
+    private:
+
+        void clear()
+        {
+            for(auto& entry : entries_)
+            {
+                if(entry.context != nullptr)
+                {
+                    EVP_CIPHER_CTX_free(entry.context);
+                    entry.context = nullptr;
+                }
+                entry.cipher = nullptr;
+                OPENSSL_cleanse(entry.key.data(), entry.key.size());
+            }
+        }
+
+        struct Entry
+        {
+            Entry() : context(nullptr), cipher(nullptr), encrypt(false) {}
+
+            EVP_CIPHER_CTX* context;
+            const EVP_CIPHER* cipher;
+            bool encrypt;
+            std::array<uint8_t, 32> key;
+        };
+
+        std::array<Entry, 8> entries_;
+        size_t next_;
+        uint32_t generation_;
+};
+
+//! Context of the calling thread to encrypt, or decrypt, with a key and an initialization vector.
+EVP_CIPHER_CTX* cipher_context(const EVP_CIPHER* cipher, const std::array<uint8_t, 32>& key,
+        const std::array<uint8_t, 12>& initialization_vector, bool encrypt)
+{
+    if(cipher == nullptr)
+        return nullptr;
+
+    static thread_local CipherContextCache cache;
+    return cache.get(cipher, key, initialization_vector, encrypt);
+}
+
+/*!
+ * Session keys derived by a thread, by master key, master salt and session id.
+ * Receivers derive the session key of every message they decode, but senders only change it when a session
+ * expires, so almost every derivation is found here. When it is full, the oldest key is replaced.
+ * Like CipherContextCache, it is cleared when a key handle has been destroyed since its last use.
+ */
+class SessionKeyCache
+{
+    public:
+
+        SessionKeyCache() : next_(0), generation_(key_material_generation.load(std::memory_order_relaxed)) {}
+
+        ~SessionKeyCache()
+        {
+            clear();
+        }
+
+        //! @return nullptr if the session key has not been derived by this thread lately.
+        const std::array<uint8_t, 32>* find(const std::array<uint8_t, 32>& master_key,
+                const std::array<uint8_t, 32>& master_salt, uint32_t session_id)
+        {
+            uint32_t generation = key_material_generation.load(std::memory_order_relaxed);
+            if(generation != generation_)
+            {
+                clear();
+                generation_ = generation;
+                return nullptr;
+            }
+
+            for(auto& entry : entries_)
+            {
+                if(entry.valid && entry.session_id == session_id && entry.master_key == master_key &&
+                        entry.master_salt == master_salt)
+                    return &entry.session_key;
+            }
+
+            return nullptr;
+        }
+
+        void add(const std::array<uint8_t, 32>& master_key, const std::array<uint8_t, 32>& master_salt,
+                uint32_t session_id, const std::array<uint8_t, 32>& session_key)
+        {
+            Entry& entry = entries_[next_];
+            next_ = (next_ + 1) % entries_.size();
+
+            entry.valid = true;
+            entry.master_key = master_key;
+            entry.master_salt = master_salt;
+            entry.session_id = session_id;
+            entry.session_key = session_key;
+        }
+
+    private:
+
+        void clear()
+        {
+            for(auto& entry : entries_)
+            {
+                entry.valid = false;
+                OPENSSL_cleanse(entry.master_key.data(), entry.master_key.size());
+                OPENSSL_cleanse(entry.master_salt.data(), entry.master_salt.size());
+                OPENSSL_cleanse(entry.session_key.data(), entry.session_key.size());
+            }
+        }
+
+        struct Entry
+        {
+            Entry() : valid(false), session_id(0) {}
+
+            bool valid;
+            std::array<uint8_t, 32> master_key;
+            std::array<uint8_t, 32> master_salt;
+            uint32_t session_id;
+            std::array<uint8_t, 32> session_key;
+        };
+
+        std::array<Entry, 16> entries_;
+        size_t next_;
+        uint32_t generation_;
+};
+
+/*!
+ * Whether the current session key of a local handle has to be updated before ciphering more data:
+ * it has been used for the maximum number of messages, or it has ciphered the maximum number of bytes.
+ */
+template<typename KeyHandle>
+bool session_expired(const KeyHandle* handle)
+{
+    return handle->session_block_counter >= handle->max_blocks_per_session ||
+        (handle->max_bytes_per_session != 0 && handle->session_byte_counter >= handle->max_bytes_per_session);
+}
+
+//! AES-GCM cipher of a transformation kind, or nullptr if it is not known.
+const EVP_CIPHER* transformation_cipher(const CryptoTransformKind& transformation_kind)
+{
+    if(transformation_kind == CryptoTransformKind{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
+            transformation_kind == CryptoTransformKind{CRYPTO_TRANSFORMATION_KIND_AES128_GMAC})
+        return EVP_aes_128_gcm();
+
+    if(transformation_kind == CryptoTransformKind{CRYPTO_TRANSFORMATION_KIND_AES256_GCM} ||
+            transformation_kind == CryptoTransformKind{CRYPTO_TRANSFORMATION_KIND_AES256_GMAC})
+        return EVP_aes_256_gcm();
+
+    return nullptr;
+}
+
+/*!
+ * Computes the receiver specific MAC of a message: the GMAC of its common MAC with the receiver specific key.
+ * @param mac Output buffer of 16 bytes.
+ */
+bool compute_receiver_specific_mac(const EVP_CIPHER* cipher, const std::array<uint8_t, 32>& session_key,
+        const std::array<uint8_t, 12>& initialization_vector, const std::array<uint8_t, 16>& common_mac, uint8_t* mac)
+{
+    int actual_size = 0, final_size = 0;
+    EVP_CIPHER_CTX* e_ctx = cipher_context(cipher, session_key, initialization_vector, true);
+
+    if(e_ctx == nullptr)
+    {
+        logError(SECURITY_CRYPTO, "Unable to create authentication for the submessage. EVP_EncryptInit function returns an error");
+        return false;
+    }
+    if(!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, common_mac.data(), 16))
+    {
+        logError(SECURITY_CRYPTO, "Unable to create authentication for the submessage. EVP_EncryptUpdate function returns an error");
+        return false;
+    }
+    if(!EVP_EncryptFinal_ex(e_ctx, NULL, &final_size))
+    {
+        logError(SECURITY_CRYPTO, "Unable to create authentication for the submessage. EVP_EncryptFinal function returns an error");
+        return false;
+    }
+
+    EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, 16, mac);
+    return true;
+}
+
+} // namespace
+
 AESGCMGMAC_Transform::AESGCMGMAC_Transform()
 {
 }
@@ -44,6 +297,38 @@ AESGCMGMAC_Transform::~AESGCMGMAC_Transform()
 {
 }
 
+AESGCMGMAC_Transform::SessionState::~SessionState()
+{
+    OPENSSL_cleanse(key.data(), key.size());
+}
+
+template<typename KeyHandle>
+void AESGCMGMAC_Transform::next_session(KeyHandle* handle, const KeyMaterial_AES_GCM_GMAC& key_material,
+        uint32_t plain_length, SessionState& session)
+{
+    std::lock_guard<std::mutex> guard(handle->mutex_);
+
+    //If the maximum number of blocks or bytes have been processed, generate a new SessionKey
+    session.updated = session_expired(handle);
+    if(session.updated)
+    {
+        handle->session_id += 1;
+        handle->SessionKey = compute_sessionkey(key_material.master_sender_key, key_material.master_salt,
+                handle->session_id);
+
+        //ReceiverSpecific keys shall be computed specifically when needed
+        handle->session_block_counter = 0;
+        handle->session_byte_counter = 0;
+    }
+
+    handle->session_block_counter += 1;
+    handle->session_byte_counter += plain_length;
+
+    session.session_id = handle->session_id;
+    session.key = handle->SessionKey;
+    session.transformation_kind = handle->transformation_kind;
+}
+
 bool AESGCMGMAC_Transform::encode_serialized_payload(
         SerializedPayload_t& output_payload,
         std::vector<uint8_t>& /*extra_inline_qos*/,
@@ -67,31 +352,18 @@ bool AESGCMGMAC_Transform::encode_serialized_payload(
     eprosima::fastcdr::FastBuffer output_buffer((char*)output_payload.data, output_payload.max_size);
     eprosima::fastcdr::Cdr serializer(output_buffer);
 
-    std::unique_lock<std::mutex> lock(local_writer->mutex_);
-
-    //If the maximum number of blocks have been processed, generate a new SessionKey
-    if(local_writer->session_block_counter >= local_writer->max_blocks_per_session)
-    {
-        local_writer->session_id += 1;
-
-        local_writer->SessionKey = compute_sessionkey(local_writer->EntityKeyMaterial.master_sender_key,
-                local_writer->EntityKeyMaterial.master_salt,
-                local_writer->session_id);
-
-        //ReceiverSpecific keys shall be computed specifically when needed
-        local_writer->session_block_counter = 0;
-    }
-    //In any case, increment session block counter
-    local_writer->session_block_counter += 1;
+    // The handle is only locked while its session is advanced. Ciphering uses a copy of the session state.
+    SessionState session;
+    next_session(*local_writer, local_writer->EntityKeyMaterial, payload.length, session);
 
     //Build NONCE elements (Build once, use once)
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
     RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t, 12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(local_writer->session_id),4);
+    memcpy(initialization_vector.data(),&(session.session_id),4);
     memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
     std::array<uint8_t, 4> session_id;
-    memcpy(session_id.data(), &(local_writer->session_id), 4);
+    memcpy(session_id.data(), &(session.session_id), 4);
 
     //Header
     try
@@ -110,7 +382,7 @@ bool AESGCMGMAC_Transform::encode_serialized_payload(
     // Body
     try
     {
-        if(!serialize_SecureDataBody(serializer, local_writer->transformation_kind, local_writer->SessionKey,
+        if(!serialize_SecureDataBody(serializer, session.transformation_kind, session.key,
                     initialization_vector, output_buffer, payload.data, payload.length, tag))
         {
             return false;
@@ -125,7 +397,7 @@ bool AESGCMGMAC_Transform::encode_serialized_payload(
     try
     {
         std::vector<DatareaderCryptoHandle*> receiving_datareader_crypto_list;
-        if(!serialize_SecureDataTag(serializer, local_writer->transformation_kind, local_writer->session_id,
+        if(!serialize_SecureDataTag(serializer, session.transformation_kind, session.session_id,
                     initialization_vector, receiving_datareader_crypto_list, false, tag))
         {
             return false;
@@ -167,32 +439,20 @@ bool AESGCMGMAC_Transform::encode_datawriter_submessage(
             encoded_rtps_submessage.max_size - encoded_rtps_submessage.pos);
     eprosima::fastcdr::Cdr serializer(output_buffer);
 
-    std::unique_lock<std::mutex> lock(local_writer->mutex_);
-
-    bool update_specific_keys = false;
-    //If the maximum number of blocks have been processed, generate a new SessionKey
-    if(local_writer->session_block_counter >= local_writer->max_blocks_per_session)
-    {
-        local_writer->session_id += 1;
-        update_specific_keys = true;
-        local_writer->SessionKey = compute_sessionkey(local_writer->EntityKeyMaterial.master_sender_key,
-                local_writer->EntityKeyMaterial.master_salt,
-                local_writer->session_id);
-
-        //ReceiverSpecific keys shall be computed specifically when needed
-        local_writer->session_block_counter = 0;
-    }
-
-    local_writer->session_block_counter += 1;
+    // The handle is only locked while its session is advanced. Ciphering uses a copy of the session state.
+    SessionState session;
+    next_session(*local_writer, local_writer->EntityKeyMaterial,
+            plain_rtps_submessage.length - plain_rtps_submessage.pos, session);
+    bool update_specific_keys = session.updated;
 
     //Build remaining NONCE elements
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
     RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t,12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(local_writer->session_id),4);
+    memcpy(initialization_vector.data(),&(session.session_id),4);
     memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
     std::array<uint8_t, 4> session_id;
-    memcpy(session_id.data(), &(local_writer->session_id), 4);
+    memcpy(session_id.data(), &(session.session_id), 4);
 
 #if __BIG_ENDIAN__
     octet flags = 0x0;
@@ -233,7 +493,7 @@ bool AESGCMGMAC_Transform::encode_datawriter_submessage(
     // Body
     try
     {
-        if(!serialize_SecureDataBody(serializer, local_writer->transformation_kind, local_writer->SessionKey,
+        if(!serialize_SecureDataBody(serializer, session.transformation_kind, session.key,
                     initialization_vector, output_buffer, &plain_rtps_submessage.buffer[plain_rtps_submessage.pos],
                     plain_rtps_submessage.length - plain_rtps_submessage.pos, tag))
         {
@@ -256,7 +516,7 @@ bool AESGCMGMAC_Transform::encode_datawriter_submessage(
 
         const char* length_position = serializer.getCurrentPosition();
 
-        if(!serialize_SecureDataTag(serializer, local_writer->transformation_kind, local_writer->session_id,
+        if(!serialize_SecureDataTag(serializer, session.transformation_kind, session.session_id,
                     initialization_vector, receiving_datareader_crypto_list, update_specific_keys, tag))
         {
             return false;
@@ -305,31 +565,20 @@ bool AESGCMGMAC_Transform::encode_datareader_submessage(
             encoded_rtps_submessage.max_size - encoded_rtps_submessage.pos);
     eprosima::fastcdr::Cdr serializer(output_buffer);
 
-    std::unique_lock<std::mutex> lock(local_reader->mutex_);
-
-    //Step 2 - If the maximum number of blocks have been processed, generate a new SessionKey
-    bool update_specific_keys = false;
-    if(local_reader->session_block_counter >= local_reader->max_blocks_per_session){
-        local_reader->session_id += 1;
-        update_specific_keys = true;
-        local_reader->SessionKey = compute_sessionkey(local_reader->EntityKeyMaterial.master_sender_key,
-                local_reader->EntityKeyMaterial.master_salt,
-                local_reader->session_id);
-
-        //ReceiverSpecific keys shall be computed specifically when needed
-        local_reader->session_block_counter = 0;
-    }
-
-    local_reader->session_block_counter += 1;
+    // The handle is only locked while its session is advanced. Ciphering uses a copy of the session state.
+    SessionState session;
+    next_session(*local_reader, local_reader->EntityKeyMaterial,
+            plain_rtps_submessage.length - plain_rtps_submessage.pos, session);
+    bool update_specific_keys = session.updated;
 
     //Build remaining NONCE elements
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
     RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t,12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(local_reader->session_id),4);
+    memcpy(initialization_vector.data(),&(session.session_id),4);
     memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
     std::array<uint8_t, 4> session_id;
-    memcpy(session_id.data(), &(local_reader->session_id), 4);
+    memcpy(session_id.data(), &(session.session_id), 4);
 
 #if __BIG_ENDIAN__
     octet flags = 0x0;
@@ -370,7 +619,7 @@ bool AESGCMGMAC_Transform::encode_datareader_submessage(
     // Body
     try
     {
-        if(!serialize_SecureDataBody(serializer, local_reader->transformation_kind, local_reader->SessionKey,
+        if(!serialize_SecureDataBody(serializer, session.transformation_kind, session.key,
                     initialization_vector, output_buffer, &plain_rtps_submessage.buffer[plain_rtps_submessage.pos],
                     plain_rtps_submessage.length - plain_rtps_submessage.pos, tag))
         {
@@ -393,7 +642,7 @@ bool AESGCMGMAC_Transform::encode_datareader_submessage(
 
         const char* length_position = serializer.getCurrentPosition();
 
-        if(!serialize_SecureDataTag(serializer, local_reader->transformation_kind, local_reader->session_id,
+        if(!serialize_SecureDataTag(serializer, session.transformation_kind, session.session_id,
                     initialization_vector, receiving_datawriter_crypto_list, update_specific_keys, tag))
         {
             return false;
@@ -443,33 +692,20 @@ bool AESGCMGMAC_Transform::encode_rtps_message(
             encoded_rtps_message.max_size - encoded_rtps_message.pos);
     eprosima::fastcdr::Cdr serializer(output_buffer);
 
-    std::unique_lock<std::mutex> lock(local_participant->mutex_);
-
-    // If the maximum number of blocks have been processed, generate a new SessionKey
-    bool update_specific_keys = false;
-    if(local_participant->session_block_counter >= local_participant->max_blocks_per_session)
-    {
-        local_participant->session_id += 1;
-        update_specific_keys = true;
-        local_participant->SessionKey = compute_sessionkey(local_participant->ParticipantKeyMaterial.master_sender_key,
-                local_participant->ParticipantKeyMaterial.master_salt,
-                local_participant->session_id);
-
-        //ReceiverSpecific keys shall be computed specifically when needed
-        local_participant->session_block_counter = 0;
-        //Insert outdate session_id values in all RemoteParticipant trackers to trigger a SessionkeyUpdate
-    }
-
-    local_participant->session_block_counter += 1;
+    // The handle is only locked while its session is advanced. Ciphering uses a copy of the session state.
+    SessionState session;
+    next_session(*local_participant, local_participant->ParticipantKeyMaterial,
+            plain_rtps_message.length - plain_rtps_message.pos, session);
+    bool update_specific_keys = session.updated;
 
     //Build remaining NONCE elements
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
     RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t,12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(local_participant->session_id),4);
+    memcpy(initialization_vector.data(),&(session.session_id),4);
     memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
     std::array<uint8_t, 4> session_id;
-    memcpy(session_id.data(), &(local_participant->session_id), 4);
+    memcpy(session_id.data(), &(session.session_id), 4);
 
 #if __BIG_ENDIAN__
     octet flags = 0x0;
@@ -510,7 +746,7 @@ bool AESGCMGMAC_Transform::encode_rtps_message(
     // Body
     try
     {
-        if(!serialize_SecureDataBody(serializer, local_participant->transformation_kind, local_participant->SessionKey,
+        if(!serialize_SecureDataBody(serializer, session.transformation_kind, session.key,
                     initialization_vector, output_buffer, &plain_rtps_message.buffer[plain_rtps_message.pos],
                     plain_rtps_message.length - plain_rtps_message.pos, tag))
         {
@@ -533,7 +769,8 @@ bool AESGCMGMAC_Transform::encode_rtps_message(
 
         const char* length_position = serializer.getCurrentPosition();
 
-        if(!serialize_SecureDataTag(serializer, local_participant, initialization_vector, receiving_crypto_list,
+        if(!serialize_SecureDataTag(serializer, local_participant, session.transformation_kind,
+                    session.session_id, initialization_vector, receiving_crypto_list,
                     update_specific_keys, tag))
         {
             return false;
@@ -1335,17 +1572,24 @@ std::array<uint8_t, 32> AESGCMGMAC_Transform::compute_sessionkey(const std::arra
         const std::array<uint8_t,32>& master_salt , const uint32_t session_id)
 {
 
+    static thread_local SessionKeyCache cache;
+
+    const std::array<uint8_t, 32>* cached_key = cache.find(master_sender_key, master_salt, session_id);
+    if(cached_key != nullptr)
+        return *cached_key;
+
     std::array<uint8_t,32> session_key;
-    unsigned char *source = (unsigned char*)malloc(32 + 10 + 32 + 4);
-    memcpy(source, master_sender_key.data(), 32);
+    std::array<uint8_t, 32 + 10 + 32 + 4> source;
+    memcpy(source.data(), master_sender_key.data(), 32);
     char seq[] = "SessionKey";
-    memcpy(source+32, seq, 10);
-    memcpy(source+32+10, master_salt.data(),32);
-    memcpy(source+32+10+32, &(session_id),4);
+    memcpy(source.data()+32, seq, 10);
+    memcpy(source.data()+32+10, master_salt.data(),32);
+    memcpy(source.data()+32+10+32, &(session_id),4);
 
-    EVP_Digest(source, 32+10+32+4, session_key.data(), NULL, EVP_sha256(), NULL);
+    EVP_Digest(source.data(), source.size(), session_key.data(), NULL, EVP_sha256(), NULL);
+    OPENSSL_cleanse(source.data(), source.size());
 
-    free(source);
+    cache.add(master_sender_key, master_salt, session_id, session_key);
     return session_key;
 }
 
@@ -1382,42 +1626,23 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
     //Cypher the plain rtps message -> SecureDataBody
 
     // AES_BLOCK_SIZE = 16
-    int cipher_block_size = 0, actual_size = 0, final_size = 0;
-    char* output_buffer_raw = nullptr;
-    EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-    if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
-            transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GMAC})
-    {
-        if(!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(session_key.data()),
-                    initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            return false;
-        }
-
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_128_gcm());
+    const EVP_CIPHER* cipher = transformation_cipher(transformation_kind);
+    EVP_CIPHER_CTX* e_ctx = cipher == nullptr ? nullptr :
+        cipher_context(cipher, session_key, initialization_vector, true);
 
-        if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM})
-        {
-            output_buffer_raw = serializer.getCurrentPosition();
-        }
-    }
-    else if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM} ||
-            transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GMAC})
+    if(e_ctx == nullptr)
     {
-        if(!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(session_key.data()),
-                    initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            return false;
-        }
+        logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
+        return false;
+    }
 
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
+    int cipher_block_size = EVP_CIPHER_block_size(cipher), actual_size = 0, final_size = 0;
+    char* output_buffer_raw = nullptr;
 
-        if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM})
-        {
-            output_buffer_raw = serializer.getCurrentPosition();
-        }
+    if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
+            transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM})
+    {
+        output_buffer_raw = serializer.getCurrentPosition();
     }
 
     if(output_buffer_raw != nullptr)
@@ -1440,7 +1665,7 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
         return false;
     }
 
-    if(!EVP_EncryptFinal(e_ctx, (unsigned char*)output_buffer_raw, &final_size))
+    if(!EVP_EncryptFinal_ex(e_ctx, (unsigned char*)output_buffer_raw, &final_size))
     {
         logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal function returns an error");
         return false;
@@ -1457,7 +1682,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
     }
 
     EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
-    EVP_CIPHER_CTX_free(e_ctx);
 
     eprosima::fastcdr::Cdr::state current_state = serializer.getState();
 
@@ -1489,6 +1713,7 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
     eprosima::fastcdr::Cdr::state length_state = serializer.getState();
     uint32_t length = 0;
     serializer << length;
+    const EVP_CIPHER* cipher = transformation_cipher(transformation_kind);
 
     //Check the list of receivers, search for keys and compute session keys as needed
     for(auto rec = receiving_crypto_list.begin(); rec != receiving_crypto_list.end(); ++rec)
@@ -1508,53 +1733,33 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
             continue;
         }
 
-        //Update the key if needed
-        if(update_specific_keys || remote_entity->session_id != session_id)
+        std::array<uint8_t, 32> receiver_session_key;
         {
-            //Update triggered!
-            remote_entity->session_id = session_id;
-            remote_entity->SessionKey = compute_sessionkey(remote_entity->Remote2EntityKeyMaterial.at(0).master_receiver_specific_key,
-                    remote_entity->Remote2EntityKeyMaterial.at(0).master_salt,
-                    remote_entity->session_id);
-        }
+            std::lock_guard<std::mutex> remote_guard(remote_entity->mutex_);
 
-        //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
-        int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-        if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
-                transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GMAC})
-        {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_entity->SessionKey.data()),
-                        initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                continue;
-            }
-        }
-        else if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM} ||
-                transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GMAC})
-        {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_entity->SessionKey.data()),
-                        initialization_vector.data()))
+            //Update the key if needed
+            if(update_specific_keys || remote_entity->session_id != session_id)
             {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                continue;
+                //Update triggered!
+                remote_entity->session_id = session_id;
+                remote_entity->SessionKey = compute_sessionkey(remote_entity->Remote2EntityKeyMaterial.at(0).master_receiver_specific_key,
+                        remote_entity->Remote2EntityKeyMaterial.at(0).master_salt,
+                        remote_entity->session_id);
             }
+
+            receiver_session_key = remote_entity->SessionKey;
         }
-        if(!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
-        {
-            logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            continue;
-        }
-        if(!EVP_EncryptFinal(e_ctx, NULL, &final_size))
-        {
-            logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
+
+        //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
+        std::array<uint8_t, 16> receiver_mac;
+        bool mac_computed = compute_receiver_specific_mac(cipher, receiver_session_key, initialization_vector,
+                tag.common_mac, receiver_mac.data());
+        OPENSSL_cleanse(receiver_session_key.data(), receiver_session_key.size());
+        if(!mac_computed)
             continue;
-        }
+
         serializer << remote_entity->Remote2EntityKeyMaterial.at(0).receiver_specific_key_id;
-        EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, 16, serializer.getCurrentPosition());
-        serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
+        serializer << receiver_mac;
 
         ++length;
     }
@@ -1568,6 +1773,7 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
 
 bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& serializer,
         const AESGCMGMAC_ParticipantCryptoHandle& local_participant,
+        const std::array<uint8_t, 4>& transformation_kind, const uint32_t session_id,
         const std::array<uint8_t, 12>& initialization_vector,
         std::vector<ParticipantCryptoHandle*>& receiving_crypto_list, bool update_specific_keys,
         SecureDataTag& tag)
@@ -1577,6 +1783,7 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
     eprosima::fastcdr::Cdr::state length_state = serializer.getState();
     uint32_t length = 0;
     serializer << length;
+    const EVP_CIPHER* cipher = transformation_cipher(transformation_kind);
 
     //Check the list of receivers, search for keys and compute session keys as needed
     for(auto rec = receiving_crypto_list.begin(); rec != receiving_crypto_list.end(); ++rec)
@@ -1596,56 +1803,35 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
             continue;
         }
 
-        //Update the key if needed
-        if((update_specific_keys || remote_participant->session_id != local_participant->session_id) &&
-                (*remote_participant != *local_participant))
+        std::array<uint8_t, 32> receiver_session_key;
         {
-            //Update triggered!
-            remote_participant->session_id = local_participant->session_id;
-            remote_participant->SessionKey = compute_sessionkey(
-                    remote_participant->Participant2ParticipantKeyMaterial.at(0).master_receiver_specific_key,
-                    remote_participant->Participant2ParticipantKeyMaterial.at(0).master_salt,
-                    remote_participant->session_id);
-        }
+            std::lock_guard<std::mutex> remote_guard(remote_participant->mutex_);
 
-        //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
-        int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-        if(local_participant->transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
-                local_participant->transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GMAC})
-        {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
-                        initialization_vector.data()))
+            //Update the key if needed
+            if((update_specific_keys || remote_participant->session_id != session_id) &&
+                    (*remote_participant != *local_participant))
             {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                //TODO(Ricardo) Free context;
-                continue;
+                //Update triggered!
+                remote_participant->session_id = session_id;
+                remote_participant->SessionKey = compute_sessionkey(
+                        remote_participant->Participant2ParticipantKeyMaterial.at(0).master_receiver_specific_key,
+                        remote_participant->Participant2ParticipantKeyMaterial.at(0).master_salt,
+                        remote_participant->session_id);
             }
+
+            receiver_session_key = remote_participant->SessionKey;
         }
-        else if(local_participant->transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM} ||
-                local_participant->transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES256_GMAC})
-        {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
-                        initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                continue;
-            }
-        }
-        if(!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
-        {
-            logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            continue;
-        }
-        if(!EVP_EncryptFinal(e_ctx, NULL, &final_size))
-        {
-            logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
+
+        //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
+        std::array<uint8_t, 16> receiver_mac;
+        bool mac_computed = compute_receiver_specific_mac(cipher, receiver_session_key, initialization_vector,
+                tag.common_mac, receiver_mac.data());
+        OPENSSL_cleanse(receiver_session_key.data(), receiver_session_key.size());
+        if(!mac_computed)
             continue;
-        }
+
         serializer << remote_participant->Participant2ParticipantKeyMaterial.at(0).receiver_specific_key_id;
-        EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, 16, serializer.getCurrentPosition());
-        serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
+        serializer << receiver_mac;
 
         ++length;
     }
@@ -1676,41 +1862,23 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
     eprosima::fastcdr::Cdr::state current_state = decoder.getState();
     decoder.setState(body_state);
 
-    EVP_CIPHER_CTX *d_ctx = EVP_CIPHER_CTX_new();
-    int cipher_block_size = 0, actual_size = 0, final_size = 0;
-    octet* output_buffer = nullptr;
+    const EVP_CIPHER* cipher = transformation_cipher(transformation_kind);
+    EVP_CIPHER_CTX* d_ctx = cipher == nullptr ? nullptr :
+        cipher_context(cipher, session_key, initialization_vector, false);
 
-    if(transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
-            transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES128_GMAC})
+    if(d_ctx == nullptr)
     {
-        if(!EVP_DecryptInit(d_ctx, EVP_aes_128_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            return false;
-        }
-
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_128_gcm());
-
-        if(transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM})
-        {
-            output_buffer = plain_buffer;
-        }
+        logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
+        return false;
     }
-    if(transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM} ||
-            transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES256_GMAC})
-    {
-        if(!EVP_DecryptInit(d_ctx, EVP_aes_256_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            return false;
-        }
 
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
+    int cipher_block_size = EVP_CIPHER_block_size(cipher), actual_size = 0, final_size = 0;
+    octet* output_buffer = nullptr;
 
-        if(transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM})
-        {
-            output_buffer = plain_buffer;
-        }
+    if(transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
+            transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM})
+    {
+        output_buffer = plain_buffer;
     }
 
     // Check plain_payload contains enough memory to cypher.
@@ -1730,12 +1898,11 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
 
     EVP_CIPHER_CTX_ctrl(d_ctx, EVP_CTRL_GCM_SET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
 
-    if(!EVP_DecryptFinal(d_ctx, output_buffer, &final_size))
+    if(!EVP_DecryptFinal_ex(d_ctx, output_buffer, &final_size))
     {
         logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptFinal function returns an error");
         return false;
     }
-    EVP_CIPHER_CTX_free(d_ctx);
 
     plain_buffer_len = actual_size + final_size;
 
@@ -1824,8 +1991,12 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
         }
 
         //Auth message - The point is that we cannot verify the authorship of the message with our receiver_specific_key the message could be crafted
-        EVP_CIPHER_CTX* d_ctx = EVP_CIPHER_CTX_new();
-        const EVP_CIPHER* d_cipher = nullptr;
+        const EVP_CIPHER* d_cipher = transformation_cipher(transformation_kind);
+        if(d_cipher == nullptr)
+        {
+            logError(SECURITY_CRYPTO, "Invalid transformation kind)");
+            return false;
+        }
 
         int actual_size = 0, final_size = 0;
 
@@ -1834,24 +2005,8 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
                 master_salt, session_id);
 
         //Verify specific MAC
-        if(transformation_kind == std::array<uint8_t, 4>{CRYPTO_TRANSFORMATION_KIND_AES128_GCM} ||
-                transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES128_GMAC})
-        {
-            d_cipher = EVP_aes_128_gcm();
-        }
-        else if(transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES256_GCM} ||
-                transformation_kind == std::array<uint8_t,4>{CRYPTO_TRANSFORMATION_KIND_AES256_GMAC})
-        {
-            d_cipher = EVP_aes_256_gcm();
-        }
-        else
-        {
-            logError(SECURITY_CRYPTO, "Invalid transformation kind)");
-            return false;
-        }
-
-        if(!EVP_DecryptInit(d_ctx, d_cipher, (const unsigned char *)specific_session_key.data(),
-                    initialization_vector.data()))
+        EVP_CIPHER_CTX* d_ctx = cipher_context(d_cipher, specific_session_key, initialization_vector, false);
+        if(d_ctx == nullptr)
         {
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptInit function returns an error");
             return false;
@@ -1874,9 +2029,6 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptFinal_ex function returns an error");
             return false;
         }
-
-        // TODO(Ricardo) No freed in errors.
-        EVP_CIPHER_CTX_free(d_ctx);
     }
 
     return true;
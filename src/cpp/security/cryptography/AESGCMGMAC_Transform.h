@@ -104,6 +104,22 @@ class AESGCMGMAC_Transform : public CryptoTransform
             DatawriterCryptoHandle& sending_datawriter_crypto,
             SecurityException& exception) override;
 
+    //Copy of the session state of a local handle, used to cipher without holding the handle lock
+    struct SessionState
+    {
+        ~SessionState();
+
+        uint32_t session_id = 0;
+        std::array<uint8_t, 32> key;
+        CryptoTransformKind transformation_kind;
+        bool updated = false;
+    };
+
+    //Advances the session of a local handle under its lock and copies its state
+    template<typename KeyHandle>
+    void next_session(KeyHandle* handle, const KeyMaterial_AES_GCM_GMAC& key_material,
+            uint32_t plain_length, SessionState& session);
+
     //Aux function to compute session key from the master material
     std::array<uint8_t, 32> compute_sessionkey(const std::array<uint8_t, 32>& master_sender_key,
             const std::array<uint8_t, 32>& master_salt , const uint32_t session_id);
@@ -127,6 +143,7 @@ class AESGCMGMAC_Transform : public CryptoTransform
 
     bool serialize_SecureDataTag(eprosima::fastcdr::Cdr& serializer,
             const AESGCMGMAC_ParticipantCryptoHandle& local_participant,
+            const std::array<uint8_t, 4>& transformation_kind, const uint32_t session_id,
             const std::array<uint8_t, 12>& initialization_vector,
             std::vector<ParticipantCryptoHandle*>& receiving_crypto_list, bool update_specific_keys,
             SecureDataTag& tag);
@@ -22,5 +22,7 @@
 using namespace eprosima::fastrtps::rtps::security;
 
 
+std::atomic<uint32_t> eprosima::fastrtps::rtps::security::key_material_generation(0);
+
 const char* const ParticipantKeyHandle::class_id_ = "ParticipantCryptohandle";
 const char * const EntityKeyHandle::class_id_ = "EntityCryptohandle";
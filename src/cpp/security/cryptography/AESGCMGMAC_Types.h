@@ -26,6 +26,7 @@
 
 #include <mutex>
 #include <limits>
+#include <atomic>
 
 // Fix compilation error on Windows
 #if defined(WIN32) && defined(max)
@@ -116,13 +117,21 @@ struct SecureDataTag{
  * Note: the common key of the remote cryptohandle is stored along with the specific keys. KeyMaterial->master_sender_key
  */
 
+/*!
+ * Generation of the key material of the plugin. It increases every time a key handle is destroyed,
+ * so the keys that the transform caches per thread are cleared the next time the thread uses them.
+ */
+extern std::atomic<uint32_t> key_material_generation;
+
 class  EntityKeyHandle
 {
     public:
         EntityKeyHandle() : session_id(std::numeric_limits<uint32_t>::max()),
-                session_block_counter(0), max_blocks_per_session(0){}
+                session_block_counter(0), max_blocks_per_session(0),
+                session_byte_counter(0), max_bytes_per_session(0){}
 
         ~EntityKeyHandle(){
+            key_material_generation.fetch_add(1, std::memory_order_relaxed);
         }
 
         static const char* const class_id_;
@@ -145,6 +154,9 @@ class  EntityKeyHandle
         std::array<uint8_t,32> SessionKey;
         uint64_t session_block_counter;
         uint64_t max_blocks_per_session;
+        //Bytes ciphered with the current session key and limit before it is updated (0 means no limit)
+        uint64_t session_byte_counter;
+        uint64_t max_bytes_per_session;
         CryptoTransformKind transformation_kind;
         std::mutex mutex_;
 };
@@ -158,9 +170,12 @@ class  ParticipantKeyHandle
     public:
 
         ParticipantKeyHandle() : session_id(std::numeric_limits<uint32_t>::max()),
-                session_block_counter(0), max_blocks_per_session(0){}
+                session_block_counter(0), max_blocks_per_session(0),
+                session_byte_counter(0), max_bytes_per_session(0){}
 
-        ~ParticipantKeyHandle(){}
+        ~ParticipantKeyHandle(){
+            key_material_generation.fetch_add(1, std::memory_order_relaxed);
+        }
 
         static const char* const class_id_;
 
@@ -182,6 +197,9 @@ class  ParticipantKeyHandle
         std::array<uint8_t,32> SessionKey;
         uint64_t session_block_counter;
         uint64_t max_blocks_per_session;
+        //Bytes ciphered with the current session key and limit before it is updated (0 means no limit)
+        uint64_t session_byte_counter;
+        uint64_t max_bytes_per_session;
         CryptoTransformKind transformation_kind;
         std::mutex mutex_;
 };
@@ -42,6 +42,52 @@ bool Subscriber::takeNextData(void* data,SampleInfo_t* info)
     return mp_impl->takeNextData(data,info);
 }
 
+bool Subscriber::take_loaned(void*& data, SampleInfo_t* info)
+{
+    return mp_impl->take_loaned(data, info);
+}
+
+bool Subscriber::return_loan(void* data)
+{
+    return mp_impl->return_loan(data);
+}
+
+size_t Subscriber::read(void** data, SampleInfo_t* info, size_t max_samples,
+        SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return mp_impl->read(data, info, max_samples, sample_states, instance_states);
+}
+
+size_t Subscriber::take(void** data, SampleInfo_t* info, size_t max_samples,
+        SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return mp_impl->take(data, info, max_samples, sample_states, instance_states);
+}
+
+size_t Subscriber::read_instance(void** data, SampleInfo_t* info, size_t max_samples, const InstanceHandle_t& handle,
+        SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return mp_impl->read_instance(data, info, max_samples, handle, sample_states, instance_states);
+}
+
+size_t Subscriber::take_instance(void** data, SampleInfo_t* info, size_t max_samples, const InstanceHandle_t& handle,
+        SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return mp_impl->take_instance(data, info, max_samples, handle, sample_states, instance_states);
+}
+
+size_t Subscriber::read_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+        const InstanceHandle_t& previous, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return mp_impl->read_next_instance(data, info, max_samples, previous, sample_states, instance_states);
+}
+
+size_t Subscriber::take_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+        const InstanceHandle_t& previous, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return mp_impl->take_next_instance(data, info, max_samples, previous, sample_states, instance_states);
+}
+
 bool Subscriber::updateAttributes(SubscriberAttributes& att)
 {
     return mp_impl->updateAttributes(att);
@@ -60,4 +106,9 @@ bool Subscriber::isInCleanState() const
 uint64_t Subscriber::getUnreadCount() const
 {
 	return mp_impl->getUnreadCount();
-}
\ No newline at end of file
+}
+
+EndpointStatistics Subscriber::get_statistics() const
+{
+    return mp_impl->get_statistics();
+}
@@ -26,6 +26,7 @@
 #include <fastrtps/TopicDataType.h>
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
 #include <mutex>
 
 using namespace eprosima::fastrtps;
@@ -54,6 +55,9 @@ SubscriberHistory::SubscriberHistory(SubscriberImpl* simpl,uint32_t payloadMaxSi
 SubscriberHistory::~SubscriberHistory() {
     mp_subImpl->getType()->deleteData(mp_getKeyObject);
 
+    for(CacheChange_t* change : m_loanedChanges)
+        release_Cache(change);
+
 }
 
 bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_missing_changes_up_to)
@@ -157,10 +161,10 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
                     << " and no method to obtain it";);
             return false;
         }
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if(find_Key(a_change,&vit))
         {
-            //logInfo(RTPS_EDP,"Trying to add change with KEY: "<< vit->first << endl;);
+            //logInfo(RTPS_EDP,"Trying to add change with KEY: "<< vit->first);
             bool add = false;
             if(m_historyQos.kind == KEEP_ALL_HISTORY_QOS)
             {
@@ -182,26 +186,26 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
                 }
                 else
                 {
-                    // Try to substitude a older samples.
-                    auto older_sample = m_changes.rend();
-                    for(auto it = m_changes.rbegin(); it != m_changes.rend(); ++it)
+                    // Try to substitude the oldest sample of the instance from the same writer.
+                    // Changes of an instance are ordered by sequence number, so it is the first one found.
+                    CacheChange_t* older_sample = nullptr;
+                    for(CacheChange_t* instance_change : vit->second)
                     {
-
-                        if((*it)->writerGUID == a_change->writerGUID)
+                        if(instance_change->writerGUID == a_change->writerGUID)
                         {
-                            if((*it)->sequenceNumber < a_change->sequenceNumber)
-                                older_sample = it;
                             // Already received
-                            else if((*it)->sequenceNumber == a_change->sequenceNumber)
+                            if(instance_change->sequenceNumber == a_change->sequenceNumber)
                                 return false;
+                            else if(older_sample == nullptr && instance_change->sequenceNumber < a_change->sequenceNumber)
+                                older_sample = instance_change;
                         }
                     }
 
-                    if(older_sample != m_changes.rend())
+                    if(older_sample != nullptr)
                     {
-                        bool read = (*older_sample)->isRead;
+                        bool read = older_sample->isRead;
 
-                        if(this->remove_change_sub(*older_sample, &vit))
+                        if(this->remove_change_sub(older_sample, &vit))
                         {
                             if(!read)
                             {
@@ -228,18 +232,14 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
                     if((int32_t)m_changes.size()==m_resourceLimitsQos.max_samples)
                         m_isHistoryFull = true;
                     //ADD TO KEY VECTOR
-                    if(vit->second.size() == 0)
-                    {
-                        vit->second.push_back(a_change);
-                    }
-                    else if(vit->second.back()->sequenceNumber < a_change->sequenceNumber)
+                    if(vit->second.empty() || vit->second.back()->sequenceNumber < a_change->sequenceNumber)
                     {
                         vit->second.push_back(a_change);
                     }
                     else
                     {
-                        vit->second.push_back(a_change);
-                        std::sort(vit->second.begin(),vit->second.end(),sort_ReaderHistoryCache);
+                        vit->second.insert(std::upper_bound(vit->second.begin(), vit->second.end(), a_change,
+                                    sort_ReaderHistoryCache), a_change);
                     }
                     logInfo(SUBSCRIBER,this->mp_reader->getGuid().entityId
                             <<": Change "<< a_change->sequenceNumber << " added from: "
@@ -274,22 +274,7 @@ bool SubscriberHistory::readNextData(void* data, SampleInfo_t* info)
         if(change->kind == ALIVE)
             this->mp_subImpl->getType()->deserialize(&change->serializedPayload,data);
         if(info!=nullptr)
-        {
-            info->sampleKind = change->kind;
-            info->sample_identity.writer_guid(change->writerGUID);
-            info->sample_identity.sequence_number(change->sequenceNumber);
-            info->sourceTimestamp = change->sourceTimestamp;
-            if(this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
-                info->ownershipStrength = wp->m_att.ownershipStrength;
-            if(this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
-                    change->instanceHandle == c_InstanceHandle_Unknown &&
-                    change->kind == ALIVE)
-            {
-                this->mp_subImpl->getType()->getKey(data,&change->instanceHandle);
-            }
-            info->iHandle = change->instanceHandle;
-            info->related_sample_identity = change->write_params.sample_identity();
-        }
+            fill_sample_info(change, wp, data, info);
         return true;
     }
     return false;
@@ -318,74 +303,299 @@ bool SubscriberHistory::takeNextData(void* data, SampleInfo_t* info)
         if(change->kind == ALIVE)
             this->mp_subImpl->getType()->deserialize(&change->serializedPayload,data);
         if(info!=nullptr)
+            fill_sample_info(change, wp, data, info);
+        this->remove_change_sub(change);
+        return true;
+    }
+
+    return false;
+}
+
+bool SubscriberHistory::take_loaned(void*& data, SampleInfo_t* info)
+{
+
+    if(mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    CacheChange_t* change;
+    WriterProxy * wp;
+    while(this->mp_reader->nextUntakenCache(&change,&wp))
+    {
+        if(!change->isRead)
+            this->decreaseUnreadCount();
+        change->isRead = true;
+        logInfo(SUBSCRIBER,this->mp_reader->getGuid().entityId<<": taking loaned seqNum"<< change->sequenceNumber <<
+                " from writer: "<< change->writerGUID);
+
+        data = nullptr;
+        if(change->kind == ALIVE)
         {
-            info->sampleKind = change->kind;
-            info->sample_identity.writer_guid(change->writerGUID);
-            info->sample_identity.sequence_number(change->sequenceNumber);
-            info->sourceTimestamp = change->sourceTimestamp;
-            if(this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
-                info->ownershipStrength = wp->m_att.ownershipStrength;
-            if(this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
-                    change->instanceHandle == c_InstanceHandle_Unknown &&
-                    change->kind == ALIVE)
+            // The sample is read in place, so it has to be in the representation of this host.
+            const SerializedPayload_t& payload = change->serializedPayload;
+            octet host_encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+            if(payload.length != this->mp_subImpl->getType()->m_typeSize || payload.data[1] != host_encapsulation)
             {
-                this->mp_subImpl->getType()->getKey(data,&change->instanceHandle);
+                logWarning(SUBSCRIBER,"Discarding seqNum " << change->sequenceNumber << " from writer: " <<
+                        change->writerGUID << ", it cannot be loaned in the representation of this host");
+                this->remove_change_sub(change);
+                continue;
             }
-            info->iHandle = change->instanceHandle;
-            info->related_sample_identity = change->write_params.sample_identity();
+
+            data = payload.data + 4;
+        }
+
+        if(info!=nullptr)
+            fill_sample_info(change, wp, data, info);
+
+        if(data == nullptr)
+        {
+            this->remove_change_sub(change);
+        }
+        else if(this->remove_change_sub(change, nullptr, false))
+        {
+            m_loanedChanges.push_back(change);
+        }
+        else
+        {
+            data = nullptr;
+            return false;
         }
-        this->remove_change_sub(change);
         return true;
     }
 
     return false;
 }
 
-bool SubscriberHistory::find_Key(CacheChange_t* a_change, t_v_Inst_Caches::iterator* vit_out)
+bool SubscriberHistory::return_loan(void* data)
 {
-    t_v_Inst_Caches::iterator vit;
-    bool found = false;
-    for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+    if(mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    for(auto it = m_loanedChanges.begin(); it != m_loanedChanges.end(); ++it)
     {
-        if (a_change->instanceHandle == vit->first)
+        if((*it)->serializedPayload.data + 4 == data)
         {
-            *vit_out = vit;
+            release_Cache(*it);
+            m_loanedChanges.erase(it);
             return true;
         }
     }
-    if (!found)
+
+    logWarning(SUBSCRIBER,"Returned sample was not loaned by this subscriber");
+    return false;
+}
+
+size_t SubscriberHistory::get_samples(void** data, SampleInfo_t* info, size_t max_samples, bool take,
+        const InstanceHandle_t* handle, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    if(mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+        return 0;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    m_selectedChanges.clear();
+    WriterProxy* wp = nullptr;
+
+    // Selected first, as taking them modifies the containers.
+    if(handle == nullptr)
     {
-        if ((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
+        for(auto it = m_changes.begin(); it != m_changes.end() && m_selectedChanges.size() < max_samples; ++it)
         {
-            t_p_I_Change newpair;
-            newpair.first = a_change->instanceHandle;
-            m_keyedChanges.push_back(newpair);
-            *vit_out = m_keyedChanges.end() - 1;
-            return true;
+            if(select_change(*it, sample_states, instance_states, &wp))
+                m_selectedChanges.emplace_back(*it, wp);
         }
-        else
+    }
+    else if(mp_subImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
+    {
+        auto vit = m_keyedChanges.find(*handle);
+        if(vit != m_keyedChanges.end())
         {
-            for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+            for(auto it = vit->second.begin(); it != vit->second.end() && m_selectedChanges.size() < max_samples; ++it)
             {
-                if (vit->second.size() == 0)
-                {
-                    m_keyedChanges.erase(vit);
-                    t_p_I_Change newpair;
-                    newpair.first = a_change->instanceHandle;
-                    m_keyedChanges.push_back(newpair);
-                    *vit_out = m_keyedChanges.end() - 1;
-                    return true;
-                }
+                if(select_change(*it, sample_states, instance_states, &wp))
+                    m_selectedChanges.emplace_back(*it, wp);
+            }
+        }
+    }
+
+    size_t count = 0;
+    for(auto& selected : m_selectedChanges)
+    {
+        CacheChange_t* change = selected.first;
+        if(!change->isRead)
+            this->decreaseUnreadCount();
+        change->isRead = true;
+        logInfo(SUBSCRIBER,this->mp_reader->getGuid().entityId<<": " << (take ? "taking" : "reading") <<
+                " seqNum" << change->sequenceNumber << " from writer: " << change->writerGUID);
+        if(change->kind == ALIVE)
+            this->mp_subImpl->getType()->deserialize(&change->serializedPayload, data[count]);
+        if(info != nullptr)
+            fill_sample_info(change, selected.second, data[count], &info[count]);
+        if(take)
+            this->remove_change_sub(change);
+        ++count;
+    }
+
+    m_selectedChanges.clear();
+    remove_unpaired_changes();
+    return count;
+}
+
+size_t SubscriberHistory::get_next_instance_samples(void** data, SampleInfo_t* info, size_t max_samples, bool take,
+        const InstanceHandle_t& previous, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    if(mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+        return 0;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    const InstanceHandle_t* next = nullptr;
+    WriterProxy* wp = nullptr;
+
+    for(auto& instance : m_keyedChanges)
+    {
+        if(!(previous < instance.first) || (next != nullptr && !(instance.first < *next)))
+            continue;
+
+        for(CacheChange_t* change : instance.second)
+        {
+            if(select_change(change, sample_states, instance_states, &wp))
+            {
+                next = &instance.first;
+                break;
+            }
+        }
+    }
+
+    remove_unpaired_changes();
+
+    if(next == nullptr)
+        return 0;
+
+    // The handle is copied, as taking the samples may remove the instance.
+    InstanceHandle_t handle = *next;
+    return get_samples(data, info, max_samples, take, &handle, sample_states, instance_states);
+}
+
+InstanceStateKind SubscriberHistory::instance_state(CacheChange_t* change) const
+{
+    ChangeKind_t kind = change->kind;
+
+    if(mp_subImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
+    {
+        auto vit = m_keyedChanges.find(change->instanceHandle);
+        if(vit != m_keyedChanges.end() && !vit->second.empty())
+            kind = vit->second.back()->kind;
+    }
+
+    switch(kind)
+    {
+        case ALIVE:
+            return ALIVE_INSTANCE_STATE;
+        case NOT_ALIVE_UNREGISTERED:
+            return NOT_ALIVE_NO_WRITERS_INSTANCE_STATE;
+        default:
+            return NOT_ALIVE_DISPOSED_INSTANCE_STATE;
+    }
+}
+
+bool SubscriberHistory::select_change(CacheChange_t* change, SampleStateMask sample_states,
+        InstanceStateMask instance_states, WriterProxy** wp)
+{
+    *wp = nullptr;
+    if(!this->mp_reader->is_change_available(change, wp))
+    {
+        // Without writer, the change will never be available because its writer is no longer paired.
+        if(*wp == nullptr)
+            m_unpairedChanges.push_back(change);
+        return false;
+    }
+
+    SampleStateKind sample_state = change->isRead ? READ_SAMPLE_STATE : NOT_READ_SAMPLE_STATE;
+
+    return (sample_states & sample_state) != 0 &&
+        (instance_states & instance_state(change)) != 0;
+}
+
+void SubscriberHistory::remove_unpaired_changes()
+{
+    for(CacheChange_t* change : m_unpairedChanges)
+    {
+        logWarning(RTPS_READER,"Removing change "<< change->sequenceNumber << " from " << change->writerGUID <<
+                " because is no longer paired");
+        if(!change->isRead)
+            this->decreaseUnreadCount();
+        this->remove_change_sub(change);
+    }
+
+    m_unpairedChanges.clear();
+}
+
+void SubscriberHistory::fill_sample_info(CacheChange_t* change, WriterProxy* wp, void* data, SampleInfo_t* info)
+{
+    info->sampleKind = change->kind;
+    info->sample_identity.writer_guid(change->writerGUID);
+    info->sample_identity.sequence_number(change->sequenceNumber);
+    info->sourceTimestamp = change->sourceTimestamp;
+    if(this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
+        info->ownershipStrength = wp->m_att.ownershipStrength;
+    if(this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
+            change->instanceHandle == c_InstanceHandle_Unknown &&
+            change->kind == ALIVE)
+    {
+        this->mp_subImpl->getType()->getKey(data,&change->instanceHandle);
+    }
+    info->iHandle = change->instanceHandle;
+    info->related_sample_identity = change->write_params.sample_identity();
+}
+
+bool SubscriberHistory::find_Key(CacheChange_t* a_change, t_m_Inst_Caches::iterator* vit_out)
+{
+    t_m_Inst_Caches::iterator vit = m_keyedChanges.find(a_change->instanceHandle);
+    if(vit != m_keyedChanges.end())
+    {
+        *vit_out = vit;
+        return true;
+    }
+
+    if((int)m_keyedChanges.size() >= m_resourceLimitsQos.max_instances)
+    {
+        // Only reached with all the instances in use, so the scan does not happen on every sample.
+        for(vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+        {
+            if(vit->second.empty())
+            {
+                break;
             }
+        }
+
+        if(vit == m_keyedChanges.end())
+        {
             logWarning(SUBSCRIBER, "History has reached the maximum number of instances");
+            return false;
         }
 
+        m_keyedChanges.erase(vit);
     }
-    return false;
+
+    *vit_out = m_keyedChanges.emplace(a_change->instanceHandle, t_Inst_Changes()).first;
+    return true;
 }
 
 
-bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_v_Inst_Caches::iterator* vit_in)
+bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_m_Inst_Caches::iterator* vit_in, bool release)
 {
 
     if(mp_reader == nullptr || mp_mutex == nullptr)
@@ -397,7 +607,7 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_v_Inst_Caches:
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
     if(mp_subImpl->getAttributes().topic.getTopicKind() == NO_KEY)
     {
-        if(this->remove_change(change))
+        if(this->remove_change(change, release))
         {
             m_isHistoryFull = false;
             return true;
@@ -406,14 +616,10 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_v_Inst_Caches:
     }
     else
     {
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if(vit_in!=nullptr)
             vit = *vit_in;
-        else if(this->find_Key(change,&vit))
-        {
-
-        }
-        else
+        else if((vit = m_keyedChanges.find(change->instanceHandle)) == m_keyedChanges.end())
             return false;
         for(auto chit = vit->second.begin();
                 chit!= vit->second.end();++chit)
@@ -421,7 +627,7 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_v_Inst_Caches:
             if((*chit)->sequenceNumber == change->sequenceNumber
                     && (*chit)->writerGUID == change->writerGUID)
             {
-                if(remove_change(change))
+                if(remove_change(change, release))
                 {
                     vit->second.erase(chit);
                     m_isHistoryFull = false;
@@ -88,12 +88,71 @@ bool SubscriberImpl::takeNextData(void* data,SampleInfo_t* info) {
     return this->m_history.takeNextData(data,info);
 }
 
+bool SubscriberImpl::take_loaned(void*& data, SampleInfo_t* info)
+{
+    if(!mp_type->is_plain())
+    {
+        logError(SUBSCRIBER, "Type " << mp_type->getName() << " is not plain, its samples cannot be loaned");
+        return false;
+    }
+
+    return this->m_history.take_loaned(data, info);
+}
+
+bool SubscriberImpl::return_loan(void* data)
+{
+    return this->m_history.return_loan(data);
+}
+
+size_t SubscriberImpl::read(void** data, SampleInfo_t* info, size_t max_samples,
+        SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return this->m_history.get_samples(data, info, max_samples, false, nullptr, sample_states, instance_states);
+}
+
+size_t SubscriberImpl::take(void** data, SampleInfo_t* info, size_t max_samples,
+        SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return this->m_history.get_samples(data, info, max_samples, true, nullptr, sample_states, instance_states);
+}
+
+size_t SubscriberImpl::read_instance(void** data, SampleInfo_t* info, size_t max_samples,
+        const InstanceHandle_t& handle, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return this->m_history.get_samples(data, info, max_samples, false, &handle, sample_states, instance_states);
+}
+
+size_t SubscriberImpl::take_instance(void** data, SampleInfo_t* info, size_t max_samples,
+        const InstanceHandle_t& handle, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return this->m_history.get_samples(data, info, max_samples, true, &handle, sample_states, instance_states);
+}
+
+size_t SubscriberImpl::read_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+        const InstanceHandle_t& previous, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return this->m_history.get_next_instance_samples(data, info, max_samples, false, previous,
+            sample_states, instance_states);
+}
+
+size_t SubscriberImpl::take_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+        const InstanceHandle_t& previous, SampleStateMask sample_states, InstanceStateMask instance_states)
+{
+    return this->m_history.get_next_instance_samples(data, info, max_samples, true, previous,
+            sample_states, instance_states);
+}
+
 
 
 const GUID_t& SubscriberImpl::getGuid(){
     return mp_reader->getGuid();
 }
 
+EndpointStatistics SubscriberImpl::get_statistics() const
+{
+    return mp_reader->get_statistics();
+}
+
 
 
 bool SubscriberImpl::updateAttributes(SubscriberAttributes& att)
@@ -22,6 +22,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 #include <fastrtps/rtps/common/Locator.h>
 #include <fastrtps/rtps/common/Guid.h>
+#include <fastrtps/rtps/common/Statistics.h>
 
 #include <fastrtps/attributes/SubscriberAttributes.h>
 #include <fastrtps/subscriber/SubscriberHistory.h>
@@ -76,6 +77,21 @@ public:
 
 	bool readNextData(void* data,SampleInfo_t* info);
 	bool takeNextData(void* data,SampleInfo_t* info);
+	bool take_loaned(void*& data, SampleInfo_t* info);
+	bool return_loan(void* data);
+
+	size_t read(void** data, SampleInfo_t* info, size_t max_samples,
+			SampleStateMask sample_states, InstanceStateMask instance_states);
+	size_t take(void** data, SampleInfo_t* info, size_t max_samples,
+			SampleStateMask sample_states, InstanceStateMask instance_states);
+	size_t read_instance(void** data, SampleInfo_t* info, size_t max_samples, const rtps::InstanceHandle_t& handle,
+			SampleStateMask sample_states, InstanceStateMask instance_states);
+	size_t take_instance(void** data, SampleInfo_t* info, size_t max_samples, const rtps::InstanceHandle_t& handle,
+			SampleStateMask sample_states, InstanceStateMask instance_states);
+	size_t read_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+			const rtps::InstanceHandle_t& previous, SampleStateMask sample_states, InstanceStateMask instance_states);
+	size_t take_next_instance(void** data, SampleInfo_t* info, size_t max_samples,
+			const rtps::InstanceHandle_t& previous, SampleStateMask sample_states, InstanceStateMask instance_states);
 
 	///@}
 	
@@ -118,6 +134,12 @@ public:
 	 */
 	uint64_t getUnreadCount() const;
 
+	/**
+	 * Get the statistics of the RTPSReader.
+	 * @return Snapshot of the statistics of the reader
+	 */
+	rtps::EndpointStatistics get_statistics() const;
+
 private:
 	//!Participant
 	ParticipantImpl* mp_participant;
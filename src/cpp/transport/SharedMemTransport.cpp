@@ -0,0 +1,742 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/log/Log.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <new>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <climits>
+#endif
+
+using namespace std;
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+static const uint32_t maximumMessageSize = 65500;
+static const uint32_t defaultQueueSize = 32;
+static const uint32_t segmentMagic = 0x53484d31; // "SHM1"
+static const uint32_t cacheLineSize = 64;
+
+//! Time to wait before looking again for the segment of a port that had none.
+static const std::chrono::milliseconds missingSegmentRetryPeriod(1000);
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word must be a plain 32 bit integer");
+
+//! Header of every message slot of a segment queue. The message follows it.
+struct SegmentCell
+{
+    std::atomic<uint64_t> sequence;
+    uint32_t size;
+    uint32_t source_port;
+};
+
+//! Header placed at the beginning of every segment. The queue slots follow it.
+struct SegmentHeader
+{
+    std::atomic<uint32_t> magic;
+    uint32_t cell_count;
+    uint32_t cell_size;
+    int32_t owner_pid;
+    std::atomic<uint32_t> closed;
+    //! Incremented on every push. Receivers block on it while the queue is empty.
+    std::atomic<uint32_t> notify;
+    std::atomic<uint32_t> waiters;
+    alignas(cacheLineSize) std::atomic<uint64_t> enqueue_pos;
+    alignas(cacheLineSize) std::atomic<uint64_t> dequeue_pos;
+};
+
+static uint32_t RoundUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static std::string SegmentName(uint32_t port)
+{
+    return "/fastrtps_shm_" + std::to_string(port);
+}
+
+/**
+ * Shared memory segment holding the queue of one input port.
+ * The queue is a bounded multi-producer multi-consumer ring (one sequence number per slot), so
+ * several processes can push into it concurrently without locks.
+ */
+class SharedMemSegment
+{
+    public:
+
+        //! Creates the segment of the given port, owned by this process.
+        static std::shared_ptr<SharedMemSegment> create(uint32_t port, uint32_t cell_count, uint32_t cell_size);
+
+        //! Maps the segment of the given port, created by another transport.
+        static std::shared_ptr<SharedMemSegment> open(uint32_t port);
+
+        ~SharedMemSegment();
+
+        bool push(const octet* data, uint32_t size, uint32_t source_port);
+
+        /**
+         * Takes the oldest message of the queue.
+         * @return false when the queue is empty. A message that does not fit in the buffer is
+         * discarded, and reported with a size of 0.
+         */
+        bool pop(octet* buffer, uint32_t capacity, uint32_t& size, uint32_t& source_port);
+
+        uint32_t notify_value() const
+        {
+            return header_->notify.load();
+        }
+
+        //! Blocks until a push happens after notify_value() returned the expected value.
+        void wait(uint32_t expected);
+
+        //! Wakes up all the threads blocked on wait().
+        void interrupt();
+
+        //! Marks the segment as closed and removes its name, so no new sender finds it.
+        void close();
+
+        bool is_closed() const
+        {
+            return header_->closed.load() != 0;
+        }
+
+        //! Reports whether the segment is open and the process that owns it still exists.
+        bool is_alive() const;
+
+    private:
+
+        SharedMemSegment(const std::string& name, void* address, size_t size, bool owner);
+
+        SharedMemSegment(const SharedMemSegment&) = delete;
+        SharedMemSegment& operator=(const SharedMemSegment&) = delete;
+
+        static size_t CellsOffset()
+        {
+            return RoundUp(static_cast<uint32_t>(sizeof(SegmentHeader)), cacheLineSize);
+        }
+
+        static uint32_t CellStride(uint32_t cell_size)
+        {
+            return RoundUp(static_cast<uint32_t>(sizeof(SegmentCell)) + cell_size, cacheLineSize);
+        }
+
+        SegmentCell* cell(uint64_t pos) const
+        {
+            return reinterpret_cast<SegmentCell*>(cells_ + (pos & mask_) * cell_stride_);
+        }
+
+        static octet* payload(SegmentCell* cell)
+        {
+            return reinterpret_cast<octet*>(cell) + sizeof(SegmentCell);
+        }
+
+        std::string name_;
+        void* address_;
+        size_t size_;
+        bool owner_;
+        SegmentHeader* header_;
+        octet* cells_;
+        uint32_t cell_stride_;
+        uint64_t mask_;
+};
+
+SharedMemSegment::SharedMemSegment(const std::string& name, void* address, size_t size, bool owner) :
+    name_(name), address_(address), size_(size), owner_(owner),
+    header_(static_cast<SegmentHeader*>(address)),
+    cells_(static_cast<octet*>(address) + CellsOffset()),
+    cell_stride_(CellStride(header_->cell_size)),
+    mask_(header_->cell_count - 1)
+{
+}
+
+SharedMemSegment::~SharedMemSegment()
+{
+    if(owner_)
+    {
+        close();
+    }
+
+#if !defined(_WIN32)
+    munmap(address_, size_);
+#endif
+}
+
+std::shared_ptr<SharedMemSegment> SharedMemSegment::create(uint32_t port, uint32_t cell_count, uint32_t cell_size)
+{
+#if defined(_WIN32)
+    (void)port;
+    (void)cell_count;
+    (void)cell_size;
+    return nullptr;
+#else
+    std::string name = SegmentName(port);
+    size_t size = CellsOffset() + static_cast<size_t>(cell_count) * CellStride(cell_size);
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+    if(fd < 0 && errno == EEXIST)
+    {
+        // Left behind by a process that did not close it. It is only replaced when its owner is gone.
+        std::shared_ptr<SharedMemSegment> previous = open(port);
+        if(previous && previous->is_alive())
+        {
+            return nullptr;
+        }
+        previous.reset();
+
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+    }
+
+    if(fd < 0)
+    {
+        logWarning(RTPS_MSG_IN, "Cannot create shared memory segment " << name << ": " << strerror(errno));
+        return nullptr;
+    }
+
+    if(ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        logWarning(RTPS_MSG_IN, "Cannot resize shared memory segment " << name << ": " << strerror(errno));
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(address == MAP_FAILED)
+    {
+        logWarning(RTPS_MSG_IN, "Cannot map shared memory segment " << name << ": " << strerror(errno));
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    SegmentHeader* header = new (address) SegmentHeader;
+    header->cell_count = cell_count;
+    header->cell_size = cell_size;
+    header->owner_pid = static_cast<int32_t>(getpid());
+    header->closed.store(0);
+    header->notify.store(0);
+    header->waiters.store(0);
+    header->enqueue_pos.store(0);
+    header->dequeue_pos.store(0);
+
+    octet* cells = static_cast<octet*>(address) + CellsOffset();
+    for(uint32_t i = 0; i < cell_count; ++i)
+    {
+        SegmentCell* cell = new (cells + static_cast<size_t>(i) * CellStride(cell_size)) SegmentCell;
+        cell->sequence.store(i);
+    }
+
+    // Senders do not use the segment until they see it fully initialized.
+    header->magic.store(segmentMagic, std::memory_order_release);
+
+    return std::shared_ptr<SharedMemSegment>(new SharedMemSegment(name, address, size, true));
+#endif
+}
+
+std::shared_ptr<SharedMemSegment> SharedMemSegment::open(uint32_t port)
+{
+#if defined(_WIN32)
+    (void)port;
+    return nullptr;
+#else
+    std::string name = SegmentName(port);
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if(fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat status;
+    if(fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < CellsOffset())
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>(status.st_size);
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(address == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    SegmentHeader* header = static_cast<SegmentHeader*>(address);
+    if(header->magic.load(std::memory_order_acquire) != segmentMagic ||
+            header->cell_count == 0 || (header->cell_count & (header->cell_count - 1)) != 0 ||
+            size < CellsOffset() + static_cast<size_t>(header->cell_count) * CellStride(header->cell_size))
+    {
+        munmap(address, size);
+        return nullptr;
+    }
+
+    return std::shared_ptr<SharedMemSegment>(new SharedMemSegment(name, address, size, false));
+#endif
+}
+
+bool SharedMemSegment::push(const octet* data, uint32_t size, uint32_t source_port)
+{
+    if(size > header_->cell_size)
+    {
+        return false;
+    }
+
+    uint64_t pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+    SegmentCell* target = nullptr;
+
+    while(target == nullptr)
+    {
+        SegmentCell* candidate = cell(pos);
+        uint64_t sequence = candidate->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+
+        if(diff == 0)
+        {
+            if(header_->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                target = candidate;
+            }
+        }
+        else if(diff < 0)
+        {
+            // Queue full.
+            return false;
+        }
+        else
+        {
+            pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    memcpy(payload(target), data, size);
+    target->size = size;
+    target->source_port = source_port;
+    target->sequence.store(pos + 1, std::memory_order_release);
+
+    header_->notify.fetch_add(1);
+    if(header_->waiters.load() > 0)
+    {
+        interrupt();
+    }
+
+    return true;
+}
+
+bool SharedMemSegment::pop(octet* buffer, uint32_t capacity, uint32_t& size, uint32_t& source_port)
+{
+    uint64_t pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+    SegmentCell* target = nullptr;
+
+    while(target == nullptr)
+    {
+        SegmentCell* candidate = cell(pos);
+        uint64_t sequence = candidate->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+
+        if(diff == 0)
+        {
+            if(header_->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                target = candidate;
+            }
+        }
+        else if(diff < 0)
+        {
+            // Queue empty.
+            return false;
+        }
+        else
+        {
+            pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    size = 0;
+    source_port = target->source_port;
+    if(target->size <= capacity)
+    {
+        memcpy(buffer, payload(target), target->size);
+        size = target->size;
+    }
+
+    target->sequence.store(pos + mask_ + 1, std::memory_order_release);
+
+    return true;
+}
+
+void SharedMemSegment::wait(uint32_t expected)
+{
+#if defined(__linux__)
+    header_->waiters.fetch_add(1);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header_->notify), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+    header_->waiters.fetch_sub(1);
+#else
+    if(header_->notify.load() == expected)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+#endif
+}
+
+void SharedMemSegment::interrupt()
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header_->notify), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+void SharedMemSegment::close()
+{
+    uint32_t expected = 0;
+    if(owner_ && header_->closed.compare_exchange_strong(expected, 1))
+    {
+#if !defined(_WIN32)
+        shm_unlink(name_.c_str());
+#endif
+        header_->notify.fetch_add(1);
+        interrupt();
+    }
+}
+
+bool SharedMemSegment::is_alive() const
+{
+    if(is_closed())
+    {
+        return false;
+    }
+
+#if !defined(_WIN32)
+    if(kill(static_cast<pid_t>(header_->owner_pid), 0) != 0 && errno == ESRCH)
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+struct SharedMemTransport::InputChannel
+{
+    InputChannel(const std::shared_ptr<SharedMemSegment>& input_segment) :
+        segment(input_segment), alive(true)
+    {
+    }
+
+    std::shared_ptr<SharedMemSegment> segment;
+    std::atomic<bool> alive;
+};
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor():
+    TransportDescriptorInterface(maximumMessageSize),
+    queueSize(defaultQueueSize)
+{
+}
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t) :
+    TransportDescriptorInterface(t),
+    queueSize(t.queueSize)
+{
+}
+
+SharedMemTransport::SharedMemTransport(const SharedMemTransportDescriptor& descriptor) :
+    mConfiguration_(descriptor)
+{
+}
+
+SharedMemTransport::~SharedMemTransport()
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+    for(auto& channel : mInputChannels)
+    {
+        channel.second->alive = false;
+        channel.second->segment->close();
+    }
+    mInputChannels.clear();
+}
+
+bool SharedMemTransport::init()
+{
+#if defined(_WIN32)
+    logError(RTPS_MSG_OUT, "Shared memory transport is not supported on this platform");
+    return false;
+#else
+    if(mConfiguration_.maxMessageSize == 0)
+    {
+        logError(RTPS_MSG_OUT, "maxMessageSize cannot be 0");
+        return false;
+    }
+
+    if(mConfiguration_.queueSize == 0)
+    {
+        mConfiguration_.queueSize = defaultQueueSize;
+    }
+
+    // The queues index their slots with a mask.
+    uint32_t queue_size = 1;
+    while(queue_size < mConfiguration_.queueSize)
+    {
+        queue_size <<= 1;
+    }
+    mConfiguration_.queueSize = queue_size;
+
+    return true;
+#endif
+}
+
+bool SharedMemTransport::IsInputChannelOpen(const Locator_t& locator) const
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+    return IsLocatorSupported(locator) && (mInputChannels.find(locator.port) != mInputChannels.end());
+}
+
+bool SharedMemTransport::IsOutputChannelOpen(const Locator_t& locator) const
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+    return IsLocatorSupported(locator) && (mOutputChannels.find(locator.port) != mOutputChannels.end());
+}
+
+bool SharedMemTransport::IsLocatorSupported(const Locator_t& locator) const
+{
+    return locator.kind == LOCATOR_KIND_SHM;
+}
+
+bool SharedMemTransport::DoLocatorsMatch(const Locator_t& left, const Locator_t& right) const
+{
+    return IsLocatorSupported(left) && IsLocatorSupported(right) && left.port == right.port;
+}
+
+Locator_t SharedMemTransport::RemoteToMainLocal(const Locator_t&) const
+{
+    Locator_t mainLocal;
+    mainLocal.kind = LOCATOR_KIND_SHM;
+    mainLocal.port = 0;
+    LOCATOR_ADDRESS_INVALID(mainLocal.address);
+    return mainLocal;
+}
+
+bool SharedMemTransport::OpenInputChannel(const Locator_t& locator)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+    if (!IsLocatorSupported(locator) || IsInputChannelOpen(locator))
+        return false;
+
+    std::shared_ptr<SharedMemSegment> segment = SharedMemSegment::create(locator.port,
+            mConfiguration_.queueSize, mConfiguration_.maxMessageSize);
+    if(!segment)
+        return false;
+
+    mInputChannels[locator.port] = std::make_shared<InputChannel>(segment);
+    logInfo(RTPS_MSG_IN, "SHM: listening on port " << locator.port);
+
+    return true;
+}
+
+bool SharedMemTransport::OpenOutputChannel(Locator_t& locator)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+    if (!IsLocatorSupported(locator) || IsOutputChannelOpen(locator))
+        return false;
+
+    mOutputChannels.insert(locator.port);
+    return true;
+}
+
+bool SharedMemTransport::CloseInputChannel(const Locator_t& locator)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+    if (!IsInputChannelOpen(locator))
+        return false;
+
+    // Threads still on Receive keep the mapping alive until they return.
+    auto& channel = mInputChannels.at(locator.port);
+    channel->alive = false;
+    channel->segment->close();
+    mInputChannels.erase(locator.port);
+
+    return true;
+}
+
+bool SharedMemTransport::ReleaseInputChannel(const Locator_t& locator)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+    if (!IsInputChannelOpen(locator))
+        return false;
+
+    auto& channel = mInputChannels.at(locator.port);
+    channel->alive = false;
+    channel->segment->interrupt();
+
+    return true;
+}
+
+bool SharedMemTransport::CloseOutputChannel(const Locator_t& locator)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+    if (!IsOutputChannelOpen(locator))
+        return false;
+
+    mOutputChannels.erase(locator.port);
+
+    return true;
+}
+
+std::shared_ptr<SharedMemSegment> SharedMemTransport::GetRemoteSegment(uint32_t port)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+
+    auto it = mRemoteSegments.find(port);
+    if(it != mRemoteSegments.end())
+    {
+        if(!it->second->is_closed())
+            return it->second;
+
+        mRemoteSegments.erase(it);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto missing = mMissingSegments.find(port);
+    if(missing != mMissingSegments.end() && now < missing->second)
+        return nullptr;
+
+    std::shared_ptr<SharedMemSegment> segment = SharedMemSegment::open(port);
+    if(!segment || segment->is_closed())
+    {
+        mMissingSegments[port] = now + missingSegmentRetryPeriod;
+        return nullptr;
+    }
+
+    mMissingSegments.erase(port);
+    mRemoteSegments[port] = segment;
+
+    return segment;
+}
+
+bool SharedMemTransport::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+        const Locator_t& remoteLocator)
+{
+    if (!IsOutputChannelOpen(localLocator) || !IsLocatorSupported(remoteLocator) ||
+            sendBufferSize > mConfiguration_.maxMessageSize)
+        return false;
+
+    std::shared_ptr<SharedMemSegment> segment = GetRemoteSegment(remoteLocator.port);
+    if(!segment)
+        return false;
+
+    if(segment->push(sendBuffer, sendBufferSize, localLocator.port))
+    {
+        logInfo(RTPS_MSG_OUT, "SHM: " << sendBufferSize << " bytes TO port " << remoteLocator.port);
+        return true;
+    }
+
+    // The queue is full. When nobody is going to empty it, forget the segment so a new one on that port is found.
+    if(!segment->is_alive())
+    {
+        std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+        auto it = mRemoteSegments.find(remoteLocator.port);
+        if(it != mRemoteSegments.end() && it->second == segment)
+            mRemoteSegments.erase(it);
+    }
+
+    return false;
+}
+
+bool SharedMemTransport::Receive(octet* receiveBuffer, uint32_t receiveBufferCapacity, uint32_t& receiveBufferSize,
+        const Locator_t& localLocator, Locator_t& remoteLocator)
+{
+    std::shared_ptr<InputChannel> channel;
+
+    { // lock scope
+        std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+        if (!IsInputChannelOpen(localLocator))
+            return false;
+
+        channel = mInputChannels.at(localLocator.port);
+    }
+
+    while(channel->alive)
+    {
+        uint32_t expected = channel->segment->notify_value();
+        uint32_t source_port = 0;
+
+        if(channel->segment->pop(receiveBuffer, receiveBufferCapacity, receiveBufferSize, source_port))
+        {
+            if(receiveBufferSize == 0)
+            {
+                logWarning(RTPS_MSG_IN, "SHM: message bigger than the reception buffer discarded");
+                continue;
+            }
+
+            // Replies go through the loopback interface, as if the message had been received through UDP.
+            remoteLocator.kind = LOCATOR_KIND_UDPv4;
+            remoteLocator.port = source_port;
+            LOCATOR_ADDRESS_INVALID(remoteLocator.address);
+            remoteLocator.set_IP4_address(127, 0, 0, 1);
+            return true;
+        }
+
+        channel->segment->wait(expected);
+    }
+
+    return false;
+}
+
+LocatorList_t SharedMemTransport::NormalizeLocator(const Locator_t& locator)
+{
+    LocatorList_t list;
+    list.push_back(locator);
+    return list;
+}
+
+LocatorList_t SharedMemTransport::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
+{
+    LocatorList_t result;
+
+    for(auto& locatorList : locatorLists)
+        for(auto it = locatorList.begin(); it != locatorList.end(); ++it)
+            result.push_back(*it);
+
+    return result;
+}
+
+bool SharedMemTransport::is_local_locator(const Locator_t&) const
+{
+    return true;
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
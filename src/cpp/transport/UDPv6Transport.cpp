@@ -16,9 +16,15 @@
 #include <utility>
 #include <cstring>
 #include <algorithm>
+#include <iterator>
 #include <fastrtps/log/Log.h>
 #include <fastrtps/utils/Semaphore.h>
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
 using namespace std;
 using namespace asio;
 
@@ -29,6 +35,7 @@ namespace rtps{
 static const uint32_t maximumMessageSize = 65500;
 static const uint32_t minimumSocketBuffer = 65536;
 static const uint8_t defaultTTL = 1;
+static const uint32_t maximumBatchSize = 64;
 
 static void GetIP6s(vector<IPFinder::info_IP>& locNames, bool return_loopback = false)
 {
@@ -93,7 +100,8 @@ UDPv6TransportDescriptor::UDPv6TransportDescriptor():
     TransportDescriptorInterface(maximumMessageSize),
     sendBufferSize(0),
     receiveBufferSize(0),
-    TTL(defaultTTL)
+    TTL(defaultTTL),
+    maxBatchSize(1)
 {
 }
 
@@ -101,7 +109,8 @@ UDPv6TransportDescriptor::UDPv6TransportDescriptor(const UDPv6TransportDescripto
     TransportDescriptorInterface(t),
     sendBufferSize(t.sendBufferSize),
     receiveBufferSize(t.receiveBufferSize),
-    TTL(t.TTL)
+    TTL(t.TTL),
+    maxBatchSize(t.maxBatchSize)
 {
 }
 
@@ -162,6 +171,16 @@ bool UDPv6Transport::init()
         return false;
     }
 
+    if(mConfiguration_.maxBatchSize == 0)
+    {
+        mConfiguration_.maxBatchSize = 1;
+    }
+    else if(mConfiguration_.maxBatchSize > maximumBatchSize)
+    {
+        logWarning(RTPS_MSG_OUT, "maxBatchSize limited to " << maximumBatchSize);
+        mConfiguration_.maxBatchSize = maximumBatchSize;
+    }
+
     // TODO(Ricardo) Create an event that update this list.
     GetIP6s(currentInterfaces);
 
@@ -519,6 +538,167 @@ bool UDPv6Transport::Receive(octet* receiveBuffer, uint32_t receiveBufferCapacit
     return (receiveBufferSize > 0);
 }
 
+bool UDPv6Transport::SendBatch(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+        const LocatorList_t& remoteLocators)
+{
+#if defined(__linux__)
+    if(mConfiguration_.maxBatchSize > 1 && std::distance(remoteLocators.begin(), remoteLocators.end()) > 1)
+    {
+        std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+        if (!IsOutputChannelOpen(localLocator) ||
+                sendBufferSize > mConfiguration_.sendBufferSize)
+            return false;
+
+        bool success = false;
+
+        auto& sockets = mOutputSockets.at(localLocator.port);
+        for (auto& socket : sockets)
+        {
+            success |= SendBatchThroughSocket(sendBuffer, sendBufferSize, remoteLocators, socket);
+        }
+
+        return success;
+    }
+#endif
+
+    return TransportInterface::SendBatch(sendBuffer, sendBufferSize, localLocator, remoteLocators);
+}
+
+uint32_t UDPv6Transport::ReceiveBatch(TransportReceiveBuffer* buffers, uint32_t bufferCount,
+        const Locator_t& localLocator)
+{
+#if defined(__linux__)
+    if(mConfiguration_.maxBatchSize > 1 && bufferCount > 1)
+    {
+        if (!IsInputChannelOpen(localLocator))
+            return 0;
+
+        ip::udp::socket* socket = nullptr;
+
+        { // lock scope
+            std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+            if (!IsInputChannelOpen(localLocator))
+                return 0;
+
+            socket = &mInputSockets.at(localLocator.port);
+        }
+
+        uint32_t count = std::min(bufferCount, mConfiguration_.maxBatchSize);
+        struct mmsghdr headers[maximumBatchSize];
+        struct iovec iovecs[maximumBatchSize];
+        struct sockaddr_in6 addresses[maximumBatchSize];
+        memset(headers, 0, sizeof(headers));
+
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            iovecs[i].iov_base = buffers[i].buffer;
+            iovecs[i].iov_len = buffers[i].capacity;
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = &addresses[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+        }
+
+        // Blocks until one datagram is available, then takes the rest without blocking.
+        int received = recvmmsg(socket->native_handle(), headers, count, MSG_WAITFORONE, nullptr);
+        if(received <= 0)
+            return 0;
+
+        for(int i = 0; i < received; ++i)
+        {
+            buffers[i].size = headers[i].msg_len;
+
+            if(buffers[i].size == 13 && memcmp(buffers[i].buffer, "EPRORTPSCLOSE", 13) == 0)
+            {
+                // Channel is being released. Datagrams after this one are discarded.
+                return static_cast<uint32_t>(i);
+            }
+
+            buffers[i].remoteLocator.kind = LOCATOR_KIND_UDPv6;
+            buffers[i].remoteLocator.port = ntohs(addresses[i].sin6_port);
+            memcpy(&buffers[i].remoteLocator.address[0], &addresses[i].sin6_addr, 16);
+        }
+
+        return static_cast<uint32_t>(received);
+    }
+#endif
+
+    return TransportInterface::ReceiveBatch(buffers, bufferCount, localLocator);
+}
+
+uint32_t UDPv6Transport::MaxBatchSize() const
+{
+#if defined(__linux__)
+    return mConfiguration_.maxBatchSize;
+#else
+    return 1;
+#endif
+}
+
+bool UDPv6Transport::SendBatchThroughSocket(const octet* sendBuffer,
+        uint32_t sendBufferSize,
+        const LocatorList_t& remoteLocators,
+        SocketInfo& socket)
+{
+#if defined(__linux__)
+    struct mmsghdr headers[maximumBatchSize];
+    struct sockaddr_in6 addresses[maximumBatchSize];
+    struct iovec iov;
+    iov.iov_base = const_cast<octet*>(sendBuffer);
+    iov.iov_len = sendBufferSize;
+
+    bool success = false;
+    auto it = remoteLocators.begin();
+
+    while(it != remoteLocators.end())
+    {
+        // Fill a batch with the destinations this socket has to send to.
+        uint32_t count = 0;
+        for(; it != remoteLocators.end() && count < mConfiguration_.maxBatchSize; ++it)
+        {
+            if(!IsMulticastAddress(*it) && socket.only_multicast_purpose())
+                continue;
+
+            memset(&headers[count], 0, sizeof(headers[count]));
+            memset(&addresses[count], 0, sizeof(addresses[count]));
+            addresses[count].sin6_family = AF_INET6;
+            addresses[count].sin6_port = htons(static_cast<uint16_t>(it->port));
+            memcpy(&addresses[count].sin6_addr, &it->address[0], 16);
+            headers[count].msg_hdr.msg_name = &addresses[count];
+            headers[count].msg_hdr.msg_namelen = sizeof(addresses[count]);
+            headers[count].msg_hdr.msg_iov = &iov;
+            headers[count].msg_hdr.msg_iovlen = 1;
+            ++count;
+        }
+
+        uint32_t sent = 0;
+        while(sent < count)
+        {
+            int ret = sendmmsg(socket.socket_.native_handle(), &headers[sent], count - sent, 0);
+            if(ret <= 0)
+            {
+                logWarning(RTPS_MSG_OUT, "Error: sendmmsg failed sending to " << (count - sent) << " destinations");
+                break;
+            }
+
+            sent += static_cast<uint32_t>(ret);
+            success = true;
+        }
+
+        logInfo(RTPS_MSG_OUT,"UDPv6: " << sendBufferSize << " bytes TO " << sent << " endpoints FROM "
+                << socket.socket_.local_endpoint());
+    }
+
+    return success;
+#else
+    (void)sendBuffer;
+    (void)sendBufferSize;
+    (void)remoteLocators;
+    (void)socket;
+    return false;
+#endif
+}
+
 bool UDPv6Transport::SendThroughSocket(const octet* sendBuffer,
         uint32_t sendBufferSize,
         const Locator_t& remoteLocator,
@@ -74,6 +74,12 @@ bool test_UDPv4Transport::Send(const octet* sendBuffer, uint32_t sendBufferSize,
     }
 }
 
+bool test_UDPv4Transport::SendBatch(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+        const LocatorList_t& remoteLocators)
+{
+    return TransportInterface::SendBatch(sendBuffer, sendBufferSize, localLocator, remoteLocators);
+}
+
 static bool ReadSubmessageHeader(CDRMessage_t& msg, SubmessageHeader_t& smh)
 {
     if(msg.length - msg.pos < 4)
@@ -19,6 +19,8 @@
 
 #include <fastrtps/utils/StringMatching.h>
 
+#include <cstring>
+
 #if defined(__cplusplus_winrt)
 #include <algorithm>
 #include <regex>
@@ -41,6 +43,11 @@ StringMatching::~StringMatching() {
 	// TODO Auto-generated destructor stub
 }
 
+bool StringMatching::hasWildcards(const char* str)
+{
+	return strpbrk(str, "*?[") != nullptr;
+}
+
 #if defined(__cplusplus_winrt)
 void replace_all(std::string & subject, const std::string & search, const std::string & replace) {
 	size_t pos = 0;
@@ -395,6 +395,8 @@ XMLP_ret XMLParser::getXMLWriterQosPolicies(tinyxml2::XMLElement *elem, WriterQo
             <xs:element name="topicData" type="topicDataQosPolicyType"/>
             <xs:element name="groupData" type="groupDataQosPolicyType"/>
             <xs:element name="publishMode" type="publishModeQosPolicyType"/>
+            <xs:element name="fragmentScheduling" type="fragmentSchedulingQosPolicyType"/>
+            <xs:element name="slowReader" type="slowReaderQosPolicyType"/>
         </xs:all>
     </xs:complexType>*/
 
@@ -425,6 +427,17 @@ XMLP_ret XMLParser::getXMLWriterQosPolicies(tinyxml2::XMLElement *elem, WriterQo
     {
         if (XMLP_ret::XML_OK != getXMLPublishModeQos(p_aux, qos.m_publishMode, ident)) return XMLP_ret::XML_ERROR;
     }
+    // fragmentScheduling
+    if (nullptr != (p_aux = elem->FirstChildElement(   FRAG_SCHEDULING)))
+    {
+        if (XMLP_ret::XML_OK != getXMLFragmentSchedulingQos(p_aux, qos.m_fragmentScheduling, ident))
+            return XMLP_ret::XML_ERROR;
+    }
+    // slowReader
+    if (nullptr != (p_aux = elem->FirstChildElement(       SLOW_READER)))
+    {
+        if (XMLP_ret::XML_OK != getXMLSlowReaderQos(p_aux, qos.m_slowReader, ident)) return XMLP_ret::XML_ERROR;
+    }
 
     if (nullptr != (p_aux = elem->FirstChildElement(    DURABILITY_SRV)) ||
         nullptr != (p_aux = elem->FirstChildElement(          DEADLINE)) ||
@@ -1076,6 +1089,7 @@ XMLP_ret XMLParser::getXMLPublishModeQos(tinyxml2::XMLElement *elem, PublishMode
     /*<xs:complexType name="publishModeQosPolicyType">
       <xs:all>
         <xs:element name="kind" type="publishModeQosKindType"/>
+        <xs:element name="priority" type="publishModePriorityType" minOccurs="0"/>
       </xs:all>
     </xs:complexType>*/
 
@@ -1111,6 +1125,133 @@ XMLP_ret XMLParser::getXMLPublishModeQos(tinyxml2::XMLElement *elem, PublishMode
         return XMLP_ret::XML_ERROR;
     }
 
+    if (nullptr != (p_aux0 = elem->FirstChildElement(PRIORITY)))
+    {
+        /*<xs:simpleType name="publishModePriorityType">
+          <xs:restriction base="xs:string">
+            <xs:enumeration value="LOW"/>
+            <xs:enumeration value="NORMAL"/>
+            <xs:enumeration value="HIGH"/>
+          </xs:restriction>
+        </xs:simpleType>*/
+        const char* text = p_aux0->GetText();
+        if (nullptr == text)
+        {
+            logError(XMLPARSER, "Node '" << PRIORITY << "' without content");
+            return XMLP_ret::XML_ERROR;
+        }
+             if (strcmp(text, LOW_PRIORITY) == 0)
+            publishMode.priority = PublishModePriorityKind::LOW_PRIORITY_PUBLISH_MODE;
+        else if (strcmp(text, NORMAL_PRIORITY) == 0)
+            publishMode.priority = PublishModePriorityKind::NORMAL_PRIORITY_PUBLISH_MODE;
+        else if (strcmp(text, HIGH_PRIORITY) == 0)
+            publishMode.priority = PublishModePriorityKind::HIGH_PRIORITY_PUBLISH_MODE;
+        else
+        {
+            logError(XMLPARSER, "Node '" << PRIORITY << "' bad content");
+            return XMLP_ret::XML_ERROR;
+        }
+    }
+
+    return XMLP_ret::XML_OK;
+}
+
+XMLP_ret XMLParser::getXMLFragmentSchedulingQos(tinyxml2::XMLElement *elem,
+                                                FragmentSchedulingQosPolicy &fragmentScheduling, uint8_t ident)
+{
+    /*<xs:complexType name="fragmentSchedulingQosPolicyType">
+      <xs:all minOccurs="0">
+        <xs:element name="kind" type="fragmentSchedulingQosKindType"/>
+        <xs:element name="bytesPerReaderPerPeriod" type="uint32Type"/>
+        <xs:element name="periodMillisecs" type="uint32Type"/>
+      </xs:all>
+    </xs:complexType>*/
+
+    tinyxml2::XMLElement *p_aux0 = nullptr;
+
+    if (nullptr != (p_aux0 = elem->FirstChildElement(KIND)))
+    {
+        /*<xs:simpleType name="fragmentSchedulingQosKindType">
+          <xs:restriction base="xs:string">
+            <xs:enumeration value="SEQUENTIAL"/>
+            <xs:enumeration value="INTERLEAVED"/>
+          </xs:restriction>
+        </xs:simpleType>*/
+        const char* text = p_aux0->GetText();
+        if (nullptr == text)
+        {
+            logError(XMLPARSER, "Node '" << KIND << "' without content");
+            return XMLP_ret::XML_ERROR;
+        }
+             if (strcmp(text, SEQUENTIAL) == 0)
+            fragmentScheduling.kind = FragmentSchedulingQosPolicyKind::SEQUENTIAL_FRAGMENT_SCHEDULING;
+        else if (strcmp(text, INTERLEAVED) == 0)
+            fragmentScheduling.kind = FragmentSchedulingQosPolicyKind::INTERLEAVED_FRAGMENT_SCHEDULING;
+        else
+        {
+            logError(XMLPARSER, "Node '" << KIND << "' bad content");
+            return XMLP_ret::XML_ERROR;
+        }
+    }
+    // bytesPerReaderPerPeriod - uint32Type
+    if (nullptr != (p_aux0 = elem->FirstChildElement(BYTES_PER_READER)))
+    {
+        if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &fragmentScheduling.bytesPerReaderPerPeriod, ident))
+            return XMLP_ret::XML_ERROR;
+    }
+    // periodMillisecs - uint32Type
+    if (nullptr != (p_aux0 = elem->FirstChildElement(PERIOD_MILLISECS)))
+    {
+        if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &fragmentScheduling.periodMillisecs, ident))
+            return XMLP_ret::XML_ERROR;
+    }
+
+    return XMLP_ret::XML_OK;
+}
+
+XMLP_ret XMLParser::getXMLSlowReaderQos(tinyxml2::XMLElement *elem, SlowReaderQosPolicy &slowReader, uint8_t /*ident*/)
+{
+    /*<xs:complexType name="slowReaderQosPolicyType">
+      <xs:all>
+        <xs:element name="kind" type="slowReaderQosKindType"/>
+      </xs:all>
+    </xs:complexType>*/
+
+    tinyxml2::XMLElement *p_aux0 = nullptr;
+    bool bKindDefined = false;
+
+    if (nullptr != (p_aux0 = elem->FirstChildElement(KIND)))
+    {
+        /*<xs:simpleType name="slowReaderQosKindType">
+          <xs:restriction base="xs:string">
+            <xs:enumeration value="BLOCK"/>
+            <xs:enumeration value="DROP_SLOWEST"/>
+          </xs:restriction>
+        </xs:simpleType>*/
+        bKindDefined = true;
+        const char* text = p_aux0->GetText();
+        if (nullptr == text)
+        {
+            logError(XMLPARSER, "Node '" << KIND << "' without content");
+            return XMLP_ret::XML_ERROR;
+        }
+             if (strcmp(text, BLOCK) == 0)
+            slowReader.kind = SlowReaderQosPolicyKind::BLOCK_ON_SLOW_READER;
+        else if (strcmp(text, DROP_SLOWEST) == 0)
+            slowReader.kind = SlowReaderQosPolicyKind::DROP_SLOWEST_READER;
+        else
+        {
+            logError(XMLPARSER, "Node '" << KIND << "' bad content");
+            return XMLP_ret::XML_ERROR;
+        }
+    }
+
+    if (!bKindDefined)
+    {
+        logError(XMLPARSER, "Node 'slowReaderQosPolicyType' without content");
+        return XMLP_ret::XML_ERROR;
+    }
+
     return XMLP_ret::XML_OK;
 }
 
@@ -1223,6 +1364,7 @@ XMLP_ret XMLParser::getXMLReaderTimes(tinyxml2::XMLElement *elem, ReaderTimes &t
       <xs:all minOccurs="0">
         <xs:element name="initialAcknackDelay" type="durationType"/>
         <xs:element name="heartbeatResponseDelay" type="durationType"/>
+        <xs:element name="fragmentedSampleTimeout" type="durationType"/>
       </xs:all>
     </xs:complexType>*/
 
@@ -1237,6 +1379,11 @@ XMLP_ret XMLParser::getXMLReaderTimes(tinyxml2::XMLElement *elem, ReaderTimes &t
     {
         if (XMLP_ret::XML_OK != getXMLDuration(p_aux0, times.heartbeatResponseDelay, ident)) return XMLP_ret::XML_ERROR;
     }
+    // fragmentedSampleTimeout
+    if (nullptr != (p_aux0 = elem->FirstChildElement(FRAG_SAMPLE_TIMEOUT)))
+    {
+        if (XMLP_ret::XML_OK != getXMLDuration(p_aux0, times.fragmentedSampleTimeout, ident)) return XMLP_ret::XML_ERROR;
+    }
 
     return XMLP_ret::XML_OK;
 }
@@ -1324,6 +1471,7 @@ XMLP_ret XMLParser::getXMLHistoryMemoryPolicy(tinyxml2::XMLElement *elem,
       <xs:restriction base="xs:string">
         <xs:enumeration value="PREALLOCATED"/>
         <xs:enumeration value="PREALLOCATED_WITH_REALLOC"/>
+        <xs:enumeration value="PREALLOCATED_WITH_ARENA"/>
         <xs:enumeration value="DYNAMIC"/>
       </xs:restriction>
     </xs:simpleType>*/
@@ -1337,6 +1485,8 @@ XMLP_ret XMLParser::getXMLHistoryMemoryPolicy(tinyxml2::XMLElement *elem,
         historyMemoryPolicy = MemoryManagementPolicy::PREALLOCATED_MEMORY_MODE;
     else if (strcmp(text, PREALLOCATED_WITH_REALLOC) == 0)
         historyMemoryPolicy = MemoryManagementPolicy::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+    else if (strcmp(text,   PREALLOCATED_WITH_ARENA) == 0)
+        historyMemoryPolicy = MemoryManagementPolicy::PREALLOCATED_WITH_ARENA_MEMORY_MODE;
     else if (strcmp(text,                   DYNAMIC) == 0)
         historyMemoryPolicy = MemoryManagementPolicy::DYNAMIC_RESERVE_MEMORY_MODE;
     else
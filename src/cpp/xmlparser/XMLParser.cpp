@@ -277,6 +277,10 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
         <xs:element name="defaultSendPort" type="uint32Type"/>
         <xs:element name="sendSocketBufferSize" type="uint32Type"/>
         <xs:element name="listenSocketBufferSize" type="uint32Type"/>
+        <xs:element name="listenWorkerThreads" type="uint32Type"/>
+        <xs:element name="listenBufferPoolSize" type="uint32Type"/>
+        <xs:element name="asyncSendThreads" type="uint32Type"/>
+        <xs:element name="eventThreads" type="uint32Type"/>
         <xs:element name="builtin" type="builtinAttributesType"/>
         <xs:element name="port" type="portType"/>
         <xs:element name="userData" type="octetVectorType"/>
@@ -352,6 +356,30 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
         if (XMLP_ret::XML_OK != getXMLUint(p_aux, &participant_node.get()->rtps.listenSocketBufferSize, ident))
             return XMLP_ret::XML_ERROR;
     }
+    // listenWorkerThreads - uint32Type
+    if (nullptr != (p_aux = p_element->FirstChildElement(LIST_WORKER_THREADS)))
+    {
+        if (XMLP_ret::XML_OK != getXMLUint(p_aux, &participant_node.get()->rtps.listenWorkerThreads, ident))
+            return XMLP_ret::XML_ERROR;
+    }
+    // listenBufferPoolSize - uint32Type
+    if (nullptr != (p_aux = p_element->FirstChildElement(LIST_BUF_POOL_SIZE)))
+    {
+        if (XMLP_ret::XML_OK != getXMLUint(p_aux, &participant_node.get()->rtps.listenBufferPoolSize, ident))
+            return XMLP_ret::XML_ERROR;
+    }
+    // asyncSendThreads - uint32Type
+    if (nullptr != (p_aux = p_element->FirstChildElement(ASYNC_SEND_THREADS)))
+    {
+        if (XMLP_ret::XML_OK != getXMLUint(p_aux, &participant_node.get()->rtps.asyncSendThreads, ident))
+            return XMLP_ret::XML_ERROR;
+    }
+    // eventThreads - uint32Type
+    if (nullptr != (p_aux = p_element->FirstChildElement(EVENT_THREADS)))
+    {
+        if (XMLP_ret::XML_OK != getXMLUint(p_aux, &participant_node.get()->rtps.eventThreads, ident))
+            return XMLP_ret::XML_ERROR;
+    }
     // builtin
     if (nullptr != (p_aux = p_element->FirstChildElement(BUILTIN)))
     {
@@ -43,6 +43,10 @@ const char* DEF_OUT_LOC_LIST= "defaultOutLocatorList";
 const char* DEF_SEND_PORT = "defaultSendPort";
 const char* SEND_SOCK_BUF_SIZE = "sendSocketBufferSize";
 const char* LIST_SOCK_BUF_SIZE = "listenSocketBufferSize";
+const char* LIST_WORKER_THREADS = "listenWorkerThreads";
+const char* LIST_BUF_POOL_SIZE = "listenBufferPoolSize";
+const char* ASYNC_SEND_THREADS = "asyncSendThreads";
+const char* EVENT_THREADS = "eventThreads";
 const char* BUILTIN = "builtin";
 const char* PORT = "port";
 const char* USER_DATA = "userData";
@@ -77,6 +81,7 @@ const char* VALUE = "value";
 const char* PROPAGATE = "propagate";
 const char* PREALLOCATED = "PREALLOCATED";
 const char* PREALLOCATED_WITH_REALLOC = "PREALLOCATED_WITH_REALLOC";
+const char* PREALLOCATED_WITH_ARENA = "PREALLOCATED_WITH_ARENA";
 const char* DYNAMIC = "DYNAMIC";
 const char* LOCATOR = "locator";
 const char* KIND = "kind";
@@ -86,6 +91,7 @@ const char* UDPv4 = "UDPv4";
 const char* UDPv6 = "UDPv6";
 const char* INIT_ACKNACK_DELAY = "initialAcknackDelay";
 const char* HEARTB_RESP_DELAY = "heartbeatResponseDelay";
+const char* FRAG_SAMPLE_TIMEOUT = "fragmentedSampleTimeout";
 const char* INIT_HEARTB_DELAY = "initialHeartbeatDelay";
 const char* HEARTB_PERIOD = "heartbeatPeriod";
 const char* NACK_RESP_DELAY = "nackResponseDelay";
@@ -117,9 +123,20 @@ const char* PARTITION = "partition";
 const char* TOPIC_DATA = "topicData";
 const char* GROUP_DATA = "groupData";
 const char* PUB_MODE = "publishMode";
+const char* FRAG_SCHEDULING = "fragmentScheduling";
+const char* SLOW_READER = "slowReader";
 
 const char* SYNCHRONOUS = "SYNCHRONOUS";
 const char* ASYNCHRONOUS = "ASYNCHRONOUS";
+const char* PRIORITY = "priority";
+const char* LOW_PRIORITY = "LOW";
+const char* NORMAL_PRIORITY = "NORMAL";
+const char* HIGH_PRIORITY = "HIGH";
+const char* SEQUENTIAL = "SEQUENTIAL";
+const char* INTERLEAVED = "INTERLEAVED";
+const char* BYTES_PER_READER = "bytesPerReaderPerPeriod";
+const char* BLOCK = "BLOCK";
+const char* DROP_SLOWEST = "DROP_SLOWEST";
 const char* NAMES = "names";
 const char* INSTANCE = "INSTANCE";
 const char* GROUP = "GROUP";
@@ -16,6 +16,7 @@
 #include "types/StringType.h"
 #include "types/Data64kbType.h"
 #include "types/Data1mbType.h"
+#include "types/FixedSizedType.h"
 
 #include <thread>
 
@@ -117,6 +118,9 @@ using namespace eprosima::fastrtps::rtps;
 #elif defined(DYNAMIC_RESERVE_MEMORY_MODE_TEST)
 #define MEMORY_MODE_STRING DynMem
 #define MEMORY_MODE_BYTE 2
+#elif defined(PREALLOCATED_WITH_ARENA_MEMORY_MODE_TEST)
+#define MEMORY_MODE_STRING ArenaMem
+#define MEMORY_MODE_BYTE 4
 #else
 #define MEMORY_MODE_STRING PreallocMem
 #define MEMORY_MODE_BYTE 3
@@ -269,6 +273,45 @@ std::list<Data1mb> default_data300kb_mix_data_generator(size_t max = 0)
     return returnedValue;
 }
 
+std::list<FixedSized> default_fixed_sized_data_generator(size_t max = 0)
+{
+    uint16_t index = 1;
+    size_t maximum = max ? max : 10;
+    std::list<FixedSized> returnedValue(maximum);
+
+    std::generate(returnedValue.begin(), returnedValue.end(), [&index] {
+            FixedSized data;
+            data.index = index;
+            for(size_t i = 0; i < data.data.size(); ++i)
+            {
+                data.data[i] = static_cast<uint8_t>(i + index);
+            }
+            ++index;
+            return data;
+            });
+
+    return returnedValue;
+}
+
+std::list<FixedSized> default_keyed_fixed_sized_data_generator(uint16_t instances, uint16_t samples_per_instance)
+{
+    std::list<FixedSized> returnedValue;
+
+    // Samples of the instances are interleaved, and data[0] tells the samples of an instance apart.
+    for(uint16_t sample = 0; sample < samples_per_instance; ++sample)
+    {
+        for(uint16_t instance = 1; instance <= instances; ++instance)
+        {
+            FixedSized data;
+            data.index = instance;
+            data.data.fill(static_cast<uint8_t>(sample));
+            returnedValue.push_back(data);
+        }
+    }
+
+    return returnedValue;
+}
+
 /****** Auxiliary lambda functions  ******/
 const std::function<void(const HelloWorld&)>  default_helloworld_print = [](const HelloWorld& hello)
 {
@@ -720,6 +763,38 @@ BLACKBOXTEST(BlackBox, AsyncPubSubAsNonReliableHelloworld)
     reader.block_for_at_least(2);
 }
 
+BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldTakeBatch)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        take_batch(8).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_helloworld_data_generator();
+
+    reader.startReception(data);
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+}
+
 BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworld)
 {
     PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
@@ -835,6 +910,158 @@ BLACKBOXTEST(BlackBox, ParticipantRemoval)
     reader.wait_participant_undiscovery();
 }
 
+BLACKBOXTEST(BlackBox, PubSubAsReliableLoanedFixedSized)
+{
+    PubSubReader<FixedSizedType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<FixedSizedType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(10).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        take_loaned(true).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(10).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_fixed_sized_data_generator();
+
+    reader.startReception(data);
+
+    // Send data writing the samples directly into loans.
+    writer.send_loaned(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableKeyedReadTakeInstance)
+{
+    PubSubReader<KeyedFixedSizedType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<KeyedFixedSizedType> writer(TEST_TOPIC_NAME);
+
+    reader.topic_kind(WITH_KEY).history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.topic_kind(WITH_KEY).history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_keyed_fixed_sized_data_generator(3, 2);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(reader.block_for_unread_count(6));
+
+    Subscriber* subscriber = reader.get_native_subscriber();
+    KeyedFixedSizedType type;
+    FixedSized key_sample;
+    key_sample.index = 2;
+    InstanceHandle_t handle;
+    ASSERT_TRUE(type.getKey(&key_sample, &handle));
+
+    std::vector<FixedSized> samples(10);
+    std::vector<void*> buffers;
+    for(auto& sample : samples)
+        buffers.push_back(&sample);
+    std::vector<SampleInfo_t> infos(samples.size());
+
+    // Only the samples of the instance are read, in order.
+    ASSERT_EQ(subscriber->read_instance(buffers.data(), infos.data(), samples.size(), handle), 2u);
+    for(size_t i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(samples[i].index, 2u);
+        ASSERT_EQ(samples[i].data[0], i);
+        ASSERT_EQ(infos[i].iHandle, handle);
+    }
+    ASSERT_EQ(subscriber->getUnreadCount(), 4u);
+
+    // The samples read are only returned when the sample state mask allows it.
+    ASSERT_EQ(subscriber->read_instance(buffers.data(), infos.data(), samples.size(), handle,
+                NOT_READ_SAMPLE_STATE), 0u);
+    ASSERT_EQ(subscriber->read_instance(buffers.data(), infos.data(), samples.size(), handle,
+                READ_SAMPLE_STATE), 2u);
+    ASSERT_EQ(subscriber->read_instance(buffers.data(), infos.data(), samples.size(), handle,
+                ANY_SAMPLE_STATE, NOT_ALIVE_DISPOSED_INSTANCE_STATE), 0u);
+
+    // Taking the instance removes its samples and leaves the other instances untouched.
+    ASSERT_EQ(subscriber->take_instance(buffers.data(), infos.data(), samples.size(), handle), 2u);
+    ASSERT_EQ(subscriber->take_instance(buffers.data(), infos.data(), samples.size(), handle), 0u);
+    ASSERT_EQ(subscriber->read(buffers.data(), infos.data(), samples.size(), NOT_READ_SAMPLE_STATE), 4u);
+    for(size_t i = 0; i < 4; ++i)
+        ASSERT_NE(samples[i].index, 2u);
+    ASSERT_EQ(subscriber->getUnreadCount(), 0u);
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableKeyedReadTakeNextInstance)
+{
+    PubSubReader<KeyedFixedSizedType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<KeyedFixedSizedType> writer(TEST_TOPIC_NAME);
+
+    reader.topic_kind(WITH_KEY).history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.topic_kind(WITH_KEY).history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_keyed_fixed_sized_data_generator(3, 2);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(reader.block_for_unread_count(6));
+
+    Subscriber* subscriber = reader.get_native_subscriber();
+    std::vector<FixedSized> samples(10);
+    std::vector<void*> buffers;
+    for(auto& sample : samples)
+        buffers.push_back(&sample);
+    std::vector<SampleInfo_t> infos(samples.size());
+
+    // Instances are visited in order of their handles, one per call.
+    InstanceHandle_t previous = c_InstanceHandle_Unknown;
+    for(uint16_t instance = 1; instance <= 3; ++instance)
+    {
+        ASSERT_EQ(subscriber->read_next_instance(buffers.data(), infos.data(), samples.size(), previous), 2u);
+        ASSERT_EQ(samples[0].index, instance);
+        ASSERT_EQ(samples[1].index, instance);
+        ASSERT_EQ(infos[0].iHandle, infos[1].iHandle);
+        previous = infos[0].iHandle;
+    }
+    ASSERT_EQ(subscriber->read_next_instance(buffers.data(), infos.data(), samples.size(), previous), 0u);
+    ASSERT_EQ(subscriber->getUnreadCount(), 0u);
+
+    // Every sample has been read, so no instance has samples in the NOT_READ state.
+    ASSERT_EQ(subscriber->take_next_instance(buffers.data(), infos.data(), samples.size(),
+                c_InstanceHandle_Unknown, NOT_READ_SAMPLE_STATE), 0u);
+
+    previous = c_InstanceHandle_Unknown;
+    for(uint16_t instance = 1; instance <= 3; ++instance)
+    {
+        ASSERT_EQ(subscriber->take_next_instance(buffers.data(), infos.data(), samples.size(), previous,
+                    READ_SAMPLE_STATE), 2u);
+        ASSERT_EQ(samples[0].index, instance);
+        previous = infos[0].iHandle;
+    }
+    ASSERT_EQ(subscriber->take_next_instance(buffers.data(), infos.data(), samples.size(),
+                c_InstanceHandle_Unknown), 0u);
+}
+
 BLACKBOXTEST(BlackBox, PubSubAsReliableData64kb)
 {
     PubSubReader<Data64kbType> reader(TEST_TOPIC_NAME);
@@ -5084,6 +5311,80 @@ BLACKBOXTEST(BlackBox, PubSubAsReliableVolatilePubRemoveWithoutSubs)
     ASSERT_FALSE(writer.remove_all_changes(&number_of_changes_removed));
 }
 
+BLACKBOXTEST(BlackBox, PubSubAsReliableVolatileTrimsAckedChanges)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(10).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(10).
+        durability_kind(eprosima::fastrtps::VOLATILE_DURABILITY_QOS).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_helloworld_data_generator();
+
+    reader.startReception(data);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    reader.block_for_all();
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(5)));
+
+    // The changes acknowledged by every reader have already been removed from the history.
+    size_t number_of_changes_removed = 0;
+    ASSERT_FALSE(writer.remove_all_changes(&number_of_changes_removed));
+    ASSERT_EQ(number_of_changes_removed, 0u);
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableKeepAllDropSlowestReader)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubReader<HelloWorldType> slow_reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        heartbeatResponseDelay(0, 4294967 * 10).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    // The slow reader never acknowledges anything.
+    auto testTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+    testTransport->dropAckNackMessagesPercentage = 100;
+    slow_reader.disable_builtin_transport().add_user_transport_to_pparams(testTransport).
+        history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(slow_reader.isInitialized());
+
+    writer.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        resource_limits_allocated_samples(5).resource_limits_max_samples(5).
+        heartbeat_period_seconds(0).heartbeat_period_fraction(4294967 * 20).
+        slow_reader_kind(eprosima::fastrtps::DROP_SLOWEST_READER).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    writer.waitDiscovery(2);
+    reader.waitDiscovery();
+    slow_reader.waitDiscovery();
+
+    auto data = default_helloworld_data_generator(20);
+
+    reader.startReception(data);
+    // With a full history the writer stops waiting for the slow reader instead of blocking.
+    writer.send(data, 100);
+    ASSERT_TRUE(data.empty());
+    // The reader keeping up still receives every sample reliably.
+    ASSERT_EQ(reader.block_for_all(std::chrono::seconds(10)), 20u);
+}
+
 // Test created to check bug #3087 (Github #230)
 BLACKBOXTEST(BlackBox, AsyncPubSubAsNonReliableVolatileHelloworld)
 {
@@ -34,7 +34,12 @@
 
 #include <string>
 #include <list>
+#include <vector>
+#include <memory>
+#include <functional>
 #include <condition_variable>
+#include <thread>
+#include <chrono>
 #include <asio.hpp>
 #include <gtest/gtest.h>
 
@@ -142,7 +147,7 @@ class PubSubReader
         PubSubReader(const std::string& topic_name) : participant_listener_(*this), listener_(*this),
         participant_(nullptr), subscriber_(nullptr), topic_name_(topic_name), initialized_(false),
         matched_(0), participant_matched_(0), receiving_(false), current_received_count_(0),
-        number_samples_expected_(0), discovery_result_(false), onDiscovery_(nullptr)
+        number_samples_expected_(0), discovery_result_(false), onDiscovery_(nullptr), take_loaned_(false), take_batch_(0)
 #if HAVE_SECURITY
         , authorized_(0), unauthorized_(0)
 #endif
@@ -155,6 +160,8 @@ class PubSubReader
 
 #if defined(PREALLOCATED_WITH_REALLOC_MEMORY_MODE_TEST)
             subscriber_attr_.historyMemoryPolicy = eprosima::fastrtps::rtps::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+#elif defined(PREALLOCATED_WITH_ARENA_MEMORY_MODE_TEST)
+            subscriber_attr_.historyMemoryPolicy = eprosima::fastrtps::rtps::PREALLOCATED_WITH_ARENA_MEMORY_MODE;
 #elif defined(DYNAMIC_RESERVE_MEMORY_MODE_TEST)
             subscriber_attr_.historyMemoryPolicy = eprosima::fastrtps::rtps::DYNAMIC_RESERVE_MEMORY_MODE;
 #else
@@ -268,6 +275,19 @@ class PubSubReader
                     return current_received_count_;
                 }
 
+        bool block_for_unread_count(uint64_t unread_count)
+        {
+            // Samples are not notified when the reader is not receiving, so the history is polled.
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while(subscriber_->getUnreadCount() < unread_count)
+            {
+                if(std::chrono::steady_clock::now() > deadline)
+                    return false;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            return true;
+        }
+
         void waitDiscovery()
         {
             std::unique_lock<std::mutex> lock(mutexDiscovery_);
@@ -337,6 +357,24 @@ class PubSubReader
             return *this;
         }
 
+        PubSubReader& take_loaned(bool take_loaned)
+        {
+            take_loaned_ = take_loaned;
+            return *this;
+        }
+
+        PubSubReader& take_batch(size_t batch_size)
+        {
+            take_batch_ = batch_size;
+            return *this;
+        }
+
+        PubSubReader& topic_kind(const eprosima::fastrtps::rtps::TopicKind_t kind)
+        {
+            subscriber_attr_.topic.topicKind = kind;
+            return *this;
+        }
+
         PubSubReader& history_kind(const eprosima::fastrtps::HistoryQosPolicyKind kind)
         {
             subscriber_attr_.topic.historyQos.kind = kind;
@@ -539,33 +577,67 @@ class PubSubReader
             return participant_guid_;
         }
 
+        eprosima::fastrtps::Subscriber* get_native_subscriber() const
+        {
+            return subscriber_;
+        }
+
     private:
 
         void receive_one(eprosima::fastrtps::Subscriber* subscriber, bool& returnedValue)
         {
             returnedValue = false;
+
+            if(take_batch_ > 0)
+            {
+                std::vector<type> data(take_batch_);
+                std::vector<void*> samples;
+                for(auto& sample : data)
+                    samples.push_back(&sample);
+                std::vector<eprosima::fastrtps::SampleInfo_t> infos(take_batch_);
+
+                size_t taken = subscriber->take(samples.data(), infos.data(), take_batch_);
+                returnedValue = taken > 0;
+
+                for(size_t i = 0; i < taken; ++i)
+                    check_sample(data[i], infos[i]);
+
+                return;
+            }
+
             type data;
             eprosima::fastrtps::SampleInfo_t info;
+            void* loaned = nullptr;
 
-            if(subscriber->takeNextData((void*)&data, &info))
+            if(take_loaned_ ? subscriber->take_loaned(loaned, &info) : subscriber->takeNextData((void*)&data, &info))
             {
                 returnedValue = true;
 
-                std::unique_lock<std::mutex> lock(mutex_);
+                // Loaned samples are checked in place.
+                std::unique_ptr<void, std::function<void(void*)>> loan(loaned,
+                        [subscriber](void* sample) { subscriber->return_loan(sample); });
+                const type& sample = loaned != nullptr ? *static_cast<const type*>(loaned) : data;
+
+                check_sample(sample, info);
+            }
+        }
 
-                // Check order of changes.
-                ASSERT_LT(last_seq, info.sample_identity.sequence_number());
-                last_seq = info.sample_identity.sequence_number();
+        void check_sample(const type& sample, const eprosima::fastrtps::SampleInfo_t& info)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
 
-                if(info.sampleKind == eprosima::fastrtps::rtps::ALIVE)
-                {
-                    auto it = std::find(total_msgs_.begin(), total_msgs_.end(), data);
-                    ASSERT_NE(it, total_msgs_.end());
-                    total_msgs_.erase(it);
-                    ++current_received_count_;
-                    default_receive_print<type>(data);
-                    cv_.notify_one();
-                }
+            // Check order of changes.
+            ASSERT_LT(last_seq, info.sample_identity.sequence_number());
+            last_seq = info.sample_identity.sequence_number();
+
+            if(info.sampleKind == eprosima::fastrtps::rtps::ALIVE)
+            {
+                auto it = std::find(total_msgs_.begin(), total_msgs_.end(), sample);
+                ASSERT_NE(it, total_msgs_.end());
+                total_msgs_.erase(it);
+                ++current_received_count_;
+                default_receive_print<type>(sample);
+                cv_.notify_one();
             }
         }
 
@@ -640,6 +712,9 @@ class PubSubReader
 
         std::function<bool(const eprosima::fastrtps::ParticipantDiscoveryInfo& info)> onDiscovery_;
 
+        bool take_loaned_;
+        size_t take_batch_;
+
 #if HAVE_SECURITY
         std::mutex mutexAuthentication_;
         std::condition_variable cvAuthentication_;
@@ -249,6 +249,8 @@ class PubSubWriter
 
 #if defined(PREALLOCATED_WITH_REALLOC_MEMORY_MODE_TEST)
         publisher_attr_.historyMemoryPolicy = eprosima::fastrtps::rtps::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+#elif defined(PREALLOCATED_WITH_ARENA_MEMORY_MODE_TEST)
+        publisher_attr_.historyMemoryPolicy = eprosima::fastrtps::rtps::PREALLOCATED_WITH_ARENA_MEMORY_MODE;
 #elif defined(DYNAMIC_RESERVE_MEMORY_MODE_TEST)
         publisher_attr_.historyMemoryPolicy = eprosima::fastrtps::rtps::DYNAMIC_RESERVE_MEMORY_MODE;
 #else
@@ -337,18 +339,39 @@ class PubSubWriter
         }
     }
 
+    void send_loaned(std::list<type>& msgs)
+    {
+        auto it = msgs.begin();
+
+        while(it != msgs.end())
+        {
+            void* sample = nullptr;
+            if(!publisher_->loan_sample(sample))
+                break;
+
+            *static_cast<type*>(sample) = *it;
+            if(publisher_->write(sample))
+            {
+                default_send_print<type>(*it);
+                it = msgs.erase(it);
+            }
+            else
+                break;
+        }
+    }
+
     bool send_sample(type& msg)
     {
         return publisher_->write((void*)&msg);
     }
 
-    void waitDiscovery()
+    void waitDiscovery(unsigned int expected_match = 1)
     {
         std::unique_lock<std::mutex> lock(mutexDiscovery_);
 
         std::cout << "Writer is waiting discovery..." << std::endl;
 
-        cv_.wait(lock, [&](){return matched_ != 0;});
+        cv_.wait(lock, [&](){return matched_ >= expected_match;});
 
         std::cout << "Writer discovery finished..." << std::endl;
     }
@@ -446,6 +469,12 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& slow_reader_kind(const eprosima::fastrtps::SlowReaderQosPolicyKind kind)
+    {
+        publisher_attr_.qos.m_slowReader.kind = kind;
+        return *this;
+    }
+
     PubSubWriter& add_throughput_controller_descriptor_to_pparams(uint32_t bytesPerPeriod, uint32_t periodInMs)
     {
         eprosima::fastrtps::rtps::ThroughputControllerDescriptor descriptor {bytesPerPeriod, periodInMs};
@@ -460,6 +489,12 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& topic_kind(const eprosima::fastrtps::rtps::TopicKind_t kind)
+    {
+        publisher_attr_.topic.topicKind = kind;
+        return *this;
+    }
+
     PubSubWriter& history_kind(const eprosima::fastrtps::HistoryQosPolicyKind kind)
     {
         publisher_attr_.topic.historyQos.kind = kind;
@@ -92,6 +92,8 @@ class RTPSAsSocketReader
 
 #if defined(PREALLOCATED_WITH_REALLOC_MEMORY_MODE_TEST)
             hattr_.memoryPolicy = eprosima::fastrtps::rtps::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+#elif defined(PREALLOCATED_WITH_ARENA_MEMORY_MODE_TEST)
+            hattr_.memoryPolicy = eprosima::fastrtps::rtps::PREALLOCATED_WITH_ARENA_MEMORY_MODE;
 #elif defined(DYNAMIC_RESERVE_MEMORY_MODE_TEST)
             hattr_.memoryPolicy = eprosima::fastrtps::rtps::DYNAMIC_RESERVE_MEMORY_MODE;
 #else
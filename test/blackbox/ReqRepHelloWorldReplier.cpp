@@ -40,6 +40,9 @@ ReqRepHelloWorldReplier::ReqRepHelloWorldReplier(): request_listener_(*this), re
 #if defined(PREALLOCATED_WITH_REALLOC_MEMORY_MODE_TEST)
             sattr.historyMemoryPolicy = PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
             puattr.historyMemoryPolicy = PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+#elif defined(PREALLOCATED_WITH_ARENA_MEMORY_MODE_TEST)
+            sattr.historyMemoryPolicy = PREALLOCATED_WITH_ARENA_MEMORY_MODE;
+            puattr.historyMemoryPolicy = PREALLOCATED_WITH_ARENA_MEMORY_MODE;
 #elif defined(DYNAMIC_RESERVE_MEMORY_MODE_TEST)
             sattr.historyMemoryPolicy = DYNAMIC_RESERVE_MEMORY_MODE;
             puattr.historyMemoryPolicy = DYNAMIC_RESERVE_MEMORY_MODE;
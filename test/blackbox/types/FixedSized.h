@@ -0,0 +1,40 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FixedSized.h
+ *
+ */
+
+#ifndef _FIXEDSIZED_H_
+#define _FIXEDSIZED_H_
+
+#include <array>
+#include <cstdint>
+
+/*!
+ * @brief Plain structure, whose memory representation is the same as its CDR representation.
+ */
+struct FixedSized
+{
+    uint16_t index;
+    std::array<uint8_t, 4094> data;
+
+    bool operator==(const FixedSized& x) const
+    {
+        return index == x.index && data == x.data;
+    }
+};
+
+#endif // _FIXEDSIZED_H_
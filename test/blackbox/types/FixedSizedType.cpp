@@ -0,0 +1,98 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FixedSizedType.cpp
+ *
+ */
+
+#include "FixedSizedType.h"
+
+#include <cstring>
+
+using namespace eprosima::fastrtps::rtps;
+
+static const uint16_t host_encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+
+FixedSizedType::FixedSizedType()
+{
+    setName("FixedSizedType");
+    m_typeSize = (uint32_t)sizeof(FixedSized) + 4 /*encapsulation*/;
+    m_isGetKeyDefined = false;
+}
+
+FixedSizedType::~FixedSizedType()
+{
+}
+
+bool FixedSizedType::serialize(void* data, SerializedPayload_t* payload)
+{
+    if(payload->max_size < m_typeSize)
+        return false;
+
+    payload->encapsulation = host_encapsulation;
+    payload->data[0] = 0;
+    payload->data[1] = static_cast<octet>(host_encapsulation);
+    payload->data[2] = 0;
+    payload->data[3] = 0;
+    memcpy(payload->data + 4, data, sizeof(FixedSized));
+    payload->length = m_typeSize;
+    return true;
+}
+
+bool FixedSizedType::deserialize(SerializedPayload_t* payload, void* data)
+{
+    if(payload->length != m_typeSize || payload->data[1] != host_encapsulation)
+        return false;
+
+    payload->encapsulation = host_encapsulation;
+    memcpy(data, payload->data + 4, sizeof(FixedSized));
+    return true;
+}
+
+std::function<uint32_t()> FixedSizedType::getSerializedSizeProvider(void* /*data*/)
+{
+    uint32_t size = m_typeSize;
+    return [size]() -> uint32_t { return size; };
+}
+
+void* FixedSizedType::createData()
+{
+    return (void*)new FixedSized();
+}
+
+void FixedSizedType::deleteData(void* data)
+{
+    delete((FixedSized*)data);
+}
+
+bool FixedSizedType::getKey(void* /*data*/, InstanceHandle_t* /*ihandle*/)
+{
+    return false;
+}
+
+KeyedFixedSizedType::KeyedFixedSizedType()
+{
+    setName("KeyedFixedSizedType");
+    m_isGetKeyDefined = true;
+}
+
+bool KeyedFixedSizedType::getKey(void* data, InstanceHandle_t* ihandle)
+{
+    const FixedSized* sample = static_cast<const FixedSized*>(data);
+    *ihandle = InstanceHandle_t();
+    ihandle->value[14] = static_cast<octet>(sample->index >> 8);
+    ihandle->value[15] = static_cast<octet>(sample->index & 0xFF);
+    return true;
+}
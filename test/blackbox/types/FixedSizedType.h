@@ -0,0 +1,58 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FixedSizedType.h
+ *
+ */
+
+#ifndef _FIXEDSIZED_TYPE_H_
+#define _FIXEDSIZED_TYPE_H_
+
+#include <fastrtps/TopicDataType.h>
+
+#include "FixedSized.h"
+
+/*!
+ * @brief TopicDataType of the plain type FixedSized, which is serialized copying its memory.
+ */
+class FixedSizedType : public eprosima::fastrtps::TopicDataType
+{
+    public:
+
+        typedef FixedSized type;
+
+        FixedSizedType();
+        virtual ~FixedSizedType();
+        bool serialize(void* data, eprosima::fastrtps::rtps::SerializedPayload_t* payload);
+        bool deserialize(eprosima::fastrtps::rtps::SerializedPayload_t* payload, void* data);
+        std::function<uint32_t()> getSerializedSizeProvider(void* data);
+        bool getKey(void* data, eprosima::fastrtps::rtps::InstanceHandle_t* ihandle);
+        void* createData();
+        void deleteData(void* data);
+        bool is_plain() const { return true; }
+};
+
+/*!
+ * @brief TopicDataType of the plain type FixedSized, keyed by its index.
+ */
+class KeyedFixedSizedType : public FixedSizedType
+{
+    public:
+
+        KeyedFixedSizedType();
+        bool getKey(void* data, eprosima::fastrtps::rtps::InstanceHandle_t* ihandle);
+};
+
+#endif // _FIXEDSIZED_TYPE_H_
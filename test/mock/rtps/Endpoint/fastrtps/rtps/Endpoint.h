@@ -19,6 +19,8 @@
 #ifndef _RTPS_ENDPOINT_H_
 #define _RTPS_ENDPOINT_H_
 
+#include <fastrtps/rtps/common/Statistics.h>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -28,6 +30,12 @@ class Endpoint
     public:
 
         virtual ~Endpoint() = default;
+
+        EndpointStatisticsCounters& statistics_counters() { return statistics_; }
+
+        EndpointStatistics get_statistics() const { return statistics_.snapshot(); }
+
+        EndpointStatisticsCounters statistics_;
 };
 
 } // namespace rtps
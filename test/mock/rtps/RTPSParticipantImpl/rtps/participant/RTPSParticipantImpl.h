@@ -56,7 +56,7 @@ class RTPSParticipantImpl
 
         RTPSParticipantImpl()
         {
-            events_.init_thread(this);
+            events_.init_thread();
         }
 
         MOCK_CONST_METHOD0(getRTPSParticipantAttributes, const RTPSParticipantAttributes&());
@@ -104,8 +104,6 @@ class RTPSParticipantImpl
 
         void set_endpoint_rtps_protection_supports(Endpoint* /*endpoint*/, bool /*support*/) {}
 
-        void ResourceSemaphoreWait() {}
-        void ResourceSemaphorePost() {}
 
         uint32_t getMaxMessageSize() const { return 65536; }
 
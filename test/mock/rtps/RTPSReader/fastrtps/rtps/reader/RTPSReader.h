@@ -20,6 +20,7 @@
 #define _RTPS_READER_RTPSREADER_H_
 
 #include <fastrtps/rtps/Endpoint.h>
+#include <fastrtps/rtps/attributes/ReaderAttributes.h>
 #include <fastrtps/rtps/history/ReaderHistory.h>
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
@@ -43,6 +44,12 @@ class RTPSReader : public Endpoint
 
         MOCK_CONST_METHOD0(getGuid, const GUID_t&());
 
+        MOCK_METHOD2(reserveCache, bool(CacheChange_t**, uint32_t));
+
+        MOCK_METHOD1(releaseCache, void(CacheChange_t*));
+
+        MOCK_METHOD0(remove_stale_fragmented_changes, size_t());
+
         ReaderHistory* getHistory()
         {
             getHistory_mock();
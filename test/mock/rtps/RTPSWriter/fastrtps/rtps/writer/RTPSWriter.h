@@ -45,6 +45,8 @@ class RTPSWriter : public Endpoint
         MOCK_METHOD3(new_change, CacheChange_t*(const std::function<uint32_t()>&,
             ChangeKind_t, InstanceHandle_t));
 
+        MOCK_METHOD0(send_any_unsent_changes, void());
+
         WriterHistory* history_;
 };
 
@@ -21,6 +21,8 @@
 
 #include <fastrtps/rtps/common/Guid.h>
 
+#include <string>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -31,9 +33,15 @@ class ReaderProxyData
 
         GUID_t guid() { return m_guid; }
 
+        void topicName(const std::string& topicName) { m_topicName = topicName; }
+
+        const std::string& topicName() const { return m_topicName; }
+
     private:
 
         GUID_t m_guid;
+
+        std::string m_topicName;
 };
 
 } // namespace rtps
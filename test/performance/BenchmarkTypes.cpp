@@ -0,0 +1,65 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BenchmarkTypes.cpp
+ *
+ */
+
+#include "BenchmarkTypes.h"
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+bool BenchmarkDataType::serialize(void*data,SerializedPayload_t* payload)
+{
+    BenchmarkType* bt = (BenchmarkType*)data;
+
+    if(bt->data.size() + 8 > payload->max_size)
+        return false;
+
+    *(uint32_t*)payload->data = bt->seqnum;
+    *(uint32_t*)(payload->data+4) = (uint32_t)bt->data.size();
+    memcpy(payload->data + 8, bt->data.data(), bt->data.size());
+    payload->length = (uint32_t)(8+bt->data.size());
+    return true;
+}
+
+bool BenchmarkDataType::deserialize(SerializedPayload_t* payload,void * data)
+{
+    BenchmarkType* bt = (BenchmarkType*)data;
+    bt->seqnum = *(uint32_t*)payload->data;
+    uint32_t siz = *(uint32_t*)(payload->data+4);
+    bt->data.assign(payload->data+8,payload->data+8+siz);
+    return true;
+}
+
+std::function<uint32_t()> BenchmarkDataType::getSerializedSizeProvider(void* data)
+{
+    return [data]() -> uint32_t
+    {
+        BenchmarkType *tdata = static_cast<BenchmarkType*>(data);
+        return (uint32_t)(sizeof(uint32_t) + sizeof(uint32_t) + tdata->data.size());
+    };
+}
+
+void* BenchmarkDataType::createData()
+{
+    return (void*)new BenchmarkType();
+}
+
+void BenchmarkDataType::deleteData(void* data)
+{
+    delete((BenchmarkType*)data);
+}
@@ -0,0 +1,60 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BenchmarkTypes.h
+ *
+ */
+
+#ifndef BENCHMARKTYPES_H_
+#define BENCHMARKTYPES_H_
+
+#include "fastrtps/fastrtps_all.h"
+
+class BenchmarkType
+{
+    public:
+
+        uint32_t seqnum;
+        std::vector<uint8_t> data;
+
+        BenchmarkType(): seqnum(0) {}
+
+        BenchmarkType(uint32_t number) :
+            seqnum(0), data(number,0) {}
+
+        ~BenchmarkType() {}
+};
+
+class BenchmarkDataType : public eprosima::fastrtps::TopicDataType
+{
+    public:
+        /**
+         * @param max_data_size Maximum size of the data of the samples.
+         */
+        BenchmarkDataType(uint32_t max_data_size)
+        {
+            setName("BenchmarkType");
+            m_typeSize = max_data_size + 8;
+            m_isGetKeyDefined = false;
+        };
+        ~BenchmarkDataType(){};
+        bool serialize(void*data, eprosima::fastrtps::rtps::SerializedPayload_t* payload);
+        bool deserialize(eprosima::fastrtps::rtps::SerializedPayload_t* payload,void * data);
+        std::function<uint32_t()> getSerializedSizeProvider(void* data);
+        void* createData();
+        void deleteData(void* data);
+};
+
+#endif /* BENCHMARKTYPES_H_ */
@@ -0,0 +1,444 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file Benchmarks.cpp
+ *
+ */
+
+#include "Benchmarks.h"
+#include "BenchmarkTypes.h"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/publisher/PublisherListener.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/transport/test_UDPv4Transport.h>
+#include <fastrtps/transport/test_UDPv4TransportDescriptor.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+typedef std::chrono::steady_clock Clock;
+
+//! Biggest sample sent synchronously. Bigger ones have to be fragmented by an asynchronous publisher.
+static const uint32_t max_sync_sample_size = 64000;
+
+//! Packets kept in the drop log of the test transport, used to count the drops.
+static const uint32_t max_logged_drops = 100000;
+
+static double elapsed_ms(const Clock::time_point& from, const Clock::time_point& to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+/**
+ * Counts the matches notified to publishers and subscribers.
+ */
+class MatchCounter : public PublisherListener, public SubscriberListener
+{
+    public:
+
+        MatchCounter() : publications_(0), subscriptions_(0) {}
+
+        void onPublicationMatched(Publisher* /*pub*/, MatchingInfo& info)
+        {
+            count(publications_, info);
+        }
+
+        void onSubscriptionMatched(Subscriber* /*sub*/, MatchingInfo& info)
+        {
+            count(subscriptions_, info);
+        }
+
+        //! Waits until there are the given matches of each kind.
+        bool wait(uint32_t publications, uint32_t subscriptions, const Clock::time_point& deadline)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return cv_.wait_until(lock, deadline, [&]()
+                    {
+                        return publications_ >= publications && subscriptions_ >= subscriptions;
+                    });
+        }
+
+    private:
+
+        void count(uint32_t& counter, const MatchingInfo& info)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(info.status == MATCHED_MATCHING)
+                ++counter;
+            else if(counter > 0)
+                --counter;
+            cv_.notify_all();
+        }
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        uint32_t publications_;
+        uint32_t subscriptions_;
+};
+
+/**
+ * Takes every sample received by a subscriber, keeping the count and the time of the last one.
+ */
+class ReceptionCounter : public MatchCounter
+{
+    public:
+
+        ReceptionCounter() : received_(0) {}
+
+        void onNewDataMessage(Subscriber* sub)
+        {
+            BenchmarkType sample;
+            SampleInfo_t info;
+
+            while(sub->takeNextData(&sample, &info))
+            {
+                if(info.sampleKind == ALIVE)
+                {
+                    std::lock_guard<std::mutex> lock(reception_mutex_);
+                    ++received_;
+                    last_reception_ = Clock::now();
+                    reception_cv_.notify_all();
+                }
+            }
+        }
+
+        //! Waits until the given number of samples have been received.
+        bool wait_samples(uint64_t samples, const Clock::time_point& deadline)
+        {
+            std::unique_lock<std::mutex> lock(reception_mutex_);
+            return reception_cv_.wait_until(lock, deadline, [&]() { return received_ >= samples; });
+        }
+
+        uint64_t received()
+        {
+            std::lock_guard<std::mutex> lock(reception_mutex_);
+            return received_;
+        }
+
+        Clock::time_point last_reception()
+        {
+            std::lock_guard<std::mutex> lock(reception_mutex_);
+            return last_reception_;
+        }
+
+    private:
+
+        std::mutex reception_mutex_;
+        std::condition_variable reception_cv_;
+        uint64_t received_;
+        Clock::time_point last_reception_;
+};
+
+/**
+ * Participants of a benchmark, removed when it finishes.
+ */
+class ParticipantSet
+{
+    public:
+
+        ParticipantSet(uint32_t domain, TopicDataType* type) : domain_(domain), type_(type) {}
+
+        ~ParticipantSet()
+        {
+            for(Participant* participant : participants_)
+                Domain::removeParticipant(participant);
+        }
+
+        Participant* create(const std::string& name,
+                std::shared_ptr<TransportDescriptorInterface> transport = nullptr)
+        {
+            ParticipantAttributes PParam;
+            PParam.rtps.builtin.domainId = domain_;
+            PParam.rtps.builtin.leaseDuration = c_TimeInfinite;
+            PParam.rtps.setName(name.c_str());
+
+            if(transport)
+            {
+                PParam.rtps.useBuiltinTransports = false;
+                PParam.rtps.userTransports.push_back(transport);
+            }
+
+            Participant* participant = Domain::createParticipant(PParam);
+            if(participant != nullptr)
+            {
+                participants_.push_back(participant);
+                Domain::registerType(participant, type_);
+            }
+            return participant;
+        }
+
+    private:
+
+        uint32_t domain_;
+        TopicDataType* type_;
+        std::vector<Participant*> participants_;
+};
+
+static PublisherAttributes publisher_attributes(const std::string& topic, uint32_t sample_size)
+{
+    PublisherAttributes Wparam;
+    Wparam.topic.topicDataType = "BenchmarkType";
+    Wparam.topic.topicKind = NO_KEY;
+    Wparam.topic.topicName = topic;
+    Wparam.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+    Wparam.historyMemoryPolicy = DYNAMIC_RESERVE_MEMORY_MODE;
+    Wparam.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    Wparam.times.heartbeatPeriod = TimeConv::MilliSeconds2Time_t(100);
+    Wparam.times.nackResponseDelay = TimeConv::MilliSeconds2Time_t(0);
+    Wparam.times.nackSupressionDuration = TimeConv::MilliSeconds2Time_t(0);
+
+    if(sample_size > max_sync_sample_size)
+        Wparam.qos.m_publishMode.kind = ASYNCHRONOUS_PUBLISH_MODE;
+
+    return Wparam;
+}
+
+static SubscriberAttributes subscriber_attributes(const std::string& topic)
+{
+    SubscriberAttributes Rparam;
+    Rparam.topic.topicDataType = "BenchmarkType";
+    Rparam.topic.topicKind = NO_KEY;
+    Rparam.topic.topicName = topic;
+    Rparam.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+    Rparam.historyMemoryPolicy = DYNAMIC_RESERVE_MEMORY_MODE;
+    Rparam.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    return Rparam;
+}
+
+Benchmarks::Benchmarks(uint32_t seed, uint32_t timeout_sec) : seed_(seed), timeout_sec_(timeout_sec)
+{
+}
+
+std::string Benchmarks::topic_name(const std::string& benchmark) const
+{
+    std::ostringstream topic;
+    topic << "Benchmark_" << benchmark << "_" << seed_;
+    return topic.str();
+}
+
+BenchmarkResult Benchmarks::discovery(uint32_t participants, uint32_t endpoints)
+{
+    BenchmarkResult result("discovery");
+    result.parameters.emplace_back("participants", participants);
+    result.parameters.emplace_back("endpoints_per_participant", endpoints);
+
+    BenchmarkDataType type(1024);
+    MatchCounter counter;
+    std::string topic = topic_name(result.name);
+    uint32_t total_endpoints = participants * endpoints;
+
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::seconds(timeout_sec_);
+    {
+        ParticipantSet set(seed_ % 230, &type);
+
+        for(uint32_t p = 0; p < participants; ++p)
+        {
+            Participant* participant = set.create("Benchmark_discovery");
+            if(participant == nullptr)
+                return result;
+
+            for(uint32_t e = 0; e < endpoints; ++e)
+            {
+                PublisherAttributes Wparam = publisher_attributes(topic, 0);
+                SubscriberAttributes Rparam = subscriber_attributes(topic);
+                if(Domain::createPublisher(participant, Wparam, &counter) == nullptr ||
+                        Domain::createSubscriber(participant, Rparam, &counter) == nullptr)
+                    return result;
+            }
+        }
+
+        auto created = Clock::now();
+        result.results.emplace_back("creation_ms", elapsed_ms(start, created));
+
+        result.completed = counter.wait(total_endpoints * total_endpoints, total_endpoints * total_endpoints, deadline);
+        if(result.completed)
+            result.results.emplace_back("time_to_full_match_ms", elapsed_ms(start, Clock::now()));
+    }
+
+    return result;
+}
+
+Benchmarks::DeliveryStats Benchmarks::deliver(const std::string& topic, uint32_t readers, uint32_t samples,
+        uint32_t sample_size, std::shared_ptr<TransportDescriptorInterface> writer_transport)
+{
+    DeliveryStats stats;
+    BenchmarkDataType type(sample_size);
+    MatchCounter writer_counter;
+    std::vector<std::unique_ptr<ReceptionCounter> > reader_counters;
+
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::seconds(timeout_sec_);
+
+    ParticipantSet set(seed_ % 230, &type);
+
+    for(uint32_t r = 0; r < readers; ++r)
+    {
+        reader_counters.emplace_back(new ReceptionCounter());
+        Participant* participant = set.create("Benchmark_reader");
+        SubscriberAttributes Rparam = subscriber_attributes(topic);
+        if(participant == nullptr ||
+                Domain::createSubscriber(participant, Rparam, reader_counters.back().get()) == nullptr)
+            return stats;
+    }
+
+    Participant* participant = set.create("Benchmark_writer", writer_transport);
+    PublisherAttributes Wparam = publisher_attributes(topic, sample_size);
+    Publisher* publisher = participant == nullptr ? nullptr :
+        Domain::createPublisher(participant, Wparam, &writer_counter);
+    if(publisher == nullptr)
+        return stats;
+
+    if(!writer_counter.wait(readers, 0, deadline))
+        return stats;
+    for(auto& counter : reader_counters)
+    {
+        if(!counter->wait(0, 1, deadline))
+            return stats;
+    }
+    auto matched = Clock::now();
+    stats.match_ms = elapsed_ms(start, matched);
+
+    BenchmarkType sample(sample_size);
+    for(uint32_t s = 0; s < samples; ++s)
+    {
+        sample.seqnum = s;
+        sample.data[0] = static_cast<uint8_t>(s);
+        publisher->write(&sample);
+    }
+
+    stats.completed = true;
+    auto last_reception = matched;
+    for(auto& counter : reader_counters)
+    {
+        stats.completed = counter->wait_samples(samples, deadline) && stats.completed;
+        stats.received += counter->received();
+        if(counter->last_reception() > last_reception)
+            last_reception = counter->last_reception();
+    }
+    stats.delivery_ms = elapsed_ms(matched, last_reception);
+
+    return stats;
+}
+
+void Benchmarks::add_delivery_results(BenchmarkResult& result, const DeliveryStats& stats, uint32_t readers,
+        uint32_t samples, uint32_t sample_size)
+{
+    result.completed = stats.completed;
+    result.results.emplace_back("time_to_match_ms", stats.match_ms);
+    result.results.emplace_back("delivery_ms", stats.delivery_ms);
+    result.results.emplace_back("received_samples", static_cast<double>(stats.received));
+    result.results.emplace_back("expected_samples", static_cast<double>(readers) * samples);
+
+    if(stats.completed && stats.delivery_ms > 0)
+    {
+        double seconds = stats.delivery_ms / 1000;
+        result.results.emplace_back("samples_per_second", stats.received / seconds);
+        result.results.emplace_back("megabits_per_second",
+                static_cast<double>(stats.received) * sample_size * 8 / 1e6 / seconds);
+    }
+}
+
+BenchmarkResult Benchmarks::fan_out(uint32_t readers, uint32_t samples, uint32_t sample_size)
+{
+    BenchmarkResult result("fan_out");
+    result.parameters.emplace_back("readers", readers);
+    result.parameters.emplace_back("samples", samples);
+    result.parameters.emplace_back("sample_size", sample_size);
+
+    DeliveryStats stats = deliver(topic_name(result.name), readers, samples, sample_size, nullptr);
+    add_delivery_results(result, stats, readers, samples, sample_size);
+    return result;
+}
+
+BenchmarkResult Benchmarks::large_sample(uint32_t samples, uint32_t sample_size)
+{
+    BenchmarkResult result("large_sample");
+    result.parameters.emplace_back("samples", samples);
+    result.parameters.emplace_back("sample_size", sample_size);
+
+    DeliveryStats stats = deliver(topic_name(result.name), 1, samples, sample_size, nullptr);
+    add_delivery_results(result, stats, 1, samples, sample_size);
+    if(stats.completed && samples > 0)
+        result.results.emplace_back("mean_ms_per_sample", stats.delivery_ms / samples);
+    return result;
+}
+
+BenchmarkResult Benchmarks::lossy_reliability(uint32_t samples, uint32_t sample_size, uint8_t drop_percentage)
+{
+    BenchmarkResult result("lossy_reliability");
+    result.parameters.emplace_back("samples", samples);
+    result.parameters.emplace_back("sample_size", sample_size);
+    result.parameters.emplace_back("drop_percentage", drop_percentage);
+
+    auto transport = std::make_shared<test_UDPv4TransportDescriptor>();
+    transport->dropDataMessagesPercentage = drop_percentage;
+    transport->dropDataFragMessagesPercentage = drop_percentage;
+    transport->dropLogLength = max_logged_drops;
+    test_UDPv4Transport::DropLog.clear();
+
+    DeliveryStats stats = deliver(topic_name(result.name), 1, samples, sample_size, transport);
+    add_delivery_results(result, stats, 1, samples, sample_size);
+    result.results.emplace_back("dropped_messages", static_cast<double>(test_UDPv4Transport::DropLog.size()));
+    test_UDPv4Transport::DropLog.clear();
+    return result;
+}
+
+static void write_members(std::ostream& output, const std::vector<std::pair<std::string, double> >& members)
+{
+    output << "{";
+    for(size_t i = 0; i < members.size(); ++i)
+    {
+        output << (i == 0 ? "" : ", ") << "\"" << members[i].first << "\": " << members[i].second;
+    }
+    output << "}";
+}
+
+void Benchmarks::write_json(std::ostream& output, const std::vector<BenchmarkResult>& results)
+{
+    std::ios::fmtflags flags = output.flags();
+    output << std::fixed << std::setprecision(3);
+
+    output << "{" << std::endl << "  \"benchmarks\": [" << std::endl;
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        output << "    {" << std::endl;
+        output << "      \"name\": \"" << result.name << "\"," << std::endl;
+        output << "      \"completed\": " << (result.completed ? "true" : "false") << "," << std::endl;
+        output << "      \"parameters\": ";
+        write_members(output, result.parameters);
+        output << "," << std::endl << "      \"results\": ";
+        write_members(output, result.results);
+        output << std::endl << "    }" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    output << "  ]" << std::endl << "}" << std::endl;
+
+    output.flags(flags);
+}
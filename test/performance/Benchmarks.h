@@ -0,0 +1,98 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file Benchmarks.h
+ *
+ */
+
+#ifndef BENCHMARKS_H_
+#define BENCHMARKS_H_
+
+#include <fastrtps/transport/TransportInterface.h>
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Outcome of a benchmark: the parameters it was run with and the values it measured.
+ */
+struct BenchmarkResult
+{
+    BenchmarkResult(const std::string& benchmark_name) : name(benchmark_name), completed(false) {}
+
+    std::string name;
+    //! False if the benchmark timed out or its entities could not be created.
+    bool completed;
+    std::vector<std::pair<std::string, double> > parameters;
+    std::vector<std::pair<std::string, double> > results;
+};
+
+/**
+ * Benchmarks run in a single process, creating every participant they need.
+ * Each one runs on its own domain and topic, derived from the seed, so they do not interfere with other runs.
+ */
+class Benchmarks
+{
+    public:
+
+        Benchmarks(uint32_t seed, uint32_t timeout_sec);
+
+        /**
+         * Creates participants x endpoints publishers and as many subscribers, all on the same topic,
+         * and measures the time until every publisher has matched every subscriber.
+         */
+        BenchmarkResult discovery(uint32_t participants, uint32_t endpoints);
+
+        //! Measures the delivery of reliable samples from one publisher to a number of readers, each on its own participant.
+        BenchmarkResult fan_out(uint32_t readers, uint32_t samples, uint32_t sample_size);
+
+        //! Measures the delivery of reliable samples large enough to be fragmented.
+        BenchmarkResult large_sample(uint32_t samples, uint32_t sample_size);
+
+        //! Measures the recovery of reliable samples when the writer drops a percentage of its DATA and DATA_FRAG.
+        BenchmarkResult lossy_reliability(uint32_t samples, uint32_t sample_size, uint8_t drop_percentage);
+
+        //! Writes the results as a JSON document.
+        static void write_json(std::ostream& output, const std::vector<BenchmarkResult>& results);
+
+    private:
+
+        struct DeliveryStats
+        {
+            DeliveryStats() : completed(false), match_ms(0), delivery_ms(0), received(0) {}
+
+            bool completed;
+            double match_ms;
+            double delivery_ms;
+            uint64_t received;
+        };
+
+        DeliveryStats deliver(const std::string& topic, uint32_t readers, uint32_t samples, uint32_t sample_size,
+                std::shared_ptr<eprosima::fastrtps::rtps::TransportDescriptorInterface> writer_transport);
+
+        void add_delivery_results(BenchmarkResult& result, const DeliveryStats& stats, uint32_t readers,
+                uint32_t samples, uint32_t sample_size);
+
+        std::string topic_name(const std::string& benchmark) const;
+
+        uint32_t seed_;
+        uint32_t timeout_sec_;
+};
+
+#endif /* BENCHMARKS_H_ */
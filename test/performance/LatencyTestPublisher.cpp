@@ -20,6 +20,7 @@
 #include "LatencyTestPublisher.h"
 #include "fastrtps/log/Log.h"
 #include "fastrtps/log/Colors.h"
+#include "fastrtps/transport/SharedMemTransportDescriptor.h"
 #include <numeric>
 #include <cmath>
 #include <fstream>
@@ -71,7 +72,8 @@ LatencyTestPublisher::~LatencyTestPublisher()
 
 
 bool LatencyTestPublisher::init(int n_sub, int n_sam, bool reliable, uint32_t pid, bool hostname, bool export_csv,
-        const PropertyPolicy& part_property_policy, const PropertyPolicy& property_policy, bool large_data)
+        const PropertyPolicy& part_property_policy, const PropertyPolicy& property_policy, bool large_data,
+        bool shared_memory)
 {
     n_samples = n_sam;
     n_subscribers = n_sub;
@@ -187,6 +189,13 @@ bool LatencyTestPublisher::init(int n_sub, int n_sam, bool reliable, uint32_t pi
     PParam.rtps.sendSocketBufferSize = 65536;
     PParam.rtps.listenSocketBufferSize = 2*65536;
     PParam.rtps.setName("Participant_pub");
+
+    if(shared_memory)
+    {
+        // Participants of this host are reached through shared memory, the rest through the builtin UDPv4.
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+    }
+
     mp_participant = Domain::createParticipant(PParam);
     if(mp_participant == nullptr)
         return false;
@@ -68,7 +68,7 @@ class LatencyTestPublisher {
         bool n_export_csv;
         bool init(int n_sub, int n_sam, bool reliable, uint32_t pid, bool hostname, bool export_csv,
                 const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
-                const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool large_data);
+                const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool large_data, bool shared_memory);
         void run();
         void analyzeTimes(uint32_t datasize);
         bool test(uint32_t datasize);
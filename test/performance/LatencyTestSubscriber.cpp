@@ -20,6 +20,7 @@
 #include "LatencyTestSubscriber.h"
 #include "fastrtps/log/Log.h"
 #include "fastrtps/log/Colors.h"
+#include "fastrtps/transport/SharedMemTransportDescriptor.h"
 
 using namespace eprosima;
 using namespace eprosima::fastrtps;
@@ -64,7 +65,8 @@ LatencyTestSubscriber::~LatencyTestSubscriber()
 }
 
 bool LatencyTestSubscriber::init(bool echo, int nsam, bool reliable, uint32_t pid, bool hostname,
-        const PropertyPolicy& part_property_policy, const PropertyPolicy& property_policy, bool large_data)
+        const PropertyPolicy& part_property_policy, const PropertyPolicy& property_policy, bool large_data,
+        bool shared_memory)
 {
     if(!large_data)
     {
@@ -88,6 +90,13 @@ bool LatencyTestSubscriber::init(bool echo, int nsam, bool reliable, uint32_t pi
     PParam.rtps.listenSocketBufferSize = 2*65536;
     PParam.rtps.setName("Participant_sub");
     PParam.rtps.properties = part_property_policy;
+
+    if(shared_memory)
+    {
+        // Participants of this host are reached through shared memory, the rest through the builtin UDPv4.
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+    }
+
     mp_participant = Domain::createParticipant(PParam);
     if(mp_participant == nullptr)
         return false;
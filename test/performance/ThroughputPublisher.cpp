@@ -24,6 +24,7 @@
 #include <fastrtps/attributes/ParticipantAttributes.h>
 #include <fastrtps/attributes/PublisherAttributes.h>
 #include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 
 #include <fastrtps/publisher/Publisher.h>
 #include <fastrtps/subscriber/Subscriber.h>
@@ -104,7 +105,7 @@ void ThroughputPublisher::CommandPubListener::onPublicationMatched(Publisher* /*
 
 ThroughputPublisher::ThroughputPublisher(bool reliable, uint32_t pid, bool hostname, bool export_csv,
         const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
-        const eprosima::fastrtps::rtps::PropertyPolicy& property_policy): disc_count_(0),
+        const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool shared_memory): disc_count_(0),
 #pragma warning(disable:4355)
     m_DataPubListener(*this), m_CommandSubListener(*this), m_CommandPubListener(*this),
     ready(true), m_export_csv(export_csv), reliable_(reliable)
@@ -114,6 +115,13 @@ ThroughputPublisher::ThroughputPublisher(bool reliable, uint32_t pid, bool hostn
     PParam.rtps.builtin.leaseDuration = c_TimeInfinite;
     PParam.rtps.setName("Participant_publisher");
     PParam.rtps.properties = part_property_policy;
+
+    if(shared_memory)
+    {
+        // Participants of this host are reached through shared memory, the rest through the builtin UDPv4.
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+    }
+
     mp_par = Domain::createParticipant(PParam);
     if(mp_par == nullptr)
     {
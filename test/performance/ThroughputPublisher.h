@@ -41,7 +41,7 @@ class ThroughputPublisher
 
         ThroughputPublisher(bool reliable, uint32_t pid, bool hostname, bool export_csv,
                 const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
-                const eprosima::fastrtps::rtps::PropertyPolicy& property_policy);
+                const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool shared_memory);
         virtual ~ThroughputPublisher();
         eprosima::fastrtps::Participant* mp_par;
         eprosima::fastrtps::Publisher* mp_datapub;
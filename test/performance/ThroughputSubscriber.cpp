@@ -24,6 +24,7 @@
 #include <fastrtps/attributes/ParticipantAttributes.h>
 #include <fastrtps/attributes/PublisherAttributes.h>
 #include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 
 #include <fastrtps/publisher/Publisher.h>
 #include <fastrtps/subscriber/Subscriber.h>
@@ -210,7 +211,7 @@ ThroughputSubscriber::~ThroughputSubscriber(){Domain::stopAll();}
 
 ThroughputSubscriber::ThroughputSubscriber(bool reliable, uint32_t pid, bool hostname,
         const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
-        const eprosima::fastrtps::rtps::PropertyPolicy& property_policy) : disc_count_(0), stop_count_(0),
+        const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool shared_memory) : disc_count_(0), stop_count_(0),
 #pragma warning(disable:4355)
     m_DataSubListener(*this),m_CommandSubListener(*this),m_CommandPubListener(*this),
     ready(true),m_datasize(0),m_demand(0)
@@ -220,6 +221,13 @@ ThroughputSubscriber::ThroughputSubscriber(bool reliable, uint32_t pid, bool hos
     PParam.rtps.builtin.leaseDuration = c_TimeInfinite;
     PParam.rtps.setName("Participant_subscriber");
     PParam.rtps.properties = part_property_policy;
+
+    if(shared_memory)
+    {
+        // Participants of this host are reached through shared memory, the rest through the builtin UDPv4.
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+    }
+
     mp_par = Domain::createParticipant(PParam);
     if(mp_par == nullptr)
     {
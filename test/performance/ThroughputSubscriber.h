@@ -46,7 +46,7 @@ class ThroughputSubscriber
 
         ThroughputSubscriber(bool reliable, uint32_t pid, bool hostname,
                 const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
-                const eprosima::fastrtps::rtps::PropertyPolicy& property_policy);
+                const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool shared_memory);
         virtual ~ThroughputSubscriber();
         eprosima::fastrtps::Participant* mp_par;
         eprosima::fastrtps::Subscriber* mp_datasub;
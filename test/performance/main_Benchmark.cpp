@@ -0,0 +1,263 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Benchmarks.h"
+
+#include "optionparser.h"
+
+#include <stdio.h>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include <fastrtps/Domain.h>
+
+#if defined(_MSC_VER)
+#pragma warning (push)
+#pragma warning (disable:4512)
+#endif
+
+using namespace eprosima::fastrtps;
+
+struct Arg: public option::Arg{
+
+    static void printError(const char* msg1, const option::Option& opt, const char* msg2){
+        fprintf(stderr, "%s", msg1);
+        fwrite(opt.name, opt.namelen, 1, stderr);
+        fprintf(stderr, "%s", msg2);
+    }
+
+    static option::ArgStatus Unknown(const option::Option& option, bool msg){
+        if (msg) printError("Unknown option '", option, "'\n");
+        return option::ARG_ILLEGAL;
+    }
+
+    static option::ArgStatus Required(const option::Option& option, bool msg){
+        if (option.arg != 0 && option.arg[0] != 0)
+        return option::ARG_OK;
+
+        if (msg) printError("Option '", option, "' requires an argument\n");
+        return option::ARG_ILLEGAL;
+    }
+
+    static option::ArgStatus Numeric(const option::Option& option, bool msg){
+        char* endptr = 0;
+        if (option.arg != 0 && strtol(option.arg, &endptr, 10)){};
+        if (endptr != option.arg && *endptr == 0)
+        return option::ARG_OK;
+
+        if (msg) printError("Option '", option, "' requires a numeric argument\n");
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    BENCHMARK,
+    SEED,
+    TIMEOUT,
+    OUTPUT,
+    PARTICIPANTS,
+    ENDPOINTS,
+    READERS,
+    SAMPLES,
+    MSG_SIZE,
+    LARGE_SIZE,
+    DROP
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0,"", "",                Arg::None,      "Usage: BenchmarkSuite [options]\n\nGeneral options:" },
+    { HELP,    0,"h", "help",               Arg::None,      "  -h \t--help  \tProduce help message." },
+    { BENCHMARK,0,"b","benchmark",          Arg::Required,  "  -b <arg>, \t--benchmark=<arg>  \tBenchmark to run (\"discovery\"/\"fanout\"/\"large\"/\"loss\"). Can be repeated. All of them by default." },
+    { SEED,0,"","seed",                     Arg::Numeric,   "  \t--seed=<num>  \tSeed to calculate domain and topics, to isolate the run." },
+    { TIMEOUT,0,"t","timeout",              Arg::Numeric,   "  -t <num>, \t--timeout=<num>  \tMaximum time of each benchmark in seconds." },
+    { OUTPUT,0,"o","output",                Arg::Required,  "  -o <arg>, \t--output=<arg>  \tFile where the JSON results are written. Standard output by default." },
+    { UNKNOWN_OPT, 0,"", "",                Arg::None,      "\nBenchmark options:"},
+    { PARTICIPANTS,0,"","participants",     Arg::Numeric,   "  \t--participants=<num>  \tParticipants of the discovery benchmark." },
+    { ENDPOINTS,0,"","endpoints",           Arg::Numeric,   "  \t--endpoints=<num>  \tPublishers and subscribers of each participant in the discovery benchmark." },
+    { READERS,0,"","readers",               Arg::Numeric,   "  \t--readers=<num>  \tReaders of the fan-out benchmark." },
+    { SAMPLES,0,"","samples",               Arg::Numeric,   "  \t--samples=<num>  \tSamples sent by the delivery benchmarks." },
+    { MSG_SIZE,0,"s","msg_size",            Arg::Numeric,   "  -s <num>, \t--msg_size=<num>  \tSize of the samples of the fan-out and loss benchmarks." },
+    { LARGE_SIZE,0,"","large_size",         Arg::Numeric,   "  \t--large_size=<num>  \tSize of the samples of the large sample benchmark." },
+    { DROP,0,"","drop",                     Arg::Numeric,   "  \t--drop=<num>  \tPercentage of DATA and DATA_FRAG dropped by the writer in the loss benchmark." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+
+int main(int argc, char** argv){
+
+    int columns;
+
+#if defined(_WIN32)
+    char* buf = nullptr;
+    size_t sz = 0;
+    if (_dupenv_s(&buf, &sz, "COLUMNS") == 0 && buf != nullptr){
+        columns = strtol(buf, nullptr, 10);
+        free(buf);
+    }
+    else{
+        columns = 80;
+    }
+#else
+    columns = getenv("COLUMNS")? atoi(getenv("COLUMNS")) : 80;
+#endif
+
+    uint32_t seed = 80;
+    uint32_t timeout_sec = 60;
+    std::string output_file;
+    uint32_t participants = 4, endpoints = 4, readers = 8, samples = 500;
+    uint32_t msg_size = 1024, large_size = 1024 * 1024;
+    uint32_t drop = 10;
+    bool run_discovery = false, run_fanout = false, run_large = false, run_loss = false;
+
+    argc-=(argc>0); argv+=(argc>0); // skip program name argv[0] if present
+    option::Stats stats(usage, argc, argv);
+    std::vector<option::Option> options(stats.options_max);
+    std::vector<option::Option> buffer(stats.buffer_max);
+    option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+    if (parse.error())
+    return 1;
+
+    if (options[HELP]){
+        option::printUsage(fwrite, stdout, usage, columns);
+        return 0;
+    }
+
+    for (int i = 0; i < parse.optionsCount(); ++i){
+        option::Option& opt = buffer[i];
+        switch (opt.index()){
+            case HELP:
+                // not possible, because handled further above and exits the program
+                break;
+
+            case BENCHMARK:
+                if(strcmp(opt.arg, "discovery") == 0){
+                    run_discovery = true;
+                }
+                else if(strcmp(opt.arg, "fanout") == 0){
+                    run_fanout = true;
+                }
+                else if(strcmp(opt.arg, "large") == 0){
+                    run_large = true;
+                }
+                else if(strcmp(opt.arg, "loss") == 0){
+                    run_loss = true;
+                }
+                else{
+                    option::printUsage(fwrite, stdout, usage, columns);
+                    return 1;
+                }
+                break;
+
+            case SEED:
+                seed = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case TIMEOUT:
+                timeout_sec = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case OUTPUT:
+                output_file = opt.arg;
+                break;
+
+            case PARTICIPANTS:
+                participants = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case ENDPOINTS:
+                endpoints = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case READERS:
+                readers = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case SAMPLES:
+                samples = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case MSG_SIZE:
+                msg_size = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case LARGE_SIZE:
+                large_size = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case DROP:
+                drop = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case UNKNOWN_OPT:
+                option::printUsage(fwrite, stdout, usage, columns);
+                return 0;
+                break;
+        }
+    }
+
+    if(!run_discovery && !run_fanout && !run_large && !run_loss)
+        run_discovery = run_fanout = run_large = run_loss = true;
+
+    if(msg_size == 0 || large_size == 0 || drop > 100){
+        option::printUsage(fwrite, stdout, usage, columns);
+        return 1;
+    }
+
+    Benchmarks benchmarks(seed, timeout_sec);
+    std::vector<BenchmarkResult> results;
+
+    // Each benchmark uses its own topic, as the entities of the previous one may still be undiscovered by now.
+    if(run_discovery)
+        results.push_back(benchmarks.discovery(participants, endpoints));
+    if(run_fanout)
+        results.push_back(benchmarks.fan_out(readers, samples, msg_size));
+    if(run_large)
+        results.push_back(benchmarks.large_sample(std::max<uint32_t>(samples / 50, 1), large_size));
+    if(run_loss)
+        results.push_back(benchmarks.lossy_reliability(samples, msg_size, static_cast<uint8_t>(drop)));
+
+    if(output_file.empty()){
+        Benchmarks::write_json(std::cout, results);
+    }
+    else{
+        std::ofstream output(output_file);
+        if(!output.is_open()){
+            std::cerr << "Cannot open " << output_file << std::endl;
+            return 1;
+        }
+        Benchmarks::write_json(output, results);
+    }
+
+    Domain::stopAll();
+
+    for(const BenchmarkResult& result : results){
+        if(!result.completed){
+            std::cerr << "Benchmark " << result.name << " did not complete" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
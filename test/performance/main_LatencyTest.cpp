@@ -101,7 +101,8 @@ enum  optionIndex {
     EXPORT_CSV,
     USE_SECURITY,
     CERTS_PATH,
-    LARGE_DATA
+    LARGE_DATA,
+    SHARED_MEMORY
 };
 
 const option::Descriptor usage[] = {
@@ -121,6 +122,7 @@ const option::Descriptor usage[] = {
     { CERTS_PATH, 0, "", "certs",       Arg::Required,      "  --certs <arg>  \tPath where located certificates." },
 #endif
     { LARGE_DATA, 0, "l", "large",      Arg::None,      "  -l \t--large\tTest large data."},
+    { SHARED_MEMORY, 0, "", "shm",      Arg::None,      "  \t--shm\tUse shared memory with participants of this host."},
     { 0, 0, 0, 0, 0, 0 }
 };
 
@@ -157,6 +159,7 @@ int main(int argc, char** argv){
     bool hostname = false;
     bool export_csv = false;
     bool large_data = false;
+    bool shared_memory = false;
 
     argc-=(argc>0); argv+=(argc>0); // skip program name argv[0] if present
     if(argc){
@@ -245,6 +248,10 @@ int main(int argc, char** argv){
                 large_data = true;
                 break;
 
+            case SHARED_MEMORY:
+                shared_memory = true;
+                break;
+
 #if HAVE_SECURITY
             case USE_SECURITY:
                 if(strcmp(opt.arg, "true") == 0)
@@ -320,13 +327,13 @@ int main(int argc, char** argv){
         cout << "Performing test with "<< sub_number << " subscribers and "<<n_samples << " samples" <<endl;
         LatencyTestPublisher latencyPub;
         latencyPub.init(sub_number,n_samples, reliable, seed, hostname, export_csv, pub_part_property_policy,
-                pub_property_policy, large_data);
+                pub_property_policy, large_data, shared_memory);
         latencyPub.run();
     }
     else {
         LatencyTestSubscriber latencySub;
         latencySub.init(echo, n_samples, reliable, seed, hostname, sub_part_property_policy, sub_property_policy,
-                large_data);
+                large_data, shared_memory);
         latencySub.run();
     }
 
@@ -95,7 +95,8 @@ enum  optionIndex {
     HOSTNAME,
     EXPORT_CSV,
     USE_SECURITY,
-    CERTS_PATH
+    CERTS_PATH,
+    SHARED_MEMORY
 };
 
 const option::Descriptor usage[] = {
@@ -112,6 +113,7 @@ const option::Descriptor usage[] = {
     { UNKNOWN_OPT, 0,"", "",                Arg::None,      "\nNote:\nIf no demand or msg_size is provided the .csv file is used.\n"},
     { HOSTNAME,0,"","hostname",             Arg::None,      "" },
     { EXPORT_CSV,0,"","export_csv",         Arg::None,      "" },
+    { SHARED_MEMORY,0,"","shm",             Arg::None,      "  \t--shm  \tUse shared memory with participants of this host." },
     { FILE_R,0,"f","file",                  Arg::Required,  "  -f <arg>, \t--file=<arg>   \tFile to read the payload demands from.\t" },
 #if HAVE_SECURITY
     { USE_SECURITY, 0, "", "security",      Arg::Required,  "  --security <arg>  \tEcho mode (\"true\"/\"false\")." },
@@ -147,6 +149,7 @@ int main(int argc, char** argv){
     uint32_t seed = 80;
     bool hostname = false;
     bool export_csv = false;
+    bool shared_memory = false;
     std::string file_name = "";
 #if HAVE_SECURITY
     bool use_security = false;
@@ -236,6 +239,10 @@ int main(int argc, char** argv){
                 export_csv = true;
                 break;
 
+            case SHARED_MEMORY:
+                shared_memory = true;
+                break;
+
 #if HAVE_SECURITY
             case USE_SECURITY:
                 if(strcmp(opt.arg, "true") == 0)
@@ -311,12 +318,13 @@ int main(int argc, char** argv){
 
     if(pub_sub){
         ThroughputPublisher tpub(reliable, seed, hostname, export_csv, pub_part_property_policy,
-                pub_property_policy);
+                pub_property_policy, shared_memory);
         tpub.m_file_name = file_name;
         tpub.run(test_time_sec, recovery_time_ms, demand, msg_size);
     }
     else{
-        ThroughputSubscriber tsub(reliable, seed, hostname, sub_part_property_policy, sub_property_policy);
+        ThroughputSubscriber tsub(reliable, seed, hostname, sub_part_property_policy, sub_property_policy,
+                shared_memory);
         tsub.run();
     }
 
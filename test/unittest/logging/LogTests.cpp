@@ -25,6 +25,39 @@
 using namespace eprosima::fastrtps;
 using namespace std;
 
+class BlockingConsumer: public LogConsumer
+{
+   public:
+   BlockingConsumer() : mBlocked(false), mUnblocked(false) {}
+
+   virtual void Consume(const Log::Entry&)
+   {
+      std::unique_lock<std::mutex> guard(mMutex);
+      mBlocked = true;
+      mCv.notify_all();
+      mCv.wait(guard, [this]{ return mUnblocked; });
+   }
+
+   void WaitUntilBlocked()
+   {
+      std::unique_lock<std::mutex> guard(mMutex);
+      mCv.wait(guard, [this]{ return mBlocked; });
+   }
+
+   void Unblock()
+   {
+      std::unique_lock<std::mutex> guard(mMutex);
+      mUnblocked = true;
+      mCv.notify_all();
+   }
+
+   private:
+   std::mutex mMutex;
+   std::condition_variable mCv;
+   bool mBlocked;
+   bool mUnblocked;
+};
+
 class LogTests: public ::testing::Test 
 {
    public:
@@ -144,6 +177,69 @@ TEST_F(LogTests, multiple_verbosity_levels)
    ASSERT_EQ(3, consumedEntries.size());
 }
 
+TEST_F(LogTests, category_filter_changes_apply_to_previous_call_sites)
+{
+   auto logFromSameSite = []{ logError(CallSiteCategory, "Logged from the same call site"); };
+
+   logFromSameSite();
+   auto consumedEntries = HELPER_WaitForEntries(1);
+   ASSERT_EQ(1, consumedEntries.size());
+
+   Log::SetCategoryFilter(std::regex("(OtherCategory)"));
+   logFromSameSite();
+   consumedEntries = HELPER_WaitForEntries(2);
+   ASSERT_EQ(1, consumedEntries.size());
+
+   Log::SetCategoryFilter(std::regex("(CallSite)"));
+   logFromSameSite();
+   consumedEntries = HELPER_WaitForEntries(2);
+   ASSERT_EQ(2, consumedEntries.size());
+}
+
+TEST_F(LogTests, long_messages_are_truncated)
+{
+   logError(Truncation, std::string(Log::MaxMessageSize * 2, 'x') << " and more");
+   auto consumedEntries = HELPER_WaitForEntries(1);
+   ASSERT_EQ(1, consumedEntries.size());
+   const std::string& message = consumedEntries.back().message;
+   ASSERT_EQ(Log::MaxMessageSize, message.size());
+   EXPECT_EQ(std::string(Log::MaxMessageSize - 3, 'x') + "...", message);
+}
+
+TEST_F(LogTests, messages_that_fit_are_not_marked)
+{
+   logError(Truncation, std::string(Log::MaxMessageSize, 'x'));
+   auto consumedEntries = HELPER_WaitForEntries(1);
+   ASSERT_EQ(1, consumedEntries.size());
+   EXPECT_EQ(std::string(Log::MaxMessageSize, 'x'), consumedEntries.back().message);
+}
+
+TEST_F(LogTests, full_queue_drops_entries_and_reports_them)
+{
+   // Holds the logging thread inside the first entry, so the queue can be filled.
+   std::unique_ptr<BlockingConsumer> consumer(new BlockingConsumer);
+   BlockingConsumer* blockingConsumer = consumer.get();
+   Log::RegisterConsumer(std::move(consumer));
+   // Only the first entry reaches the consumers, the rest are counted but not printed.
+   Log::SetErrorStringFilter(std::regex("(Blocking)"));
+
+   uint64_t droppedBefore = Log::GetDroppedEntries();
+   logError(Overflow, "Blocking entry");
+   blockingConsumer->WaitUntilBlocked();
+
+   for (size_t i = 0; i != Log::QueueCapacity + 10; i++)
+   {
+      logError(Overflow, "Flooding entry " << i);
+   }
+   ASSERT_EQ(droppedBefore + 10, Log::GetDroppedEntries());
+
+   blockingConsumer->Unblock();
+   auto consumedEntries = HELPER_WaitForEntries(2);
+   ASSERT_EQ(2, consumedEntries.size());
+   ASSERT_EQ(Log::Kind::Warning, consumedEntries.back().kind);
+   ASSERT_NE(std::string::npos, consumedEntries.back().message.find("Dropped 10 "));
+}
+
 std::vector<Log::Entry> LogTests::HELPER_WaitForEntries(uint32_t amount)
 {
    size_t entries = 0;
@@ -0,0 +1,294 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/common/SequenceNumberWindow.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+
+#include <climits>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+typedef SequenceNumberWindow<ChangeFromWriter_t> Window;
+
+static std::vector<SequenceNumber_t> sequence_numbers(const Window& window)
+{
+    std::vector<SequenceNumber_t> result;
+    for(auto& change : window)
+        result.push_back(change.getSequenceNumber());
+    return result;
+}
+
+/*!
+ * @fn TEST(SequenceNumberWindow, InsertKeepsOrder)
+ * @brief This test checks elements are traversed by sequence number, whatever the insertion order.
+ */
+TEST(SequenceNumberWindow, InsertKeepsOrder)
+{
+    Window window;
+
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 10))).second);
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 14))).second);
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 7))).second);
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 12))).second);
+    ASSERT_FALSE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 12))).second);
+
+    std::vector<SequenceNumber_t> expected = { SequenceNumber_t(0, 7), SequenceNumber_t(0, 10),
+        SequenceNumber_t(0, 12), SequenceNumber_t(0, 14) };
+    ASSERT_EQ(window.size(), 4u);
+    ASSERT_EQ(sequence_numbers(window), expected);
+    ASSERT_EQ(window.rbegin()->getSequenceNumber(), SequenceNumber_t(0, 14));
+
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 11)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 20)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 12))->getSequenceNumber(), SequenceNumber_t(0, 12));
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(0, 11))->getSequenceNumber(), SequenceNumber_t(0, 12));
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(0, 1))->getSequenceNumber(), SequenceNumber_t(0, 7));
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(0, 15)), window.end());
+}
+
+/*!
+ * @fn TEST(SequenceNumberWindow, EraseKeepsIterators)
+ * @brief This test checks erasing elements does not invalidate iterators to other elements.
+ */
+TEST(SequenceNumberWindow, EraseKeepsIterators)
+{
+    Window window;
+
+    for(uint32_t i = 1; i <= 10; ++i)
+        window.insert(ChangeFromWriter_t(SequenceNumber_t(0, i)));
+
+    auto last = window.find(SequenceNumber_t(0, 8));
+    auto it = window.begin();
+    while(it != last)
+        it = window.erase(it);
+
+    ASSERT_EQ(window.size(), 3u);
+    ASSERT_EQ(window.begin()->getSequenceNumber(), SequenceNumber_t(0, 8));
+
+    window.erase(window.find(SequenceNumber_t(0, 9)));
+    ASSERT_EQ(++window.begin(), window.find(SequenceNumber_t(0, 10)));
+
+    window.erase(window.find(SequenceNumber_t(0, 10)));
+    ASSERT_EQ(window.size(), 1u);
+    ASSERT_EQ(window.rbegin()->getSequenceNumber(), SequenceNumber_t(0, 8));
+
+    window.clear();
+    ASSERT_TRUE(window.empty());
+    ASSERT_EQ(window.begin(), window.end());
+}
+
+/*!
+ * @fn TEST(SequenceNumberWindow, SlidesOverManySequenceNumbers)
+ * @brief This test checks the window keeps working when it moves forward past its capacity and past 32 bits.
+ */
+TEST(SequenceNumberWindow, SlidesOverManySequenceNumbers)
+{
+    Window window;
+    SequenceNumber_t seq(0, UINT32_MAX - 500);
+
+    for(uint32_t i = 0; i < 1000; ++i, ++seq)
+    {
+        window.insert(ChangeFromWriter_t(seq));
+        if(window.size() > 20)
+            window.erase(window.begin());
+
+        ASSERT_EQ(window.rbegin()->getSequenceNumber(), seq);
+    }
+
+    ASSERT_EQ(window.size(), 20u);
+    ASSERT_EQ(window.begin()->getSequenceNumber(), seq - 20);
+    ASSERT_EQ(sequence_numbers(window).size(), 20u);
+}
+
+/*!
+ * @fn TEST(SequenceNumberWindow, GrowsWithElementsPresent)
+ * @brief This test checks the elements keep their values and order when the window grows, forwards and backwards,
+ * also when they wrap around the end of the circular array.
+ */
+TEST(SequenceNumberWindow, GrowsWithElementsPresent)
+{
+    Window window;
+
+    // Fill the initial capacity and slide it, so the elements wrap around the end of the array.
+    for(uint32_t i = 1; i <= 26; ++i)
+    {
+        ChangeFromWriter_t change(SequenceNumber_t(0, i));
+        change.setStatus(i % 2 == 0 ? RECEIVED : MISSING);
+        window.insert(change);
+        if(window.size() > 16)
+            window.erase(window.begin());
+    }
+    ASSERT_EQ(window.begin()->getSequenceNumber(), SequenceNumber_t(0, 11));
+
+    // Grows forwards.
+    for(uint32_t i = 27; i <= 100; ++i)
+    {
+        ChangeFromWriter_t change(SequenceNumber_t(0, i));
+        change.setStatus(i % 2 == 0 ? RECEIVED : MISSING);
+        ASSERT_TRUE(window.insert(change).second);
+    }
+
+    // Grows backwards, leaving a hole.
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 2))).second);
+
+    ASSERT_EQ(window.size(), 91u);
+    std::vector<SequenceNumber_t> result = sequence_numbers(window);
+    ASSERT_EQ(result.size(), 91u);
+    ASSERT_EQ(result[0], SequenceNumber_t(0, 2));
+    for(uint32_t i = 11; i <= 100; ++i)
+    {
+        ASSERT_EQ(result[i - 10], SequenceNumber_t(0, i));
+        auto it = window.find(SequenceNumber_t(0, i));
+        ASSERT_NE(it, window.end());
+        ASSERT_EQ(it->getStatus(), i % 2 == 0 ? RECEIVED : MISSING);
+    }
+    for(uint32_t i = 3; i <= 10; ++i)
+        ASSERT_EQ(window.find(SequenceNumber_t(0, i)), window.end());
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(0, 3))->getSequenceNumber(), SequenceNumber_t(0, 11));
+    ASSERT_EQ((++window.begin())->getSequenceNumber(), SequenceNumber_t(0, 11));
+}
+
+/*!
+ * @fn TEST(SequenceNumberWindow, OutOfRangeLookups)
+ * @brief This test checks find and erase of sequence numbers below the first element or past the last one.
+ */
+TEST(SequenceNumberWindow, OutOfRangeLookups)
+{
+    Window window;
+
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 1)), window.end());
+    ASSERT_EQ(window.erase(window.find(SequenceNumber_t(0, 1))), window.end());
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(0, 1)), window.end());
+
+    for(uint32_t i = 20; i <= 30; ++i)
+        window.insert(ChangeFromWriter_t(SequenceNumber_t(0, i)));
+
+    // Below the first element, including the slots that share the array position of the elements.
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 19)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 4)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t()), window.end());
+
+    // Past the last element.
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 31)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 36)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(1, 20)), window.end());
+
+    // Erasing what is not found changes nothing.
+    ASSERT_EQ(window.erase(window.find(SequenceNumber_t(0, 4))), window.end());
+    ASSERT_EQ(window.erase(window.find(SequenceNumber_t(0, 36))), window.end());
+    ASSERT_EQ(window.erase(window.lower_bound(SequenceNumber_t(0, 31)), window.end()), window.end());
+    ASSERT_EQ(window.size(), 11u);
+
+    // A range from below the first element starts at the first element.
+    window.erase(window.lower_bound(SequenceNumber_t(0, 1)), window.find(SequenceNumber_t(0, 25)));
+    ASSERT_EQ(window.size(), 6u);
+    ASSERT_EQ(window.begin()->getSequenceNumber(), SequenceNumber_t(0, 25));
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 24)), window.end());
+
+    window.erase(window.find(SequenceNumber_t(0, 30)));
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 30)), window.end());
+    ASSERT_EQ(window.rbegin()->getSequenceNumber(), SequenceNumber_t(0, 29));
+}
+
+/*!
+ * @fn TEST(SequenceNumberWindow, InsertInsideTheWindow)
+ * @brief This test checks inserting a sequence number between present ones keeps iterators and order.
+ */
+TEST(SequenceNumberWindow, InsertInsideTheWindow)
+{
+    Window window;
+
+    window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 10)));
+    window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 20)));
+    auto first = window.find(SequenceNumber_t(0, 10));
+    auto last = window.find(SequenceNumber_t(0, 20));
+    ASSERT_EQ(++Window::iterator(first), last);
+
+    auto inserted = window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 15)));
+    ASSERT_TRUE(inserted.second);
+    ASSERT_EQ(inserted.first->getSequenceNumber(), SequenceNumber_t(0, 15));
+    ASSERT_EQ(++Window::iterator(first), inserted.first);
+    ASSERT_EQ(++Window::iterator(inserted.first), last);
+    ASSERT_EQ(--Window::iterator(last), inserted.first);
+
+    ChangeFromWriter_t duplicated(SequenceNumber_t(0, 15));
+    duplicated.setStatus(LOST);
+    inserted = window.insert(duplicated);
+    ASSERT_FALSE(inserted.second);
+    ASSERT_EQ(inserted.first->getStatus(), UNKNOWN);
+
+    window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 11)));
+    window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 19)));
+    std::vector<SequenceNumber_t> expected = { SequenceNumber_t(0, 10), SequenceNumber_t(0, 11),
+        SequenceNumber_t(0, 15), SequenceNumber_t(0, 19), SequenceNumber_t(0, 20) };
+    ASSERT_EQ(sequence_numbers(window), expected);
+    ASSERT_EQ(window.size(), 5u);
+
+    // A slot emptied inside the window can be used again.
+    window.erase(window.find(SequenceNumber_t(0, 15)));
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 15)), window.end());
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, 15))).second);
+    ASSERT_EQ(sequence_numbers(window), expected);
+}
+
+/*!
+ * @fn TEST(SequenceNumberWindow, CrossesThe32BitBoundary)
+ * @brief This test checks elements on both sides of the carry from the low to the high part of the sequence number.
+ */
+TEST(SequenceNumberWindow, CrossesThe32BitBoundary)
+{
+    Window window;
+
+    // Inserted after the boundary first, so the window grows backwards across it.
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(1, 1))).second);
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, UINT32_MAX - 1))).second);
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(1, 0))).second);
+    ASSERT_TRUE(window.insert(ChangeFromWriter_t(SequenceNumber_t(0, UINT32_MAX))).second);
+    ASSERT_FALSE(window.insert(ChangeFromWriter_t(SequenceNumber_t(1, 0))).second);
+
+    std::vector<SequenceNumber_t> expected = { SequenceNumber_t(0, UINT32_MAX - 1), SequenceNumber_t(0, UINT32_MAX),
+        SequenceNumber_t(1, 0), SequenceNumber_t(1, 1) };
+    ASSERT_EQ(sequence_numbers(window), expected);
+
+    std::vector<SequenceNumber_t> reversed;
+    for(auto it = window.rbegin(); it != window.rend(); ++it)
+        reversed.push_back(it->getSequenceNumber());
+    ASSERT_EQ(reversed, std::vector<SequenceNumber_t>(expected.rbegin(), expected.rend()));
+
+    // The same low part on the other side of the boundary is a different sequence number.
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 0)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(0, 1)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(1, UINT32_MAX)), window.end());
+    ASSERT_EQ(window.find(SequenceNumber_t(1, 0))->getSequenceNumber(), SequenceNumber_t(1, 0));
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(0, 5))->getSequenceNumber(), SequenceNumber_t(0, UINT32_MAX - 1));
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(1, 0))->getSequenceNumber(), SequenceNumber_t(1, 0));
+    ASSERT_EQ(window.lower_bound(SequenceNumber_t(1, 2)), window.end());
+
+    // Erasing across the boundary.
+    window.erase(window.find(SequenceNumber_t(0, UINT32_MAX)), window.find(SequenceNumber_t(1, 1)));
+    expected = { SequenceNumber_t(0, UINT32_MAX - 1), SequenceNumber_t(1, 1) };
+    ASSERT_EQ(sequence_numbers(window), expected);
+    ASSERT_EQ(++window.begin(), window.find(SequenceNumber_t(1, 1)));
+
+    window.erase(window.begin());
+    ASSERT_EQ(window.begin()->getSequenceNumber(), SequenceNumber_t(1, 1));
+    ASSERT_EQ(window.size(), 1u);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,178 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/builtin/discovery/participant/DiscoveredEndpointIndex.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+// Stands for ReaderProxyData and WriterProxyData, of which the index only uses the GUID and the topic name.
+class ProxyDataMock
+{
+    public:
+
+        ProxyDataMock(uint8_t participant, uint8_t entity, const std::string& topic_name) : topic_name_(topic_name)
+        {
+            guid_.guidPrefix.value[0] = participant;
+            guid_.entityId.value[3] = entity;
+        }
+
+        const GUID_t& guid() const { return guid_; }
+
+        const std::string& topicName() const { return topic_name_; }
+
+    private:
+
+        GUID_t guid_;
+
+        std::string topic_name_;
+};
+
+class DiscoveredEndpointIndexTests : public ::testing::Test
+{
+    protected:
+
+        DiscoveredEndpointIndexTests() :
+            participant_1(reinterpret_cast<ParticipantProxyData*>(&participant_storage[0])),
+            participant_2(reinterpret_cast<ParticipantProxyData*>(&participant_storage[1])),
+            endpoint_1(1, 1, "TopicA"), endpoint_2(1, 2, "TopicA"), endpoint_3(2, 1, "TopicA"),
+            endpoint_4(2, 2, "TopicB")
+        {
+        }
+
+        static bool contains(const std::vector<DiscoveredEndpoint<ProxyDataMock>>& endpoints,
+                const ProxyDataMock& data, ParticipantProxyData* participant)
+        {
+            for(const auto& endpoint : endpoints)
+            {
+                if(endpoint.data == &data)
+                {
+                    return endpoint.participant == participant;
+                }
+            }
+
+            return false;
+        }
+
+        // The index never dereferences participants, so any distinct addresses do.
+        int participant_storage[2];
+        ParticipantProxyData* participant_1;
+        ParticipantProxyData* participant_2;
+
+        ProxyDataMock endpoint_1, endpoint_2, endpoint_3, endpoint_4;
+
+        DiscoveredEndpointIndex<ProxyDataMock> index;
+};
+
+TEST_F(DiscoveredEndpointIndexTests, endpoints_are_found_by_guid)
+{
+    ASSERT_TRUE(index.add(participant_1, &endpoint_1));
+    ASSERT_TRUE(index.add(participant_2, &endpoint_3));
+    EXPECT_EQ(2u, index.size());
+
+    const DiscoveredEndpoint<ProxyDataMock>* endpoint = index.find(endpoint_1.guid());
+    ASSERT_NE(nullptr, endpoint);
+    EXPECT_EQ(&endpoint_1, endpoint->data);
+    EXPECT_EQ(participant_1, endpoint->participant);
+
+    endpoint = index.find(endpoint_3.guid());
+    ASSERT_NE(nullptr, endpoint);
+    EXPECT_EQ(&endpoint_3, endpoint->data);
+    EXPECT_EQ(participant_2, endpoint->participant);
+
+    EXPECT_EQ(nullptr, index.find(endpoint_2.guid()));
+}
+
+TEST_F(DiscoveredEndpointIndexTests, a_guid_is_only_indexed_once)
+{
+    ProxyDataMock duplicated(1, 1, "TopicB");
+
+    ASSERT_TRUE(index.add(participant_1, &endpoint_1));
+    EXPECT_FALSE(index.add(participant_1, &duplicated));
+
+    EXPECT_EQ(1u, index.size());
+    EXPECT_EQ(&endpoint_1, index.find(endpoint_1.guid())->data);
+    EXPECT_TRUE(index.in_topic("TopicB").empty());
+}
+
+TEST_F(DiscoveredEndpointIndexTests, endpoints_are_grouped_by_topic)
+{
+    index.add(participant_1, &endpoint_1);
+    index.add(participant_1, &endpoint_2);
+    index.add(participant_2, &endpoint_3);
+    index.add(participant_2, &endpoint_4);
+    EXPECT_EQ(2u, index.topic_count());
+
+    std::vector<DiscoveredEndpoint<ProxyDataMock>> topic_a = index.in_topic("TopicA");
+    ASSERT_EQ(3u, topic_a.size());
+    EXPECT_TRUE(contains(topic_a, endpoint_1, participant_1));
+    EXPECT_TRUE(contains(topic_a, endpoint_2, participant_1));
+    EXPECT_TRUE(contains(topic_a, endpoint_3, participant_2));
+
+    std::vector<DiscoveredEndpoint<ProxyDataMock>> topic_b = index.in_topic("TopicB");
+    ASSERT_EQ(1u, topic_b.size());
+    EXPECT_TRUE(contains(topic_b, endpoint_4, participant_2));
+
+    EXPECT_TRUE(index.in_topic("TopicC").empty());
+}
+
+TEST_F(DiscoveredEndpointIndexTests, removed_endpoints_leave_both_indexes)
+{
+    index.add(participant_1, &endpoint_1);
+    index.add(participant_1, &endpoint_2);
+    index.add(participant_2, &endpoint_3);
+    index.add(participant_2, &endpoint_4);
+
+    // The copy returned by in_topic is not affected by later changes.
+    std::vector<DiscoveredEndpoint<ProxyDataMock>> topic_a = index.in_topic("TopicA");
+
+    DiscoveredEndpoint<ProxyDataMock> removed{nullptr, nullptr};
+    ASSERT_TRUE(index.remove(endpoint_1.guid(), removed));
+    EXPECT_EQ(&endpoint_1, removed.data);
+    EXPECT_EQ(participant_1, removed.participant);
+    EXPECT_FALSE(index.remove(endpoint_1.guid(), removed));
+
+    EXPECT_EQ(3u, topic_a.size());
+    EXPECT_EQ(nullptr, index.find(endpoint_1.guid()));
+    std::vector<DiscoveredEndpoint<ProxyDataMock>> remaining = index.in_topic("TopicA");
+    ASSERT_EQ(2u, remaining.size());
+    EXPECT_FALSE(contains(remaining, endpoint_1, participant_1));
+    EXPECT_TRUE(contains(remaining, endpoint_2, participant_1));
+    EXPECT_TRUE(contains(remaining, endpoint_3, participant_2));
+
+    // Topics without endpoints are dropped.
+    ASSERT_TRUE(index.remove(endpoint_4.guid(), removed));
+    EXPECT_TRUE(index.in_topic("TopicB").empty());
+    EXPECT_EQ(1u, index.topic_count());
+
+    ASSERT_TRUE(index.remove(endpoint_2.guid(), removed));
+    ASSERT_TRUE(index.remove(endpoint_3.guid(), removed));
+    EXPECT_EQ(0u, index.size());
+    EXPECT_EQ(0u, index.topic_count());
+
+    // An endpoint can be added again once removed.
+    ASSERT_TRUE(index.add(participant_2, &endpoint_1));
+    EXPECT_EQ(participant_2, index.find(endpoint_1.guid())->participant);
+    EXPECT_TRUE(contains(index.in_topic("TopicA"), endpoint_1, participant_2));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,218 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/history/CacheChangePool.h>
+#include <fastrtps/rtps/history/PayloadArena.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+#include <fastrtps/log/Log.h>
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <set>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+class CacheChangePoolTests : public ::testing::Test
+{
+    public:
+
+        ~CacheChangePoolTests()
+        {
+            Log::KillThread();
+        }
+};
+
+TEST_F(CacheChangePoolTests, reserve_and_release_preallocated_changes)
+{
+    CacheChangePool pool(9, 128, 0, PREALLOCATED_MEMORY_MODE);
+    ASSERT_EQ(pool.get_allCachesSize(), 10u);
+    ASSERT_EQ(pool.get_freeCachesSize(), 10u);
+
+    std::set<CacheChange_t*> reserved;
+    for(int i = 0; i < 10; ++i)
+    {
+        CacheChange_t* ch = nullptr;
+        ASSERT_TRUE(pool.reserve_Cache(&ch, 0));
+        ASSERT_NE(ch, nullptr);
+        ASSERT_EQ(ch->serializedPayload.max_size, 128u);
+        ASSERT_TRUE(reserved.insert(ch).second);
+    }
+    ASSERT_EQ(pool.get_freeCachesSize(), 0u);
+
+    for(CacheChange_t* ch : reserved)
+    {
+        pool.release_Cache(ch);
+    }
+    ASSERT_EQ(pool.get_allCachesSize(), 10u);
+    ASSERT_EQ(pool.get_freeCachesSize(), 10u);
+}
+
+TEST_F(CacheChangePoolTests, preallocated_pool_grows_up_to_its_maximum)
+{
+    CacheChangePool pool(4, 128, 40, PREALLOCATED_MEMORY_MODE);
+
+    std::vector<CacheChange_t*> reserved;
+    CacheChange_t* ch = nullptr;
+    while(pool.reserve_Cache(&ch, 0))
+    {
+        reserved.push_back(ch);
+    }
+
+    ASSERT_EQ(reserved.size(), 41u);
+    ASSERT_EQ(pool.get_allCachesSize(), 41u);
+
+    for(CacheChange_t* change : reserved)
+    {
+        pool.release_Cache(change);
+    }
+    ASSERT_EQ(pool.get_freeCachesSize(), 41u);
+}
+
+TEST_F(CacheChangePoolTests, reserve_reallocates_payload)
+{
+    CacheChangePool pool(4, 128, 0, PREALLOCATED_WITH_REALLOC_MEMORY_MODE);
+
+    CacheChange_t* ch = nullptr;
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 1024));
+    ASSERT_GE(ch->serializedPayload.max_size, 1024u);
+    pool.release_Cache(ch);
+}
+
+TEST_F(CacheChangePoolTests, release_dynamic_changes_in_any_order)
+{
+    CacheChangePool pool(0, 0, 0, DYNAMIC_RESERVE_MEMORY_MODE);
+
+    std::vector<CacheChange_t*> reserved;
+    for(uint32_t i = 0; i < 100; ++i)
+    {
+        CacheChange_t* ch = nullptr;
+        ASSERT_TRUE(pool.reserve_Cache(&ch, 16 + i));
+        ASSERT_EQ(ch->serializedPayload.max_size, 16 + i);
+        reserved.push_back(ch);
+    }
+    ASSERT_EQ(pool.get_allCachesSize(), 100u);
+
+    // Release the changes at even positions, from the middle of the pool.
+    for(size_t i = 0; i < reserved.size(); i += 2)
+    {
+        pool.release_Cache(reserved[i]);
+    }
+    ASSERT_EQ(pool.get_allCachesSize(), 50u);
+
+    // A change is only released once.
+    pool.release_Cache(reserved[1]);
+    ASSERT_EQ(pool.get_allCachesSize(), 49u);
+
+    // The rest are deleted by the pool.
+}
+
+TEST_F(CacheChangePoolTests, arena_payloads_are_reused_by_size_class)
+{
+    CacheChangePool pool(4, 65536, 0, PREALLOCATED_WITH_ARENA_MEMORY_MODE);
+
+    CacheChange_t* ch = nullptr;
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 1000));
+    ASSERT_EQ(ch->serializedPayload.max_size, 1024u);
+    octet* buffer = ch->serializedPayload.data;
+    ASSERT_NE(buffer, nullptr);
+    pool.release_Cache(ch);
+    ASSERT_EQ(ch->serializedPayload.data, nullptr);
+
+    // A payload of the same size class recycles the buffer.
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 600));
+    ASSERT_EQ(ch->serializedPayload.data, buffer);
+    ASSERT_EQ(ch->serializedPayload.max_size, 1024u);
+    pool.release_Cache(ch);
+
+    // Payloads of other size classes use other buffers.
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 2000));
+    ASSERT_NE(ch->serializedPayload.data, buffer);
+    ASSERT_EQ(ch->serializedPayload.max_size, 2048u);
+    pool.release_Cache(ch);
+
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 10));
+    ASSERT_EQ(ch->serializedPayload.max_size, PayloadArena::c_minClassSize);
+    pool.release_Cache(ch);
+}
+
+TEST_F(CacheChangePoolTests, arena_keeps_reallocated_payloads)
+{
+    PayloadArena arena;
+    SerializedPayload_t payload;
+
+    ASSERT_TRUE(arena.acquire(payload, 100));
+    ASSERT_EQ(payload.max_size, 128u);
+
+    // A payload growing its buffer by itself still gives it back to the arena.
+    payload.reserve(300);
+    arena.release(payload);
+    ASSERT_EQ(payload.data, nullptr);
+    ASSERT_EQ(arena.get_freeBuffersSize(), 1u);
+
+    ASSERT_TRUE(arena.acquire(payload, 256));
+    ASSERT_EQ(arena.get_freeBuffersSize(), 0u);
+    ASSERT_GE(payload.max_size, 256u);
+    arena.release(payload);
+}
+
+TEST_F(CacheChangePoolTests, concurrent_reserve_and_release)
+{
+    const uint32_t num_threads = 4;
+    const uint32_t num_iterations = 20000;
+    CacheChangePool pool(8, 64, 0, PREALLOCATED_MEMORY_MODE);
+
+    auto worker = [&](uint32_t id)
+    {
+        std::vector<CacheChange_t*> reserved;
+        for(uint32_t i = 0; i < num_iterations; ++i)
+        {
+            CacheChange_t* ch = nullptr;
+            ASSERT_TRUE(pool.reserve_Cache(&ch, 0));
+            // Owned changes are not shared with other threads.
+            ASSERT_EQ(ch->sequenceNumber.low, 0u);
+            ch->sequenceNumber.low = id + 1;
+            reserved.push_back(ch);
+
+            if(reserved.size() == 3 || i + 1 == num_iterations)
+            {
+                for(CacheChange_t* change : reserved)
+                {
+                    ASSERT_EQ(change->sequenceNumber.low, id + 1);
+                    pool.release_Cache(change);
+                }
+                reserved.clear();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(uint32_t i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back(worker, i);
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(pool.get_freeCachesSize(), pool.get_allCachesSize());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
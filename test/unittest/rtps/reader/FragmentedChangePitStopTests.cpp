@@ -0,0 +1,273 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/reader/timedevent/FragmentedSampleTimeout.h>
+#include <fastrtps/rtps/resources/ResourceEvent.h>
+#include <rtps/reader/FragmentedChangePitStop.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::_;
+using ::testing::Invoke;
+
+static const uint32_t fragmentSize = 100;
+static const uint32_t sampleSize = 1050;
+
+class ReaderMock : public RTPSReader
+{
+    public:
+
+        ReaderMock()
+        {
+            ON_CALL(*this, reserveCache(_, _)).WillByDefault(Invoke(
+                        [this](CacheChange_t** change, uint32_t size)
+                        {
+                            reserved.emplace_back(new CacheChange_t(size));
+                            *change = reserved.back().get();
+                            return true;
+                        }));
+        }
+
+        bool matched_writer_add(RemoteWriterAttributes&) { return true; }
+
+        bool matched_writer_remove(RemoteWriterAttributes&) { return true; }
+
+        std::vector<std::unique_ptr<CacheChange_t>> reserved;
+};
+
+class FragmentedChangePitStopTests : public ::testing::Test
+{
+    public:
+
+        FragmentedChangePitStopTests() : sample(sampleSize)
+        {
+            for(uint32_t i = 0; i < sampleSize; ++i)
+                sample[i] = static_cast<octet>(i);
+
+            writer.guidPrefix.value[0] = 1;
+            writer.entityId = c_EntityId_SPDPWriter;
+        }
+
+        /*!
+         * Processes a DATA_FRAG carrying the fragments [first, first + count) of the sample,
+         * the way MessageReceiver fills the incoming CacheChange_t.
+         */
+        CacheChange_t* receive(FragmentedChangePitStop& pit_stop, const GUID_t& writer_guid,
+                const SequenceNumber_t& sequence_number, uint32_t first, uint32_t count, uint32_t length = 0)
+        {
+            uint32_t offset = (first - 1) * fragmentSize;
+            if(length == 0)
+                length = std::min(count * fragmentSize, sampleSize - offset);
+
+            CacheChange_t incoming;
+            incoming.writerGUID = writer_guid;
+            incoming.sequenceNumber = sequence_number;
+            incoming.serializedPayload.data = &sample[offset];
+            incoming.serializedPayload.length = length;
+            incoming.setFragmentSize(fragmentSize);
+            incoming.getDataFragments().assign(count, true);
+
+            CacheChange_t* completed = pit_stop.process(&incoming, sampleSize, first);
+
+            // The payload belongs to the message.
+            incoming.serializedPayload.data = nullptr;
+            return completed;
+        }
+
+        void expect_sample(const CacheChange_t* change)
+        {
+            ASSERT_NE(nullptr, change);
+            ASSERT_EQ(sampleSize, change->serializedPayload.length);
+            EXPECT_EQ(0, memcmp(sample.data(), change->serializedPayload.data, sampleSize));
+        }
+
+        std::vector<octet> sample;
+
+        GUID_t writer;
+
+        ::testing::NiceMock<ReaderMock> reader;
+};
+
+TEST_F(FragmentedChangePitStopTests, fragments_received_out_of_order_complete_the_sample)
+{
+    FragmentedChangePitStop pit_stop(&reader);
+    SequenceNumber_t sequence_number(0, 1);
+
+    EXPECT_CALL(reader, reserveCache(_, sampleSize)).Times(1);
+
+    // Last fragment is shorter than the others.
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, sequence_number, 11, 1));
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, sequence_number, 4, 5));
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, sequence_number, 1, 2));
+
+    CacheChange_t* uncompleted = pit_stop.find(sequence_number, writer);
+    ASSERT_NE(nullptr, uncompleted);
+    EXPECT_EQ(8u, uncompleted->getDataFragments().count());
+    EXPECT_EQ(2u, uncompleted->getDataFragments().find_next(0, false));
+
+    // Overlaps fragments already received.
+    CacheChange_t* completed = receive(pit_stop, writer, sequence_number, 2, 9);
+    expect_sample(completed);
+    EXPECT_EQ(nullptr, pit_stop.find(sequence_number, writer));
+    EXPECT_EQ(0u, pit_stop.size());
+}
+
+TEST_F(FragmentedChangePitStopTests, samples_are_kept_apart_by_writer_and_sequence_number)
+{
+    FragmentedChangePitStop pit_stop(&reader);
+    GUID_t other_writer = writer;
+    other_writer.guidPrefix.value[0] = 2;
+
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, SequenceNumber_t(0, 1), 1, 5));
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, SequenceNumber_t(0, 2), 1, 5));
+    ASSERT_EQ(nullptr, receive(pit_stop, other_writer, SequenceNumber_t(0, 1), 6, 6));
+    EXPECT_EQ(3u, pit_stop.size());
+
+    ASSERT_EQ(nullptr, receive(pit_stop, other_writer, SequenceNumber_t(0, 2), 6, 6));
+    expect_sample(receive(pit_stop, other_writer, SequenceNumber_t(0, 1), 1, 5));
+    EXPECT_NE(nullptr, pit_stop.find(SequenceNumber_t(0, 1), writer));
+
+    EXPECT_CALL(reader, releaseCache(pit_stop.find(SequenceNumber_t(0, 1), writer))).Times(1);
+    EXPECT_CALL(reader, releaseCache(pit_stop.find(SequenceNumber_t(0, 2), writer))).Times(1);
+    EXPECT_TRUE(pit_stop.try_to_remove_until(SequenceNumber_t(0, 3), writer));
+    EXPECT_EQ(1u, pit_stop.size());
+    EXPECT_NE(nullptr, pit_stop.find(SequenceNumber_t(0, 2), other_writer));
+
+    ::testing::Mock::VerifyAndClearExpectations(&reader);
+}
+
+TEST_F(FragmentedChangePitStopTests, fragments_beyond_the_received_payload_are_not_copied)
+{
+    FragmentedChangePitStop pit_stop(&reader);
+    SequenceNumber_t sequence_number(0, 1);
+
+    // Says it carries two fragments, but only has the bytes of one.
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, sequence_number, 1, 2, fragmentSize));
+    EXPECT_EQ(0u, pit_stop.find(sequence_number, writer)->getDataFragments().count());
+
+    // Fragments out of the sample are ignored.
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, sequence_number, 12, 1, fragmentSize));
+    EXPECT_EQ(0u, pit_stop.find(sequence_number, writer)->getDataFragments().count());
+
+    expect_sample(receive(pit_stop, writer, sequence_number, 1, 11));
+}
+
+TEST_F(FragmentedChangePitStopTests, stale_samples_are_released)
+{
+    Duration_t timeout;
+    timeout.fraction = 50 * 1000 * 1000; // ~12ms
+    FragmentedChangePitStop pit_stop(&reader, timeout);
+
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, SequenceNumber_t(0, 1), 1, 5));
+    EXPECT_EQ(0u, pit_stop.remove_stale_changes());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_CALL(reader, releaseCache(pit_stop.find(SequenceNumber_t(0, 1), writer))).Times(1);
+
+    // Processing fragments of another sample discards the stale one.
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, SequenceNumber_t(0, 2), 1, 5));
+    EXPECT_EQ(nullptr, pit_stop.find(SequenceNumber_t(0, 1), writer));
+    EXPECT_EQ(1u, pit_stop.size());
+
+    ::testing::Mock::VerifyAndClearExpectations(&reader);
+}
+
+TEST_F(FragmentedChangePitStopTests, stale_samples_are_released_by_the_reader_without_new_fragments)
+{
+    Duration_t timeout;
+    timeout.fraction = 50 * 1000 * 1000; // ~12ms
+
+    ResourceEvent resource;
+    resource.init_thread();
+    FragmentedChangePitStop pit_stop(&reader, timeout);
+
+    // The reader protects the pit stop with its mutex.
+    std::mutex mutex;
+    std::condition_variable released_cond;
+    bool released = false;
+
+    ON_CALL(reader, remove_stale_fragmented_changes()).WillByDefault(Invoke(
+                [&]()
+                {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    return pit_stop.remove_stale_changes();
+                }));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_EQ(nullptr, receive(pit_stop, writer, SequenceNumber_t(0, 1), 1, 5));
+
+    EXPECT_CALL(reader, releaseCache(pit_stop.find(SequenceNumber_t(0, 1), writer))).WillOnce(Invoke(
+                [&](CacheChange_t*)
+                {
+                    released = true;
+                    released_cond.notify_one();
+                }));
+
+    // No more fragments are received. The periodic event of the reader discards the sample.
+    FragmentedSampleTimeout event(&reader, resource, 10);
+    event.restart_timer();
+
+    ASSERT_TRUE(released_cond.wait_for(lock, std::chrono::seconds(5), [&]() { return released; }));
+    EXPECT_EQ(0u, pit_stop.size());
+    lock.unlock();
+
+    event.cancel_timer();
+    ::testing::Mock::VerifyAndClearExpectations(&reader);
+}
+
+TEST(FragmentBitmapTests, positions_are_tracked_across_words)
+{
+    FragmentBitmap_t bitmap;
+    bitmap.assign(70, false);
+
+    EXPECT_TRUE(bitmap.set(0));
+    EXPECT_TRUE(bitmap.set(33));
+    EXPECT_TRUE(bitmap.set(69));
+    EXPECT_FALSE(bitmap.set(33));
+    EXPECT_FALSE(bitmap.set(70));
+    EXPECT_EQ(3u, bitmap.count());
+
+    EXPECT_EQ(33u, bitmap.find_next(1, true));
+    EXPECT_EQ(69u, bitmap.find_next(34, true));
+    EXPECT_EQ(1u, bitmap.find_next(0, false));
+    EXPECT_EQ(34u, bitmap.find_next(33, false));
+
+    bitmap.assign(70, true);
+    EXPECT_TRUE(bitmap.all());
+    EXPECT_EQ(70u, bitmap.find_next(0, false));
+    EXPECT_TRUE(bitmap.reset(64));
+
+    FragmentNumberSet_t missing;
+    bitmap.to_fragment_number_set(missing, false);
+    EXPECT_EQ(65u, missing.base);
+    ASSERT_EQ(1u, missing.get_size());
+    EXPECT_EQ(65u, *missing.get_begin());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -323,6 +323,32 @@ namespace eprosima
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0);
             }
 
+            TEST(WriterProxyTests, LostAndDuplicateChangesAreCounted)
+            {
+                RemoteWriterAttributes wattr;
+                StatefulReader readerMock;
+                WriterProxy wproxy(wattr, &readerMock);
+
+                // Changes 1 to 4 known, 2 of them received.
+                wproxy.missing_changes_update(SequenceNumber_t(0, 4));
+                wproxy.received_change_set(SequenceNumber_t(0, 2));
+                wproxy.received_change_set(SequenceNumber_t(0, 4));
+
+                // Lost before 4: only 1 and 3 were not received.
+                wproxy.lost_changes_update(SequenceNumber_t(0, 4));
+                ASSERT_EQ(2u, readerMock.get_statistics().samples_lost);
+
+                // Lost before 9: 5 to 8 were never known.
+                wproxy.lost_changes_update(SequenceNumber_t(0, 9));
+                ASSERT_EQ(6u, readerMock.get_statistics().samples_lost);
+
+                // Received again, or given up on.
+                ASSERT_TRUE(wproxy.change_was_received(SequenceNumber_t(0, 4)));
+                ASSERT_TRUE(wproxy.change_was_received(SequenceNumber_t(0, 7)));
+                ASSERT_FALSE(wproxy.change_was_received(SequenceNumber_t(0, 9)));
+                ASSERT_EQ(2u, readerMock.get_statistics().duplicates_received);
+            }
+
         } // namespace rtps
     } // namespace fastrtps
 } // namespace eprosima
@@ -0,0 +1,241 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <rtps/resources/TimerWheel.h>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+class TestEntry : public TimerWheel::Entry
+{
+    public:
+
+        TestEntry(int id, std::vector<int>* order = nullptr, std::mutex* order_mutex = nullptr) :
+            id_(id), order_(order), order_mutex_(order_mutex), expirations_(0) {}
+
+        void expired(uint64_t sequence) override
+        {
+            (void)sequence;
+            expired_at_ = TimerWheel::clock::now();
+
+            if(order_ != nullptr)
+            {
+                std::lock_guard<std::mutex> guard(*order_mutex_);
+                order_->push_back(id_);
+            }
+
+            if(callback_)
+                callback_();
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            ++expirations_;
+            cond_.notify_all();
+        }
+
+        bool wait(int expirations, unsigned int milliseconds)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return cond_.wait_for(lock, std::chrono::milliseconds(milliseconds),
+                    [&]() { return expirations_ >= expirations; });
+        }
+
+        int expirations()
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return expirations_;
+        }
+
+        std::function<void()> callback_;
+        TimerWheel::clock::time_point expired_at_;
+
+    private:
+
+        int id_;
+        std::vector<int>* order_;
+        std::mutex* order_mutex_;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        int expirations_;
+};
+
+TEST(TimerWheel, EntriesExpireInDeadlineOrder)
+{
+    TimerWheel wheel;
+    wheel.start(1);
+
+    std::vector<int> order;
+    std::mutex order_mutex;
+    TestEntry first(1, &order, &order_mutex), second(2, &order, &order_mutex), third(3, &order, &order_mutex);
+
+    auto scheduled_at = TimerWheel::clock::now();
+    wheel.schedule(third, std::chrono::milliseconds(30));
+    wheel.schedule(first, std::chrono::milliseconds(10));
+    wheel.schedule(second, std::chrono::milliseconds(20));
+
+    ASSERT_TRUE(third.wait(1, 1000));
+    ASSERT_TRUE(first.wait(1, 1000));
+    ASSERT_TRUE(second.wait(1, 1000));
+
+    ASSERT_EQ(3u, order.size());
+    EXPECT_EQ(1, order[0]);
+    EXPECT_EQ(2, order[1]);
+    EXPECT_EQ(3, order[2]);
+
+    // Never early.
+    EXPECT_GE(first.expired_at_ - scheduled_at, std::chrono::milliseconds(10));
+    EXPECT_GE(third.expired_at_ - scheduled_at, std::chrono::milliseconds(30));
+}
+
+TEST(TimerWheel, EntriesWithSameDeadlineExpireInScheduleOrder)
+{
+    // A coarse tick, so all the entries fall in the same one.
+    TimerWheel wheel(std::chrono::milliseconds(50));
+    wheel.start(1);
+
+    std::vector<int> order;
+    std::mutex order_mutex;
+    std::vector<std::unique_ptr<TestEntry>> entries;
+    for(int i = 0; i < 100; ++i)
+        entries.emplace_back(new TestEntry(i, &order, &order_mutex));
+
+    for(auto& entry : entries)
+        wheel.schedule(*entry, std::chrono::milliseconds(50));
+
+    ASSERT_TRUE(entries.back()->wait(1, 1000));
+
+    std::lock_guard<std::mutex> guard(order_mutex);
+    ASSERT_EQ(entries.size(), order.size());
+    for(int i = 0; i < 100; ++i)
+        EXPECT_EQ(i, order[i]);
+}
+
+TEST(TimerWheel, CancelledAndRescheduledEntries)
+{
+    TimerWheel wheel;
+    wheel.start(1);
+
+    TestEntry cancelled(1), rescheduled(2);
+
+    wheel.schedule(cancelled, std::chrono::milliseconds(10));
+    wheel.schedule(rescheduled, std::chrono::milliseconds(10));
+    EXPECT_TRUE(wheel.cancel(cancelled));
+    EXPECT_FALSE(wheel.cancel(cancelled));
+
+    // Rescheduling replaces the previous expiration.
+    auto scheduled_at = TimerWheel::clock::now();
+    wheel.schedule(rescheduled, std::chrono::milliseconds(50));
+
+    ASSERT_TRUE(rescheduled.wait(1, 1000));
+    EXPECT_GE(rescheduled.expired_at_ - scheduled_at, std::chrono::milliseconds(50));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(0, cancelled.expirations());
+    EXPECT_EQ(1, rescheduled.expirations());
+}
+
+TEST(TimerWheel, LongDelaysAreMovedDownTheLevels)
+{
+    // 10 us ticks, so the delays below need the upper levels of the wheel.
+    TimerWheel wheel(std::chrono::microseconds(10));
+    wheel.start(1);
+
+    std::vector<int> order;
+    std::mutex order_mutex;
+    TestEntry level0(0, &order, &order_mutex), level1(1, &order, &order_mutex), level2(2, &order, &order_mutex);
+
+    auto scheduled_at = TimerWheel::clock::now();
+    wheel.schedule(level2, std::chrono::milliseconds(800));
+    wheel.schedule(level1, std::chrono::milliseconds(100));
+    wheel.schedule(level0, std::chrono::milliseconds(1));
+
+    ASSERT_TRUE(level2.wait(1, 3000));
+    ASSERT_TRUE(level1.wait(1, 1000));
+    ASSERT_TRUE(level0.wait(1, 1000));
+
+    ASSERT_EQ(3u, order.size());
+    EXPECT_EQ(0, order[0]);
+    EXPECT_EQ(1, order[1]);
+    EXPECT_EQ(2, order[2]);
+    EXPECT_GE(level1.expired_at_ - scheduled_at, std::chrono::milliseconds(100));
+    EXPECT_GE(level2.expired_at_ - scheduled_at, std::chrono::milliseconds(800));
+}
+
+TEST(TimerWheel, SeveralThreadsRunExpirationsInParallel)
+{
+    TimerWheel wheel;
+    wheel.start(2);
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    int running = 0;
+    std::atomic<int> overlapped(0);
+
+    // Each expiration waits for the other one to start.
+    auto callback = [&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++running;
+        cond.notify_all();
+        if(cond.wait_for(lock, std::chrono::seconds(1), [&]() { return running == 2; }))
+            ++overlapped;
+    };
+
+    TestEntry first(1), second(2);
+    first.callback_ = callback;
+    second.callback_ = callback;
+
+    wheel.schedule(first, std::chrono::milliseconds(10));
+    wheel.schedule(second, std::chrono::milliseconds(10));
+
+    ASSERT_TRUE(first.wait(1, 2000));
+    ASSERT_TRUE(second.wait(1, 2000));
+    EXPECT_EQ(2, overlapped.load());
+}
+
+TEST(TimerWheel, RemoveWaitsForRunningExpiration)
+{
+    TimerWheel wheel;
+    wheel.start(1);
+
+    std::atomic<bool> started(false);
+    std::atomic<bool> finished(false);
+
+    TestEntry entry(1);
+    entry.callback_ = [&]()
+    {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        finished = true;
+    };
+
+    wheel.schedule(entry, std::chrono::milliseconds(1));
+    while(!started)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    wheel.remove(entry);
+    EXPECT_TRUE(finished.load());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -16,17 +16,17 @@
 #define  _TEST_RTPS_RESOURCES_TIMEDEVENT_MOCKEVENT_H_
 
 #include <fastrtps/rtps/resources/TimedEvent.h>
+#include <fastrtps/rtps/resources/ResourceEvent.h>
 
 #include <atomic>
 #include <condition_variable>
-#include <asio.hpp>
 #include <thread>
 
 class MockEvent : public eprosima::fastrtps::rtps::TimedEvent
 {
     public:
 
-        MockEvent(asio::io_service &service, const std::thread& event_thread, double milliseconds, bool autorestart, TimedEvent::AUTODESTRUCTION_MODE autodestruction = TimedEvent::NONE);
+        MockEvent(eprosima::fastrtps::rtps::ResourceEvent& resource, double milliseconds, bool autorestart, TimedEvent::AUTODESTRUCTION_MODE autodestruction = TimedEvent::NONE);
 
         virtual ~MockEvent();
 
@@ -16,18 +16,18 @@
 #define  _TEST_RTPS_RESOURCES_TIMEDEVENT_MOCKPARENTEVENT_H_
 
 #include <fastrtps/rtps/resources/TimedEvent.h>
+#include <fastrtps/rtps/resources/ResourceEvent.h>
 #include "MockEvent.h"
 
 #include <atomic>
 #include <condition_variable>
-#include <asio.hpp>
 #include <thread>
 
 class MockParentEvent : public eprosima::fastrtps::rtps::TimedEvent
 {
     public:
 
-        MockParentEvent(asio::io_service &service, const std::thread& event_thread, double milliseconds, unsigned int countUntilDestruction,
+        MockParentEvent(eprosima::fastrtps::rtps::ResourceEvent& resource, double milliseconds, unsigned int countUntilDestruction,
                 TimedEvent::AUTODESTRUCTION_MODE autodestruction = TimedEvent::NONE);
 
         virtual ~MockParentEvent();
@@ -0,0 +1,277 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <rtps/resources/AsyncSendScheduler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+/*!
+ * Records the sends run by the scheduler. Sends can be blocked to keep the workers busy.
+ */
+class SendRecorder
+{
+    public:
+
+        SendRecorder() : blocked_(false), running_(0), max_running_(0), finished_(0) {}
+
+        void run(int id)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            order_.push_back(id);
+            max_running_ = (std::max)(max_running_, ++running_);
+            cv_.notify_all();
+
+            cv_.wait(lock, [this]() { return !blocked_; });
+
+            --running_;
+            ++finished_;
+            cv_.notify_all();
+        }
+
+        void block()
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            blocked_ = true;
+        }
+
+        void release()
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            blocked_ = false;
+            cv_.notify_all();
+        }
+
+        bool wait_started(size_t runs)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return cv_.wait_for(lock, std::chrono::seconds(5), [&]() { return order_.size() >= runs; });
+        }
+
+        bool wait_finished(size_t runs)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return cv_.wait_for(lock, std::chrono::seconds(5), [&]() { return finished_ >= runs; });
+        }
+
+        std::vector<int> order()
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return order_;
+        }
+
+        int max_running()
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return max_running_;
+        }
+
+    private:
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool blocked_;
+        int running_;
+        int max_running_;
+        size_t finished_;
+        std::vector<int> order_;
+};
+
+class WriterMock : public RTPSWriter
+{
+    public:
+
+        WriterMock(SendRecorder& recorder, int id)
+        {
+            ON_CALL(*this, send_any_unsent_changes()).WillByDefault(Invoke(
+                        [&recorder, id]() { recorder.run(id); }));
+        }
+
+        bool matched_reader_add(RemoteReaderAttributes&) { return true; }
+
+        bool matched_reader_remove(RemoteReaderAttributes&) { return true; }
+};
+
+TEST(AsyncSendSchedulerTests, registered_writers_are_run_when_woken_up)
+{
+    SendRecorder recorder;
+    NiceMock<WriterMock> writer_1(recorder, 1), writer_2(recorder, 2);
+    AsyncSendScheduler scheduler(2);
+
+    ASSERT_TRUE(scheduler.add_writer(&writer_1, NORMAL_PRIORITY_WRITER));
+    ASSERT_FALSE(scheduler.add_writer(&writer_1, HIGH_PRIORITY_WRITER));
+
+    // Writers that are not registered are ignored.
+    scheduler.wake_up(&writer_2);
+    scheduler.wake_up(&writer_1);
+    ASSERT_TRUE(recorder.wait_finished(1));
+
+    ASSERT_TRUE(scheduler.add_writer(&writer_2, NORMAL_PRIORITY_WRITER));
+    scheduler.wake_up_all();
+    ASSERT_TRUE(recorder.wait_finished(3));
+
+    ASSERT_TRUE(scheduler.remove_writer(&writer_1));
+    ASSERT_TRUE(scheduler.remove_writer(&writer_2));
+    ASSERT_FALSE(scheduler.remove_writer(&writer_2));
+
+    scheduler.wake_up(&writer_1);
+    scheduler.wake_up_all();
+
+    std::vector<int> order = recorder.order();
+    ASSERT_EQ(3u, order.size());
+    EXPECT_EQ(1, order[0]);
+    EXPECT_EQ(2, std::count(order.begin(), order.end(), 1));
+    EXPECT_EQ(1, std::count(order.begin(), order.end(), 2));
+}
+
+TEST(AsyncSendSchedulerTests, higher_priority_classes_are_served_first)
+{
+    SendRecorder recorder;
+    NiceMock<WriterMock> blocker(recorder, 0), low(recorder, 1), normal(recorder, 2), high(recorder, 3);
+    AsyncSendScheduler scheduler(1);
+
+    scheduler.add_writer(&blocker, LOW_PRIORITY_WRITER);
+    scheduler.add_writer(&low, LOW_PRIORITY_WRITER);
+    scheduler.add_writer(&normal, NORMAL_PRIORITY_WRITER);
+    scheduler.add_writer(&high, HIGH_PRIORITY_WRITER);
+
+    // Keep the only worker busy while the other writers are queued.
+    recorder.block();
+    scheduler.wake_up(&blocker);
+    ASSERT_TRUE(recorder.wait_started(1));
+
+    scheduler.wake_up(&low);
+    scheduler.wake_up(&normal);
+    scheduler.wake_up(&high);
+    recorder.release();
+    ASSERT_TRUE(recorder.wait_finished(4));
+
+    EXPECT_EQ(std::vector<int>({0, 3, 2, 1}), recorder.order());
+}
+
+TEST(AsyncSendSchedulerTests, writers_of_the_same_class_are_served_in_turns)
+{
+    SendRecorder recorder;
+    NiceMock<WriterMock> blocker(recorder, 0), writer_1(recorder, 1), writer_2(recorder, 2);
+    AsyncSendScheduler scheduler(1);
+
+    scheduler.add_writer(&blocker, NORMAL_PRIORITY_WRITER);
+    scheduler.add_writer(&writer_1, NORMAL_PRIORITY_WRITER);
+    scheduler.add_writer(&writer_2, NORMAL_PRIORITY_WRITER);
+
+    recorder.block();
+    scheduler.wake_up(&blocker);
+    ASSERT_TRUE(recorder.wait_started(1));
+
+    // A writer already queued is not queued twice.
+    scheduler.wake_up(&writer_1);
+    scheduler.wake_up(&writer_2);
+    scheduler.wake_up(&writer_1);
+    recorder.release();
+    ASSERT_TRUE(recorder.wait_finished(3));
+
+    scheduler.remove_writer(&blocker);
+    scheduler.remove_writer(&writer_1);
+    scheduler.remove_writer(&writer_2);
+
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), recorder.order());
+}
+
+TEST(AsyncSendSchedulerTests, a_writer_is_never_run_twice_at_the_same_time)
+{
+    SendRecorder recorder;
+    NiceMock<WriterMock> writer(recorder, 1);
+    AsyncSendScheduler scheduler(4);
+
+    scheduler.add_writer(&writer, NORMAL_PRIORITY_WRITER);
+
+    recorder.block();
+    scheduler.wake_up(&writer);
+    ASSERT_TRUE(recorder.wait_started(1));
+
+    // Wake ups received while the writer runs are folded into a single rerun.
+    std::vector<std::thread> wakers;
+    for(int i = 0; i < 3; ++i)
+    {
+        wakers.emplace_back([&]()
+                {
+                    for(int j = 0; j < 10; ++j)
+                    {
+                        scheduler.wake_up(&writer);
+                        scheduler.wake_up_all();
+                    }
+                });
+    }
+    for(std::thread& waker : wakers)
+    {
+        waker.join();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(1u, recorder.order().size());
+
+    recorder.release();
+    ASSERT_TRUE(recorder.wait_finished(2));
+    scheduler.remove_writer(&writer);
+
+    EXPECT_EQ(2u, recorder.order().size());
+    EXPECT_EQ(1, recorder.max_running());
+}
+
+TEST(AsyncSendSchedulerTests, remove_writer_waits_for_its_send_to_finish)
+{
+    SendRecorder recorder;
+    NiceMock<WriterMock> writer(recorder, 1);
+    AsyncSendScheduler scheduler(1);
+
+    scheduler.add_writer(&writer, NORMAL_PRIORITY_WRITER);
+
+    recorder.block();
+    scheduler.wake_up(&writer);
+    ASSERT_TRUE(recorder.wait_started(1));
+
+    std::atomic<bool> removed(false);
+    std::thread remover([&]()
+            {
+                scheduler.remove_writer(&writer);
+                removed = true;
+            });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(removed);
+
+    recorder.release();
+    remover.join();
+    EXPECT_TRUE(removed);
+    EXPECT_TRUE(recorder.wait_finished(1));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/writer/DestinationGroupCache.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+/*!
+ * Fills the destination of a set of readers, identified by number, and counts how many times it is called.
+ */
+class DestinationCounter
+{
+    public:
+
+        DestinationCounter() : calls(0) {}
+
+        void operator()(const std::vector<int>& readers, DestinationGroup& group)
+        {
+            ++calls;
+            for(int reader : readers)
+            {
+                GUID_t guid;
+                guid.entityId.value[3] = static_cast<octet>(reader);
+                group.guids.push_back(guid);
+                group.expectsInlineQos |= reader < 0;
+            }
+        }
+
+        int calls;
+};
+
+TEST(DestinationGroupCacheTests, destinations_are_computed_once_per_set_of_readers)
+{
+    DestinationGroupCache<int> cache;
+    DestinationCounter counter;
+    auto compute = [&counter](const std::vector<int>& readers, DestinationGroup& group) { counter(readers, group); };
+
+    const DestinationGroup& group = cache.get({1, 2}, compute);
+    ASSERT_EQ(2u, group.guids.size());
+    EXPECT_EQ(1, group.guids[0].entityId.value[3]);
+    EXPECT_EQ(2, group.guids[1].entityId.value[3]);
+    EXPECT_FALSE(group.expectsInlineQos);
+    EXPECT_EQ(1, counter.calls);
+
+    EXPECT_EQ(2u, cache.get({1, 2}, compute).guids.size());
+    EXPECT_EQ(1, counter.calls);
+
+    // Sets with the same readers in another order, or a subset of them, are different sets.
+    EXPECT_EQ(2u, cache.get({2, 1}, compute).guids.size());
+    EXPECT_EQ(1u, cache.get({1}, compute).guids.size());
+    EXPECT_TRUE(cache.get({1, -1}, compute).expectsInlineQos);
+    EXPECT_EQ(4, counter.calls);
+    EXPECT_EQ(4u, cache.size());
+}
+
+TEST(DestinationGroupCacheTests, clear_drops_every_destination)
+{
+    DestinationGroupCache<int> cache;
+    DestinationCounter counter;
+    auto compute = [&counter](const std::vector<int>& readers, DestinationGroup& group) { counter(readers, group); };
+
+    cache.get({1}, compute);
+    cache.get({1, 2}, compute);
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+
+    // The destinations are computed again, not merged with the old ones.
+    EXPECT_EQ(1u, cache.get({1}, compute).guids.size());
+    EXPECT_EQ(3, counter.calls);
+}
+
+TEST(DestinationGroupCacheTests, cache_is_bounded)
+{
+    DestinationGroupCache<int> cache;
+    DestinationCounter counter;
+    auto compute = [&counter](const std::vector<int>& readers, DestinationGroup& group) { counter(readers, group); };
+
+    ASSERT_EQ(256u, DestinationGroupCache<int>::default_max_groups);
+
+    for(int reader = 0; reader < 256; ++reader)
+    {
+        cache.get({reader}, compute);
+    }
+    EXPECT_EQ(256u, cache.size());
+    EXPECT_EQ(256, counter.calls);
+
+    // Cached sets are still found when the cache is full.
+    cache.get({0}, compute);
+    cache.get({255}, compute);
+    EXPECT_EQ(256u, cache.size());
+    EXPECT_EQ(256, counter.calls);
+
+    // A new set empties the cache before being added.
+    const DestinationGroup& group = cache.get({256}, compute);
+    ASSERT_EQ(1u, group.guids.size());
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_EQ(257, counter.calls);
+
+    cache.get({0}, compute);
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_EQ(258, counter.calls);
+}
+
+TEST(DestinationGroupCacheTests, limit_can_be_set)
+{
+    DestinationGroupCache<int> cache(2);
+    DestinationCounter counter;
+    auto compute = [&counter](const std::vector<int>& readers, DestinationGroup& group) { counter(readers, group); };
+
+    cache.get({1}, compute);
+    cache.get({2}, compute);
+    EXPECT_EQ(2u, cache.size());
+    cache.get({3}, compute);
+    EXPECT_EQ(1u, cache.size());
+    cache.get({1}, compute);
+    EXPECT_EQ(4, counter.calls);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/writer/FragmentPacingBudget.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+using namespace eprosima::fastrtps::rtps;
+
+class FragmentPacingBudgetTests : public ::testing::Test
+{
+    protected:
+
+        FragmentPacingBudgetTests() : pacing(1000, 100), start(std::chrono::steady_clock::now()) {}
+
+        std::chrono::steady_clock::time_point at(int milliseconds)
+        {
+            return start + std::chrono::milliseconds(milliseconds);
+        }
+
+        ThroughputControllerDescriptor pacing;
+        std::chrono::steady_clock::time_point start;
+        FragmentPacingBudget budget;
+};
+
+TEST_F(FragmentPacingBudgetTests, sent_bytes_are_accounted_until_the_period_is_over)
+{
+    EXPECT_EQ(1000u, budget.available(pacing, at(0)));
+
+    budget.sent(300);
+    EXPECT_EQ(700u, budget.available(pacing, at(10)));
+
+    budget.sent(700);
+    EXPECT_EQ(0u, budget.available(pacing, at(99)));
+
+    // Bytes over the budget are accounted too.
+    budget.sent(500);
+    EXPECT_EQ(0u, budget.available(pacing, at(99)));
+
+    // The period started on the first call, so a new one starts 100 ms later.
+    EXPECT_EQ(1000u, budget.available(pacing, at(100)));
+    budget.sent(400);
+    EXPECT_EQ(600u, budget.available(pacing, at(150)));
+    EXPECT_EQ(1000u, budget.available(pacing, at(200)));
+}
+
+TEST_F(FragmentPacingBudgetTests, fragments_are_taken_while_they_fit)
+{
+    uint32_t available = budget.available(pacing, at(0));
+
+    EXPECT_TRUE(FragmentPacingBudget::take(400, available, pacing));
+    EXPECT_EQ(600u, available);
+    EXPECT_TRUE(FragmentPacingBudget::take(400, available, pacing));
+    EXPECT_EQ(200u, available);
+    EXPECT_FALSE(FragmentPacingBudget::take(400, available, pacing));
+    EXPECT_EQ(200u, available);
+
+    // A smaller fragment still fits.
+    EXPECT_TRUE(FragmentPacingBudget::take(200, available, pacing));
+    EXPECT_EQ(0u, available);
+    EXPECT_FALSE(FragmentPacingBudget::take(1, available, pacing));
+}
+
+TEST_F(FragmentPacingBudgetTests, a_period_lets_at_least_one_fragment_through)
+{
+    // A fragment larger than the whole period is sent alone at the start of a period.
+    uint32_t available = budget.available(pacing, at(0));
+    EXPECT_TRUE(FragmentPacingBudget::take(1500, available, pacing));
+    EXPECT_EQ(0u, available);
+    EXPECT_FALSE(FragmentPacingBudget::take(1500, available, pacing));
+    budget.sent(1500);
+
+    // But not once the period has been used.
+    available = budget.available(pacing, at(50));
+    EXPECT_FALSE(FragmentPacingBudget::take(1500, available, pacing));
+
+    available = budget.available(pacing, at(100));
+    EXPECT_EQ(1000u, available);
+    EXPECT_TRUE(FragmentPacingBudget::take(100, available, pacing));
+    EXPECT_FALSE(FragmentPacingBudget::take(1500, available, pacing));
+}
+
+TEST_F(FragmentPacingBudgetTests, unlimited_pacing_takes_every_fragment)
+{
+    ThroughputControllerDescriptor unlimited;
+    uint32_t available = UINT32_MAX;
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(FragmentPacingBudget::take(64000, available, unlimited));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,198 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/writer/RTPSWriterCollector.h>
+
+#include <memory>
+#include <set>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+typedef RTPSWriterCollector<int> Collector;
+
+static const size_t numberOfChanges = 100;
+
+class RTPSWriterCollectorTests : public ::testing::Test
+{
+    public:
+
+        RTPSWriterCollectorTests()
+        {
+            for(uint32_t i = 0; i < numberOfChanges; ++i)
+            {
+                changes.emplace_back(new CacheChange_t());
+                changes.back()->sequenceNumber = {0, i + 1};
+            }
+        }
+
+        void fragment(size_t index, uint32_t fragments)
+        {
+            changes[index]->serializedPayload.length = fragments * 100;
+            changes[index]->setFragmentSize(100);
+        }
+
+        void collect_all(Collector& collector, int readers)
+        {
+            for(int reader = 0; reader < readers; ++reader)
+                for(auto& change : changes)
+                    collector.add_change(change.get(), reader, FragmentNumberSet_t());
+        }
+
+        std::vector<std::unique_ptr<CacheChange_t>> changes;
+};
+
+TEST_F(RTPSWriterCollectorTests, items_are_ordered_and_grouped_by_change)
+{
+    Collector collector;
+
+    // Collected in reverse order, by two readers.
+    for(int reader = 0; reader < 2; ++reader)
+        for(auto it = changes.rbegin(); it != changes.rend(); ++it)
+            collector.add_change(it->get(), reader, FragmentNumberSet_t());
+
+    ASSERT_EQ(numberOfChanges, collector.size());
+
+    SequenceNumber_t expected(0, 1);
+    for(auto& item : collector)
+    {
+        EXPECT_EQ(expected, item.sequenceNumber);
+        EXPECT_EQ(0u, item.fragmentNumber);
+        EXPECT_EQ(expected, item.cacheChange->sequenceNumber);
+        ASSERT_EQ(2u, item.remoteReaders.size());
+        EXPECT_EQ(0, item.remoteReaders[0]);
+        EXPECT_EQ(1, item.remoteReaders[1]);
+        ++expected;
+    }
+}
+
+TEST_F(RTPSWriterCollectorTests, erase_removes_only_the_given_items)
+{
+    Collector collector;
+    collect_all(collector, 1);
+
+    // Like a flow controller: the first ten go through.
+    collector.erase(collector.begin() + 10, collector.end());
+    ASSERT_EQ(10u, collector.size());
+
+    // Items erased from the middle.
+    collector.erase(collector.begin() + 2, collector.begin() + 8);
+    ASSERT_EQ(4u, collector.size());
+
+    EXPECT_EQ(SequenceNumber_t(0, 1), collector.pop().sequenceNumber);
+    EXPECT_EQ(SequenceNumber_t(0, 2), collector.pop().sequenceNumber);
+    EXPECT_EQ(SequenceNumber_t(0, 9), collector.pop().sequenceNumber);
+    EXPECT_EQ(SequenceNumber_t(0, 10), collector.pop().sequenceNumber);
+    EXPECT_TRUE(collector.empty());
+
+    // Reused items do not keep the readers of their previous use.
+    collector.add_change(changes.front().get(), 7, FragmentNumberSet_t());
+    ASSERT_EQ(1u, collector.size());
+    ASSERT_EQ(1u, collector.begin()->remoteReaders.size());
+    EXPECT_EQ(7, collector.begin()->remoteReaders[0]);
+}
+
+TEST_F(RTPSWriterCollectorTests, collecting_again_the_same_load_reuses_the_storage)
+{
+    Collector collector;
+
+    // First round grows the storage.
+    collect_all(collector, 3);
+    const Collector::Item* items = &*collector.begin();
+    std::set<const int*> readers;
+    for(auto& item : collector)
+        readers.insert(item.remoteReaders.data());
+    ASSERT_EQ(numberOfChanges, readers.size());
+    collector.clear();
+
+    // The items, and the readers of each one, keep the storage of the first round.
+    for(int round = 0; round < 10; ++round)
+    {
+        collect_all(collector, 3);
+        ASSERT_EQ(numberOfChanges, collector.size());
+        EXPECT_EQ(items, &*collector.begin());
+
+        std::set<const int*> reused;
+        for(auto& item : collector)
+            reused.insert(item.remoteReaders.data());
+        EXPECT_EQ(readers, reused);
+
+        collector.erase(collector.begin() + numberOfChanges / 2, collector.end());
+        collector.clear();
+    }
+}
+
+TEST_F(RTPSWriterCollectorTests, interleaved_fragments_are_ordered_by_fragment_number)
+{
+    Collector collector(true);
+    fragment(0, 3);
+    fragment(1, 3);
+
+    // Two fragmented changes and a whole one.
+    for(FragmentNumber_t fragmentNumber = 1; fragmentNumber <= 3; ++fragmentNumber)
+    {
+        collector.add_fragment(changes[1].get(), fragmentNumber, 0);
+        collector.add_fragment(changes[0].get(), fragmentNumber, 0);
+    }
+    collector.add_change(changes[2].get(), 0, FragmentNumberSet_t());
+    collector.add_fragment(changes[0].get(), 1, 1);
+
+    ASSERT_EQ(7u, collector.size());
+
+    // The whole change first, then one fragment of each change in turn.
+    EXPECT_EQ(SequenceNumber_t(0, 3), collector.begin()->sequenceNumber);
+    EXPECT_EQ(0u, collector.begin()->fragmentNumber);
+
+    FragmentNumber_t expectedFragment = 1;
+    uint32_t expectedChange = 1;
+    for(auto it = collector.begin() + 1; it != collector.end(); ++it)
+    {
+        EXPECT_EQ(expectedFragment, it->fragmentNumber);
+        EXPECT_EQ(SequenceNumber_t(0, expectedChange), it->sequenceNumber);
+        EXPECT_EQ(expectedChange == 1 && expectedFragment == 1 ? 2u : 1u, it->remoteReaders.size());
+
+        if(++expectedChange > 2)
+        {
+            expectedChange = 1;
+            ++expectedFragment;
+        }
+    }
+}
+
+TEST_F(RTPSWriterCollectorTests, sequential_fragments_are_ordered_by_change)
+{
+    Collector collector;
+    fragment(0, 2);
+    fragment(1, 2);
+
+    for(FragmentNumber_t fragmentNumber = 1; fragmentNumber <= 2; ++fragmentNumber)
+    {
+        collector.add_fragment(changes[1].get(), fragmentNumber, 0);
+        collector.add_fragment(changes[0].get(), fragmentNumber, 0);
+    }
+
+    ASSERT_EQ(4u, collector.size());
+    EXPECT_EQ(SequenceNumber_t(0, 1), collector.begin()[0].sequenceNumber);
+    EXPECT_EQ(1u, collector.begin()[0].fragmentNumber);
+    EXPECT_EQ(SequenceNumber_t(0, 1), collector.begin()[1].sequenceNumber);
+    EXPECT_EQ(2u, collector.begin()[1].fragmentNumber);
+    EXPECT_EQ(SequenceNumber_t(0, 2), collector.begin()[2].sequenceNumber);
+    EXPECT_EQ(1u, collector.begin()[2].fragmentNumber);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
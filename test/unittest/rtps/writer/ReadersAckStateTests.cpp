@@ -0,0 +1,134 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/writer/ReadersAckState.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+static SequenceNumber_t sn(uint32_t low)
+{
+    return SequenceNumber_t(0, low);
+}
+
+TEST(ReadersAckStateTests, without_readers_everything_is_acked)
+{
+    ReadersAckState state;
+
+    EXPECT_TRUE(state.all_acked());
+    EXPECT_EQ(SequenceNumber_t(), state.low_mark());
+    EXPECT_FALSE(state.is_acked_by_all(sn(1)));
+}
+
+TEST(ReadersAckStateTests, low_mark_is_the_lowest_of_the_readers)
+{
+    ReadersAckState state;
+
+    state.add_reader(sn(0), false);
+    state.add_reader(sn(0), false);
+    state.add_reader(sn(0), false);
+    EXPECT_EQ(sn(0), state.low_mark());
+
+    // Readers acknowledge in any order, and several readers share a low mark.
+    state.reader_changed(sn(0), false, sn(5), false);
+    EXPECT_EQ(sn(0), state.low_mark());
+    state.reader_changed(sn(0), false, sn(3), false);
+    EXPECT_EQ(sn(0), state.low_mark());
+    state.reader_changed(sn(0), false, sn(3), false);
+    EXPECT_EQ(sn(3), state.low_mark());
+    EXPECT_TRUE(state.is_acked_by_all(sn(3)));
+    EXPECT_FALSE(state.is_acked_by_all(sn(4)));
+
+    state.reader_changed(sn(3), false, sn(7), false);
+    EXPECT_EQ(sn(3), state.low_mark());
+    state.reader_changed(sn(3), false, sn(6), false);
+    EXPECT_EQ(sn(5), state.low_mark());
+
+    // Removing the slowest reader raises the low mark.
+    state.remove_reader(sn(5), false);
+    EXPECT_EQ(sn(6), state.low_mark());
+    state.remove_reader(sn(6), false);
+    EXPECT_EQ(sn(7), state.low_mark());
+    state.remove_reader(sn(7), false);
+    EXPECT_EQ(SequenceNumber_t(), state.low_mark());
+}
+
+TEST(ReadersAckStateTests, readers_with_changes_are_counted)
+{
+    ReadersAckState state;
+
+    state.add_reader(sn(0), false);
+    state.add_reader(sn(0), false);
+    EXPECT_TRUE(state.all_acked());
+
+    state.reader_changed(sn(0), false, sn(0), true);
+    state.reader_changed(sn(0), false, sn(0), true);
+    EXPECT_FALSE(state.all_acked());
+
+    // A new change for a reader that had some already changes nothing.
+    state.reader_changed(sn(0), true, sn(0), true);
+    state.reader_changed(sn(0), true, sn(2), true);
+    EXPECT_FALSE(state.all_acked());
+
+    state.reader_changed(sn(2), true, sn(4), false);
+    EXPECT_FALSE(state.all_acked());
+    state.reader_changed(sn(0), true, sn(4), false);
+    EXPECT_TRUE(state.all_acked());
+
+    // A reader removed with changes pending stops being waited for.
+    state.reader_changed(sn(4), false, sn(4), true);
+    EXPECT_FALSE(state.all_acked());
+    state.remove_reader(sn(4), true);
+    EXPECT_TRUE(state.all_acked());
+    EXPECT_EQ(sn(4), state.low_mark());
+}
+
+TEST(ReadersAckStateTests, changes_are_notified_once)
+{
+    std::vector<CacheChange_t> storage(5);
+    std::vector<CacheChange_t*> history;
+    for(uint32_t i = 0; i < storage.size(); ++i)
+    {
+        // The history has a gap: 1, 2, 4, 5, 6.
+        storage[i].sequenceNumber = sn(i < 2 ? i + 1 : i + 2);
+        history.push_back(&storage[i]);
+    }
+
+    ReadersAckState state;
+    EXPECT_EQ(history.begin(), state.first_not_notified(history.begin(), history.end()));
+
+    state.notified(sn(2));
+    EXPECT_EQ(sn(2), state.last_notified());
+    EXPECT_EQ(history.begin() + 2, state.first_not_notified(history.begin(), history.end()));
+
+    // The gap is skipped.
+    state.notified(sn(3));
+    EXPECT_EQ(history.begin() + 2, state.first_not_notified(history.begin(), history.end()));
+
+    // Older notifications do not move it back.
+    state.notified(sn(1));
+    EXPECT_EQ(sn(3), state.last_notified());
+
+    state.notified(sn(6));
+    EXPECT_EQ(history.end(), state.first_not_notified(history.begin(), history.end()));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
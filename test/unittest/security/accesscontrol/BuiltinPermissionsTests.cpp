@@ -0,0 +1,188 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../../../src/cpp/security/accesscontrol/Permissions.h"
+#include "../../../../src/cpp/security/accesscontrol/AccessPermissionsHandle.h"
+#include <fastrtps/rtps/builtin/data/WriterProxyData.h>
+#include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using namespace eprosima::fastrtps::rtps::security;
+
+class AccessControlPermissionsTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp()
+        {
+            AccessPermissions& permissions = **handle;
+
+            // Allowed and Denied are protected topics with a grant rule for domain 0. NotGranted is protected
+            // but no grant rule allows it. Open is not protected. Missing has no governance rule.
+            EndpointSecurityAttributes protected_topic;
+            protected_topic.is_access_protected = true;
+            EndpointSecurityAttributes open_topic;
+            open_topic.is_access_protected = false;
+
+            for(auto rules : {&permissions.governance_writer_topic_rules_,
+                    &permissions.governance_reader_topic_rules_})
+            {
+                rules->emplace("Allowed*", protected_topic);
+                rules->emplace("Denied", protected_topic);
+                rules->emplace("NotGranted", protected_topic);
+                rules->emplace("Open", open_topic);
+            }
+
+            Criteria allowed_criteria;
+            allowed_criteria.topics.push_back("Allowed*");
+            Criteria denied_criteria;
+            denied_criteria.topics.push_back("Denied");
+
+            Rule deny_rule;
+            deny_rule.allow = false;
+            deny_rule.domains.ranges.emplace_back(0, 0);
+            deny_rule.publishes.push_back(denied_criteria);
+            deny_rule.subscribes.push_back(denied_criteria);
+            permissions.grant.rules.push_back(deny_rule);
+
+            Rule allow_rule;
+            allow_rule.allow = true;
+            allow_rule.domains.ranges.emplace_back(0, 0);
+            allow_rule.publishes.push_back(allowed_criteria);
+            allow_rule.subscribes.push_back(allowed_criteria);
+            permissions.grant.rules.push_back(allow_rule);
+        }
+
+        virtual void TearDown()
+        {
+        }
+
+    public:
+
+        AccessControlPermissionsTest() {}
+
+        bool check_remote_datawriter(const std::string& topic_name, uint32_t domain_id, std::string& message)
+        {
+            WriterProxyData publication_data;
+            publication_data.topicName(topic_name);
+            SecurityException exception;
+            bool returned_value = plugin.check_remote_datawriter(handle, domain_id, publication_data, exception);
+            message = exception.what();
+            return returned_value;
+        }
+
+        bool check_remote_datareader(const std::string& topic_name, uint32_t domain_id, std::string& message)
+        {
+            ReaderProxyData subscription_data;
+            subscription_data.topicName(topic_name);
+            SecurityException exception;
+            bool returned_value = plugin.check_remote_datareader(handle, domain_id, subscription_data, exception);
+            message = exception.what();
+            return returned_value;
+        }
+
+        Permissions plugin;
+        AccessPermissionsHandle handle;
+};
+
+TEST_F(AccessControlPermissionsTest, check_remote_endpoints_decisions)
+{
+    std::string message;
+
+    ASSERT_TRUE(check_remote_datawriter("AllowedTopic", 0, message));
+    ASSERT_TRUE(message.empty());
+    ASSERT_TRUE(check_remote_datareader("AllowedTopic", 0, message));
+    ASSERT_TRUE(message.empty());
+
+    ASSERT_TRUE(check_remote_datawriter("Open", 1, message));
+    ASSERT_TRUE(message.empty());
+    ASSERT_TRUE(check_remote_datareader("Open", 1, message));
+    ASSERT_TRUE(message.empty());
+
+    ASSERT_FALSE(check_remote_datawriter("AllowedTopic", 1, message));
+    ASSERT_EQ(message.find("AllowedTopic topic not found in allow rule."), 0u);
+    ASSERT_FALSE(check_remote_datareader("AllowedTopic", 1, message));
+    ASSERT_EQ(message.find("AllowedTopic topic not found in allow rule."), 0u);
+
+    ASSERT_FALSE(check_remote_datawriter("Denied", 0, message));
+    ASSERT_EQ(message.find("Denied topic denied by deny rule."), 0u);
+    ASSERT_FALSE(check_remote_datareader("Denied", 0, message));
+    ASSERT_EQ(message.find("Denied topic denied by deny rule."), 0u);
+
+    ASSERT_FALSE(check_remote_datawriter("NotGranted", 0, message));
+    ASSERT_EQ(message.find("NotGranted topic not found in allow rule."), 0u);
+    ASSERT_FALSE(check_remote_datareader("NotGranted", 0, message));
+    ASSERT_EQ(message.find("NotGranted topic not found in allow rule."), 0u);
+
+    ASSERT_FALSE(check_remote_datawriter("Missing", 0, message));
+    ASSERT_EQ(message.find("Not found topic access rule for topic Missing"), 0u);
+    ASSERT_FALSE(check_remote_datareader("Missing", 0, message));
+    ASSERT_EQ(message.find("Not found topic access rule for topic Missing"), 0u);
+}
+
+TEST_F(AccessControlPermissionsTest, check_remote_endpoints_repeated_decisions)
+{
+    const std::vector<std::pair<std::string, uint32_t>> checks = {
+        {"AllowedTopic", 0}, {"AllowedOtherTopic", 0}, {"AllowedTopic", 1}, {"Open", 0}, {"Denied", 0},
+        {"NotGranted", 0}, {"Missing", 0}};
+
+    std::vector<bool> writer_results, reader_results;
+    std::vector<std::string> writer_messages, reader_messages;
+
+    for(const auto& check : checks)
+    {
+        std::string message;
+        writer_results.push_back(check_remote_datawriter(check.first, check.second, message));
+        writer_messages.push_back(message);
+        reader_results.push_back(check_remote_datareader(check.first, check.second, message));
+        reader_messages.push_back(message);
+    }
+
+    ASSERT_EQ((**handle).remote_writer_decisions_.size(), checks.size());
+    ASSERT_EQ((**handle).remote_reader_decisions_.size(), checks.size());
+
+    // Once taken, decisions do not depend on the grant anymore.
+    (**handle).grant.rules.clear();
+
+    for(int repetition = 0; repetition < 3; ++repetition)
+    {
+        for(size_t i = 0; i < checks.size(); ++i)
+        {
+            std::string message;
+            ASSERT_EQ(check_remote_datawriter(checks[i].first, checks[i].second, message), writer_results[i]);
+            ASSERT_EQ(message, writer_messages[i]);
+            ASSERT_EQ(check_remote_datareader(checks[i].first, checks[i].second, message), reader_results[i]);
+            ASSERT_EQ(message, reader_messages[i]);
+        }
+    }
+
+    ASSERT_EQ((**handle).remote_writer_decisions_.size(), checks.size());
+    ASSERT_EQ((**handle).remote_reader_decisions_.size(), checks.size());
+
+    // New topics are decided with the current grant.
+    std::string message;
+    ASSERT_FALSE(check_remote_datawriter("AllowedNewTopic", 0, message));
+    ASSERT_EQ(message.find("AllowedNewTopic topic not found in allow rule."), 0u);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
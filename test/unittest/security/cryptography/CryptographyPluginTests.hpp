@@ -24,6 +24,7 @@
 #include <openssl/rand.h>
 #include <cstdlib>
 #include <cstring>
+#include <set>
 
 class CryptographyPluginTest : public ::testing::Test
 {
@@ -1303,4 +1304,148 @@ TEST_F(CryptographyPluginTest, transform_preprocess_secure_submessage)
     delete i_handle;
 }
 
+TEST_F(CryptographyPluginTest, transform_RTPSMessage_session_renewal)
+{
+    eprosima::fastrtps::rtps::security::PKIIdentityHandle* i_handle = new eprosima::fastrtps::rtps::security::PKIIdentityHandle();
+    eprosima::fastrtps::rtps::security::AccessPermissionsHandle* perm_handle = new eprosima::fastrtps::rtps::security::AccessPermissionsHandle();
+    eprosima::fastrtps::rtps::PropertySeq prop_handle;
+    eprosima::fastrtps::rtps::security::SharedSecretHandle* shared_secret = new eprosima::fastrtps::rtps::security::SharedSecretHandle();
+
+    eprosima::fastrtps::rtps::security::SecurityException exception;
+
+    //Fill shared secret with dummy values
+    std::vector<uint8_t> dummy_data, challenge_1, challenge_2;
+    eprosima::fastrtps::rtps::security::SharedSecret::BinaryData binary_data;
+    challenge_1.resize(8);
+    challenge_2.resize(8);
+
+    RAND_bytes(challenge_1.data(),8);
+    binary_data.name("Challenge1");
+    binary_data.value(challenge_1);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    RAND_bytes(challenge_2.data(),8);
+    binary_data.name("Challenge2");
+    binary_data.value(challenge_2);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    dummy_data.resize(32);
+    RAND_bytes(dummy_data.data(),32);
+    binary_data.name("SharedSecret");
+    binary_data.value(dummy_data);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    //Session keys are updated every 4 messages of 1024 bytes
+    const uint32_t message_length = 1024;
+    eprosima::fastrtps::rtps::Property prop1;
+    prop1.name("dds.sec.crypto.maxblockspersession");
+    prop1.value("1000000");
+    prop_handle.push_back(prop1);
+    eprosima::fastrtps::rtps::Property prop2;
+    prop2.name("dds.sec.crypto.maxbytespersession");
+    prop2.value("4096");
+    prop_handle.push_back(prop2);
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantA = CryptoPlugin->keyfactory()->register_local_participant(*i_handle,*perm_handle,prop_handle,exception);
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantB = CryptoPlugin->keyfactory()->register_local_participant(*i_handle,*perm_handle,prop_handle,exception);
+
+    ASSERT_TRUE( (ParticipantA != nullptr) & (ParticipantB != nullptr) );
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantA_remote =CryptoPlugin->keyfactory()->register_matched_remote_participant(*ParticipantA,*i_handle,*perm_handle,*shared_secret, exception);
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantB_remote =CryptoPlugin->keyfactory()->register_matched_remote_participant(*ParticipantB,*i_handle,*perm_handle,*shared_secret, exception);
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoTokenSeq ParticipantA_CryptoTokens, ParticipantB_CryptoTokens;
+
+    CryptoPlugin->keyexchange()->create_local_participant_crypto_tokens(ParticipantA_CryptoTokens, *ParticipantA, *ParticipantA_remote, exception);
+    CryptoPlugin->keyexchange()->create_local_participant_crypto_tokens(ParticipantB_CryptoTokens, *ParticipantB, *ParticipantB_remote, exception);
+
+    CryptoPlugin->keyexchange()->set_remote_participant_crypto_tokens(*ParticipantA,*ParticipantA_remote,ParticipantB_CryptoTokens,exception);
+    CryptoPlugin->keyexchange()->set_remote_participant_crypto_tokens(*ParticipantB,*ParticipantB_remote,ParticipantA_CryptoTokens,exception);
+
+    eprosima::fastrtps::rtps::CDRMessage_t plain_rtps_message;
+    eprosima::fastrtps::rtps::CDRMessage_t encoded_rtps_message;
+    eprosima::fastrtps::rtps::CDRMessage_t decoded_rtps_message;
+
+    RAND_bytes(plain_rtps_message.buffer, message_length);
+    plain_rtps_message.length = message_length;
+
+    std::vector<eprosima::fastrtps::rtps::security::ParticipantCryptoHandle*> receivers;
+    receivers.push_back(ParticipantA_remote);
+
+    eprosima::fastrtps::rtps::security::AESGCMGMAC_ParticipantCryptoHandle& local_participant =
+        eprosima::fastrtps::rtps::security::AESGCMGMAC_ParticipantCryptoHandle::narrow(*ParticipantA);
+    std::vector<uint32_t> session_ids;
+
+    const int messages = 40;
+
+    for(int i = 0; i < messages; ++i)
+    {
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->encode_rtps_message(encoded_rtps_message, plain_rtps_message,*ParticipantA,receivers,exception));
+        encoded_rtps_message.pos = 0;
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->decode_rtps_message(decoded_rtps_message,encoded_rtps_message,*ParticipantB,*ParticipantB_remote,exception));
+
+        ASSERT_EQ(plain_rtps_message.length, decoded_rtps_message.length);
+        ASSERT_EQ(0, memcmp(plain_rtps_message.buffer, decoded_rtps_message.buffer, message_length));
+        session_ids.push_back(local_participant->session_id);
+
+        plain_rtps_message.pos = 0;
+        encoded_rtps_message.pos = 0;
+        encoded_rtps_message.length = 0;
+        decoded_rtps_message.pos = 0;
+        decoded_rtps_message.length = 0;
+    }
+
+    // A new session starts every four messages, and only then.
+    for(int i = 1; i < messages; ++i)
+    {
+        if(i % 4 == 0)
+            EXPECT_NE(session_ids[i - 1], session_ids[i]) << "Message " << i;
+        else
+            EXPECT_EQ(session_ids[i - 1], session_ids[i]) << "Message " << i;
+    }
+    EXPECT_EQ(static_cast<size_t>(messages / 4), std::set<uint32_t>(session_ids.begin(), session_ids.end()).size());
+
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantA,exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantB,exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantA_remote,exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantB_remote,exception);
+
+    delete shared_secret;
+    delete perm_handle;
+    delete i_handle;
+}
+
+TEST_F(CryptographyPluginTest, factory_MaxBytesPerSessionProperty)
+{
+    eprosima::fastrtps::rtps::security::PKIIdentityHandle* i_handle = new eprosima::fastrtps::rtps::security::PKIIdentityHandle();
+    eprosima::fastrtps::rtps::security::AccessPermissionsHandle* perm_handle = new eprosima::fastrtps::rtps::security::AccessPermissionsHandle();
+    eprosima::fastrtps::rtps::security::SecurityException exception;
+
+    // Values that are not a non-negative 64 bits number leave the byte budget disabled.
+    const std::vector<std::pair<std::string, uint64_t>> values = {
+        {"4096", 4096}, {" 4096", 4096}, {"-1", 0}, {" -1", 0}, {"bytes", 0}, {"", 0},
+        {"18446744073709551615", 18446744073709551615ull}, {"18446744073709551616", 0}
+    };
+
+    for(const auto& value : values)
+    {
+        eprosima::fastrtps::rtps::PropertySeq prop_handle;
+        eprosima::fastrtps::rtps::Property prop;
+        prop.name("dds.sec.crypto.maxbytespersession");
+        prop.value(value.first);
+        prop_handle.push_back(prop);
+
+        eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *target = CryptoPlugin->keyfactory()->register_local_participant(*i_handle,*perm_handle,prop_handle,exception);
+        ASSERT_TRUE(target != nullptr);
+
+        eprosima::fastrtps::rtps::security::AESGCMGMAC_ParticipantCryptoHandle& local_participant = eprosima::fastrtps::rtps::security::AESGCMGMAC_ParticipantCryptoHandle::narrow(*target);
+        EXPECT_EQ(value.second, local_participant->max_bytes_per_session) << "Value: \"" << value.first << "\"";
+
+        CryptoPlugin->keyfactory()->unregister_participant(target,exception);
+    }
+
+    delete perm_handle;
+    delete i_handle;
+}
+
 #endif
@@ -0,0 +1,247 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <fastrtps/log/Log.h>
+#include <memory>
+#include <unistd.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+const uint32_t ReceiveBufferCapacity = 65536;
+
+static uint16_t g_default_port = 0;
+
+uint16_t get_port()
+{
+    uint16_t port = static_cast<uint16_t>(getpid());
+
+    if(4000 > port)
+    {
+        port += 4000;
+    }
+
+    return port;
+}
+
+class SharedMemTests: public ::testing::Test
+{
+    public:
+        SharedMemTests()
+        {
+            HELPER_SetDescriptorDefaults();
+        }
+
+        ~SharedMemTests()
+        {
+            Log::KillThread();
+        }
+
+        void HELPER_SetDescriptorDefaults();
+
+        Locator_t HELPER_Locator(uint32_t port);
+
+        SharedMemTransportDescriptor descriptor;
+        std::unique_ptr<std::thread> senderThread;
+        std::unique_ptr<std::thread> receiverThread;
+};
+
+TEST_F(SharedMemTests, locators_with_kind_shm_supported)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t supportedLocator;
+    supportedLocator.kind = LOCATOR_KIND_SHM;
+    Locator_t unsupportedLocator;
+    unsupportedLocator.kind = LOCATOR_KIND_UDPv4;
+
+    // Then
+    ASSERT_TRUE(transportUnderTest.IsLocatorSupported(supportedLocator));
+    ASSERT_FALSE(transportUnderTest.IsLocatorSupported(unsupportedLocator));
+}
+
+TEST_F(SharedMemTests, opening_and_closing_input_channel)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t inputChannelLocator = HELPER_Locator(g_default_port);
+
+    // Then
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputChannelLocator));
+    ASSERT_TRUE  (transportUnderTest.OpenInputChannel(inputChannelLocator));
+    ASSERT_TRUE  (transportUnderTest.IsInputChannelOpen(inputChannelLocator));
+    ASSERT_TRUE  (transportUnderTest.CloseInputChannel(inputChannelLocator));
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputChannelLocator));
+    ASSERT_FALSE (transportUnderTest.CloseInputChannel(inputChannelLocator));
+}
+
+TEST_F(SharedMemTests, input_channel_is_owned_by_one_transport)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+    SharedMemTransport otherTransport(descriptor);
+    otherTransport.init();
+
+    Locator_t inputChannelLocator = HELPER_Locator(g_default_port);
+
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputChannelLocator));
+    ASSERT_FALSE(otherTransport.OpenInputChannel(inputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputChannelLocator));
+    ASSERT_TRUE(otherTransport.OpenInputChannel(inputChannelLocator));
+}
+
+TEST_F(SharedMemTests, send_and_receive_between_transports)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+    SharedMemTransport senderTransport(descriptor);
+    senderTransport.init();
+
+    Locator_t inputChannelLocator = HELPER_Locator(g_default_port);
+    Locator_t outputChannelLocator = senderTransport.RemoteToMainLocal(inputChannelLocator);
+    ASSERT_TRUE(senderTransport.OpenOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputChannelLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(senderTransport.Send(message, 5, outputChannelLocator, inputChannelLocator));
+    };
+
+    auto receiveThreadFunction = [&]()
+    {
+        std::vector<octet> receiveBuffer(ReceiveBufferCapacity);
+        uint32_t receiveBufferSize = 0;
+
+        Locator_t remoteLocatorToReceive;
+        EXPECT_TRUE(transportUnderTest.Receive(receiveBuffer.data(), ReceiveBufferCapacity, receiveBufferSize,
+                    inputChannelLocator, remoteLocatorToReceive));
+        EXPECT_EQ(receiveBufferSize, 5u);
+        EXPECT_EQ(memcmp(message, receiveBuffer.data(), 5), 0);
+        EXPECT_EQ(remoteLocatorToReceive.kind, LOCATOR_KIND_UDPv4);
+        EXPECT_EQ(remoteLocatorToReceive.to_IP4_string(), "127.0.0.1");
+    };
+
+    receiverThread.reset(new std::thread(receiveThreadFunction));
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    receiverThread->join();
+}
+
+TEST_F(SharedMemTests, send_fails_when_there_is_no_input_channel)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t remoteLocator = HELPER_Locator(g_default_port + 1);
+    Locator_t outputChannelLocator = transportUnderTest.RemoteToMainLocal(remoteLocator);
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    ASSERT_FALSE(transportUnderTest.Send(message, 5, outputChannelLocator, remoteLocator));
+}
+
+TEST_F(SharedMemTests, send_fails_when_queue_is_full)
+{
+    descriptor.queueSize = 2;
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t inputChannelLocator = HELPER_Locator(g_default_port);
+    Locator_t outputChannelLocator = transportUnderTest.RemoteToMainLocal(inputChannelLocator);
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputChannelLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    ASSERT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, inputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, inputChannelLocator));
+    ASSERT_FALSE(transportUnderTest.Send(message, 5, outputChannelLocator, inputChannelLocator));
+
+    // Taking one message makes room for another one.
+    std::vector<octet> receiveBuffer(ReceiveBufferCapacity);
+    uint32_t receiveBufferSize = 0;
+    Locator_t remoteLocatorToReceive;
+    ASSERT_TRUE(transportUnderTest.Receive(receiveBuffer.data(), ReceiveBufferCapacity, receiveBufferSize,
+                inputChannelLocator, remoteLocatorToReceive));
+    ASSERT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, inputChannelLocator));
+}
+
+TEST_F(SharedMemTests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t inputChannelLocator = HELPER_Locator(g_default_port);
+    Locator_t outputChannelLocator = transportUnderTest.RemoteToMainLocal(inputChannelLocator);
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputChannelLocator));
+
+    std::vector<octet> message(descriptor.maxMessageSize + 1);
+    ASSERT_FALSE(transportUnderTest.Send(message.data(), static_cast<uint32_t>(message.size()),
+                outputChannelLocator, inputChannelLocator));
+}
+
+TEST_F(SharedMemTests, release_input_channel_unblocks_receive)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t inputChannelLocator = HELPER_Locator(g_default_port);
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputChannelLocator));
+
+    auto receiveThreadFunction = [&]()
+    {
+        std::vector<octet> receiveBuffer(ReceiveBufferCapacity);
+        uint32_t receiveBufferSize = 0;
+
+        Locator_t remoteLocatorToReceive;
+        EXPECT_FALSE(transportUnderTest.Receive(receiveBuffer.data(), ReceiveBufferCapacity, receiveBufferSize,
+                    inputChannelLocator, remoteLocatorToReceive));
+    };
+
+    receiverThread.reset(new std::thread(receiveThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(transportUnderTest.ReleaseInputChannel(inputChannelLocator));
+    receiverThread->join();
+}
+
+void SharedMemTests::HELPER_SetDescriptorDefaults()
+{
+    descriptor.maxMessageSize = 1024;
+    descriptor.queueSize = 4;
+}
+
+Locator_t SharedMemTests::HELPER_Locator(uint32_t port)
+{
+    Locator_t locator;
+    locator.kind = LOCATOR_KIND_SHM;
+    locator.port = port;
+    return locator;
+}
+
+int main(int argc, char **argv)
+{
+    Log::SetVerbosity(Log::Info);
+    g_default_port = get_port();
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
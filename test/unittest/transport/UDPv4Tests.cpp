@@ -200,6 +200,69 @@ TEST_F(UDPv4Tests, send_to_loopback)
     senderThread->join();
     receiverThread->join();
 }
+
+TEST_F(UDPv4Tests, send_and_receive_batch)
+{
+    descriptor.maxBatchSize = 8;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t multicastLocator;
+    multicastLocator.port = g_default_port;
+    multicastLocator.kind = LOCATOR_KIND_UDPv4;
+    multicastLocator.set_IP4_address(239, 255, 0, 1);
+
+    Locator_t unicastLocator;
+    unicastLocator.port = g_default_port;
+    unicastLocator.kind = LOCATOR_KIND_UDPv4;
+    unicastLocator.set_IP4_address(127, 0, 0, 1);
+
+    LocatorList_t destinations;
+    destinations.push_back(multicastLocator);
+    destinations.push_back(unicastLocator);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator)); // Includes loopback
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(multicastLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(transportUnderTest.SendBatch(message, 5, outputChannelLocator, destinations));
+    };
+
+    auto receiveThreadFunction = [&]()
+    {
+        std::vector<octet> receiveBuffers(8 * ReceiveBufferCapacity);
+        TransportReceiveBuffer buffers[8];
+        for(uint32_t i = 0; i < 8; ++i)
+        {
+            buffers[i].buffer = &receiveBuffers[i * ReceiveBufferCapacity];
+            buffers[i].capacity = ReceiveBufferCapacity;
+        }
+
+        // Both datagrams arrive to the same socket, on one or several batches.
+        uint32_t total = 0;
+        while(total < 2)
+        {
+            uint32_t received = transportUnderTest.ReceiveBatch(buffers, 8, multicastLocator);
+            ASSERT_GT(received, 0u);
+            for(uint32_t i = 0; i < received; ++i)
+            {
+                EXPECT_EQ(buffers[i].size, 5u);
+                EXPECT_EQ(memcmp(message, buffers[i].buffer, 5), 0);
+            }
+            total += received;
+        }
+    };
+
+    receiverThread.reset(new std::thread(receiveThreadFunction));
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    receiverThread->join();
+}
 #endif
 
 TEST_F(UDPv4Tests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
@@ -0,0 +1,191 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/SnapshotPtr.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps;
+
+// Stands for an endpoint: it is destroyed by marking it as not alive.
+struct Endpoint
+{
+    Endpoint() : alive(true) {}
+
+    std::atomic<bool> alive;
+};
+
+typedef std::vector<Endpoint*> Table;
+
+// Same operations as MessageReceiver::associateEndpoint and removeEndpoint.
+static void associate(SnapshotPtr<Table>& table, Endpoint* endpoint)
+{
+    std::shared_ptr<Table> new_table = std::make_shared<Table>(*table.get());
+    new_table->push_back(endpoint);
+    table.publish(std::move(new_table));
+}
+
+static void remove(SnapshotPtr<Table>& table, Endpoint* endpoint)
+{
+    std::shared_ptr<Table> new_table = std::make_shared<Table>(*table.get());
+    new_table->erase(std::remove(new_table->begin(), new_table->end(), endpoint), new_table->end());
+    table.publish_and_wait(std::move(new_table));
+}
+
+TEST(SnapshotPtrTests, snapshots_keep_their_value)
+{
+    SnapshotPtr<Table> table(std::make_shared<const Table>());
+    Endpoint endpoint;
+
+    std::shared_ptr<const Table> before = table.get();
+    associate(table, &endpoint);
+    std::shared_ptr<const Table> after = table.get();
+
+    EXPECT_TRUE(before->empty());
+    ASSERT_EQ(1u, after->size());
+    EXPECT_EQ(&endpoint, after->front());
+}
+
+TEST(SnapshotPtrTests, removal_waits_for_every_previous_snapshot)
+{
+    SnapshotPtr<Table> table(std::make_shared<const Table>());
+    Endpoint first, second;
+
+    associate(table, &first);
+    std::shared_ptr<const Table> old_snapshot = table.get();
+
+    // Not waited by the association, so the snapshot holding the first endpoint is older than the replaced table.
+    associate(table, &second);
+
+    std::atomic<bool> removed(false);
+    std::thread remover([&]()
+    {
+        remove(table, &first);
+        removed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(removed.load());
+
+    old_snapshot.reset();
+    remover.join();
+    EXPECT_TRUE(removed.load());
+}
+
+TEST(SnapshotPtrTests, removal_wakes_up_when_the_last_old_snapshot_is_released)
+{
+    SnapshotPtr<Table> table(std::make_shared<const Table>());
+    Endpoint endpoint;
+
+    associate(table, &endpoint);
+    std::shared_ptr<const Table> first_snapshot = table.get();
+    std::shared_ptr<const Table> second_snapshot = first_snapshot;
+
+    std::atomic<bool> removed(false);
+    std::thread remover([&]()
+    {
+        remove(table, &endpoint);
+        removed = true;
+    });
+
+    // Snapshots taken after the removal do not hold it back.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::shared_ptr<const Table> new_snapshot = table.get();
+    first_snapshot.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(removed.load());
+
+    // Released by another thread, like a receive thread finishing with a submessage.
+    std::thread releaser([&]() { second_snapshot.reset(); });
+    releaser.join();
+    remover.join();
+    EXPECT_TRUE(removed.load());
+    EXPECT_TRUE(new_snapshot->empty());
+}
+
+TEST(SnapshotPtrTests, snapshots_outlive_their_snapshot_ptr)
+{
+    Endpoint endpoint;
+    std::shared_ptr<const Table> snapshot;
+
+    {
+        SnapshotPtr<Table> table(std::make_shared<const Table>());
+        associate(table, &endpoint);
+        snapshot = table.get();
+    }
+
+    ASSERT_EQ(1u, snapshot->size());
+    EXPECT_EQ(&endpoint, snapshot->front());
+    snapshot.reset();
+}
+
+TEST(SnapshotPtrTests, endpoints_are_not_used_after_being_removed)
+{
+    SnapshotPtr<Table> table(std::make_shared<const Table>());
+    std::atomic<bool> stop(false);
+    std::atomic<bool> used_after_removal(false);
+
+    // Receive thread: uses every endpoint of its snapshot for a while, like when processing a submessage.
+    std::thread receiver([&]()
+    {
+        while(!stop)
+        {
+            std::shared_ptr<const Table> snapshot = table.get();
+            for(int i = 0; i < 10; ++i)
+            {
+                for(Endpoint* endpoint : *snapshot)
+                {
+                    if(!endpoint->alive)
+                        used_after_removal = true;
+                }
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Removed endpoints are only marked as destroyed and freed at the end, so a late access is detected.
+    std::vector<std::unique_ptr<Endpoint>> endpoints;
+
+    for(int round = 0; round < 2000; ++round)
+    {
+        endpoints.emplace_back(new Endpoint());
+        Endpoint* first = endpoints.back().get();
+        endpoints.emplace_back(new Endpoint());
+        Endpoint* second = endpoints.back().get();
+
+        associate(table, first);
+        associate(table, second);
+        remove(table, first);
+        first->alive = false;
+        remove(table, second);
+        second->alive = false;
+    }
+
+    stop = true;
+    receiver.join();
+
+    EXPECT_FALSE(used_after_removal.load());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -79,6 +79,10 @@ TEST_F(XMLProfileParserTests, XMLParserParcipant)
     EXPECT_EQ(rtps_atts.defaultSendPort, 80);
     EXPECT_EQ(rtps_atts.sendSocketBufferSize, 32);
     EXPECT_EQ(rtps_atts.listenSocketBufferSize, 1000);
+    EXPECT_EQ(rtps_atts.listenWorkerThreads, 4);
+    EXPECT_EQ(rtps_atts.listenBufferPoolSize, 128);
+    EXPECT_EQ(rtps_atts.asyncSendThreads, 3);
+    EXPECT_EQ(rtps_atts.eventThreads, 2);
     EXPECT_EQ(builtin.use_SIMPLE_RTPSParticipantDiscoveryProtocol, true);
     EXPECT_EQ(builtin.use_WriterLivelinessProtocol, false);
     EXPECT_EQ(builtin.use_SIMPLE_EndpointDiscoveryProtocol, true);
@@ -149,6 +153,10 @@ TEST_F(XMLProfileParserTests, XMLParserDefaultParcipantProfile)
     EXPECT_EQ(rtps_atts.defaultSendPort, 80);
     EXPECT_EQ(rtps_atts.sendSocketBufferSize, 32);
     EXPECT_EQ(rtps_atts.listenSocketBufferSize, 1000);
+    EXPECT_EQ(rtps_atts.listenWorkerThreads, 4);
+    EXPECT_EQ(rtps_atts.listenBufferPoolSize, 128);
+    EXPECT_EQ(rtps_atts.asyncSendThreads, 3);
+    EXPECT_EQ(rtps_atts.eventThreads, 2);
     EXPECT_EQ(builtin.use_SIMPLE_RTPSParticipantDiscoveryProtocol, true);
     EXPECT_EQ(builtin.use_WriterLivelinessProtocol, false);
     EXPECT_EQ(builtin.use_SIMPLE_EndpointDiscoveryProtocol, true);
@@ -227,6 +235,11 @@ TEST_F(XMLProfileParserTests, XMLParserPublisher)
     EXPECT_EQ(pub_qos.m_partition.getNames()[0], "partition_name_a");
     EXPECT_EQ(pub_qos.m_partition.getNames()[1], "partition_name_b");
     EXPECT_EQ(pub_qos.m_publishMode.kind, ASYNCHRONOUS_PUBLISH_MODE);
+    EXPECT_EQ(pub_qos.m_publishMode.priority, HIGH_PRIORITY_PUBLISH_MODE);
+    EXPECT_EQ(pub_qos.m_fragmentScheduling.kind, INTERLEAVED_FRAGMENT_SCHEDULING);
+    EXPECT_EQ(pub_qos.m_fragmentScheduling.bytesPerReaderPerPeriod, 65536u);
+    EXPECT_EQ(pub_qos.m_fragmentScheduling.periodMillisecs, 50u);
+    EXPECT_EQ(pub_qos.m_slowReader.kind, DROP_SLOWEST_READER);
     EXPECT_EQ(pub_times.initialHeartbeatDelay, c_TimeZero);
     EXPECT_EQ(pub_times.heartbeatPeriod.seconds, 11);
     EXPECT_EQ(pub_times.heartbeatPeriod.fraction, 32);
@@ -294,6 +307,11 @@ TEST_F(XMLProfileParserTests, XMLParserDefaultPublisherProfile)
     EXPECT_EQ(pub_qos.m_partition.getNames()[0], "partition_name_a");
     EXPECT_EQ(pub_qos.m_partition.getNames()[1], "partition_name_b");
     EXPECT_EQ(pub_qos.m_publishMode.kind, ASYNCHRONOUS_PUBLISH_MODE);
+    EXPECT_EQ(pub_qos.m_publishMode.priority, HIGH_PRIORITY_PUBLISH_MODE);
+    EXPECT_EQ(pub_qos.m_fragmentScheduling.kind, INTERLEAVED_FRAGMENT_SCHEDULING);
+    EXPECT_EQ(pub_qos.m_fragmentScheduling.bytesPerReaderPerPeriod, 65536u);
+    EXPECT_EQ(pub_qos.m_fragmentScheduling.periodMillisecs, 50u);
+    EXPECT_EQ(pub_qos.m_slowReader.kind, DROP_SLOWEST_READER);
     EXPECT_EQ(pub_times.initialHeartbeatDelay, c_TimeZero);
     EXPECT_EQ(pub_times.heartbeatPeriod.seconds, 11);
     EXPECT_EQ(pub_times.heartbeatPeriod.fraction, 32);